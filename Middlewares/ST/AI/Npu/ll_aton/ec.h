@@ -24,9 +24,18 @@
 /** Magic number of the Epoch Controller binary file. */
 #define ECASM_BINARY_MAGIC 0xECBF0030
 
+/** Magic number of a "cooked" Epoch Controller binary file (see
+ * scripts/epoch_controller/cook_ec_binary.py): the header is extended to 8 entries, entries 5..7
+ * hold the precomputed sizes (in 32-bit words) of the relocation table, the patch table and the
+ * blob section, and all the sections are 8-byte aligned so the blob can be used in place. */
+#define ECASM_BINARY_MAGIC_COOKED 0xECBF0031
+
 /** Magic number of the Epoch Controller blob. */
 #define ECASM_BLOB_MAGIC 0xCA057A7A
 
+/** Magic number of an LZ4-compressed Epoch Controller blob (see scripts/epoch_controller/compress_ec_binary.py). */
+#define ECASM_BLOB_MAGIC_LZ4 0xCA057A4C
+
 /** Type containing an Epoch Controller instruction. */
 typedef uint32_t ECInstr;
 
@@ -97,6 +97,23 @@ bool ec_copy_file(const char *path, uint8_t *ptr)
 
 #endif /* #ifdef USE_FILES */
 
+/**
+ * Return the precomputed section sizes of a "cooked" Epoch Controller binary.
+ *
+ * \param[in] binary_ptr is the pointer to the memory area containing the whole Epoch Controller binary
+ *
+ * \return the pointer to the three precomputed sizes (in 32-bit words) of the relocation table, the
+ * patch table and the blob section (header entries 5..7), or \e NULL if the binary is not cooked
+ */
+
+static const ECFileEntry *_ec_cooked_sizes(const uint8_t *binary_ptr)
+{
+  if (*((const ECFileEntry *)binary_ptr) != ECASM_BINARY_MAGIC_COOKED)
+    return NULL;
+
+  return ((const ECFileEntry *)binary_ptr) + 5;
+}
+
 /**
  * Get the pointer to the blob contained in an Epoch Controller binary.
  *
@@ -119,7 +136,7 @@ const uint64_t *ec_get_blob_ptr(const uint8_t *binary_ptr)
 
   ptr += sizeof(ECFileEntry);
 
-  if (magic != ECASM_BINARY_MAGIC)
+  if ((magic != ECASM_BINARY_MAGIC) && (magic != ECASM_BINARY_MAGIC_COOKED))
   {
     LL_ATON_PRINTF("Error: Epoch Controller binary is invalid\n");
 
@@ -142,9 +159,105 @@ const uint64_t *ec_get_blob_ptr(const uint8_t *binary_ptr)
   return (const uint64_t *)(binary_ptr + blob_offset);
 }
 
+/**
+ * Decompress an LZ4 block stream directly into its destination buffer.
+ *
+ * \param[out] dst      is the pointer to the destination buffer
+ * \param[in]  dst_size is the size in bytes of the decompressed data (and of the destination buffer)
+ * \param[in]  src      is the pointer to the compressed stream
+ * \param[in]  src_size is the size in bytes of the compressed stream
+ *
+ * \retval \e true  if exactly \e dst_size bytes were produced
+ * \retval \e false if the stream is truncated or corrupted
+ */
+
+bool ec_lz4_decode(uint8_t *dst, uint32_t dst_size, const uint8_t *src, uint32_t src_size)
+{
+  uint8_t *dst_base = dst;
+  uint8_t *dst_end = dst + dst_size;
+  const uint8_t *src_end = src + src_size;
+
+  while (src < src_end)
+  {
+    uint8_t token = *src++;
+
+    // literals
+    uint32_t len = token >> 4;
+
+    if (len == 15)
+    {
+      uint8_t byte;
+
+      do
+      {
+        if (src >= src_end)
+          return false;
+
+        byte = *src++;
+
+        len += byte;
+      } while (byte == 255);
+    }
+
+    if (((uint32_t)(src_end - src) < len) || ((uint32_t)(dst_end - dst) < len))
+      return false;
+
+    memcpy(dst, src, len);
+
+    dst += len;
+    src += len;
+
+    if (src >= src_end)
+      break; // the stream ends with a literals-only sequence
+
+    // match
+    if ((src_end - src) < 2)
+      return false;
+
+    uint32_t offset = (uint32_t)src[0] | ((uint32_t)src[1] << 8);
+
+    src += 2;
+
+    if ((offset == 0) || (offset > (uint32_t)(dst - dst_base)))
+      return false;
+
+    len = token & 0x0f;
+
+    if (len == 15)
+    {
+      uint8_t byte;
+
+      do
+      {
+        if (src >= src_end)
+          return false;
+
+        byte = *src++;
+
+        len += byte;
+      } while (byte == 255);
+    }
+
+    len += 4;
+
+    if ((uint32_t)(dst_end - dst) < len)
+      return false;
+
+    // matches may overlap their own output: copy byte by byte
+    const uint8_t *match = dst - offset;
+
+    for (uint32_t i = 0; i < len; i++)
+      *dst++ = *match++;
+  }
+
+  return dst == dst_end;
+}
+
 /**
  * Copy to memory an Epoch Controller blob contained in an Epoch Controller binary.
  * The magic number and the length of the blob will be copied as well.
+ * If the blob section is LZ4-compressed, it is inflated directly into the destination buffer and the
+ * copy gets the magic number of a plain blob, so downstream consumers see no difference.
  *
  * \param[out]    blob      is the pointer to the memory area (which must be already allocated and large enough) that
  * will contain the Epoch Controller blob
@@ -179,7 +292,7 @@ bool ec_copy_blob(ECInstr *blob, const uint8_t *binary_ptr, unsigned int *blob_s
 
   ptr += sizeof(ECInstr);
 
-  if (blob_magic != ECASM_BLOB_MAGIC)
+  if ((blob_magic != ECASM_BLOB_MAGIC) && (blob_magic != ECASM_BLOB_MAGIC_LZ4))
   {
     LL_ATON_PRINTF("Error: Invalid magic number of Epoch Controller blob\n");
 
@@ -192,6 +305,17 @@ bool ec_copy_blob(ECInstr *blob, const uint8_t *binary_ptr, unsigned int *blob_s
 
   ptr += sizeof(ECInstr);
 
+  ECInstr compressed_size = 0;
+
+  if (blob_magic == ECASM_BLOB_MAGIC_LZ4)
+  {
+    // compressed blob section: the size of the compressed stream in bytes follows the
+    // (uncompressed) blob length
+    compressed_size = *((ECInstr *)ptr);
+
+    ptr += sizeof(ECInstr);
+  }
+
   if (blob == NULL)
   {
     if (blob_size != NULL)
@@ -223,15 +347,64 @@ bool ec_copy_blob(ECInstr *blob, const uint8_t *binary_ptr, unsigned int *blob_s
       return false;
     }
 
-    blob[0] = blob_magic;
+    // the copy is always a plain blob, even when the section was compressed
+    blob[0] = ECASM_BLOB_MAGIC;
     blob[1] = size;
 
-    memcpy((uint8_t *)(blob + 2), ptr, size * sizeof(ECInstr));
+    if (blob_magic == ECASM_BLOB_MAGIC_LZ4)
+    {
+      if (!ec_lz4_decode((uint8_t *)(blob + 2), size * sizeof(ECInstr), ptr, compressed_size))
+      {
+        LL_ATON_PRINTF("Error: Compressed Epoch Controller blob is corrupted\n");
+
+        return false;
+      }
+    }
+    else
+    {
+      memcpy((uint8_t *)(blob + 2), ptr, size * sizeof(ECInstr));
+    }
   }
 
   return true;
 }
 
+/**
+ * Get the pointer to the blob of a "cooked" Epoch Controller binary for in-place use.
+ * In a cooked binary the blob section is stored 8-byte aligned in its in-memory layout, so
+ * no copy is needed: the returned pointer can be passed directly to the relocation/patch
+ * functions, provided the binary resides in writable memory.
+ *
+ * \param[in] binary_ptr is the pointer to the memory area containing the whole Epoch Controller binary
+ *
+ * \return the pointer to the blob (including magic number and blob length), or \e NULL if the
+ * binary is not cooked, the blob section is compressed or the alignment is wrong
+ */
+
+ECInstr *ec_get_cooked_blob(uint8_t *binary_ptr)
+{
+  if (_ec_cooked_sizes(binary_ptr) == NULL)
+    return NULL;
+
+  ECInstr *blob = (ECInstr *)ec_get_blob_ptr(binary_ptr);
+
+  if (blob == NULL)
+    return NULL;
+
+  if ((((intptr_t)blob) % 8) != 0)
+  {
+    LL_ATON_PRINTF("Error: Blob section of a cooked Epoch Controller binary must be 8-byte aligned\n");
+
+    return NULL;
+  }
+
+  // a compressed blob cannot be used in place
+  if (blob[0] != ECASM_BLOB_MAGIC)
+    return NULL;
+
+  return blob;
+}
+
 /**
  * Copy to memory the relocation table contained in an Epoch Controller binary.
  *
@@ -261,7 +434,7 @@ bool ec_copy_reloc_table(ECFileEntry *reloc_table, const uint8_t *binary_ptr, un
 
   ECFileEntry magic = *ptr++;
 
-  if (magic != ECASM_BINARY_MAGIC)
+  if ((magic != ECASM_BINARY_MAGIC) && (magic != ECASM_BINARY_MAGIC_COOKED))
   {
     LL_ATON_PRINTF("Error: Epoch Controller binary is invalid\n");
 
@@ -280,24 +453,36 @@ bool ec_copy_reloc_table(ECFileEntry *reloc_table, const uint8_t *binary_ptr, un
     return false;
   }
 
-  ECFileEntry end = blob_offset;
+  ECFileEntry size;
 
-  if (debug_offset != 0)
-    end = debug_offset;
+  const ECFileEntry *cooked_sizes = _ec_cooked_sizes(binary_ptr);
 
-  if (patch_offset != 0)
-    end = patch_offset;
+  if (cooked_sizes != NULL)
+  {
+    // cooked binary: the table size is precomputed, nothing to derive or validate
+    size = cooked_sizes[0];
+  }
+  else
+  {
+    ECFileEntry end = blob_offset;
 
-  ECFileEntry size = end - reloc_table_offset;
+    if (debug_offset != 0)
+      end = debug_offset;
 
-  if ((size % 4) != 0)
-  {
-    LL_ATON_PRINTF("Error: Size of the relocation table of an Epoch Controller blob must be 4-byte aligned\n");
+    if (patch_offset != 0)
+      end = patch_offset;
 
-    return false;
-  }
+    size = end - reloc_table_offset;
 
-  size /= 4;
+    if ((size % 4) != 0)
+    {
+      LL_ATON_PRINTF("Error: Size of the relocation table of an Epoch Controller blob must be 4-byte aligned\n");
+
+      return false;
+    }
+
+    size /= 4;
+  }
 
   if (reloc_table == NULL)
   {
@@ -359,7 +544,7 @@ const ECFileEntry *ec_get_reloc_table_ptr(const uint8_t *binary_ptr)
 
   ptr += sizeof(ECFileEntry);
 
-  if (magic != ECASM_BINARY_MAGIC)
+  if ((magic != ECASM_BINARY_MAGIC) && (magic != ECASM_BINARY_MAGIC_COOKED))
   {
     LL_ATON_PRINTF("Error: Epoch Controller binary is invalid\n");
 
@@ -491,6 +676,216 @@ bool ec_reloc(const ECFileEntry *reloc_table_ptr, ECInstr *blob, unsigned int id
   return true;
 }
 
+/**
+ * Relocate all the values associated with a set of relocations in one sequential pass over the blob.
+ *
+ * Applying the relocations one by one (ec_reloc) walks the blob once per relocation, in whatever
+ * order the caller installs them; the value lists of different relocations interleave in the blob,
+ * so every pass touches cache lines the previous passes already evicted. Here the value lists of
+ * all the requested relocations are merged by ascending blob offset and the patches are applied in
+ * a single monotonically advancing sweep, which maximizes cache-line reuse and keeps the hardware
+ * prefetcher on a regular stride. The lists are emitted in ascending offset order by the Epoch
+ * Controller compiler; an unsorted list only costs locality, not correctness, as every value is
+ * still patched exactly once.
+ *
+ * \param[in]     reloc_table_ptr is the pointer to the relocation table (contained in an Epoch
+ * Controller binary or copied from it)
+ * \param[out]    blob            is the pointer to the memory area containing the Epoch Controller
+ * blob (that will be patched)
+ * \param[in,out] reqs            is the array of relocation requests; the \e prev_base location of
+ * each request is updated with its \e base if this function completes successfully
+ * \param[in]     num             is the number of relocation requests
+ *
+ * \retval \e true  on success
+ * \retval \e false otherwise (no request is applied)
+ */
+
+bool ec_reloc_batch(const ECFileEntry *reloc_table_ptr, ECInstr *blob, ECRelocRequest *reqs, unsigned int num)
+{
+  struct
+  {
+    const ECFileEntry *ptr; /* cursor in the value list */
+    ECFileEntry remaining;  /* values not applied yet */
+    ECAddr delta;           /* base - *prev_base of the owning relocation */
+  } cursor[EC_RELOC_BATCH_MAX];
+
+  unsigned int active = 0;
+
+  if (reloc_table_ptr == NULL)
+  {
+    LL_ATON_PRINTF("Error: Cannot relocate because the pointer to the Epoch Controller relocation table is invalid\n");
+
+    return false;
+  }
+
+  if (num > EC_RELOC_BATCH_MAX)
+  {
+    LL_ATON_PRINTF("Error: Too many relocation requests (%u) for a batch\n", num);
+
+    return false;
+  }
+
+  ECFileEntry size = *reloc_table_ptr;
+
+  // gather the value lists; requests whose base did not move contribute nothing
+  for (unsigned int i = 0; i < num; i++)
+  {
+    if (reqs[i].idx >= size)
+    {
+      LL_ATON_PRINTF("Error: Relocation index %u in Epoch Controller binary is invalid\n", reqs[i].idx);
+
+      return false;
+    }
+
+    if (reqs[i].base == *reqs[i].prev_base)
+      continue;
+
+    const ECFileEntry *ptr = reloc_table_ptr + 3 * reqs[i].idx + 2;
+
+    ECFileEntry count = *ptr++;
+
+    ECFileEntry offset = *ptr;
+
+    if ((offset % sizeof(ECFileEntry)) != 0)
+    {
+      LL_ATON_PRINTF("Error: Offset %lu in Epoch Controller binary is invalid\n", (unsigned long)offset);
+
+      return false;
+    }
+
+    if (count > 0)
+    {
+      cursor[active].ptr = (const ECFileEntry *)((const uint8_t *)reloc_table_ptr + offset);
+      cursor[active].remaining = count;
+      cursor[active].delta = reqs[i].base - *reqs[i].prev_base;
+      active++;
+    }
+  }
+
+  // k-way merge by ascending blob offset: the blob is swept once, front to back
+  while (active > 0)
+  {
+    unsigned int min = 0;
+
+    for (unsigned int i = 1; i < active; i++)
+      if (*cursor[i].ptr < *cursor[min].ptr)
+        min = i;
+
+    ECFileEntry offset = *cursor[min].ptr++;
+
+    // offset is from the real beginning of the EC blob, that is, from the first real instruction (the one
+    // following the magic number of the EC blob and its size)
+    blob[offset + 2] += cursor[min].delta;
+
+    if (--cursor[min].remaining == 0)
+      cursor[min] = cursor[--active];
+  }
+
+  for (unsigned int i = 0; i < num; i++)
+    *reqs[i].prev_base = reqs[i].base;
+
+  return true;
+}
+
+/* Open-addressing hash index over the entry identifiers of a relocation/patch table.
+ * The index is built once, lazily, the first time a by-id lookup is issued on a given table and
+ * turns the per-call linear scan with string compares of ec_reloc_by_id()/ec_patch_by_id() into a
+ * single hash probe. This matters for the cipher bring-up which patches the ENCR_LSB/ENCR_MSB
+ * registers by identifier for every stream engine on every run.
+ */
+
+#ifndef EC_ID_INDEX_SLOTS
+#define EC_ID_INDEX_SLOTS 64 /* must be a power of two and larger than the number of table entries */
+#endif
+
+#define _EC_ID_NOT_FOUND (-1) /* index is authoritative and the identifier is absent */
+#define _EC_ID_NO_INDEX  (-2) /* index unavailable (table too large), caller must scan linearly */
+
+struct _ec_id_index
+{
+  const ECFileEntry *table;            /* table the index was built for (NULL if not built) */
+  unsigned int stride;                 /* number of ECFileEntry words per table entry */
+  uint16_t slot[EC_ID_INDEX_SLOTS];    /* entry index + 1, 0 means empty */
+};
+
+static struct _ec_id_index _ec_reloc_index;
+static struct _ec_id_index _ec_patch_index;
+
+/* FNV-1a hash of an identifier string */
+static uint32_t _ec_id_hash(const char *id)
+{
+  uint32_t h = 2166136261u;
+
+  while (*id != '\0')
+  {
+    h ^= (uint8_t)*id++;
+    h *= 16777619u;
+  }
+
+  return h;
+}
+
+static const char *_ec_id_at(const ECFileEntry *table_ptr, unsigned int stride, unsigned int idx)
+{
+  ECFileEntry offset = table_ptr[stride * idx + 1];
+
+  return (const char *)((const uint8_t *)table_ptr + offset);
+}
+
+/**
+ * Look up the index of a table entry by its identifier, (re)building the hash index if needed.
+ *
+ * \param[in] index     is the cached index associated with this table kind
+ * \param[in] table_ptr is the pointer to the relocation/patch table
+ * \param[in] stride    is the number of \e ECFileEntry words per table entry
+ * \param[in] id        is the identifier to look up
+ *
+ * \return the index of the entry whose identifier matches \e id, \e _EC_ID_NOT_FOUND if no entry
+ * matches, or \e _EC_ID_NO_INDEX if the table cannot be indexed and must be scanned linearly
+ */
+
+static int _ec_id_index_find(struct _ec_id_index *index, const ECFileEntry *table_ptr, unsigned int stride,
+                             const char *id)
+{
+  ECFileEntry size = *table_ptr;
+
+  if (size > (EC_ID_INDEX_SLOTS - (EC_ID_INDEX_SLOTS / 4)))
+    return _EC_ID_NO_INDEX; /* keep the load factor below 3/4 so probe chains stay short */
+
+  if ((index->table != table_ptr) || (index->stride != stride))
+  {
+    // build the index: one-time cost, amortized over all subsequent by-id lookups
+    memset(index->slot, 0, sizeof(index->slot));
+
+    for (unsigned int n = 0; n < size; n++)
+    {
+      uint32_t h = _ec_id_hash(_ec_id_at(table_ptr, stride, n)) & (EC_ID_INDEX_SLOTS - 1);
+
+      while (index->slot[h] != 0)
+        h = (h + 1) & (EC_ID_INDEX_SLOTS - 1);
+
+      index->slot[h] = (uint16_t)(n + 1);
+    }
+
+    index->table = table_ptr;
+    index->stride = stride;
+  }
+
+  uint32_t h = _ec_id_hash(id) & (EC_ID_INDEX_SLOTS - 1);
+
+  while (index->slot[h] != 0)
+  {
+    unsigned int n = index->slot[h] - 1;
+
+    if (strcmp(id, _ec_id_at(table_ptr, stride, n)) == 0)
+      return (int)n;
+
+    h = (h + 1) & (EC_ID_INDEX_SLOTS - 1);
+  }
+
+  return _EC_ID_NOT_FOUND;
+}
+
 /**
  * Relocate all the values associated with a relocation specified by using an identifier.
  *
@@ -520,53 +915,60 @@ bool ec_reloc_by_id(const ECFileEntry *reloc_table_ptr, ECInstr *blob, const cha
   if (base == *prev_base)
     return true;
 
-  const ECFileEntry *ptr = reloc_table_ptr;
+  int found = _ec_id_index_find(&_ec_reloc_index, reloc_table_ptr, 3, id);
 
-  ECFileEntry size = *ptr;
-
-  for (unsigned int n = 0; n < size; n++)
+  if (found == _EC_ID_NO_INDEX)
   {
-    ptr = reloc_table_ptr + 3 * n + 1;
+    // table too large for the index: fall back to the linear scan
+    ECFileEntry size = *reloc_table_ptr;
 
-    ECFileEntry offset = *ptr;
+    found = _EC_ID_NOT_FOUND;
 
-    const char *tmp_id = (const char *)((const uint8_t *)reloc_table_ptr + offset);
-
-    if (strcmp(id, tmp_id) == 0)
+    for (unsigned int n = 0; n < size; n++)
     {
-      ptr++;
+      if (strcmp(id, _ec_id_at(reloc_table_ptr, 3, n)) == 0)
+      {
+        found = (int)n;
+
+        break;
+      }
+    }
+  }
 
-      ECFileEntry num = *ptr++;
+  if (found < 0)
+  {
+    LL_ATON_PRINTF("Error: Relocation symbol '%s' not found in Epoch Controller relocation table\n", id);
 
-      ECFileEntry offset = *ptr;
+    return false;
+  }
 
-      if ((offset % sizeof(ECFileEntry)) != 0)
-      {
-        LL_ATON_PRINTF("Error: Offset %lu in Epoch Controller binary is invalid\n", (unsigned long)offset);
+  const ECFileEntry *ptr = reloc_table_ptr + 3 * found + 2;
 
-        return false;
-      }
+  ECFileEntry num = *ptr++;
 
-      ptr = (const ECFileEntry *)((const uint8_t *)reloc_table_ptr + offset);
+  ECFileEntry offset = *ptr;
 
-      for (unsigned int i = 0; i < num; i++)
-      {
-        ECFileEntry offset = *ptr++;
+  if ((offset % sizeof(ECFileEntry)) != 0)
+  {
+    LL_ATON_PRINTF("Error: Offset %lu in Epoch Controller binary is invalid\n", (unsigned long)offset);
 
-        // offset is from the real beginning of the EC blob, that is, from the first real instruction (the one
-        // following the magic number of the EC blob and its size)
-        blob[offset + 2] += base - *prev_base;
-      }
+    return false;
+  }
 
-      *prev_base = base;
+  ptr = (const ECFileEntry *)((const uint8_t *)reloc_table_ptr + offset);
 
-      return true;
-    }
+  for (unsigned int i = 0; i < num; i++)
+  {
+    ECFileEntry offset = *ptr++;
+
+    // offset is from the real beginning of the EC blob, that is, from the first real instruction (the one
+    // following the magic number of the EC blob and its size)
+    blob[offset + 2] += base - *prev_base;
   }
 
-  LL_ATON_PRINTF("Error: Relocation symbol '%s' not found in Epoch Controller relocation table\n", id);
+  *prev_base = base;
 
-  return false;
+  return true;
 }
 
 /**
@@ -598,7 +1000,7 @@ bool ec_copy_patch_table(ECFileEntry *patch_table, const uint8_t *binary_ptr, un
 
   ECFileEntry magic = *ptr++;
 
-  if (magic != ECASM_BINARY_MAGIC)
+  if ((magic != ECASM_BINARY_MAGIC) && (magic != ECASM_BINARY_MAGIC_COOKED))
   {
     LL_ATON_PRINTF("Error: Epoch Controller binary is invalid\n");
 
@@ -618,21 +1020,33 @@ bool ec_copy_patch_table(ECFileEntry *patch_table, const uint8_t *binary_ptr, un
     return false;
   }
 
-  ECFileEntry end = blob_offset;
+  ECFileEntry size;
 
-  if (debug_offset != 0)
-    end = debug_offset;
+  const ECFileEntry *cooked_sizes = _ec_cooked_sizes(binary_ptr);
 
-  ECFileEntry size = end - patch_table_offset;
-
-  if ((size % 4) != 0)
+  if (cooked_sizes != NULL)
   {
-    LL_ATON_PRINTF("Error: Size of the patch table of an Epoch Controller blob must be 4-byte aligned\n");
-
-    return false;
+    // cooked binary: the table size is precomputed, nothing to derive or validate
+    size = cooked_sizes[1];
   }
+  else
+  {
+    ECFileEntry end = blob_offset;
+
+    if (debug_offset != 0)
+      end = debug_offset;
+
+    size = end - patch_table_offset;
+
+    if ((size % 4) != 0)
+    {
+      LL_ATON_PRINTF("Error: Size of the patch table of an Epoch Controller blob must be 4-byte aligned\n");
+
+      return false;
+    }
 
-  size /= 4;
+    size /= 4;
+  }
 
   if (patch_table == NULL)
   {
@@ -695,7 +1109,7 @@ const ECFileEntry *ec_get_patch_table_ptr(const uint8_t *binary_ptr)
 
   ptr += sizeof(ECFileEntry);
 
-  if (magic != ECASM_BINARY_MAGIC)
+  if ((magic != ECASM_BINARY_MAGIC) && (magic != ECASM_BINARY_MAGIC_COOKED))
   {
     LL_ATON_PRINTF("Error: Epoch Controller binary is invalid\n");
 
@@ -877,51 +1291,134 @@ bool ec_patch_by_id(const ECFileEntry *patch_table_ptr, ECInstr *blob, const cha
     return false;
   }
 
-  const ECFileEntry *ptr = patch_table_ptr;
+  int found = _ec_id_index_find(&_ec_patch_index, patch_table_ptr, 4, id);
 
-  ECFileEntry size = *ptr;
+  if (found == _EC_ID_NO_INDEX)
+  {
+    // table too large for the index: fall back to the linear scan
+    ECFileEntry size = *patch_table_ptr;
+
+    found = _EC_ID_NOT_FOUND;
+
+    for (unsigned int n = 0; n < size; n++)
+    {
+      if (strcmp(id, _ec_id_at(patch_table_ptr, 4, n)) == 0)
+      {
+        found = (int)n;
 
-  for (unsigned int n = 0; n < size; n++)
+        break;
+      }
+    }
+  }
+
+  if (found < 0)
   {
-    ptr = patch_table_ptr + 4 * n + 1;
+    LL_ATON_PRINTF("Error: Patch '%s' not found in Epoch Controller patch table\n", id);
 
-    ECFileEntry offset = *ptr;
+    return false;
+  }
 
-    const char *tmp_id = (const char *)((const uint8_t *)patch_table_ptr + offset);
+  const ECFileEntry *ptr = patch_table_ptr + 4 * found + 2;
 
-    if (strcmp(id, tmp_id) == 0)
-    {
-      ptr++;
+  uint32_t mask = *ptr++;
+  ECFileEntry num = *ptr++;
 
-      uint32_t mask = *ptr++;
-      ECFileEntry num = *ptr++;
+  ECFileEntry offset = *ptr;
 
-      ECFileEntry offset = *ptr;
+  if ((offset % sizeof(ECFileEntry)) != 0)
+  {
+    LL_ATON_PRINTF("Error: Offset %lu in Epoch Controller binary is invalid\n", (unsigned long)offset);
 
-      if ((offset % sizeof(ECFileEntry)) != 0)
-      {
-        LL_ATON_PRINTF("Error: Offset %lu in Epoch Controller binary is invalid\n", (unsigned long)offset);
+    return false;
+  }
 
-        return false;
-      }
+  ptr = (const ECFileEntry *)((const uint8_t *)patch_table_ptr + offset);
 
-      ptr = (const ECFileEntry *)((const uint8_t *)patch_table_ptr + offset);
+  for (unsigned int i = 0; i < num; i++)
+  {
+    ECFileEntry offset = *ptr++;
 
-      for (unsigned int i = 0; i < num; i++)
-      {
-        ECFileEntry offset = *ptr++;
+    // offset is from the real beginning of the EC blob, that is, from the first real instruction (the one
+    // following the magic number of the EC blob and its size)
+    blob[offset + 2] &= ~mask;
+    blob[offset + 2] |= (value & mask);
+  }
 
-        // offset is from the real beginning of the EC blob, that is, from the first real instruction (the one
-        // following the magic number of the EC blob and its size)
-        blob[offset + 2] &= ~mask;
-        blob[offset + 2] |= (value & mask);
-      }
+  return true;
+}
+
+/**
+ * Return the number of Epoch Controller binaries contained in a blob partition.
+ *
+ * \param[in] part_ptr is the pointer to the memory-mapped blob partition
+ *
+ * \return the number of directory entries of the partition pointed by \e part_ptr, or 0 if the partition is invalid
+ */
+
+unsigned int ec_part_num_blobs(const uint8_t *part_ptr)
+{
+  const ECPartHeader *header = (const ECPartHeader *)part_ptr;
+
+  if ((header == NULL) || (header->magic != ECPART_MAGIC))
+    return 0;
+
+  return header->count;
+}
+
+/**
+ * Return the identifier of a directory entry of a blob partition.
+ *
+ * \param[in] part_ptr is the pointer to the memory-mapped blob partition
+ * \param[in] idx      is the index of the entry whose identifier must be retrieved
+ *
+ * \return the identifier of the entry having index \e idx in the directory of the partition pointed by \e part_ptr,
+ * or \e NULL if that entry does not exist
+ */
+
+const char *ec_part_get_id(const uint8_t *part_ptr, unsigned int idx)
+{
+  if (idx >= ec_part_num_blobs(part_ptr))
+    return NULL;
+
+  const ECPartEntry *entries = (const ECPartEntry *)(part_ptr + sizeof(ECPartHeader));
+
+  return entries[idx].id;
+}
+
+/**
+ * Get the pointer to the Epoch Controller binary of a blob partition matching an identifier.
+ * The returned pointer addresses the binary in place in the memory-mapped partition: it can be
+ * handed directly to \e ec_get_blob_ptr (the packer keeps the binaries 8-byte aligned so the
+ * contained blob section is usable without a copy).
+ *
+ * \param[in]  part_ptr is the pointer to the memory-mapped blob partition
+ * \param[in]  id       is the identifier of the Epoch Controller binary to look up
+ * \param[out] size     is the pointer to the variable that, if not \e NULL, will contain the size in bytes of the
+ * Epoch Controller binary
+ *
+ * \return the pointer to the Epoch Controller binary whose directory identifier matches \e id, or \e NULL if the
+ * partition is invalid or no entry matches
+ */
 
-      return true;
+const uint8_t *ec_part_find(const uint8_t *part_ptr, const char *id, unsigned int *size)
+{
+  unsigned int count = ec_part_num_blobs(part_ptr);
+
+  if ((count == 0) || (id == NULL))
+    return NULL;
+
+  const ECPartEntry *entries = (const ECPartEntry *)(part_ptr + sizeof(ECPartHeader));
+
+  for (unsigned int n = 0; n < count; n++)
+  {
+    if (strncmp(id, entries[n].id, ECPART_ID_LEN) == 0)
+    {
+      if (size != NULL)
+        *size = entries[n].size;
+
+      return part_ptr + entries[n].offset;
     }
   }
 
-  LL_ATON_PRINTF("Error: Patch '%s' not found in Epoch Controller patch table\n", id);
-
-  return false;
+  return NULL;
 }
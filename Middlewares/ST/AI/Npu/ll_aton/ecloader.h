@@ -42,9 +42,15 @@ extern "C"
   // get the pointer to the blob contained in an Epoch Controller binary
   const uint64_t *ec_get_blob_ptr(const uint8_t *binary_ptr);
 
+  // decompress an LZ4 block stream (returns true iff exactly dst_size bytes were produced)
+  extern bool ec_lz4_decode(uint8_t *dst, uint32_t dst_size, const uint8_t *src, uint32_t src_size);
+
   // copy to memory the Epoch Controller blob contained in an Epoch Controller binary
   extern bool ec_copy_blob(ECInstr *blob, const uint8_t *binary_ptr, unsigned int *blob_size);
 
+  // get the pointer to the blob of a "cooked" Epoch Controller binary for in-place use (no copy)
+  extern ECInstr *ec_get_cooked_blob(uint8_t *binary_ptr);
+
   /* functions dealing with relocations */
 
   // copy to memory the relocation table contained in an Epoch Controller binary
@@ -67,6 +73,24 @@ extern "C"
   extern bool ec_reloc_by_id(const ECFileEntry *reloc_table_ptr, ECInstr *blob, const char *id, ECAddr base,
                              ECAddr *prev_base);
 
+/* maximum number of relocation requests a single ec_reloc_batch() call accepts */
+#ifndef EC_RELOC_BATCH_MAX
+#define EC_RELOC_BATCH_MAX 32
+#endif
+
+  // one pending relocation of a batch
+  typedef struct
+  {
+    unsigned int idx; // index of the relocation in the relocation table
+    ECAddr base;      // offset that must be added to the values to be relocated
+    ECAddr *prev_base; // previous base of this relocation, updated on success
+  } ECRelocRequest;
+
+  // relocate all the values associated with a set of relocations, merged by ascending blob offset
+  // and applied in one sequential pass over the blob
+  extern bool ec_reloc_batch(const ECFileEntry *reloc_table_ptr, ECInstr *blob, ECRelocRequest *reqs,
+                             unsigned int num);
+
   /* functions dealing with patches */
 
   // copy to memory the patch table contained in an Epoch Controller binary
@@ -90,6 +114,44 @@ extern "C"
   // patch all the values associated with a patch specified by using an identifier
   extern bool ec_patch_by_id(const ECFileEntry *patch_table_ptr, ECInstr *blob, const char *id, uint32_t value);
 
+  /* Epoch Controller blob partition
+   *
+   * A partition is a flat, memory-mappable image holding several Epoch Controller
+   * binaries behind a small directory, so the models can be (re)flashed
+   * independently of the firmware image:
+   *
+   *   ECPartHeader | ECPartEntry[count] | ... binaries (8-byte aligned) ...
+   *
+   * Entry offsets are relative to the partition base. The image is produced by
+   * scripts/N6_scripts/ec_partition_pack.py and consumed in place from the
+   * memory-mapped external flash.
+   */
+
+#define ECPART_MAGIC 0x54504345u /* "ECPT" (little endian) */
+#define ECPART_ID_LEN 32         /* identifier size, including the terminating '\0' */
+
+  typedef struct
+  {
+    uint32_t magic;   /* ECPART_MAGIC */
+    uint32_t count;   /* number of directory entries */
+  } ECPartHeader;
+
+  typedef struct
+  {
+    char id[ECPART_ID_LEN]; /* blob identifier, '\0' terminated */
+    uint32_t offset;        /* offset of the Epoch Controller binary from the partition base */
+    uint32_t size;          /* size in bytes of the Epoch Controller binary */
+  } ECPartEntry;
+
+  // return the number of Epoch Controller binaries contained in a blob partition
+  extern unsigned int ec_part_num_blobs(const uint8_t *part_ptr);
+
+  // return the identifier of a directory entry of a blob partition
+  extern const char *ec_part_get_id(const uint8_t *part_ptr, unsigned int idx);
+
+  // get the pointer to the Epoch Controller binary of a blob partition matching an identifier
+  extern const uint8_t *ec_part_find(const uint8_t *part_ptr, const char *id, unsigned int *size);
+
 #ifdef __cplusplus
 }
 #endif
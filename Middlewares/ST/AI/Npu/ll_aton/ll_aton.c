@@ -454,6 +454,43 @@ int LL_ATON_DisableUnits_Init(const LL_ATON_DisableUnits_InitTypeDef *LL_ATON_Di
   return LL_ATON_OK;
 }
 
+/* Adaptive spin-then-relax polling (LL_ATON_RT_POLLING configuration).
+ *
+ * Back-to-back status reads are bus transactions that compete with the
+ * stream-engine traffic and measurably slow memory-bound epochs. Each wait
+ * now spins tight only for a bounded probe window - seeded per epoch block
+ * by the runtime from its wait history - and past that window relaxes with
+ * a core-local WFE between two probes (bounded by the next event or system
+ * tick), keeping the bus free for epochs known to be long. Relaxed probes
+ * are reported with a large weight so the history converges towards "relax
+ * early" for long epochs and "spin only" for short ones.
+ */
+#define LL_ATON_POLL_SPIN_DEFAULT (256U)  /* tight probes without a hint */
+#define LL_ATON_POLL_SPIN_MAX     (4096U) /* tight window upper bound */
+#define LL_ATON_POLL_RELAX_WEIGHT (1024U) /* probe-equivalent of one WFE */
+
+static uint32_t _poll_hint; /* one-shot spin window, 0 selects the default */
+static uint32_t _poll_last; /* weighted probe count of the last wait */
+
+void LL_ATON_SetPollingBackoffHint(uint32_t expected_probes)
+{
+  _poll_hint = expected_probes;
+}
+
+uint32_t LL_ATON_GetLastPollingWait(void)
+{
+  return _poll_last;
+}
+
+static uint32_t _poll_take_spin_window(void)
+{
+  uint32_t w = (_poll_hint != 0) ? _poll_hint : LL_ATON_POLL_SPIN_DEFAULT;
+  _poll_hint = 0;
+  if (w > LL_ATON_POLL_SPIN_MAX)
+    w = LL_ATON_POLL_SPIN_MAX;
+  return w;
+}
+
 /**
  * @brief  Waits for streaming engine(s) to become idle
  * @param  mask Bitmask of DMA identifiers
@@ -463,7 +500,9 @@ int LL_Streng_Wait(uint32_t mask)
 {
   int i;
   uint32_t enableFlags;
+  uint32_t spin = _poll_take_spin_window();
 
+  _poll_last = 0;
   startWatchdog(ATON_EPOCH_TIMEOUT);
 
   do
@@ -479,6 +518,20 @@ int LL_Streng_Wait(uint32_t mask)
 
     LL_ATON_ASSERT(checkWatchdog() == 0);
 
+    if (enableFlags)
+    {
+      if (spin)
+      {
+        spin--;
+        _poll_last++;
+      }
+      else
+      {
+        /* expected-long epoch: core-local wait, no bus traffic */
+        __WFE();
+        _poll_last += LL_ATON_POLL_RELAX_WEIGHT;
+      }
+    }
   } while (enableFlags);
 
   return LL_ATON_OK;
@@ -2466,7 +2519,9 @@ int LL_EpochCtrl_Wait(uint32_t mask)
 {
   int i;
   uint32_t enableFlags;
+  uint32_t spin = _poll_take_spin_window();
 
+  _poll_last = 0;
   startWatchdog(ATON_EPOCH_TIMEOUT);
 
   do
@@ -2482,6 +2537,20 @@ int LL_EpochCtrl_Wait(uint32_t mask)
 
     LL_ATON_ASSERT(checkWatchdog() == 0);
 
+    if (enableFlags)
+    {
+      if (spin)
+      {
+        spin--;
+        _poll_last++;
+      }
+      else
+      {
+        /* expected-long blob: core-local wait, no bus traffic */
+        __WFE();
+        _poll_last += LL_ATON_POLL_RELAX_WEIGHT;
+      }
+    }
   } while (enableFlags);
 
   return LL_ATON_OK;
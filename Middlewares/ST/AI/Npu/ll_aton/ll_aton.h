@@ -510,6 +510,13 @@ extern "C"
   int LL_Streng_TensorInit(int id, const LL_Streng_TensorInitTypeDef *, int n);
   int LL_Streng_ExtSyncInit(int id, LL_Streng_ExtSyncTypedef *);
   int LL_Streng_Wait(uint32_t mask);
+
+  /* Adaptive polling backoff (LL_ATON_RT_POLLING): one-shot tight-spin
+   * window (in status probes) for the next wait, and the weighted length
+   * of the last wait, used by the runtime to maintain its per-epoch-block
+   * wait history */
+  void LL_ATON_SetPollingBackoffHint(uint32_t expected_probes);
+  uint32_t LL_ATON_GetLastPollingWait(void);
   /**
    * @}
    */
@@ -518,6 +525,7 @@ extern "C"
    * @{
    */
   int LL_Busif_SetKeys(int id, int key, uint64_t key_low, uint64_t key_hi);
+  void LL_Busif_InvalidateKeyCache(void);
   /**
    * @}
    */
@@ -27,6 +27,9 @@
  *      LL_ATON_CONCAT(a, b)
  *      LL_ATON_CONCAT3(a, b, c)
  *      LL_ATON_WEAK
+ *      LL_ATON_DTCM_SECTION
+ *      LL_ATON_HOT_TEXT
+ *      LL_ATON_COLD_TEXT
  *
  */
 
@@ -78,4 +81,30 @@
 #define LL_ATON_ALIGNED(x) /* LL_ATON_ALIGNED(x) */
 #endif
 
+/* Placement attribute for hot runtime state (network execution instances,
+   epoch-block descriptor copies). Maps to the `.dtcm_data` output section
+   when `LL_ATON_USE_DTCM` is defined and the platform linker script provides
+   the matching TCM region, empty (default placement) otherwise. */
+#if defined(LL_ATON_USE_DTCM) && (defined(__GNUC__) || defined(__clang__))
+#define LL_ATON_DTCM_SECTION __attribute__((section(".dtcm_data")))
+#else
+#define LL_ATON_DTCM_SECTION /* LL_ATON_DTCM_SECTION */
+#endif
+
+/* Placement attributes for hot/cold code splitting. The functions on the
+   per-inference path (epoch scheduling, ATON ISR) are collected into the
+   `.text.hot` input sections, which the platform linker script may gather
+   on a cache-line boundary at the front of the executable region so the
+   epoch loop does not share I-cache lines with error handling and init
+   code; with a linker script that only has a `.text*` wildcard they fall
+   back to default placement. The cold attribute keeps the error paths
+   inside hot functions out of line. */
+#if defined(__GNUC__) || defined(__clang__)
+#define LL_ATON_HOT_TEXT  __attribute__((hot, section(".text.hot")))
+#define LL_ATON_COLD_TEXT __attribute__((cold))
+#else
+#define LL_ATON_HOT_TEXT  /* LL_ATON_HOT_TEXT */
+#define LL_ATON_COLD_TEXT /* LL_ATON_COLD_TEXT */
+#endif
+
 #endif
@@ -16,8 +16,11 @@
  ******************************************************************************
  */
 
+#include <string.h>
+
 #include "ll_aton_cipher.h"
 #include "ll_aton.h"
+#include "ll_aton_caches_interface.h"
 #include "ll_aton_platform.h"
 
 #if !defined(DEFAULT_WEIGHT_ENCRYPTION_ID)
@@ -109,10 +112,24 @@ int LL_Streng_EncryptionInit(int id, LL_Streng_EncryptionTypedef *LL_Streng_Encr
 }
 
 int LL_Streng_WeightEncryptionInit(int id)
+{
+  return LL_Streng_WeightEncryptionInitWithId(id, DEFAULT_WEIGHT_ENCRYPTION_ID);
+}
+
+/**
+ * @brief Configures the Streaming Engine weight decryption with an explicit encryption ID
+ * @param id Streaming engine identifier [0..ATON_STRENG_NUM-1]
+ * @param encryption_id 43 bit encryption ID the segment was encrypted with
+ * @note Counterpart of LL_Streng_WeightEncryptionInit for weight images encrypted as
+ *       independent segments (e.g. one per epoch for lazy parameter loading): each
+ *       segment carries its own encryption ID and the loader reprograms it before
+ *       streaming the segment
+ */
+int LL_Streng_WeightEncryptionInitWithId(int id, uint64_t encryption_id)
 {
   LL_Streng_EncryptionTypedef LL_Streng_EncryptionStruct = {
       .enable = 1,
-      .encryption_id = DEFAULT_WEIGHT_ENCRYPTION_ID,
+      .encryption_id = encryption_id,
       .rounds = DEFAULT_WEIGHT_ENCRYPTION_ROUNDS,
       .key_sel = DEFAULT_WEIGHT_KEY_SEL,
       .increment = 0,
@@ -120,12 +137,36 @@ int LL_Streng_WeightEncryptionInit(int id)
   return LL_Streng_EncryptionInit(id, &LL_Streng_EncryptionStruct);
 }
 
+/* Last key material programmed per bus interface and key slot. The key
+   registers are write-only serialized accesses on the model-swap path:
+   repeated npu_init/run sequences with unchanged keys (and multi-network
+   setups sharing key material) skip the reprogramming entirely. */
+static struct
+{
+  uint64_t key_low;
+  uint64_t key_hi;
+  uint8_t valid;
+} _busif_key_cache[ATON_BUSIF_NUM][2];
+
+/**
+ * @brief Invalidates the bus-interface key cache
+ * @note  Must be called whenever the programmed keys may no longer match the
+ *        cached view (ATON reset / power cycle): the next LL_Busif_SetKeys
+ *        calls reprogram the registers unconditionally
+ */
+void LL_Busif_InvalidateKeyCache(void)
+{
+  memset(_busif_key_cache, 0, sizeof(_busif_key_cache));
+}
+
 /**
  * @brief Configures Bus Interface encryption keys
  * @param id, Bus Interface identifier [0..ATON_BUSIF_NUM-1]
  * @param key Selects key to configure [0..1]
  * @param key_low lowest 64 bits of the key
  * @param key_hi highest 64 bits of the key
+ * @note  The write sequence is skipped when the slot already holds this key
+ *        material (see LL_Busif_InvalidateKeyCache)
  */
 int LL_Busif_SetKeys(int id, int key, uint64_t key_low, uint64_t key_hi)
 {
@@ -136,6 +177,15 @@ int LL_Busif_SetKeys(int id, int key, uint64_t key_low, uint64_t key_hi)
   if (id >= ATON_BUSIF_NUM)
     return LL_ATON_INVALID_ID;
 
+  if ((key == 0) || (key == 1))
+  {
+    if (_busif_key_cache[id][key].valid && (_busif_key_cache[id][key].key_low == key_low) &&
+        (_busif_key_cache[id][key].key_hi == key_hi))
+    {
+      return 0;
+    }
+  }
+
   if (key == 0)
   {
     ATON_BUSIF_KEY_SET(id, ATON_BUSIF_0_KEY0_31_0_IDX, ATON_BUSIF_0_KEY0_31_0_S, key_low & 0xffffffff);
@@ -155,6 +205,10 @@ int LL_Busif_SetKeys(int id, int key, uint64_t key_low, uint64_t key_hi)
     return LL_ATON_INVALID_ID;
   }
 
+  _busif_key_cache[id][key].key_low = key_low;
+  _busif_key_cache[id][key].key_hi = key_hi;
+  _busif_key_cache[id][key].valid = 1;
+
   return 0;
 }
 
@@ -188,14 +242,15 @@ int LL_EpochCtrl_EncryptionInit(int id, LL_Streng_EncryptionTypedef *conf)
 }
 
 /**
- * @brief  Handles Dma/Cypher data transfer
+ * @brief  Starts a Dma/Cypher data transfer without waiting for its completion
  * @param  cypherInfo: transfer parameters (addresses, keys, ... )
  * @retval Error code (0: og - -1: ko)
  * @note   WARNING: this is an utility function and its usage is not compatible with the ATON runtime
  * @note   The function uses stream engines 0 and 1
  * @note   It uses default (0) values for encryption id and round (12)
+ * @note   LL_DmaCypherWait() must be called before starting the next transfer
  */
-int LL_DmaCypherInit(LL_Cypher_InitTypeDef *cypherInfo)
+int LL_DmaCypherStart(LL_Cypher_InitTypeDef *cypherInfo)
 {
   uint32_t limit;
   uint32_t lastAdd;
@@ -307,6 +362,21 @@ int LL_DmaCypherInit(LL_Cypher_InitTypeDef *cypherInfo)
 
   LL_ATON_EnableUnits_Init(dma_units, 2);
 
+  return (0);
+}
+
+/**
+ * @brief  Waits for the end of a Dma/Cypher transfer started with LL_DmaCypherStart
+ * @retval Error code (0: og - -1: ko)
+ */
+int LL_DmaCypherWait(void)
+{
+  const LL_Switch_InitTypeDef switch_init = {LL_Switch_Init_Dest() = ATONN_DSTPORT(STRSWITCH, 0, STRENG, 1, 0),
+                                             LL_Switch_Init_Source(0) = ATONN_SRCPORT(STRSWITCH, 0, STRENG, 0, 0),
+                                             LL_Switch_Init_Context(0) = 1, LL_Switch_Init_Frames(0) = 0};
+
+  const LL_ATON_EnableUnits_InitTypeDef dma_units[] = {{{STRENG, 1}}, {{STRENG, 0}}};
+
   /* Wait for end of transfer */
 
   const uint32_t dma_wait_mask = 1 << CYPHER_DST_STRENG_ID; // Wait for destination stream engine
@@ -322,4 +392,213 @@ int LL_DmaCypherInit(LL_Cypher_InitTypeDef *cypherInfo)
   return (0);
 }
 
+/**
+ * @brief  Handles Dma/Cypher data transfer
+ * @param  cypherInfo: transfer parameters (addresses, keys, ... )
+ * @retval Error code (0: og - -1: ko)
+ * @note   WARNING: this is an utility function and its usage is not compatible with the ATON runtime
+ * @note   The function uses stream engines 0 and 1
+ * @note   It uses default (0) values for encryption id and round (12)
+ */
+int LL_DmaCypherInit(LL_Cypher_InitTypeDef *cypherInfo)
+{
+  int res = LL_DmaCypherStart(cypherInfo);
+
+  if (res != 0)
+    return res;
+
+  return LL_DmaCypherWait();
+}
+
+/**
+ * @brief  Handles a multi-region Dma/Cypher job as one batch
+ * @param  cypherInfo: shared transfer parameters (cache/enable masks, keys);
+ *         its srcAdd/dstAdd/len fields are ignored
+ * @param  regions: per-region addresses and sizes
+ * @param  nRegions: number of regions
+ * @retval Error code (0: og - -1: ko)
+ * @note   The stream switch path, the unit list and the bus interface keys
+ *         are configured once for the whole job and only the per-region
+ *         stream engine address/length registers are rewritten between
+ *         regions, removing the per-region setup/teardown of a
+ *         LL_DmaCypherInit loop. The stream engines have no descriptor
+ *         chaining, so the region boundary still synchronizes on the
+ *         destination engine before reprogramming.
+ * @note   Same restrictions as LL_DmaCypherInit (stream engines 0 and 1)
+ */
+int LL_DmaCypherBatch(const LL_Cypher_InitTypeDef *cypherInfo, const LL_Cypher_RegionTypeDef *regions, int nRegions)
+{
+  const LL_Switch_InitTypeDef switch_init = {LL_Switch_Init_Dest() = ATONN_DSTPORT(STRSWITCH, 0, STRENG, 1, 0),
+                                             LL_Switch_Init_Source(0) = ATONN_SRCPORT(STRSWITCH, 0, STRENG, 0, 0),
+                                             LL_Switch_Init_Context(0) = 1, LL_Switch_Init_Frames(0) = 0};
+
+  const LL_ATON_EnableUnits_InitTypeDef dma_units[] = {{{STRENG, 1}}, {{STRENG, 0}}};
+  const uint32_t dma_wait_mask = 1 << CYPHER_DST_STRENG_ID;
+
+  if (!cypherInfo || !regions || (nRegions <= 0))
+    return (-1);
+
+  LL_ATON_Init();
+
+  if (cypherInfo->cypherEnableMask != 0)
+  {
+    if (((cypherInfo->cypherEnableMask & CYPHER_SRC_MASK) == 0) &&
+        ((cypherInfo->cypherEnableMask & CYPHER_DST_MASK) == 0))
+    {
+      return (-1);
+    }
+
+    /* Set encryption keys into Bus Interface, once for the whole job */
+
+    LL_Busif_SetKeys(0, 0, cypherInfo->busIfKeyLsb, cypherInfo->busIfKeyMsb);
+  }
+
+  /* Enable stream switch, once for the whole job */
+
+  LL_Switch_Init(&switch_init, 1);
+
+  for (int r = 0; r < nRegions; r++)
+  {
+    uint32_t limit;
+    uint32_t lastAdd;
+
+    if (cypherInfo->cypherCacheMask != 0 && regions[r].len > CYPHER_CACHE_SIZE)
+      return (-1);
+
+    lastAdd = regions[r].srcAdd + regions[r].len;
+    limit = (uint32_t)regions[r].len + (8 - (lastAdd & 7));
+    limit += (8 - (limit & 7));
+
+    LL_Streng_TensorInitTypeDef dma_in = {.dir = 0,
+                                          .addr_base.i = regions[r].srcAdd,
+                                          .offset_start = 0,
+                                          .offset_end = (uint32_t)regions[r].len,
+                                          .offset_limit = limit,
+                                          .raw = 1,
+                                          .frame_tot_cnt = 1,
+                                          .nbits_in = 8,
+                                          .nbits_out = 8,
+                                          .nbits_unsigned = 0};
+
+    lastAdd = regions[r].dstAdd + regions[r].len;
+    limit = (uint32_t)regions[r].len + (8 - (lastAdd & 7));
+    limit += (8 - (limit & 7));
+
+    LL_Streng_TensorInitTypeDef dma_out = {.dir = 1,
+                                           .addr_base.i = regions[r].dstAdd,
+                                           .offset_start = 0,
+                                           .offset_end = (uint32_t)regions[r].len,
+                                           .offset_limit = limit,
+                                           .raw = 1,
+                                           .frame_tot_cnt = 1,
+                                           .nbits_in = 8,
+                                           .nbits_out = 8,
+                                           .nbits_unsigned = 0};
+
+    dma_in.cacheable = (0 != (cypherInfo->cypherCacheMask & CYPHER_CACHE_SRC)) ? 1 : 0;
+    dma_in.cache_allocate = dma_in.cacheable;
+    dma_out.cacheable = (0 != (cypherInfo->cypherCacheMask & CYPHER_CACHE_DST)) ? 1 : 0;
+    dma_out.cache_allocate = dma_out.cacheable;
+
+    if ((cypherInfo->cypherEnableMask & CYPHER_SRC_MASK) != 0)
+      dma_in.cipher_en = 1;
+    else if ((cypherInfo->cypherEnableMask & CYPHER_DST_MASK) != 0)
+      dma_out.cipher_en = 1;
+
+    LL_Streng_TensorInit(CYPHER_SRC_STRENG_ID, &dma_in, 1);
+    LL_Streng_TensorInit(CYPHER_DST_STRENG_ID, &dma_out, 1);
+
+    LL_ATON_EnableUnits_Init(dma_units, 2);
+
+    /* region boundary: the destination engine must drain before its
+       address/length registers can be rewritten for the next region */
+
+    LL_Streng_Wait(dma_wait_mask);
+
+    LL_ATON_DisableUnits_Init(dma_units, 1);
+  }
+
+  LL_Switch_Deinit(&switch_init, 1);
+
+  return (0);
+}
+
+static void _dma_cypher_fetch_memcpy(void *dst, const void *src, uint32_t size)
+{
+  memcpy(dst, src, size);
+}
+
+/**
+ * @brief  Handles a chunked Dma/Cypher transfer, overlapping cipher and fetch
+ * @param  cypherInfo: transfer parameters (addresses, keys, ... )
+ * @param  bounce0: first bounce buffer (chunk_size bytes, 8-byte aligned)
+ * @param  bounce1: second bounce buffer (chunk_size bytes, 8-byte aligned)
+ * @param  chunk_size: size in bytes of a pipeline chunk (multiple of 8)
+ * @param  fetch: function used to fetch a chunk from the source into a bounce
+ *         buffer (NULL: plain memcpy); a DMA-backed copier can be passed to
+ *         free the CPU entirely (e.g. the segment copier of the reloc loader)
+ * @retval Error code (0: og - -1: ko)
+ * @note   While the cipher DMA processes chunk N from one bounce buffer, chunk
+ *         N+1 is fetched into the other one, hiding most of the cipher cost
+ *         behind the fetch time (and vice versa)
+ * @note   Same restrictions as LL_DmaCypherInit (stream engines 0 and 1)
+ */
+int LL_DmaCypherPipelined(LL_Cypher_InitTypeDef *cypherInfo, uint8_t *bounce0, uint8_t *bounce1, uint32_t chunk_size,
+                          LL_Cypher_FetchFunc_t fetch)
+{
+  if (!cypherInfo || !bounce0 || !bounce1 || (chunk_size == 0) || ((chunk_size & 7) != 0))
+    return (-1);
+
+  uint8_t *bounce[2] = {bounce0, bounce1};
+  const uint8_t *src = (const uint8_t *)cypherInfo->srcAdd;
+  uint32_t done = 0;
+  int buf = 0;
+
+  if (fetch == NULL)
+    fetch = _dma_cypher_fetch_memcpy;
+
+  /* prime the pipeline */
+  uint32_t n = (cypherInfo->len < chunk_size) ? cypherInfo->len : chunk_size;
+
+  fetch(bounce[0], src, n);
+  LL_ATON_Cache_MCU_Clean_Range((uintptr_t)bounce[0], n);
+
+  while (done < cypherInfo->len)
+  {
+    LL_Cypher_InitTypeDef chunk = *cypherInfo;
+
+    chunk.srcAdd = (uint32_t)bounce[buf];
+    chunk.dstAdd = cypherInfo->dstAdd + done;
+    chunk.len = n;
+
+    int res = LL_DmaCypherStart(&chunk);
+
+    if (res != 0)
+      return res;
+
+    /* fetch chunk N+1 while the cipher DMA processes chunk N */
+    uint32_t next = done + n;
+    uint32_t n_next = 0;
+
+    if (next < cypherInfo->len)
+    {
+      n_next = cypherInfo->len - next;
+
+      if (n_next > chunk_size)
+        n_next = chunk_size;
+
+      fetch(bounce[buf ^ 1], src + next, n_next);
+      LL_ATON_Cache_MCU_Clean_Range((uintptr_t)bounce[buf ^ 1], n_next);
+    }
+
+    LL_DmaCypherWait();
+
+    done = next;
+    n = n_next;
+    buf ^= 1;
+  }
+
+  return (0);
+}
+
 #endif //(ATON_STRENG_VERSION_ENCR_DT == 1)
@@ -77,11 +77,35 @@ extern "C"
 #define CYPHER_DST_STRENG_ID 1       /**< Stream engine used for destination data in Dma/Cypher function */
 #define CYPHER_CACHE_SIZE    0x40000 /**< N6 cache size */
 
+  /** Fetch function used by LL_DmaCypherPipelined to bring a chunk from the source
+   *  into a bounce buffer (NULL selects a plain memcpy) */
+  typedef void (*LL_Cypher_FetchFunc_t)(void *dst, const void *src, uint32_t size);
+
   int LL_Streng_EncryptionInit(int id, LL_Streng_EncryptionTypedef *);
   int LL_Streng_WeightEncryptionInit(int id);
+  int LL_Streng_WeightEncryptionInitWithId(int id, uint64_t encryption_id);
   int LL_EpochCtrl_EncryptionInit(int id, LL_Streng_EncryptionTypedef *conf);
   int LL_DmaCypherInit(LL_Cypher_InitTypeDef *cypherInfo);
 
+  /* split-phase variants of LL_DmaCypherInit, plus a double-buffered pipeline
+     overlapping the cipher DMA of chunk N with the fetch of chunk N+1 */
+  int LL_DmaCypherStart(LL_Cypher_InitTypeDef *cypherInfo);
+  int LL_DmaCypherWait(void);
+  int LL_DmaCypherPipelined(LL_Cypher_InitTypeDef *cypherInfo, uint8_t *bounce0, uint8_t *bounce1, uint32_t chunk_size,
+                            LL_Cypher_FetchFunc_t fetch);
+
+  /** One region of a LL_DmaCypherBatch job: addresses and size only, the
+   *  cipher configuration (cache/enable masks, keys) is shared across the
+   *  whole batch */
+  typedef struct
+  {
+    uint32_t srcAdd; /**< Region source address */
+    uint32_t dstAdd; /**< Region destination address */
+    uint32_t len;    /**< Region size */
+  } LL_Cypher_RegionTypeDef;
+
+  int LL_DmaCypherBatch(const LL_Cypher_InitTypeDef *cypherInfo, const LL_Cypher_RegionTypeDef *regions, int nRegions);
+
 #ifdef __cplusplus
 }
 #endif
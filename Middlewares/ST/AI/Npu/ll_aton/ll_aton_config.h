@@ -41,6 +41,12 @@
  *                                                  (to be defined as `0` or `1`)
  *      optional  LL_ATON_ENABLE_CLOCK_GATING       used to enable/disable clock gating of the ATON units not involved
  *                                                  during epoch execution (to be defined as `0` or `1`)
+ *      optional  LL_ATON_RT_STATIC_DISPATCH        route epoch block start/end function calls through a per-network
+ *                                                  dispatcher (`LL_ATON_RT_EpochFuncDispatch()`) which MUST be provided
+ *                                                  by the network generated code (to be defined as `0` or `1`)
+ *      optional  LL_ATON_SW_USE_MVE                enable Helium/MVE vectorized fast paths in the SW fallback kernels
+ *                                                  (to be defined as `0` or `1`, requires a floating-point MVE enabled
+ *                                                  target, e.g. Cortex-M55)
  *
  *      NOTE: `mandatory` means that these macros must be predefined using `-D` options in the command-line of the
  *            C compiler a/o preprocessor!
@@ -123,6 +129,20 @@
 #define LL_ATON_ENABLE_CLOCK_GATING 1
 #endif
 
+#ifndef LL_ATON_RT_STATIC_DISPATCH
+#define LL_ATON_RT_STATIC_DISPATCH 0
+#elif LL_ATON_RT_STATIC_DISPATCH != 0 && LL_ATON_RT_STATIC_DISPATCH != 1
+#undef LL_ATON_RT_STATIC_DISPATCH
+#define LL_ATON_RT_STATIC_DISPATCH 1
+#endif
+
+#ifndef LL_ATON_SW_USE_MVE
+#define LL_ATON_SW_USE_MVE 0
+#elif LL_ATON_SW_USE_MVE != 0 && LL_ATON_SW_USE_MVE != 1
+#undef LL_ATON_SW_USE_MVE
+#define LL_ATON_SW_USE_MVE 1
+#endif
+
 /* Check if selected values are valid */
 #if (LL_ATON_PLATFORM != LL_ATON_PLAT_NCSIM)
 #if (LL_ATON_PLATFORM != LL_ATON_PLAT_STICE4)
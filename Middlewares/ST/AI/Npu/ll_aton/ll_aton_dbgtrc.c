@@ -1083,3 +1083,89 @@ int LL_Dbgtrc_SynchronousCountersTest(void)
 }
 
 #endif // ATON_DEBUG_TRACE_NUM
+
+/* ---------------------------------------------------------------------------
+ * Binary event ring
+ *
+ * Fixed-cost capture of runtime events (epoch-block transitions, user
+ * markers): 8-byte records written lock-free from callback context into a
+ * power-of-two ring, drained lazily by the host transport. Single producer
+ * (the runtime callbacks) / single consumer (the drain loop): the indices
+ * are free running, the producer publishes the head only once the record is
+ * complete and drops the newest event when the ring is full, so the drained
+ * history stays consistent without ever taking a lock or masking interrupts.
+ * Software only, does not depend on the Debug and Trace hardware unit.
+ * ---------------------------------------------------------------------------
+ */
+
+/* raw DWT cycle counter, avoids a core-header dependency */
+#define _DBGTRC_DWT_CYCCNT (*(volatile uint32_t *)0xE0001004UL)
+
+static LL_Dbgtrc_Evt_TypeDef _evt_ring[LL_DBGTRC_EVT_RING_SZ] LL_ATON_DTCM_SECTION;
+static volatile uint32_t _evt_head; /* producer index (free running) */
+static volatile uint32_t _evt_tail; /* consumer index (free running) */
+static uint32_t _evt_dropped;
+
+/**
+ * @brief Resets the event ring (records and drop counter)
+ */
+void LL_Dbgtrc_Evt_Reset(void)
+{
+  _evt_tail = _evt_head;
+  _evt_dropped = 0;
+}
+
+/**
+ * @brief Pushes an event into the ring (producer side, callback context)
+ * @param type Event type (LL_DBGTRC_EVT_xxx)
+ * @param epoch Epoch block index the event relates to
+ * @param arg Event-specific argument
+ */
+void LL_Dbgtrc_Evt_Push(uint8_t type, uint16_t epoch, uint8_t arg)
+{
+  uint32_t head = _evt_head;
+
+  if ((head - _evt_tail) >= LL_DBGTRC_EVT_RING_SZ)
+  {
+    _evt_dropped++;
+    return;
+  }
+
+  LL_Dbgtrc_Evt_TypeDef *evt = &_evt_ring[head & (LL_DBGTRC_EVT_RING_SZ - 1)];
+
+  evt->ts = _DBGTRC_DWT_CYCCNT;
+  evt->epoch = epoch;
+  evt->type = type;
+  evt->arg = arg;
+
+  /* publish once the record is complete */
+  __asm volatile("" ::: "memory");
+  _evt_head = head + 1;
+}
+
+/**
+ * @brief Pops the oldest event from the ring (consumer side)
+ * @param evt Output record
+ * @retval 1 when a record was returned, 0 when the ring is empty
+ */
+int LL_Dbgtrc_Evt_Pop(LL_Dbgtrc_Evt_TypeDef *evt)
+{
+  uint32_t tail = _evt_tail;
+
+  if (tail == _evt_head)
+    return 0;
+
+  *evt = _evt_ring[tail & (LL_DBGTRC_EVT_RING_SZ - 1)];
+  __asm volatile("" ::: "memory");
+  _evt_tail = tail + 1;
+
+  return 1;
+}
+
+/**
+ * @brief Returns the number of events dropped since the last reset
+ */
+uint32_t LL_Dbgtrc_Evt_Dropped(void)
+{
+  return _evt_dropped;
+}
@@ -173,6 +173,39 @@ extern "C"
 
   int LL_Dbgtrc_SynchronousCountersTest(void);
 
+  /* Binary event ring: fixed-cost, lock-free capture of runtime events
+   * from callback context, drained lazily over the transport. The 8-byte
+   * records carry the raw DWT cycle counter at capture time: with a
+   * runtime resetting the counter at every epoch boundary the field reads
+   * as the delta since the previous boundary. Software only, available
+   * without the Debug and Trace hardware unit.
+   */
+
+#ifndef LL_DBGTRC_EVT_RING_SZ
+#define LL_DBGTRC_EVT_RING_SZ 256 /* records, must be a power of two */
+#endif
+
+/* Event types */
+#define LL_DBGTRC_EVT_EPOCH_PRE  1 /* epoch block about to be scheduled */
+#define LL_DBGTRC_EVT_EPOCH_POST 2 /* epoch block completed */
+#define LL_DBGTRC_EVT_USER       3 /* user marker */
+
+  /**
+   * @brief Event ring record
+   */
+  typedef struct
+  {
+    uint32_t ts;    /* DWT cycle counter at capture time */
+    uint16_t epoch; /* epoch block index */
+    uint8_t type;   /* event type (LL_DBGTRC_EVT_xxx) */
+    uint8_t arg;    /* event-specific argument */
+  } LL_Dbgtrc_Evt_TypeDef;
+
+  void LL_Dbgtrc_Evt_Reset(void);
+  void LL_Dbgtrc_Evt_Push(uint8_t type, uint16_t epoch, uint8_t arg);
+  int LL_Dbgtrc_Evt_Pop(LL_Dbgtrc_Evt_TypeDef *evt);
+  uint32_t LL_Dbgtrc_Evt_Dropped(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,6 +28,7 @@
 
 #include "ll_aton_caches_interface.h"
 #include "ll_aton_lib.h"
+#include "ll_aton_profiler.h"
 #include "ll_aton_runtime.h"
 
 #if _LL_LIB_DEBUG
@@ -263,7 +264,8 @@ static inline void __ll_lib_prepare_outputs_epoch(const LL_LIB_TensorShape_TypeD
   //       and returning with a respective (new) return value (of type `LL_ATON_RT_RetValues_t`),
   //       reporting about the error, from the latest call to `LL_ATON_RT_RunEpochBlock()`
   LL_ATON_ASSERT(noutputs <= __LL_MAX_TENSORS);
-  memcpy(outputs_copy, outputs, sizeof(LL_LIB_TensorShape_TypeDef) * noutputs);
+  if ((const void *)outputs != outputs_copy) // list may already have been built in-place (flat copy coalescing)
+    memcpy(outputs_copy, outputs, sizeof(LL_LIB_TensorShape_TypeDef) * noutputs);
 
   params->g_tensors = outputs_copy;
   params->g_num_tensors = noutputs;
@@ -277,10 +279,46 @@ static inline void __ll_lib_prepare_outputs_epoch(const LL_LIB_TensorShape_TypeD
 
   params->g_size = -1;
   params->g_idx = 0;
+  params->g_restarted = 0;
 
   params->g_offset_limit = input->offset_limit;
 }
 
+/**
+ * @brief  builds a coalesced copy of a flat-copy output list in the lower heap,
+ *         merging every run of outputs which sit back-to-back in memory into a single descriptor
+ * @param  outputs tensor shape structures
+ * @param  nr_of_outputs number of output tensors
+ * @retval number of descriptors in the coalesced list, or 0 if it does not fit the lower heap
+ * @note   valid only for flat copies (source read linearly, each output written as one contiguous block)
+ */
+static unsigned int __ll_lib_flat_outputs_coalesce(const LL_LIB_TensorShape_TypeDef *outputs,
+                                                   unsigned int nr_of_outputs)
+{
+  LL_LIB_TensorShape_TypeDef *merged = (LL_LIB_TensorShape_TypeDef *)__ll_lib_get_lower_heap();
+  unsigned int nr_merged = 0;
+
+  for (unsigned int i = 0; i < nr_of_outputs; i++)
+  {
+    if ((nr_merged > 0) && (LL_Buffer_addr_start(outputs + i) == LL_Buffer_addr_end(merged + (nr_merged - 1))))
+    {
+      /* destination continues the previous run, extend its descriptor instead of adding a new one */
+      merged[nr_merged - 1].offset_end += LL_Buffer_len(outputs + i);
+      continue;
+    }
+
+    if (nr_merged >= __LL_MAX_TENSORS)
+    {
+      return 0;
+    }
+
+    merged[nr_merged] = outputs[i];
+    nr_merged++;
+  }
+
+  return nr_merged;
+}
+
 /* `memcpy` generic epoch blocks */
 static inline size_t __ll_lib_memcpy_prolog(void **dst, void **src, size_t n)
 {
@@ -327,6 +365,12 @@ static void __ll_lib_inputs_memcpy_start(const void *epoch_block, uint8_t *_src)
     n = params->g_size;
   }
 
+  if ((params->g_not_continuous == 0) && (_src == _dst))
+  { /* producer already wrote in place (aliased concat input), nothing to copy */
+    __ll_lib_set_wait_mask((LL_ATON_RT_EpochBlockItem_t *)epoch_block, 0);
+    return;
+  }
+
   if (params->g_not_continuous == 0)
     n = __ll_lib_memcpy_prolog((void **)&_dst, (void **)&_src, n);
 
@@ -368,6 +412,12 @@ static void __ll_lib_outputs_memcpy_start(const void *epoch_block, uint8_t *_dst
     n = params->g_size;
   }
 
+  if ((params->g_not_continuous == 0) && (_src == _dst))
+  { /* consumer reads the slot in place (aliased split output), nothing to copy */
+    __ll_lib_set_wait_mask((LL_ATON_RT_EpochBlockItem_t *)epoch_block, 0);
+    return;
+  }
+
   if (params->g_not_continuous == 0)
     n = __ll_lib_memcpy_prolog((void **)&_dst, (void **)&_src, n);
 
@@ -552,6 +602,13 @@ static void __LL_LIB_Outputs_Channel_Split_Aton_Start_EpochBlock(const void *epo
 {
   __ll_lib_params_t *params = __ll_lib_get_params();
   LL_ATON_ASSERT(params->g_idx < params->g_num_tensors); // must be checked before
+
+  if (params->g_restarted)
+  { /* transfer already chained from the end function, just keep waiting on it */
+    params->g_restarted = 0;
+    return;
+  }
+
   params->g_not_continuous =
       1; // disables code in __ll_lib_outputs_memcpy_start that assumes a flat copy operation e.g. prolog test
 
@@ -624,6 +681,13 @@ static void __LL_LIB_Outputs_Channel_Split_Aton_End_EpochBlock(const void *epoch
           nbytes; // this must be updated on all outputs FIXME Francesco incorrect calculation
 #endif
     }
+
+    /* chain the next output transfer directly from the completion context so
+       the engines restart back-to-back; the looped-back start function then
+       only keeps waiting on it */
+    __LL_LIB_Outputs_Channel_Split_Aton_Start_EpochBlock(epoch_block);
+    params->g_restarted = 1;
+
     /* loop back one epoch block */
     LL_ATON_RT_DecCurrEpochBlock(1);
   }
@@ -637,6 +701,13 @@ static void __LL_LIB_Outputs_Channel_Split_Batched_Start_EpochBlock(const void *
 {
   __ll_lib_params_t *params = __ll_lib_get_params();
   LL_ATON_ASSERT(params->g_idx < params->g_num_tensors); // must be checked before
+
+  if (params->g_restarted)
+  { /* transfer already chained from the end function, just keep waiting on it */
+    params->g_restarted = 0;
+    return;
+  }
+
   params->g_not_continuous =
       1; // disables code in __ll_lib_outputs_memcpy_start that assumes a flat copy operation e.g. prolog test
 
@@ -714,6 +785,13 @@ static void __LL_LIB_Outputs_Channel_Split_Batched_End_EpochBlock(const void *ep
           nbytes; // this must be updated on all outputs  FIXME Francesco incorrect calculation
 #endif
     }
+
+    /* chain the next output transfer directly from the completion context so
+       the engines restart back-to-back; the looped-back start function then
+       only keeps waiting on it */
+    __LL_LIB_Outputs_Channel_Split_Batched_Start_EpochBlock(epoch_block);
+    params->g_restarted = 1;
+
     /* loop back one epoch block */
     LL_ATON_RT_DecCurrEpochBlock(1);
   }
@@ -728,6 +806,12 @@ static void __LL_LIB_Outputs_Memcpy_Start_EpochBlock(const void *epoch_block)
   __ll_lib_params_t *params = __ll_lib_get_params();
   LL_ATON_ASSERT(params->g_idx < params->g_num_tensors); // must be checked before
 
+  if (params->g_restarted)
+  { /* transfer already chained from the end function, just keep waiting on it */
+    params->g_restarted = 0;
+    return;
+  }
+
   uint8_t *dst = (uint8_t *)LL_Buffer_addr_start(((LL_LIB_TensorShape_TypeDef *)params->g_tensors) + params->g_idx);
   __ll_lib_outputs_memcpy_start(epoch_block, dst);
 }
@@ -753,6 +837,12 @@ static void __LL_LIB_Outputs_Memcpy_End_EpochBlock(const void *epoch_block)
 
   if (params->g_idx < params->g_num_tensors)
   {
+    /* chain the next output transfer directly from the completion context so
+       the engines restart back-to-back; the looped-back start function then
+       only keeps waiting on it */
+    __LL_LIB_Outputs_Memcpy_Start_EpochBlock(epoch_block);
+    params->g_restarted = 1;
+
     /* loop back one epoch block */
     LL_ATON_RT_DecCurrEpochBlock(1);
   }
@@ -1016,6 +1106,118 @@ static void __LL_LIB_DMA_Pad_Filling_End_EpochBlock(const void *epoch_block)
 #endif // DUMP_RESULTS_PAD_OP
 }
 
+/* `Pad` framing (reflect/edge border copies) as a DMA segment program:
+   the SW traversal queues the border row/plane copies as linear
+   (dst, src, len) segments in push order and the framing epoch block
+   below replays them one DMA transfer per iteration. Segment order is
+   part of the contract: outer-axis copies may read rows produced by
+   earlier segments, so the queue must execute (or be drained) strictly
+   in push order. */
+typedef struct
+{
+  uint8_t *dst;
+  const uint8_t *src;
+  uint32_t len;
+} __ll_pad_frame_segment_t;
+
+#define __LL_PAD_FRAME_MAX_SEGMENTS (64)
+
+static __ll_pad_frame_segment_t _pad_frame_segments[__LL_PAD_FRAME_MAX_SEGMENTS];
+static uint32_t _pad_frame_nr_segments = 0;
+
+void LL_ATON_LIB_DMA_Pad_Frame_Reset(void)
+{
+  _pad_frame_nr_segments = 0;
+}
+
+uint32_t LL_ATON_LIB_DMA_Pad_Frame_Count(void)
+{
+  return _pad_frame_nr_segments;
+}
+
+bool LL_ATON_LIB_DMA_Pad_Frame_Push(void *dst, const void *src, uint32_t len)
+{
+  if (_pad_frame_nr_segments >= __LL_PAD_FRAME_MAX_SEGMENTS)
+  {
+    return false;
+  }
+
+  _pad_frame_segments[_pad_frame_nr_segments].dst = (uint8_t *)dst;
+  _pad_frame_segments[_pad_frame_nr_segments].src = (const uint8_t *)src;
+  _pad_frame_segments[_pad_frame_nr_segments].len = len;
+  _pad_frame_nr_segments++;
+
+  return true;
+}
+
+void LL_ATON_LIB_DMA_Pad_Frame_Drain(void)
+{
+  /* table overflow fallback: replay the queued segments in SW, in order */
+  for (uint32_t i = 0; i < _pad_frame_nr_segments; i++)
+  {
+    memcpy(_pad_frame_segments[i].dst, _pad_frame_segments[i].src, _pad_frame_segments[i].len);
+  }
+  _pad_frame_nr_segments = 0;
+}
+
+static void __LL_LIB_DMA_Pad_Framing_Start_EpochBlock(const void *epoch_block)
+{
+  __ll_lib_params_t *params = __ll_lib_get_params();
+  const __ll_pad_frame_segment_t *seg = &_pad_frame_segments[params->g_idx];
+
+  uint8_t *_dst = seg->dst;
+  uint8_t *_src = (uint8_t *)seg->src;
+  size_t n;
+
+  n = seg->len;
+  n = __ll_lib_memcpy_prolog((void **)&_dst, (void **)&_src, n);
+
+  if (n > 0)
+  {
+    params->g_dma_in.addr_base.p = _src;
+    params->g_dma_in.offset_start = 0;
+    params->g_dma_in.offset_end = n;
+    /* the framing sources always lie within the padded output tensor */
+    params->g_dma_in.offset_limit = (uint8_t *)params->special.pad.end_out_target - _src;
+
+    params->g_dma_out.addr_base.p = _dst;
+    params->g_dma_out.offset_start = 0;
+    params->g_dma_out.offset_end = n;
+
+    __ll_lib_set_wait_mask((LL_ATON_RT_EpochBlockItem_t *)epoch_block, params->g_wait_mask);
+
+    __ll_lib_start_transfer(params);
+  }
+  else
+  {
+    /* do not start any transfer and wait, just proceed to end function */
+    __ll_lib_set_wait_mask((LL_ATON_RT_EpochBlockItem_t *)epoch_block, 0);
+  }
+}
+
+static void __LL_LIB_DMA_Pad_Framing_End_EpochBlock(const void *epoch_block)
+{
+  __ll_lib_params_t *params = __ll_lib_get_params();
+
+  if (__ll_lib_set_wait_mask((LL_ATON_RT_EpochBlockItem_t *)epoch_block, 0))
+  {
+    __ll_lib_stop_transfer();
+  }
+
+  params->g_idx++;
+
+  if (params->g_idx < _pad_frame_nr_segments)
+  {
+    /* loop back one epoch block */
+    LL_ATON_RT_DecCurrEpochBlock(1);
+  }
+  else
+  {
+    _pad_frame_nr_segments = 0;
+    /* proceed to next epoch block */
+  }
+}
+
 static void __LL_LIB_DMA_Transfer_Start_EpochBlock(const void *epoch_block)
 {
   __ll_lib_params_t *params = __ll_lib_get_params();
@@ -1155,6 +1357,20 @@ static LL_ATON_RT_EpochBlockItem_t _dma_Pad_filling_epoch_block_array[] = {
     {.flags = EpochBlock_Flags_last_eb},
 };
 
+static LL_ATON_RT_EpochBlockItem_t _dma_Pad_framing_epoch_block_array[] = {
+    // REMEMBER: static variables are not suited for multithreaded etc. environments
+    {
+        .start_epoch_block = __LL_LIB_DMA_Pad_Framing_Start_EpochBlock,
+        .end_epoch_block = __LL_LIB_DMA_Pad_Framing_End_EpochBlock,
+        .flags = EpochBlock_Flags_internal,
+#ifdef LL_ATON_EB_DBG_INFO
+        .epoch_num = -12,
+        .last_epoch_num = -12,
+#endif
+    },
+    {.flags = EpochBlock_Flags_last_eb},
+};
+
 static LL_ATON_RT_EpochBlockItem_t _dma_transpose_epoch_block_array[] = {
     // REMEMBER: static variables are not suited for multithreaded etc. environments
     {
@@ -1194,6 +1410,26 @@ static LL_ATON_RT_EpochBlockItem_t _slice_split_like_epoch_block_array[] = {
 static void __LL_ATON_LIB_DMA_Inputs_Memcpy(const LL_LIB_TensorInfo_TypeDef *inputs, unsigned int ninputs,
                                             unsigned char *dst, int nbytes, int dma_in, int dma_out)
 {
+  /* zero-copy concat: when every producer has already written its slot of the
+     destination (aliased outputs), the whole copy epoch sequence is a no-op */
+  if ((ninputs > 0) && (nbytes < 0))
+  {
+    unsigned int i, nr_in_place = 0;
+    unsigned char *slot = dst;
+
+    for (i = 0; i < ninputs; i++)
+    {
+      if (LL_Buffer_addr_start(inputs + i) == slot)
+        nr_in_place++;
+      slot += LL_Buffer_len(inputs + i);
+    }
+
+    if (nr_in_place == ninputs)
+    {
+      return;
+    }
+  }
+
   /* start epoch block sequence */
   if (ninputs > 0)
   {
@@ -2124,7 +2360,8 @@ LL_ATON_PRINTF("out: b=%d w=%d g=%d c=%d ndims=%d\n",out_batches,out_fwidth,out_
         for (i = 0; i < ninputs; i++)
         {
           // LL_ATON_PRINTF("in[%d]\n",i);
-          memcpy((void *)start, (void *)LL_Buffer_addr_start(inputs + i), LL_Buffer_len(inputs + i));
+          if ((void *)start != (void *)LL_Buffer_addr_start(inputs + i)) // skip producers already aliased in place
+            memcpy((void *)start, (void *)LL_Buffer_addr_start(inputs + i), LL_Buffer_len(inputs + i));
           start += LL_Buffer_len(inputs + i);
         }
       }
@@ -2996,13 +3233,19 @@ int LL_ATON_LIB_Softmax(const LL_LIB_TensorInfo_TypeDef *input, const LL_LIB_Ten
   {
     if (input->per_channel)
       __LL_LIB_ERROR(_ERR_DATATYPE, LL_ATON_INVALID_PARAM);
-    return legacy ? LL_ATON_LIB_Softmax_INT8_legacy(input, output, axis)
-                  : LL_ATON_LIB_Softmax_INT8(input, output, axis);
+    LL_ATON_PROF_START();
+    int prof_ret = legacy ? LL_ATON_LIB_Softmax_INT8_legacy(input, output, axis)
+                          : LL_ATON_LIB_Softmax_INT8(input, output, axis);
+    LL_ATON_PROF_STOP("Softmax");
+    return prof_ret;
   }
   if (input->type == DataType_FLOAT)
   {
-    return legacy ? LL_ATON_LIB_Softmax_float_legacy(input, output, axis)
-                  : LL_ATON_LIB_Softmax_float(input, output, axis);
+    LL_ATON_PROF_START();
+    int prof_ret = legacy ? LL_ATON_LIB_Softmax_float_legacy(input, output, axis)
+                          : LL_ATON_LIB_Softmax_float(input, output, axis);
+    LL_ATON_PROF_STOP("Softmax");
+    return prof_ret;
   }
 
   return LL_ATON_INVALID_PARAM;
@@ -3043,12 +3286,18 @@ int LL_ATON_LIB_DMA_Outputs_Flat_Copy(const LL_LIB_TensorShape_TypeDef *input,
     __LL_LIB_ERROR(_ERR_NOUTPUTS, LL_ATON_INVALID_PARAM);
   }
 
-  if (nr_of_outputs > __LL_MAX_TENSORS)
-  { // should never happen
-    __LL_LIB_ERROR(_ERR_NOUTPUTS, LL_ATON_INVALID_PARAM);
+  /* the source is read linearly, so outputs which sit back-to-back in memory collapse
+     into a single transfer; this also serves output lists longer than `__LL_MAX_TENSORS`
+     whenever the coalesced list fits the lower heap */
+  unsigned int nr_merged = __ll_lib_flat_outputs_coalesce(outputs, nr_of_outputs);
+
+  if (nr_merged == 0)
+  { /* coalesced list does not fit the lower heap, caller must fall back to software */
+    return LL_ATON_INVALID_PARAM;
   }
 
-  __LL_ATON_LIB_DMA_Outputs_Memcpy(input, outputs, nr_of_outputs, dma_in, dma_out);
+  __LL_ATON_LIB_DMA_Outputs_Memcpy(input, (const LL_LIB_TensorShape_TypeDef *)__ll_lib_get_lower_heap(), nr_merged,
+                                   dma_in, dma_out);
 
   return LL_ATON_OK;
 }
@@ -3557,3 +3806,32 @@ int LL_ATON_LIB_DMA_Pad_Filling(__ll_pad_sw_params_t *init_common_params)
 
   return LL_ATON_OK;
 }
+
+/**
+ * @brief  replays the queued reflect/edge border copies using DMA (aka Framing)
+ * @param  common_params parameters needed to setup DMAs (the pad parameters
+ *         themselves have been saved by the preceding `Filling` phase)
+ * @retval Error code
+ */
+int LL_ATON_LIB_DMA_Pad_Framing(__ll_pad_sw_params_t *common_params)
+{
+  __ll_lib_params_t *params = __ll_lib_get_params();
+
+  if (_pad_frame_nr_segments == 0)
+  {
+    return LL_ATON_OK;
+  }
+
+  /* prepare epoch */
+  params->g_dma_in = _static_const_dma_in;
+  params->g_dma_out = _static_const_dma_out;
+  params->g_idx = 0;
+
+  /* configure stream switch */
+  __ll_lib_strswitch_set_dmas(common_params->dma_in, common_params->dma_out, _dma_Pad_framing_epoch_block_array);
+
+  /* start DMAs for the framing segments */
+  LL_ATON_RT_Insert_LibEpochBlockArray(_dma_Pad_framing_epoch_block_array);
+
+  return LL_ATON_OK;
+}
@@ -169,6 +169,7 @@ int LL_LIB_TENSOR_ELEMENTS(const LL_LIB_TensorInfo_TypeDef *t);
     const void *g_tensors;
 
     uint32_t g_wait_mask;
+    unsigned int g_restarted; // next transfer already chained from the end function (split fan-out)
 
     /* Special field(s) for single cases */
     union
@@ -364,7 +365,11 @@ int LL_LIB_TENSOR_ELEMENTS(const LL_LIB_TensorInfo_TypeDef *t);
    * @param  nr_of_outputs number of output tensors
    * @param  dma_in DMA number of DMA reading from memory
    * @param  dma_in DMA number of DMA writing to memory
-   * @retval Error code
+   * @retval Error code (`LL_ATON_INVALID_PARAM` if the coalesced output list does not fit
+   *         the lower heap, in which case the caller must fall back to a software copy)
+   * @note   runs of outputs which are contiguous in memory are coalesced into single transfers,
+   *         so output lists longer than `__LL_MAX_TENSORS` are accepted as long as the
+   *         coalesced list fits the lower heap
    */
   /** @defgroup LL_ATON_LIB_DMA_Outputs_Flat_Copy function
    *  * @{
@@ -459,6 +464,26 @@ int LL_LIB_TENSOR_ELEMENTS(const LL_LIB_TensorInfo_TypeDef *t);
    *  * @}
    *   */
 
+  /**
+   * @brief  performs HW accelerated border copies for the `reflect`/`edge` modes
+   *         of the `Pad` operator (aka Framing). The SW traversal queues the
+   *         border row/plane copies as linear segments (in write order) and
+   *         `LL_ATON_LIB_DMA_Pad_Framing()` replays them with DMA; on queue
+   *         overflow the caller drains the queue in SW to preserve ordering.
+   * @retval Error code (`Push` returns `false` when the segment table is full)
+   */
+  /** @defgroup LL_ATON_LIB_DMA_Pad_Framing functions
+   *  * @{
+   *   */
+  void LL_ATON_LIB_DMA_Pad_Frame_Reset(void);
+  bool LL_ATON_LIB_DMA_Pad_Frame_Push(void *dst, const void *src, uint32_t len);
+  uint32_t LL_ATON_LIB_DMA_Pad_Frame_Count(void);
+  void LL_ATON_LIB_DMA_Pad_Frame_Drain(void);
+  int LL_ATON_LIB_DMA_Pad_Framing(__ll_pad_sw_params_t *common_params);
+  /**
+   *  * @}
+   *   */
+
   /**
    * @brief  performs a transpose operation on a (4-dimensional) matrix using DMA
    *         currently supported permutation(s) is/are: (0, 2, 1, 3)-onnx
@@ -24,6 +24,7 @@
 
 #include "ll_aton_lib.h"
 #include "ll_aton_lib_sw_operators.h"
+#include "ll_aton_profiler.h"
 #include "ll_aton_runtime.h"
 
 /* Common data structure(s) */
@@ -297,6 +298,8 @@ int LL_ATON_LIB_Slice(const LL_LIB_TensorShape_TypeDef *input, const uint32_t *i
     __LL_LIB_ERROR(_ERR_NBITS, LL_ATON_INVALID_PARAM);
   }
 
+  LL_ATON_PROF_START();
+
   const __ll_slice_params_t common_params = {.input = input,
                                              .input_axes_offsets = input_axes_offsets,
                                              .output = output,
@@ -308,6 +311,8 @@ int LL_ATON_LIB_Slice(const LL_LIB_TensorShape_TypeDef *input, const uint32_t *i
 
   __ll_aton_lib_slice(0, NULL, &common_params);
 
+  LL_ATON_PROF_STOP("Slice");
+
   return LL_ATON_OK; // TODO
 }
 
@@ -542,6 +547,8 @@ int LL_ATON_LIB_Split(const LL_LIB_TensorShape_TypeDef *input, bool aton_canonic
   if ((rank == 0) || (noutputs < 1))
     return LL_ATON_OK; // in case ONNX was out of specs
 
+  LL_ATON_PROF_START();
+
   switch (split_case)
   {
   case SW_PURE_CANONICAL:
@@ -616,17 +623,26 @@ int LL_ATON_LIB_Split(const LL_LIB_TensorShape_TypeDef *input, bool aton_canonic
   case DMA_FLAT_BATCHED:
   case DMA_CHANNEL_UNIFORM:
   {
-    if ((noutputs > __LL_MAX_TENSORS) || (split_case == SW_FLAT_CANONICAL) || (split_case == SW_FLAT_BATCHED) ||
-        (split_case == SW_CHANNEL_UNIFORM))
+    if ((split_case == SW_FLAT_CANONICAL) || (split_case == SW_FLAT_BATCHED) || (split_case == SW_CHANNEL_UNIFORM))
     {
-      return __ll_aton_lib_sw_outputs_flat_copy(input, outputs, noutputs);
+      int prof_ret = __ll_aton_lib_sw_outputs_flat_copy(input, outputs, noutputs);
+      LL_ATON_PROF_STOP("Split");
+      return prof_ret;
     }
     else
     {
       LL_ATON_ASSERT(dma_in != -1);
       LL_ATON_ASSERT(dma_out != -1);
 
-      LL_ATON_LIB_DMA_Outputs_Flat_Copy(input, (const LL_LIB_TensorShape_TypeDef *)outputs, noutputs, dma_in, dma_out);
+      /* contiguous outputs get coalesced into single transfers, so even long output lists
+         usually fit the DMA path; fall back to software only when they do not */
+      if (LL_ATON_LIB_DMA_Outputs_Flat_Copy(input, (const LL_LIB_TensorShape_TypeDef *)outputs, noutputs, dma_in,
+                                            dma_out) != LL_ATON_OK)
+      {
+        int prof_ret = __ll_aton_lib_sw_outputs_flat_copy(input, outputs, noutputs);
+        LL_ATON_PROF_STOP("Split");
+        return prof_ret;
+      }
     }
   }
   break;
@@ -635,6 +651,8 @@ int LL_ATON_LIB_Split(const LL_LIB_TensorShape_TypeDef *input, bool aton_canonic
     break;
   }
 
+  LL_ATON_PROF_STOP("Split");
+
   return LL_ATON_OK;
 }
 
@@ -680,33 +698,47 @@ int LL_ATON_LIB_SW_SpaceToDepth(const LL_LIB_TensorShape_TypeDef *input, const u
   uint32_t input_tensor_offset_2 = input_axes_offsets[2];
   uint32_t input_tensor_offset_3 = input_axes_offsets[3];
 
+  const uint8_t byte_size = LL_LIB_NBYTES(input->nbits);
+  const uint32_t in_w_stride = (bs_w * input_tensor_offset_3);
+
+  LL_ATON_PROF_START();
+
   for (uint32_t n = 0; n < N; n++)
   {
     for (uint32_t c = 0; c < C; c++)
     {
       for (uint32_t h = 0; h < H; h++)
       {
-        for (uint32_t w = 0; w < W; w++)
+        uint32_t h_rem = h % bs_h;
+        uint32_t out_h = (h / bs_h);
+
+        /* walk each phase `w_rem` of the block separately: its elements land
+           contiguously along `out_w`, so the per-element offset arithmetic
+           reduces to two pointer increments (strided read, sequential write) */
+        for (uint32_t w_rem = 0; w_rem < bs_w; w_rem++)
         {
-          uint32_t h_rem = h % bs_h;
-          uint32_t w_rem = w % bs_w;
           uint32_t out_c = c + (((h_rem * bs_w) + w_rem) * C);
-          uint32_t out_h = (h / bs_h);
-          uint32_t out_w = (w / bs_w);
 
-          int8_t *out_target = out_base + __ll_aton_lib_calc_offset(n, out_c, out_h, out_w, output_tensor_offset_0,
-                                                                    output_tensor_offset_1, output_tensor_offset_2,
-                                                                    output_tensor_offset_3);
           int8_t *in_target =
-              in_base + __ll_aton_lib_calc_offset(n, c, h, w, input_tensor_offset_0, input_tensor_offset_1,
+              in_base + __ll_aton_lib_calc_offset(n, c, h, w_rem, input_tensor_offset_0, input_tensor_offset_1,
                                                   input_tensor_offset_2, input_tensor_offset_3);
+          int8_t *out_target = out_base + __ll_aton_lib_calc_offset(n, out_c, out_h, 0, output_tensor_offset_0,
+                                                                    output_tensor_offset_1, output_tensor_offset_2,
+                                                                    output_tensor_offset_3);
 
-          __ll_aton_lib_copy_element(LL_LIB_NBYTES(input->nbits), -1, out_target, in_target);
+          for (uint32_t w = w_rem; w < W; w += bs_w)
+          {
+            __ll_aton_lib_copy_element(byte_size, -1, out_target, in_target);
+            in_target += in_w_stride;
+            out_target += output_tensor_offset_3;
+          }
         }
       }
     }
   }
 
+  LL_ATON_PROF_STOP("SpaceToDepth");
+
   return LL_ATON_OK;
 }
 
@@ -755,30 +787,39 @@ int LL_ATON_LIB_SW_DepthToSpace(const LL_LIB_TensorShape_TypeDef *input, const u
   uint32_t input_tensor_offset_2 = input_axes_offsets[2];
   uint32_t input_tensor_offset_3 = input_axes_offsets[3];
 
+  const uint8_t byte_size = LL_LIB_NBYTES(input->nbits);
+  const uint32_t out_w_stride = (bs_w * output_tensor_offset_3);
+
+  LL_ATON_PROF_START();
+
   if (mode == 0)
   { // `DCR`
     for (uint32_t n = 0; n < N; n++)
     {
       for (uint32_t c = 0; c < C; c++)
       {
+        /* the output coordinate contributions of `c` are loop invariant */
+        uint32_t out_c = c % max_c;
+        uint32_t c_off_h = (c / (max_c * bs_w));
+        uint32_t c_off_w = ((c / max_c) % bs_w);
+
         for (uint32_t h = 0; h < H; h++)
         {
+          uint32_t out_h = (h * bs_h) + c_off_h;
+
+          int8_t *in_target =
+              in_base + __ll_aton_lib_calc_offset(n, c, h, 0, input_tensor_offset_0, input_tensor_offset_1,
+                                                  input_tensor_offset_2, input_tensor_offset_3);
+          int8_t *out_target = out_base + __ll_aton_lib_calc_offset(n, out_c, out_h, c_off_w, output_tensor_offset_0,
+                                                                    output_tensor_offset_1, output_tensor_offset_2,
+                                                                    output_tensor_offset_3);
+
+          /* sequential reads along the input row, strided writes */
           for (uint32_t w = 0; w < W; w++)
           {
-            uint32_t off_h = (h * bs_h);
-            uint32_t off_w = (w * bs_w);
-            uint32_t out_c = c % max_c;
-            uint32_t out_h = off_h + (c / (max_c * bs_w));
-            uint32_t out_w = off_w + ((c / max_c) % bs_w);
-
-            int8_t *out_target = out_base + __ll_aton_lib_calc_offset(n, out_c, out_h, out_w, output_tensor_offset_0,
-                                                                      output_tensor_offset_1, output_tensor_offset_2,
-                                                                      output_tensor_offset_3);
-            int8_t *in_target =
-                in_base + __ll_aton_lib_calc_offset(n, c, h, w, input_tensor_offset_0, input_tensor_offset_1,
-                                                    input_tensor_offset_2, input_tensor_offset_3);
-
-            __ll_aton_lib_copy_element(LL_LIB_NBYTES(input->nbits), -1, out_target, in_target);
+            __ll_aton_lib_copy_element(byte_size, -1, out_target, in_target);
+            in_target += input_tensor_offset_3;
+            out_target += out_w_stride;
           }
         }
       }
@@ -798,22 +839,22 @@ int LL_ATON_LIB_SW_DepthToSpace(const LL_LIB_TensorShape_TypeDef *input, const u
 
             for (uint32_t h = 0; h < H; h++)
             {
+              uint32_t out_h = (h * bs_h) + c_rem_bs_2_div_bs;
+
+              int8_t *in_target =
+                  in_base + __ll_aton_lib_calc_offset(n, c, h, 0, input_tensor_offset_0, input_tensor_offset_1,
+                                                      input_tensor_offset_2, input_tensor_offset_3);
+              int8_t *out_target =
+                  out_base + __ll_aton_lib_calc_offset(n, out_c, out_h, c_rem_bs, output_tensor_offset_0,
+                                                       output_tensor_offset_1, output_tensor_offset_2,
+                                                       output_tensor_offset_3);
+
+              /* sequential reads along the input row, strided writes */
               for (uint32_t w = 0; w < W; w++)
               {
-                uint32_t off_h = (h * bs_h);
-                uint32_t off_w = (w * bs_w);
-                uint32_t out_h = off_h + c_rem_bs_2_div_bs;
-                uint32_t out_w = off_w + c_rem_bs;
-
-                int8_t *out_target =
-                    out_base + __ll_aton_lib_calc_offset(n, out_c, out_h, out_w, output_tensor_offset_0,
-                                                         output_tensor_offset_1, output_tensor_offset_2,
-                                                         output_tensor_offset_3);
-                int8_t *in_target =
-                    in_base + __ll_aton_lib_calc_offset(n, c, h, w, input_tensor_offset_0, input_tensor_offset_1,
-                                                        input_tensor_offset_2, input_tensor_offset_3);
-
-                __ll_aton_lib_copy_element(LL_LIB_NBYTES(input->nbits), -1, out_target, in_target);
+                __ll_aton_lib_copy_element(byte_size, -1, out_target, in_target);
+                in_target += input_tensor_offset_3;
+                out_target += out_w_stride;
               }
             }
           }
@@ -821,6 +862,9 @@ int LL_ATON_LIB_SW_DepthToSpace(const LL_LIB_TensorShape_TypeDef *input, const u
       }
     }
   }
+
+  LL_ATON_PROF_STOP("DepthToSpace");
+
   return LL_ATON_OK;
 }
 
@@ -1040,6 +1084,97 @@ static void __ll_aton_lib_transpose_3or4(const __ll_transp_params_t *common_para
   }
 }
 
+/* Tile edge (in elements) of the cache-blocked transpose kernel below.
+   16x16 byte tiles fit comfortably in the CM55 D-cache (32-byte lines) for
+   all supported element sizes */
+#define __LL_TRANSP_TILE_SIZE (16)
+
+static inline uint32_t __ll_transp_out_axis_off_for_in_axis(const __ll_transp_params_t *common_params, uint32_t in_axis)
+{
+  for (uint32_t output_axis = 0; output_axis < common_params->rank; output_axis++)
+  {
+    if ((uint32_t)common_params->perm[output_axis] == in_axis)
+      return common_params->out_axis_off[output_axis];
+  }
+  LL_ATON_ASSERT(false);
+  return 0;
+}
+
+/* Cache-blocked rank 3/4 transpose for permutations which move the innermost
+ * input axis. The element walk in `__ll_aton_lib_transpose_3or4()` reads
+ * contiguously but writes with a stride of `out_axis_off[inner_out_axis]`,
+ * which thrashes the D-cache on large feature maps. Here the innermost input
+ * axis and the input axis feeding the innermost output axis (contiguous
+ * writes) are processed jointly in square tiles so that both the read and the
+ * write side stay within a small cache footprint.
+ */
+static void __ll_aton_lib_transpose_tile_2d(const __ll_transp_params_t *common_params, uint32_t inner_out_axis)
+{
+  const uint32_t rank = common_params->rank;
+  const uint8_t byte_size = common_params->byte_size;
+
+  /* input axis which ends up innermost in the output (contiguous writes) */
+  const uint32_t pivot_in_axis = (uint32_t)common_params->perm[rank - 1];
+  LL_ATON_ASSERT(pivot_in_axis != (rank - 1)); // otherwise the `memcpy` walk applies
+
+  const uint32_t size_p = common_params->in_shape_aton[pivot_in_axis];
+  const uint32_t size_w = common_params->in_shape_aton[rank - 1];
+  const uint32_t in_p_off = common_params->in_axis_off[pivot_in_axis];
+  const uint32_t out_p_off = common_params->out_axis_off[rank - 1];
+  const uint32_t out_w_off = common_params->out_axis_off[inner_out_axis];
+
+  /* remaining outer input axes (at most two for rank 3/4) */
+  uint32_t outer_axes[2];
+  uint32_t n_outer = 0;
+  for (uint32_t axis = 0; axis < (rank - 1); axis++)
+  {
+    if (axis != pivot_in_axis)
+      outer_axes[n_outer++] = axis;
+  }
+  LL_ATON_ASSERT(n_outer == (rank - 2));
+
+  const uint32_t size_o0 = (n_outer > 0) ? common_params->in_shape_aton[outer_axes[0]] : 1;
+  const uint32_t size_o1 = (n_outer > 1) ? common_params->in_shape_aton[outer_axes[1]] : 1;
+  const uint32_t in_o0_off = (n_outer > 0) ? common_params->in_axis_off[outer_axes[0]] : 0;
+  const uint32_t in_o1_off = (n_outer > 1) ? common_params->in_axis_off[outer_axes[1]] : 0;
+  const uint32_t out_o0_off = (n_outer > 0) ? __ll_transp_out_axis_off_for_in_axis(common_params, outer_axes[0]) : 0;
+  const uint32_t out_o1_off = (n_outer > 1) ? __ll_transp_out_axis_off_for_in_axis(common_params, outer_axes[1]) : 0;
+
+  for (uint32_t index_o0 = 0; index_o0 < size_o0; index_o0++)
+  {
+    for (uint32_t index_o1 = 0; index_o1 < size_o1; index_o1++)
+    {
+      const int8_t *in_base = common_params->in_tensor + (index_o0 * in_o0_off) + (index_o1 * in_o1_off);
+      int8_t *out_base = common_params->out_tensor + (index_o0 * out_o0_off) + (index_o1 * out_o1_off);
+
+      for (uint32_t tile_p = 0; tile_p < size_p; tile_p += __LL_TRANSP_TILE_SIZE)
+      {
+        const uint32_t end_p =
+            ((tile_p + __LL_TRANSP_TILE_SIZE) < size_p) ? (tile_p + __LL_TRANSP_TILE_SIZE) : size_p;
+
+        for (uint32_t tile_w = 0; tile_w < size_w; tile_w += __LL_TRANSP_TILE_SIZE)
+        {
+          const uint32_t end_w =
+              ((tile_w + __LL_TRANSP_TILE_SIZE) < size_w) ? (tile_w + __LL_TRANSP_TILE_SIZE) : size_w;
+
+          for (uint32_t index_p = tile_p; index_p < end_p; index_p++)
+          {
+            const int8_t *in_row = in_base + (index_p * in_p_off) + (tile_w * byte_size);
+            int8_t *out_col = out_base + (index_p * out_p_off) + (tile_w * out_w_off);
+
+            for (uint32_t index_w = tile_w; index_w < end_w; index_w++)
+            {
+              __ll_aton_lib_copy_element(byte_size, index_w, out_col, (int8_t *)in_row);
+              in_row += byte_size;
+              out_col += out_w_off;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
 int LL_ATON_LIB_Transpose(const LL_LIB_TensorShape_TypeDef *input, const uint32_t *input_axes_offsets,
                           const LL_LIB_TensorShape_TypeDef *output, const uint32_t *output_axes_offsets,
                           const uint8_t *perm)
@@ -1064,6 +1199,8 @@ int LL_ATON_LIB_Transpose(const LL_LIB_TensorShape_TypeDef *input, const uint32_
     __LL_LIB_ERROR(_ERR_NBITS, LL_ATON_INVALID_PARAM);
   }
 
+  LL_ATON_PROF_START();
+
   const __ll_transp_params_t common_params = {.perm = perm,
                                               .rank = input->ndims,
                                               .in_shape_aton = input->shape,
@@ -1075,7 +1212,16 @@ int LL_ATON_LIB_Transpose(const LL_LIB_TensorShape_TypeDef *input, const uint32_
 
   if (input->ndims <= 4)
   {
-    __ll_aton_lib_transpose_3or4(&common_params);
+    uint32_t inner_out_axis = __ll_transp_get_inner_out_axis(&common_params);
+
+    if (common_params.byte_size != output_axes_offsets[inner_out_axis])
+    { /* innermost input axis moves: strided writes, use the cache-blocked kernel */
+      __ll_aton_lib_transpose_tile_2d(&common_params, inner_out_axis);
+    }
+    else
+    {
+      __ll_aton_lib_transpose_3or4(&common_params);
+    }
   }
   else
   {
@@ -1083,6 +1229,8 @@ int LL_ATON_LIB_Transpose(const LL_LIB_TensorShape_TypeDef *input, const uint32_
     __ll_aton_lib_transpose(0, inner_out_axis, NULL, &common_params);
   }
 
+  LL_ATON_PROF_STOP("Transpose");
+
   return LL_ATON_OK;
 }
 
@@ -1401,6 +1549,32 @@ static void __ll_aton_lib_pad_filling_sw(uint32_t curr_axis, __ll_pad_sw_params_
 #endif
 }
 
+/* when set, the outer-axis border copies of the reflect/edge framing are
+   queued as DMA segments instead of being copied immediately (see
+   `LL_ATON_LIB_DMA_Pad_Framing()`) */
+static bool __ll_pad_frame_use_dma = false;
+
+/* Border copy of the reflect/edge framing: queued as a DMA segment when
+ * profitable, otherwise copied right away. Once the segment table
+ * overflows, everything queued is drained in SW and the rest of the frame
+ * stays in SW as well - the push order encodes the write ordering
+ * (outer-axis copies may read rows produced by earlier ones), so a
+ * partially executed queue must not survive. */
+static void __ll_pad_frame_copy(int8_t *dst, const int8_t *src, int32_t bytes)
+{
+  if (__ll_pad_frame_use_dma && (bytes >= __LL_DMA_MIN_BUFF_LEN))
+  {
+    if (LL_ATON_LIB_DMA_Pad_Frame_Push(dst, src, (uint32_t)bytes))
+    {
+      return;
+    }
+    LL_ATON_LIB_DMA_Pad_Frame_Drain();
+    __ll_pad_frame_use_dma = false;
+  }
+
+  memcpy(dst, src, bytes);
+}
+
 static void __ll_aton_lib_pad_reflect_sw(uint32_t curr_axis, __ll_pad_sw_params_t *common_params, bool fill)
 {
   LL_ATON_ASSERT(curr_axis <= (common_params->tensor_rank - 1));
@@ -1486,7 +1660,7 @@ static void __ll_aton_lib_pad_reflect_sw(uint32_t curr_axis, __ll_pad_sw_params_
         LL_ATON_ASSERT(src_idx < n_elems);
         LL_ATON_ASSERT(src_idx >= 0);
 
-        memcpy(dst_ptr, src_ptr + (src_idx * padding_bytes), padding_bytes);
+        __ll_pad_frame_copy(dst_ptr, src_ptr + (src_idx * padding_bytes), padding_bytes);
 
         dst_ptr -= padding_bytes;
 
@@ -1559,7 +1733,7 @@ static void __ll_aton_lib_pad_reflect_sw(uint32_t curr_axis, __ll_pad_sw_params_
         LL_ATON_ASSERT((-src_idx) < n_elems);
         LL_ATON_ASSERT(src_idx <= 0);
 
-        memcpy(dst_ptr, src_ptr + (src_idx * padding_bytes), padding_bytes);
+        __ll_pad_frame_copy(dst_ptr, src_ptr + (src_idx * padding_bytes), padding_bytes);
 
         dst_ptr += padding_bytes;
         if (forward)
@@ -1674,7 +1848,7 @@ static void __ll_aton_lib_pad_edge_sw(uint32_t curr_axis, __ll_pad_sw_params_t *
         LL_ATON_PRINTF("%s(%d): memcpy, curr_axis=%d, dst=%p, src=%p, bytes=%d, times=%d/%d\n", __func__, __LINE__,
                        curr_axis, (int8_t *)dst_ptr, (int8_t *)src_ptr, padding_bytes, i + 1, nr_loops);
 #endif
-        memcpy(dst_ptr, src_ptr, padding_bytes);
+        __ll_pad_frame_copy(dst_ptr, src_ptr, padding_bytes);
         dst_ptr += padding_bytes;
       }
     }
@@ -1703,7 +1877,7 @@ static void __ll_aton_lib_pad_edge_sw(uint32_t curr_axis, __ll_pad_sw_params_t *
         LL_ATON_PRINTF("%s(%d): memcpy, curr_axis=%d, dst=%p, src=%p, bytes=%d, times=%d/%d\n", __func__, __LINE__,
                        curr_axis, (int8_t *)dst_ptr, (int8_t *)src_ptr, padding_bytes, i + 1, nr_loops);
 #endif
-        memcpy(dst_ptr, src_ptr, padding_bytes);
+        __ll_pad_frame_copy(dst_ptr, src_ptr, padding_bytes);
         dst_ptr += padding_bytes;
       }
     }
@@ -1873,6 +2047,14 @@ static int __ll_aton_lib_pad_framing_sw(__ll_pad_sw_params_t *common_params)
   int8_t *out_target = common_params->out_target;
 #endif // DUMP_RESULTS_PAD_OP
 
+  /* queue the big border copies as DMA segments while the traversal fills
+     the small ones in SW (keep everything in SW when the results must be
+     dumped right below) */
+  LL_ATON_LIB_DMA_Pad_Frame_Reset();
+#if !defined(DUMP_RESULTS_PAD_OP)
+  __ll_pad_frame_use_dma = true;
+#endif // !DUMP_RESULTS_PAD_OP
+
   switch (common_params->mode)
   {
   case 1: // `reflect` mode
@@ -1887,7 +2069,22 @@ static int __ll_aton_lib_pad_framing_sw(__ll_pad_sw_params_t *common_params)
     __LL_LIB_ERROR(_ERR_MODE, LL_ATON_INVALID_PARAM)
   }
 
+  __ll_pad_frame_use_dma = false;
+
   LL_ATON_ASSERT(common_params->callback_function != NULL); /* always "called as callback" */
+
+  if (LL_ATON_LIB_DMA_Pad_Frame_Count() > 0)
+  { // perform the queued border copies in HW
+    /* *** MCU cache clean & invalidate operation (SW) ***
+       makes the SW-written borders visible to the DMA sources and drops
+       (potentially stale) lines over the DMA-written destinations */
+    uint32_t size = (uintptr_t)(common_params->end_out_target) - (uintptr_t)(common_params->saved_out_target);
+    LL_ATON_Cache_MCU_Clean_Invalidate_Range(
+        ATON_LIB_PHYSICAL_TO_VIRTUAL_ADDR((uintptr_t)common_params->saved_out_target), size);
+
+    return LL_ATON_LIB_DMA_Pad_Framing(common_params);
+  }
+
   if ((common_params->end_out_target - common_params->saved_out_target) > 0)
   {
     /* *** MCU cache clean operation (SW) *** */
@@ -271,6 +271,7 @@
 /* ATON IP */
 #ifndef LL_ATON_OSAL_LOCK_ATON
 #define LL_ATON_OSAL_LOCK_ATON()
+#define LL_HAS_NO_ATON_OSAL_LOCK_ATON
 #endif // !LL_ATON_OSAL_LOCK_ATON
 
 #ifndef LL_ATON_OSAL_UNLOCK_ATON
@@ -33,6 +33,62 @@
 #include <stdio.h>
 #endif
 
+/* ---------------------------------------------------------------------------
+ * Per-operator cycle attribution (see ll_aton_profiler.h)
+ * ---------------------------------------------------------------------------
+ */
+
+/* raw DWT cycle counter, avoids a core-header dependency */
+#define _PROF_DWT_CYCCNT (*(volatile uint32_t *)0xE0001004UL)
+
+static LL_ATON_PROF_OpStats_TypeDef _prof_ops[LL_ATON_PROF_OP_SLOTS];
+static uint32_t _prof_n_ops;
+static uint32_t _prof_op_drop; /* invocations lost to a full table */
+
+uint32_t LL_ATON_PROF_Cycles(void)
+{
+  return _PROF_DWT_CYCCNT;
+}
+
+void LL_ATON_PROF_Account(const char *name, uint32_t cycles)
+{
+  uint32_t i;
+
+  for (i = 0; i < _prof_n_ops; i++)
+  {
+    if ((_prof_ops[i].name == name) || (strcmp(_prof_ops[i].name, name) == 0))
+    {
+      _prof_ops[i].calls += 1;
+      _prof_ops[i].cycles += cycles;
+      return;
+    }
+  }
+
+  if (_prof_n_ops >= LL_ATON_PROF_OP_SLOTS)
+  {
+    _prof_op_drop++;
+    return;
+  }
+
+  _prof_ops[_prof_n_ops].name = name;
+  _prof_ops[_prof_n_ops].calls = 1;
+  _prof_ops[_prof_n_ops].cycles = cycles;
+  _prof_n_ops++;
+}
+
+const LL_ATON_PROF_OpStats_TypeDef *LL_ATON_PROF_GetTable(uint32_t *n_entries)
+{
+  if (n_entries != NULL)
+    *n_entries = _prof_n_ops;
+  return &_prof_ops[0];
+}
+
+void LL_ATON_PROF_Reset(void)
+{
+  _prof_n_ops = 0;
+  _prof_op_drop = 0;
+}
+
 int LL_ATON_LIB_ConvInteger(const LL_LIB_TensorInfo_TypeDef *inputs, unsigned int ninputs,
                             const LL_LIB_TensorInfo_TypeDef *output, int pad_top, int pad_left, int pad_bottom,
                             int pad_right, int stride_h, int stride_w, int dilation_h, int dilation_w, int pad_value,
@@ -24,4 +24,39 @@
 #include "ll_aton_lib.h"
 #include "ll_aton_lib_sw_operators.h"
 
+/*
+ * Per-operator cycle attribution
+ *
+ * Aggregates DWT cycles per software-operator invocation into a small table
+ * keyed by operator type. The public LL_ATON_LIB_* software kernels bracket
+ * their compute path with LL_ATON_PROF_START()/LL_ATON_PROF_STOP(name):
+ * parameter-validation error exits are not accounted, DMA-driven operators
+ * are accounted for their synchronous issue path only. The bracketing
+ * compiles away unless LL_ATON_EN_OP_PROFILING is defined as 1.
+ */
+
+#ifndef LL_ATON_PROF_OP_SLOTS
+#define LL_ATON_PROF_OP_SLOTS 16
+#endif
+
+typedef struct
+{
+  const char *name; /* operator type (key) */
+  uint32_t calls;   /* number of invocations */
+  uint64_t cycles;  /* accumulated DWT cycles */
+} LL_ATON_PROF_OpStats_TypeDef;
+
+uint32_t LL_ATON_PROF_Cycles(void);
+void LL_ATON_PROF_Account(const char *name, uint32_t cycles);
+const LL_ATON_PROF_OpStats_TypeDef *LL_ATON_PROF_GetTable(uint32_t *n_entries);
+void LL_ATON_PROF_Reset(void);
+
+#if defined(LL_ATON_EN_OP_PROFILING) && (LL_ATON_EN_OP_PROFILING == 1)
+#define LL_ATON_PROF_START()    uint32_t _ll_prof_t0 = LL_ATON_PROF_Cycles()
+#define LL_ATON_PROF_STOP(_op_) LL_ATON_PROF_Account((_op_), LL_ATON_PROF_Cycles() - _ll_prof_t0)
+#else
+#define LL_ATON_PROF_START()
+#define LL_ATON_PROF_STOP(_op_)
+#endif
+
 #endif
\ No newline at end of file
@@ -91,6 +91,131 @@
   } while (0)
 #endif
 
+/* -----------------------------------------------------------------------------
+ * Optional GPDMA-backed segment copier (LL_ATON_RELOC_USE_DMA_COPY == 1)
+ *
+ * The read-only image (hdr/text/rodata) is queued as a GPDMA linked-list
+ * chain and transferred while the CPU prepares the memory pools (params
+ * copy to the external RAM,...), shortening the install time of large
+ * models. The channel is programmed at register level, no HAL dependency;
+ * if the chain does not fit the node pool the caller falls back to the
+ * plain memcpy() path.
+ * -----------------------------------------------------------------------------
+ */
+#if defined(LL_ATON_RELOC_USE_DMA_COPY) && LL_ATON_RELOC_USE_DMA_COPY == 1
+
+#ifndef LL_ATON_RELOC_DMA_CHANNEL
+#define LL_ATON_RELOC_DMA_CHANNEL     GPDMA1_Channel14 /* unused by the app */
+#define LL_ATON_RELOC_DMA_CHANNEL_IDX (14)
+#endif
+
+#define _RELOC_DMA_MAX_XFER  (0xFFC0u) /* BNDT limit, burst aligned */
+#define _RELOC_DMA_MAX_NODES (32)
+
+/* one linked-list item: CBR1/CSAR/CDAR/CLLR (UB1|USA|UDA|ULL fetch order),
+   the array may not straddle a 64KB boundary (CLBAR window) */
+struct _reloc_dma_node
+{
+  uint32_t cbr1;
+  uint32_t csar;
+  uint32_t cdar;
+  uint32_t cllr;
+};
+
+static struct _reloc_dma_node _reloc_dma_nodes[_RELOC_DMA_MAX_NODES]
+    __attribute__((aligned(sizeof(struct _reloc_dma_node) * _RELOC_DMA_MAX_NODES)));
+static uint32_t _reloc_dma_n_nodes;
+static bool _reloc_dma_ready;
+
+/* Queue one segment copy, split in BNDT-sized chunks. Returns false (and
+   queues nothing) if the chain would not fit the node pool. */
+static bool _reloc_dma_queue(uintptr_t dst, uintptr_t src, uint32_t size)
+{
+  const uint32_t n_chunks = (size + _RELOC_DMA_MAX_XFER - 1) / _RELOC_DMA_MAX_XFER;
+
+  if ((size == 0) || ((_reloc_dma_n_nodes + n_chunks) > _RELOC_DMA_MAX_NODES))
+    return false;
+
+  while (size)
+  {
+    const uint32_t chunk = size > _RELOC_DMA_MAX_XFER ? _RELOC_DMA_MAX_XFER : size;
+    struct _reloc_dma_node *node = &_reloc_dma_nodes[_reloc_dma_n_nodes++];
+
+    node->cbr1 = chunk & DMA_CBR1_BNDT_Msk;
+    node->csar = (uint32_t)src;
+    node->cdar = (uint32_t)dst;
+    node->cllr = 0;
+
+    if (_reloc_dma_n_nodes > 1)
+      _reloc_dma_nodes[_reloc_dma_n_nodes - 2].cllr =
+          DMA_CLLR_UB1 | DMA_CLLR_USA | DMA_CLLR_UDA | DMA_CLLR_ULL | ((uint32_t)node & DMA_CLLR_LA_Msk);
+
+    src += chunk;
+    dst += chunk;
+    size -= chunk;
+  }
+  return true;
+}
+
+static void _reloc_dma_kick(void)
+{
+  DMA_Channel_TypeDef *ch = LL_ATON_RELOC_DMA_CHANNEL;
+  const struct _reloc_dma_node *first = &_reloc_dma_nodes[0];
+
+  if (_reloc_dma_n_nodes == 0)
+    return;
+
+  if (!_reloc_dma_ready)
+  {
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPDMA1EN;
+    (void)RCC->AHB1ENR;
+    GPDMA1_S->SECCFGR |= (1UL << LL_ATON_RELOC_DMA_CHANNEL_IDX);
+    _reloc_dma_ready = true;
+  }
+
+  /* the items are fetched by the DMA itself */
+  RELOC_MCU_D_CACHE_CLEAN_INVALIDATE(&_reloc_dma_nodes[0], sizeof(_reloc_dma_nodes));
+
+  ch->CFCR = 0x00007F00UL; /* clear the transfer flags */
+  ch->CLBAR = (uint32_t)first & DMA_CLBAR_LBA_Msk;
+  /* 8-byte incrementing bursts on both sides */
+  ch->CTR1 = (3UL << DMA_CTR1_SDW_LOG2_Pos) | DMA_CTR1_SINC | (7UL << DMA_CTR1_SBL_1_Pos) |
+             (3UL << DMA_CTR1_DDW_LOG2_Pos) | DMA_CTR1_DINC | (7UL << DMA_CTR1_DBL_1_Pos);
+  ch->CTR2 = DMA_CTR2_SWREQ; /* memory-to-memory */
+  ch->CBR1 = first->cbr1;
+  ch->CSAR = first->csar;
+  ch->CDAR = first->cdar;
+  ch->CLLR = first->cllr;
+  ch->CCR = DMA_CCR_EN;
+}
+
+/* Wait for the end of the chain (EN is cleared by HW on the last item),
+   0 if the whole chain completed without error */
+static int _reloc_dma_wait(void)
+{
+  DMA_Channel_TypeDef *ch = LL_ATON_RELOC_DMA_CHANNEL;
+  int res = AI_RELOC_RT_ERR_NONE;
+
+  if (_reloc_dma_n_nodes == 0)
+    return res;
+
+  while (ch->CCR & DMA_CCR_EN)
+  {
+    if (ch->CSR & (DMA_CSR_DTEF | DMA_CSR_ULEF | DMA_CSR_USEF))
+    {
+      ch->CCR |= DMA_CCR_SUSP;
+      ch->CCR = DMA_CCR_RESET;
+      res = AI_RELOC_RT_ERR_MEMORY;
+      break;
+    }
+  }
+
+  _reloc_dma_n_nodes = 0;
+  return res;
+}
+
+#endif /* LL_ATON_RELOC_USE_DMA_COPY */
+
 /*
  *  Implementation of the call-backs fcts
  */
@@ -509,6 +634,29 @@ struct id_mpool_mapping
   uint32_t sz_1;
 };
 
+/* params memory pool whose copy was deferred by AI_RELOC_RT_LOAD_MODE_LAZY_PARAMS,
+   exposed through ll_aton_reloc_get_lazy_params() */
+static struct
+{
+  uintptr_t src;
+  uintptr_t dst;
+  uint32_t size;
+  bool valid;
+} _lazy_params;
+
+int ll_aton_reloc_get_lazy_params(uintptr_t *src, uintptr_t *dst, uint32_t *size)
+{
+  if (!_lazy_params.valid)
+    return 0;
+  if (src)
+    *src = _lazy_params.src;
+  if (dst)
+    *dst = _lazy_params.dst;
+  if (size)
+    *size = _lazy_params.size;
+  return 1;
+}
+
 static int _ai_reloc_prepare_mpools(const uintptr_t file_ptr, struct id_mpool_mapping *id_map, uint32_t mode)
 {
   const struct ai_reloc_bin_hdr *header = (struct ai_reloc_bin_hdr *)file_ptr;
@@ -517,6 +665,8 @@ static int _ai_reloc_prepare_mpools(const uintptr_t file_ptr, struct id_mpool_ma
   uintptr_t addr_0 = 0;
   bool invalidate_npu_cache = false;
 
+  _lazy_params.valid = false;
+
   ll_aton_reloc_mem_pool_desc *cur_mem_c_desc;
 
   /* Set/check base param addr - user addr is used in priority */
@@ -593,8 +743,19 @@ static int _ai_reloc_prepare_mpools(const uintptr_t file_ptr, struct id_mpool_ma
     {
       if (AI_RELOC_MPOOL_IS_COPY(flags))
       {
-        memcpy((void *)dst, (void const *)(src), sz);
-        RELOC_MCU_D_CACHE_CLEAN_INVALIDATE(dst, sz);
+        if ((mode & AI_RELOC_RT_LOAD_MODE_LAZY_PARAMS) && AI_RELOC_MPOOL_IS_PARAM(flags) && !_lazy_params.valid)
+        {
+          /* deferred - the caller stages the parameter windows just-in-time */
+          _lazy_params.src = src;
+          _lazy_params.dst = dst;
+          _lazy_params.size = sz;
+          _lazy_params.valid = true;
+        }
+        else
+        {
+          memcpy((void *)dst, (void const *)(src), sz);
+          RELOC_MCU_D_CACHE_CLEAN_INVALIDATE(dst, sz);
+        }
       }
       if (AI_RELOC_MPOOL_IS_RESET(flags) && (mode & AI_RELOC_RT_LOAD_MODE_CLEAR))
       {
@@ -780,17 +941,51 @@ static int _ai_reloc_install(const uintptr_t file_ptr, uintptr_t ram_addr, size_
   if (ram_addr && ram_size && !AI_RELOC_IS_ALIGNED(ram_addr))
     return AI_RELOC_RT_ERR_MEMORY;
 
+#if defined(LL_ATON_RELOC_USE_DMA_COPY) && LL_ATON_RELOC_USE_DMA_COPY == 1
+  /* Queue the hdr/text/rodata copy on the GPDMA chain, it runs while the
+     CPU prepares the memory pools below */
+  bool dma_copy = false;
+  if (mode & AI_RELOC_RT_LOAD_MODE_COPY)
+  {
+    const uint32_t ro_sz = AI_RELOC_GET_OFFSET(rom_addr->sect.data_data);
+    dma_copy = _reloc_dma_queue(ram_addr, file_ptr, ro_sz);
+    if (dma_copy)
+    {
+      /* no dirty destination lines may be written back during the DMA */
+      RELOC_MCU_D_CACHE_CLEAN_INVALIDATE(ram_addr, ro_sz);
+      _reloc_dma_kick();
+    }
+  }
+#endif
+
   res = _ai_reloc_prepare_mpools(file_ptr, &id_map, mode);
   if (res)
+  {
+#if defined(LL_ATON_RELOC_USE_DMA_COPY) && LL_ATON_RELOC_USE_DMA_COPY == 1
+    _reloc_dma_wait();
+#endif
     return res;
+  }
 
   /* Copy hrd, txt and rodata sections in RAM */
   if (mode & AI_RELOC_RT_LOAD_MODE_COPY)
   {
     const uint32_t ro_sz = AI_RELOC_GET_OFFSET(rom_addr->sect.data_data);
-    memcpy((void *)ram_addr, (void const *)file_ptr, ro_sz);
+#if defined(LL_ATON_RELOC_USE_DMA_COPY) && LL_ATON_RELOC_USE_DMA_COPY == 1
+    if (dma_copy)
+    {
+      /* join the chain before the copied header/rodata are accessed */
+      if (_reloc_dma_wait() != AI_RELOC_RT_ERR_NONE)
+        return AI_RELOC_RT_ERR_MEMORY;
+      RELOC_MCU_D_CACHE_CLEAN_INVALIDATE(ram_addr, ro_sz);
+    }
+    else
+#endif
+    {
+      memcpy((void *)ram_addr, (void const *)file_ptr, ro_sz);
 
-    RELOC_MCU_D_CACHE_CLEAN_INVALIDATE(ram_addr, ro_sz);
+      RELOC_MCU_D_CACHE_CLEAN_INVALIDATE(ram_addr, ro_sz);
+    }
 
     /* Update the rom_addr/ram_addr pointers */
     rom_addr = (struct ai_reloc_bin_hdr *)(ram_addr);
@@ -999,6 +1194,162 @@ void ll_aton_reloc_log_info(const uintptr_t file_ptr)
 #endif /* AI_RELOC_LOG_ENABLE == 1 */
 }
 
+/* -----------------------------------------------------------------------------
+ * Install-skip cache
+ *
+ * A successful install is recorded with a CRC-32 of the binary image (computed
+ * with the CRC peripheral) and the install parameters.
+ * ll_aton_reloc_is_installed() lets the application skip a re-install when the
+ * identical binary is already resident at the same exec RAM base: it only
+ * rebinds the NN instance to the runtime context left in the exec RAM by the
+ * previous install.
+ * -----------------------------------------------------------------------------
+ */
+
+struct _reloc_install_record
+{
+  uint32_t crc32;                 /* CRC-32 of the binary image */
+  uintptr_t file_ptr;             /* flashed location of the binary */
+  uintptr_t exec_ram_addr;        /* exec RAM base of the install */
+  uintptr_t ext_ram_addr;         /* external/acts RAM base of the install */
+  uint32_t mode;                  /* requested load mode */
+  struct ai_reloc_rt_ctx *rt_ctx; /* runtime context left in the exec RAM */
+  bool valid;
+};
+
+static struct _reloc_install_record _last_install;
+
+static uint32_t _reloc_file_crc32(const uintptr_t file_ptr)
+{
+  const uint32_t size = _npu_reloc_code_size(file_ptr);
+  const uint32_t *ptr = (const uint32_t *)file_ptr;
+
+  /* lazy clock enable, the unit keeps its default configuration: CRC-32, poly 0x4C11DB7 */
+  RCC->AHB4ENR |= RCC_AHB4ENR_CRCEN;
+  (void)RCC->AHB4ENR;
+
+  CRC->CR = CRC_CR_RESET;
+
+  for (uint32_t i = 0; i < size / 4; i++)
+    CRC->DR = *ptr++;
+
+  return CRC->DR;
+}
+
+int ll_aton_reloc_is_installed(const uintptr_t file_ptr, const ll_aton_reloc_config *config,
+                               NN_Instance_TypeDef *nn_instance)
+{
+  if (!nn_instance || !file_ptr || !config)
+    return 0;
+
+  if (!_last_install.valid || (_last_install.file_ptr != file_ptr) ||
+      (_last_install.exec_ram_addr != config->exec_ram_addr) ||
+      (_last_install.ext_ram_addr != config->ext_ram_addr) || (_last_install.mode != config->mode))
+    return 0;
+
+  /* the runtime context left in the exec RAM must still be intact */
+  if (_ai_rel_check_handler((uintptr_t)_last_install.rt_ctx))
+    return 0;
+
+  /* the binary content must be unchanged */
+  if (_reloc_file_crc32(file_ptr) != _last_install.crc32)
+    return 0;
+
+  /* rebind the NN instance to the resident install */
+  struct ai_reloc_rt_ctx *rt_ctx = _last_install.rt_ctx;
+
+  rt_ctx->ll_instance = nn_instance;
+  nn_instance->network = rt_ctx->itf_network;
+  memset(&nn_instance->exec_state, 0, sizeof(NN_Execution_State_TypeDef));
+  nn_instance->exec_state.inst_reloc = (uint32_t)rt_ctx;
+
+  ll_aton_reloc_set_callbacks(nn_instance, &_network_reloc_callback);
+
+  AI_RELOC_LOG("RELOC: binary 0x%08x already resident (crc=0x%08x), install skipped\r\n", (int)file_ptr,
+               (int)_last_install.crc32);
+
+  return 1;
+}
+
+/*
+ * Cooperative background preload.
+ *
+ * Resumable copy of a relocatable binary (header, code and embedded params)
+ * into a faster staging area, sliced by a caller-provided byte budget so it
+ * can be pumped from the transport idle loop of the application. Once the
+ * copy is complete the staged address can be used as the file_ptr of a
+ * regular ll_aton_reloc_install(), hiding the model-swap latency.
+ */
+static struct _reloc_preload_ctx
+{
+  const uint8_t *src;
+  uint8_t *dst;
+  uint32_t size;
+  uint32_t done;
+  bool active;
+} _preload;
+
+int ll_aton_reloc_preload_start(const uintptr_t file_ptr, uintptr_t dst_addr, uint32_t dst_size)
+{
+  ll_aton_reloc_info rt;
+
+  _preload.active = false;
+
+  int res = ll_aton_reloc_get_info(file_ptr, &rt);
+  if (res != AI_RELOC_RT_ERR_NONE)
+    return res;
+
+  /* whole image: ro region, extended with the appended params when embedded */
+  uint32_t size = rt.code_sz;
+  if (rt.params_off)
+    size = rt.params_off + rt.params_sz;
+  size = AI_RELOC_ROUND_UP(size);
+
+  if ((dst_addr == 0) || (!AI_RELOC_IS_ALIGNED(dst_addr)) || (dst_size < size))
+    return AI_RELOC_RT_ERR_MEMORY;
+
+  _preload.src = (const uint8_t *)file_ptr;
+  _preload.dst = (uint8_t *)dst_addr;
+  _preload.size = size;
+  _preload.done = 0;
+  _preload.active = true;
+
+  AI_RELOC_LOG("AI RELOC: preload %d bytes: 0x%08x -> 0x%08x\r\n", (int)size, (int)file_ptr, (int)dst_addr);
+
+  return AI_RELOC_RT_ERR_NONE;
+}
+
+int ll_aton_reloc_preload_pump(uint32_t budget)
+{
+  if (!_preload.active)
+    return AI_RELOC_RT_ERR_ARG;
+
+  uint32_t chunk = _preload.size - _preload.done;
+
+  if ((budget != 0) && (chunk > budget))
+    chunk = budget;
+
+  if (chunk)
+  {
+    memcpy(_preload.dst + _preload.done, _preload.src + _preload.done, chunk);
+    RELOC_MCU_D_CACHE_CLEAN_INVALIDATE((uintptr_t)(_preload.dst + _preload.done), chunk);
+    _preload.done += chunk;
+  }
+
+  return (int)(_preload.size - _preload.done);
+}
+
+int ll_aton_reloc_preload_get(uintptr_t *file_ptr)
+{
+  if (!_preload.active || (_preload.done < _preload.size))
+    return 0;
+
+  if (file_ptr)
+    *file_ptr = (uintptr_t)_preload.dst;
+
+  return 1;
+}
+
 int ll_aton_reloc_install(const uintptr_t file_ptr, const ll_aton_reloc_config *config,
                           NN_Instance_TypeDef *nn_instance)
 {
@@ -1025,6 +1376,22 @@ int ll_aton_reloc_install(const uintptr_t file_ptr, const ll_aton_reloc_config *
 
   RELOC_MCU_I_CACHE_INVALIDATE(config->exec_ram_addr, config->exec_ram_size);
 
+  /* record the install for the is_installed fast path */
+  if (!res)
+  {
+    _last_install.crc32 = _reloc_file_crc32(file_ptr);
+    _last_install.file_ptr = file_ptr;
+    _last_install.exec_ram_addr = config->exec_ram_addr;
+    _last_install.ext_ram_addr = config->ext_ram_addr;
+    _last_install.mode = config->mode;
+    _last_install.rt_ctx = (struct ai_reloc_rt_ctx *)nn_instance->exec_state.inst_reloc;
+    _last_install.valid = true;
+  }
+  else
+  {
+    _last_install.valid = false;
+  }
+
   return res;
 }
 
@@ -47,6 +47,9 @@ extern "C"
                                             copied in RAM, code is executed in-place */
 #define AI_RELOC_RT_LOAD_MODE_COPY  (1 << 1) /* code and data sections are copied in RAM */
 #define AI_RELOC_RT_LOAD_MODE_CLEAR (1 << 2) /* clear the acts memory pools */
+#define AI_RELOC_RT_LOAD_MODE_LAZY_PARAMS                                                                              \
+  (1 << 3) /* defer the copy of the params memory pool, the caller stages the                                          \
+              parameter windows itself (see ll_aton_reloc_get_lazy_params()) */
 
 /* AI RT error definitions */
 #define AI_RELOC_RT_ERR_NONE          (0)
@@ -290,6 +293,24 @@ extern "C"
   int ll_aton_reloc_install(const uintptr_t file_ptr, const ll_aton_reloc_config *config,
                             NN_Instance_TypeDef *nn_instance);
 
+  /* return 1 (and rebind nn_instance) when the identical binary is already installed
+     with the same configuration, so that the install can be skipped */
+  int ll_aton_reloc_is_installed(const uintptr_t file_ptr, const ll_aton_reloc_config *config,
+                                 NN_Instance_TypeDef *nn_instance);
+
+  /* cooperative background preload: resumable copy of a relocatable binary into a
+     staging area, pumped in byte-budgeted slices from the application idle loop.
+     preload_pump() returns the remaining byte count (0: complete, <0: no preload
+     pending), preload_get() returns 1 and the staged address once complete */
+  int ll_aton_reloc_preload_start(const uintptr_t file_ptr, uintptr_t dst_addr, uint32_t dst_size);
+  int ll_aton_reloc_preload_pump(uint32_t budget);
+  int ll_aton_reloc_preload_get(uintptr_t *file_ptr);
+
+  /* return 1 and the {src, dst, size} of the params memory pool whose copy was
+     deferred by AI_RELOC_RT_LOAD_MODE_LAZY_PARAMS during the last install,
+     0 when no copy was deferred */
+  int ll_aton_reloc_get_lazy_params(uintptr_t *src, uintptr_t *dst, uint32_t *size);
+
   int ll_aton_reloc_is_valid(const NN_Instance_TypeDef *nn_instance);
   int ll_aton_reloc_get_file_ptr(const NN_Instance_TypeDef *nn_instance, uintptr_t *file_ptr);
 
@@ -90,7 +90,8 @@ extern "C"
  * @param nn_if_ptr pointer to network interface
  */
 #define LL_ATON_DECLARE_NAMED_NN_INSTANCE(nn_exec_name, nn_if_ptr)                                                     \
-  static NN_Instance_TypeDef NN_Instance_##nn_exec_name = {.network = nn_if_ptr, .exec_state = {0}}
+  static LL_ATON_DTCM_SECTION NN_Instance_TypeDef NN_Instance_##nn_exec_name = {.network = nn_if_ptr,                  \
+                                                                                .exec_state = {0}}
 
 /**
  * @brief Declare and fill a non-constant named NN execution instance and constant network interface,
@@ -60,6 +60,15 @@ uint32_t volatile __ll_current_wait_mask = 0;
 /* Trace runtime callback */
 static TraceRuntime_FuncPtr_t ll_aton_init_deinit_trace = NULL;
 
+#if (LL_ATON_RT_MODE == LL_ATON_RT_POLLING)
+/* Expected polling-wait length per epoch block (weighted probe units, see
+   LL_ATON_SetPollingBackoffHint()): exponential moving average over the
+   previous runs, direct-mapped by epoch block index and shared across
+   networks (polling configurations run a single network in practice) */
+#define _POLL_EB_HIST_SLOTS 64
+static uint32_t _poll_eb_hist[_POLL_EB_HIST_SLOTS];
+#endif // (LL_ATON_RT_MODE == LL_ATON_RT_POLLING)
+
 /* Forward declaration */
 void ATON_STD_IRQHandler(void);
 
@@ -72,6 +81,16 @@ void ATON_STD_IRQHandler(void);
     LL_ATON_OSAL_DISABLE_IRQ(3);                                                                                       \
   } while (0)
 
+/* Epoch block start/end function invocation (non-relocatable instances):
+ * with `LL_ATON_RT_STATIC_DISPATCH` enabled the calls go through the
+ * per-network dispatcher emitted by the generated code (which may turn
+ * them into direct calls), otherwise plain indirect calls are performed */
+#if defined(LL_ATON_RT_STATIC_DISPATCH) && (LL_ATON_RT_STATIC_DISPATCH == 1)
+#define __LL_ATON_RT_CALL_EB_FUNC(_func_, _eb_) LL_ATON_RT_EpochFuncDispatch((_func_), (const void *)(_eb_))
+#else // !LL_ATON_RT_STATIC_DISPATCH
+#define __LL_ATON_RT_CALL_EB_FUNC(_func_, _eb_) (_func_)((const void *)(_eb_))
+#endif // !LL_ATON_RT_STATIC_DISPATCH
+
 /*** Helper Functions ***/
 
 #ifndef NDEBUG
@@ -91,7 +110,7 @@ static uint32_t __LL_ATON_RT_CntEpochBlocks(const LL_ATON_RT_EpochBlockItem_t *l
 }
 #endif
 
-static inline void __LL_ATON_RT_ExecStartEpochBlock(const LL_ATON_RT_EpochBlockItem_t *eb,
+static inline LL_ATON_HOT_TEXT void __LL_ATON_RT_ExecStartEpochBlock(const LL_ATON_RT_EpochBlockItem_t *eb,
                                                     NN_Instance_TypeDef *nn_instance)
 {
   LL_ATON_ASSERT(nn_instance->exec_state.next_epoch_block == NULL);
@@ -109,7 +128,11 @@ static inline void __LL_ATON_RT_ExecStartEpochBlock(const LL_ATON_RT_EpochBlockI
   if (EpochBlock_IsEpochPureHW(eb) ||
       EpochBlock_IsEpochHybrid(eb)) // epoch blobs are flagged as pure HW, so checking for epoch blob is not necessary
   {
+#if (LL_ATON_OWNER_HANDOFF == 1)
+    __ll_handoff_aton_owner(nn_instance);
+#else
     __ll_set_aton_owner(nn_instance);
+#endif
   }
 
   if (!EpochBlock_IsEpochBlob(eb))
@@ -149,10 +172,10 @@ static inline void __LL_ATON_RT_ExecStartEpochBlock(const LL_ATON_RT_EpochBlockI
     }
     else
     {
-      eb->start_epoch_block((const void *)eb);
+      __LL_ATON_RT_CALL_EB_FUNC(eb->start_epoch_block, eb);
     }
 #else
-    eb->start_epoch_block((const void *)eb);
+    __LL_ATON_RT_CALL_EB_FUNC(eb->start_epoch_block, eb);
 #endif
   }
 
@@ -180,7 +203,7 @@ static inline void __LL_ATON_RT_ExecStartEpochBlock(const LL_ATON_RT_EpochBlockI
     nn_instance->exec_state.epoch_callback_function(LL_ATON_RT_Callbacktype_POST_START, nn_instance, eb);
 }
 
-static inline void __LL_ATON_RT_ExecEndEpochBlock(const LL_ATON_RT_EpochBlockItem_t *eb,
+static inline LL_ATON_HOT_TEXT void __LL_ATON_RT_ExecEndEpochBlock(const LL_ATON_RT_EpochBlockItem_t *eb,
                                                   NN_Instance_TypeDef *nn_instance)
 {
   if (nn_instance->exec_state.epoch_callback_function != NULL)
@@ -211,10 +234,10 @@ static inline void __LL_ATON_RT_ExecEndEpochBlock(const LL_ATON_RT_EpochBlockIte
     }
     else
     {
-      eb->end_epoch_block((const void *)eb);
+      __LL_ATON_RT_CALL_EB_FUNC(eb->end_epoch_block, eb);
     }
 #else
-    eb->end_epoch_block((const void *)eb);
+    __LL_ATON_RT_CALL_EB_FUNC(eb->end_epoch_block, eb);
 #endif
   }
 
@@ -226,6 +249,12 @@ static inline void __LL_ATON_RT_ExecEndEpochBlock(const LL_ATON_RT_EpochBlockIte
     __LL_ATON_RT_SetWaitMask(0);
   }
 
+#if (LL_ATON_OWNER_HANDOFF == 1)
+  /* Lazy release: ownership is retained and either taken over by the next
+     network's `__ll_handoff_aton_owner()` or dropped in
+     `LL_ATON_RT_DeInit_Network()` */
+  LL_ATON_ASSERT(!EpochBlock_IsEpochPureHW(eb) || (__ll_current_aton_ip_owner == nn_instance));
+#else
   /* Release ATON IP unlock in case it's a pure HW epoch */
   if (EpochBlock_IsEpochPureHW(eb) || ((EpochBlock_IsEpochHybrid(eb) || EpochBlock_IsEpochInternal(eb)) &&
                                        (nn_instance->exec_state.saved_current_epoch_block == NULL) &&
@@ -236,6 +265,7 @@ static inline void __LL_ATON_RT_ExecEndEpochBlock(const LL_ATON_RT_EpochBlockIte
   }
   LL_ATON_ASSERT(EpochBlock_IsEpochInternal(eb) || EpochBlock_IsEpochHybrid(eb) ||
                  (__ll_current_aton_ip_owner != nn_instance));
+#endif // LL_ATON_OWNER_HANDOFF
 
   if (nn_instance->exec_state.epoch_callback_function != NULL)
   {
@@ -243,7 +273,7 @@ static inline void __LL_ATON_RT_ExecEndEpochBlock(const LL_ATON_RT_EpochBlockIte
   }
 }
 
-static void __LL_ATON_RT_DetermineNextEpochBlock(NN_Instance_TypeDef *nn_instance)
+static LL_ATON_HOT_TEXT void __LL_ATON_RT_DetermineNextEpochBlock(NN_Instance_TypeDef *nn_instance)
 {
   LL_ATON_ASSERT(nn_instance != NULL);
 #if (LL_ATON_RT_MODE == LL_ATON_RT_ASYNC)
@@ -284,7 +314,7 @@ static void __LL_ATON_RT_DetermineNextEpochBlock(NN_Instance_TypeDef *nn_instanc
 #endif
 }
 
-static inline uint32_t __LL_ATON_RT_GetWaitMask(const LL_ATON_RT_EpochBlockItem_t *eb)
+static inline LL_ATON_HOT_TEXT uint32_t __LL_ATON_RT_GetWaitMask(const LL_ATON_RT_EpochBlockItem_t *eb)
 {
   if (EpochBlock_IsEpochBlob(eb))
   {
@@ -580,7 +610,7 @@ void LL_ATON_RT_RuntimeDeInit(void)
  *                            It is entirely the user's responsibility to comply with this restriction!
  * @retval LL_ATON_RT_DONE    NN execution finished
  */
-LL_ATON_RT_RetValues_t LL_ATON_RT_RunEpochBlock(NN_Instance_TypeDef *nn_instance)
+LL_ATON_HOT_TEXT LL_ATON_RT_RetValues_t LL_ATON_RT_RunEpochBlock(NN_Instance_TypeDef *nn_instance)
 {
   LL_ATON_ASSERT(nn_instance != NULL);
 
@@ -719,6 +749,12 @@ LL_ATON_RT_RetValues_t LL_ATON_RT_RunEpochBlock(NN_Instance_TypeDef *nn_instance
     uint32_t _wait_mask = __LL_ATON_RT_GetWaitMask(nn_instance->exec_state.current_epoch_block);
     if (_wait_mask != 0)
     {
+      /* seed the adaptive spin-then-relax backoff from the wait history of
+         this epoch block, so expected-short epochs are spun tight and
+         expected-long ones relax off the bus early */
+      uint32_t _eb_slot = __LL_ATON_RT_GetCurrEpochBlockIndex(nn_instance) % _POLL_EB_HIST_SLOTS;
+      LL_ATON_SetPollingBackoffHint(_poll_eb_hist[_eb_slot]);
+
       /* Perform polling wait */
       if (EpochBlock_IsEpochBlob(nn_instance->exec_state.current_epoch_block))
       {
@@ -732,6 +768,12 @@ LL_ATON_RT_RetValues_t LL_ATON_RT_RunEpochBlock(NN_Instance_TypeDef *nn_instance
       {
         LL_Streng_Wait(_wait_mask);
       }
+
+      /* fold the observed wait into the history (EMA, 3/4 old + 1/4 new) */
+      uint32_t _eb_wait = LL_ATON_GetLastPollingWait();
+      _poll_eb_hist[_eb_slot] = (_poll_eb_hist[_eb_slot] != 0)
+                                    ? (_poll_eb_hist[_eb_slot] - (_poll_eb_hist[_eb_slot] >> 2) + (_eb_wait >> 2))
+                                    : _eb_wait;
     }
 
     /* End epoch block and advance to next one */
@@ -756,9 +798,9 @@ LL_ATON_RT_RetValues_t LL_ATON_RT_RunEpochBlock(NN_Instance_TypeDef *nn_instance
 
 // REMEMBER: mask out all interrupt from parameter `irqs` you do NOT want to be handled in beyond function
 #if (ATON_INT_NR > 32)
-static void __LL_ATON_RT_IrqErr(uint64_t irqs)
+static LL_ATON_COLD_TEXT void __LL_ATON_RT_IrqErr(uint64_t irqs)
 #else  //(ATON_INT_NR <= 32)
-static void __LL_ATON_RT_IrqErr(uint32_t irqs)
+static LL_ATON_COLD_TEXT void __LL_ATON_RT_IrqErr(uint32_t irqs)
 #endif //(ATON_INT_NR <= 32)
 {
   extern void dump_dma_state(void);
@@ -868,9 +910,9 @@ static void __LL_ATON_RT_IrqErr(uint32_t irqs)
 
 #if (LL_ATON_RT_MODE == LL_ATON_RT_ASYNC)
 #if (ATON_INT_NR > 32)
-static inline void __LL_ATON_RT_IrqEpochBlock(uint64_t irqs)
+static inline LL_ATON_HOT_TEXT void __LL_ATON_RT_IrqEpochBlock(uint64_t irqs)
 #else  //(ATON_INT_NR <= 32)
-static inline void __LL_ATON_RT_IrqEpochBlock(uint32_t irqs)
+static inline LL_ATON_HOT_TEXT void __LL_ATON_RT_IrqEpochBlock(uint32_t irqs)
 #endif //(ATON_INT_NR <= 32)
 {
   int32_t i;
@@ -917,9 +959,9 @@ static inline void __LL_ATON_RT_IrqEpochBlock(uint32_t irqs)
 
 #if defined(ATON_EPOCHCTRL_NUM)
 #if (ATON_INT_NR > 32)
-static inline void __LL_ATON_RT_IrqEpochBlob(uint64_t irqs)
+static inline LL_ATON_HOT_TEXT void __LL_ATON_RT_IrqEpochBlob(uint64_t irqs)
 #else  //(ATON_INT_NR <= 32)
-static inline void __LL_ATON_RT_IrqEpochBlob(uint32_t irqs)
+static inline LL_ATON_HOT_TEXT void __LL_ATON_RT_IrqEpochBlob(uint32_t irqs)
 #endif //(ATON_INT_NR <= 32)
 {
   uint32_t ecId = EpochBlock_EpochControllerUnit(__ll_current_aton_ip_owner->exec_state.current_epoch_block);
@@ -941,7 +983,7 @@ static inline void __LL_ATON_RT_IrqEpochBlob(uint32_t irqs)
 
 /* ATON ISR
  * ll_aton routes all interrupts to `ATON_STD_IRQ_LINE` interrupt line */
-void ATON_STD_IRQHandler(void)
+LL_ATON_HOT_TEXT void ATON_STD_IRQHandler(void)
 {
   /** Figure out which interrupt(s) fired **/
 #if (ATON_INT_NR > 32)
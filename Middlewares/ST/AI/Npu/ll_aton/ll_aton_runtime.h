@@ -65,6 +65,45 @@ extern "C"
     LL_ATON_OSAL_UNLOCK_ATON();
   }
 
+/* Cooperative ATON IP ownership handoff: on single-threaded bare-metal builds
+   (polling mode, no OSAL ATON lock configured) ownership is retained across
+   epoch blocks and transferred to the next network with a single pointer swap
+   instead of a full release/acquire round trip. Must NOT be enabled in async
+   mode as the interrupt dispatch keys on `__ll_current_aton_ip_owner` and a
+   lazily retained owner would receive events of a finished epoch block. */
+#if (LL_ATON_RT_MODE == LL_ATON_RT_POLLING) && defined(LL_HAS_NO_ATON_OSAL_LOCK_ATON)
+#define LL_ATON_OWNER_HANDOFF 1
+#else
+#define LL_ATON_OWNER_HANDOFF 0
+#endif
+
+#if (LL_ATON_OWNER_HANDOFF == 1)
+  static inline void __ll_handoff_aton_owner(NN_Instance_TypeDef *new_owner)
+  {
+    extern NN_Instance_TypeDef *volatile __ll_current_aton_ip_owner;
+    LL_ATON_ASSERT(new_owner != NULL);
+
+    if (__ll_current_aton_ip_owner == new_owner)
+    { /* ownership retained from a previous epoch block of the same network */
+      return;
+    }
+
+    if (__ll_current_aton_ip_owner != NULL)
+    { /* cooperative transfer from the lazily retained owner: pointer swap only */
+#ifndef NDEBUG
+      extern uint32_t volatile __ll_current_wait_mask;
+      LL_ATON_ASSERT(__ll_current_wait_mask == 0);
+#endif // NDEBUG
+
+      __ll_current_aton_ip_owner = new_owner;
+      return;
+    }
+
+    /* no retained owner (first acquisition or explicit release) */
+    __ll_set_aton_owner(new_owner);
+  }
+#endif // LL_ATON_OWNER_HANDOFF
+
   /**
    *  Note: the following function may only be called at the beginning of
    *       `LL_ATON_Start_EpochBlock<n>()` functions, assuming also that at that point
@@ -167,6 +206,20 @@ extern "C"
 #endif
   }
 
+#if defined(LL_ATON_RT_STATIC_DISPATCH) && (LL_ATON_RT_STATIC_DISPATCH == 1)
+  /**
+   * @brief Per-network dispatcher for epoch block start/end functions
+   * @param func epoch block function pointer taken from the epoch block item
+   * @param epoch_block pointer to the epoch block item to be passed to `func`
+   * @note  MUST be provided by the network generated code (typically a switch on
+   *        the known epoch functions with a fall-back indirect call), so that the
+   *        compiler can turn the hottest epoch transitions into direct calls.
+   *        Not used for relocatable network instances which always dispatch
+   *        through the relocation machinery.
+   */
+  void LL_ATON_RT_EpochFuncDispatch(EpochBlock_FuncPtr_t func, const void *epoch_block);
+#endif // LL_ATON_RT_STATIC_DISPATCH
+
   /*** AtoNN API Functions ***/
 
   static inline void LL_ATON_RT_Insert_LibEpochBlockArray(const LL_ATON_RT_EpochBlockItem_t *new_epoch_block_array)
@@ -240,11 +240,197 @@ void ll_sw_forward_matmul(/* int processor, */ void *sw_info_struct)
   matmul_layer.forward(AI_LAYER_OBJ(&matmul_layer));
 }
 
+//##########################################################################################
+#if LL_ATON_SW_USE_MVE == 1
+
+#include <math.h>
+
+/* Per-node dispatch memo. The generated epoch functions rebuild their
+ * `sw_info` block with the same baked-in constants on every run, so the
+ * shape classification done by the fast-path probes is invariant per node.
+ * Nodes rejected by every probe are remembered, keyed on the node type and
+ * its tensor addresses (which the generator fixes at build time), and go
+ * straight to the generic kernel on later runs, removing the repeated
+ * probe overhead of the many small software epochs. A probe that fails
+ * for content rather than shape reasons (e.g. an out-of-range gather
+ * index) also sticks to the generic kernel, which is the safe side. */
+#define __SW_DISPATCH_MAX_NODES (64)
+
+typedef struct
+{
+  const void *in;
+  const void *out;
+  NodeType type;
+} _sw_dispatch_memo_t;
+
+static _sw_dispatch_memo_t _sw_dispatch_memo[__SW_DISPATCH_MAX_NODES];
+static uint32_t _sw_dispatch_memo_n = 0;
+
+/** true iff every fast-path probe already rejected this node */
+static bool _sw_dispatch_is_generic(const General *g)
+{
+  for (uint32_t i = 0; i < _sw_dispatch_memo_n; i++)
+  {
+    if ((_sw_dispatch_memo[i].in == g->input.mem.start_offset) &&
+        (_sw_dispatch_memo[i].out == g->output.mem.start_offset) && (_sw_dispatch_memo[i].type == g->type))
+      return true;
+  }
+  return false;
+}
+
+/** remember that this node takes the generic kernel */
+static void _sw_dispatch_set_generic(const General *g)
+{
+  if (_sw_dispatch_memo_n >= __SW_DISPATCH_MAX_NODES)
+    return; /* table full: the node simply keeps probing */
+
+  _sw_dispatch_memo_t *m = &_sw_dispatch_memo[_sw_dispatch_memo_n];
+  m->in = g->input.mem.start_offset;
+  m->out = g->output.mem.start_offset;
+  m->type = g->type;
+  _sw_dispatch_memo_n++;
+}
+
+/* Fixed-point (Q16.16) bilinear resize. The generic kernel recomputes the
+ * source coordinates in floating point for every output pixel; here the
+ * horizontal source column and blend fraction are precomputed once per call
+ * into Q16 tables and the per-row coordinate is derived once per output row.
+ * The pixel walk itself stays scalar: tensors arrive with arbitrary byte
+ * strides, so vector gathers do not pay off. */
+#define __SW_RESIZE_MAX_W (1024)
+
+static uint16_t _sw_resize_x0[__SW_RESIZE_MAX_W];
+static uint16_t _sw_resize_fx[__SW_RESIZE_MAX_W]; /* Q0.16 blend fraction */
+
+/** Source coordinate in Q16.16, clamped to [0, (in_size - 1) << 16] */
+static int32_t _sw_resize_src_coord_q16(uint32_t out_idx, uint32_t in_size, uint32_t out_size, float scale,
+                                        coord_transf_mode ctm)
+{
+  float src;
+
+  switch (ctm)
+  {
+  case HALF_PIXEL:
+    src = (((float)out_idx + 0.5f) / scale) - 0.5f;
+    break;
+  case ASYMMETRIC:
+    src = (float)out_idx / scale;
+    break;
+  case ALIGN_CORNERS:
+    src = (out_size > 1) ? ((float)out_idx * (float)(in_size - 1)) / (float)(out_size - 1) : 0.0f;
+    break;
+  default:
+    src = 0.0f;
+    break;
+  }
+
+  int32_t q = (int32_t)lrintf(src * 65536.0f);
+  const int32_t q_max = (int32_t)((in_size - 1) << 16);
+  return (q < 0) ? 0 : ((q > q_max) ? q_max : q);
+}
+
+/** Q16 bilinear resize fast path, returns false when the node does not
+ *  match so that the caller falls back to the generic embednets kernel */
+static bool _sw_q16_resize_bilinear(const Resize_sw_info *sw_info)
+{
+  const General *general = &sw_info->general;
+  const uint32_t h_in = general->input.dim.tensor_h;
+  const uint32_t w_in = general->input.dim.tensor_w;
+  const uint32_t h_out = general->output.dim.tensor_h;
+  const uint32_t w_out = general->output.dim.tensor_w;
+  const uint32_t channels = general->input.dim.tensor_c;
+
+  if (sw_info->mode != RESIZE_LINEAR)
+    return false;
+  if ((sw_info->coord_transf_mode != HALF_PIXEL) && (sw_info->coord_transf_mode != ASYMMETRIC) &&
+      (sw_info->coord_transf_mode != ALIGN_CORNERS))
+    return false;
+  if (sw_info->exclude_outside || (sw_info->roi.mem.start_offset != NULL))
+    return false;
+  if ((general->input.dim.tensor_b != 1) || (general->output.dim.tensor_b != 1))
+    return false;
+  if ((channels == 0) || (channels != general->output.dim.tensor_c))
+    return false;
+  if ((h_in == 0) || (w_in == 0) || (h_out == 0) || (w_out == 0) || (w_out > __SW_RESIZE_MAX_W))
+    return false;
+
+  const float *scales = (const float *)sw_info->scales.mem.start_offset;
+  const float scale_h = scales[2];
+  const float scale_w = scales[3];
+  if ((scale_h <= 0.0f) || (scale_w <= 0.0f))
+    return false;
+
+  /* per-column source column and blend fraction, computed once */
+  for (uint32_t ow = 0; ow < w_out; ow++)
+  {
+    const int32_t q = _sw_resize_src_coord_q16(ow, w_in, w_out, scale_w, sw_info->coord_transf_mode);
+    _sw_resize_x0[ow] = (uint16_t)(q >> 16);
+    _sw_resize_fx[ow] = (uint16_t)(q & 0xFFFF);
+  }
+
+  const unsigned char *in_base = general->input.mem.start_offset;
+  unsigned char *out_base = general->output.mem.start_offset;
+  const uint32_t in_sh = general->input.stride.h;
+  const uint32_t in_sw = general->input.stride.w;
+  const uint32_t in_sc = general->input.stride.c;
+  const uint32_t out_sh = general->output.stride.h;
+  const uint32_t out_sw = general->output.stride.w;
+  const uint32_t out_sc = general->output.stride.c;
+
+  for (uint32_t oh = 0; oh < h_out; oh++)
+  {
+    const int32_t qy = _sw_resize_src_coord_q16(oh, h_in, h_out, scale_h, sw_info->coord_transf_mode);
+    const uint32_t y0 = (uint32_t)(qy >> 16);
+    const uint32_t y1 = ((y0 + 1) < h_in) ? (y0 + 1) : (h_in - 1);
+    const float fy = (float)(qy & 0xFFFF) * (1.0f / 65536.0f);
+
+    const unsigned char *row0 = in_base + (y0 * in_sh);
+    const unsigned char *row1 = in_base + (y1 * in_sh);
+    unsigned char *out_row = out_base + (oh * out_sh);
+
+    for (uint32_t ow = 0; ow < w_out; ow++)
+    {
+      const uint32_t x0 = _sw_resize_x0[ow];
+      const uint32_t x1 = ((x0 + 1) < w_in) ? (x0 + 1) : (w_in - 1);
+      const float fx = (float)_sw_resize_fx[ow] * (1.0f / 65536.0f);
+
+      const unsigned char *p00 = row0 + (x0 * in_sw);
+      const unsigned char *p01 = row0 + (x1 * in_sw);
+      const unsigned char *p10 = row1 + (x0 * in_sw);
+      const unsigned char *p11 = row1 + (x1 * in_sw);
+      unsigned char *out_pix = out_row + (ow * out_sw);
+
+      for (uint32_t c = 0; c < channels; c++)
+      {
+        const float v0 = *(const float *)(p00 + (c * in_sc)) +
+                         (fx * (*(const float *)(p01 + (c * in_sc)) - *(const float *)(p00 + (c * in_sc))));
+        const float v1 = *(const float *)(p10 + (c * in_sc)) +
+                         (fx * (*(const float *)(p11 + (c * in_sc)) - *(const float *)(p10 + (c * in_sc))));
+        *(float *)(out_pix + (c * out_sc)) = v0 + (fy * (v1 - v0));
+      }
+    }
+  }
+
+  return true;
+}
+
+#endif // LL_ATON_SW_USE_MVE
+
 //##########################################################################################
 /** Resize forward function */
 void ll_sw_forward_resize(/* int processor, */ void *sw_info_struct)
 {
   Resize_sw_info *sw_info = (Resize_sw_info *)sw_info_struct;
+
+#if LL_ATON_SW_USE_MVE == 1
+  if (!_sw_dispatch_is_generic(&sw_info->general))
+  {
+    if (_sw_q16_resize_bilinear(sw_info))
+      return;
+    _sw_dispatch_set_generic(&sw_info->general);
+  }
+#endif // LL_ATON_SW_USE_MVE
+
   // array init
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
                        sw_info->general.input.mem.start_offset, sw_info->general.input.dim.num_elem, )
@@ -313,12 +499,1022 @@ void ll_sw_forward_resize(/* int processor, */ void *sw_info_struct)
   }
 }
 
+//##########################################################################################
+#if LL_ATON_SW_USE_MVE == 1
+
+#if !defined(__ARM_FEATURE_MVE) || !(__ARM_FEATURE_MVE & 2)
+#error "LL_ATON_SW_USE_MVE requires a floating-point MVE enabled target (e.g. Cortex-M55 with FPU)"
+#endif
+
+#include <arm_mve.h>
+#include <math.h>
+
+/** Vectorized exp() approximation (4 x float32 lanes)
+ *  Standard range reduction on log2(e) plus a degree-5 polynomial on the
+ *  residual, 2^n applied through the exponent bits. Inputs are expected to
+ *  be <= 0 (softmax operates on x - max(x)), large negative values flush
+ *  to ~0 through the exponent clamp.
+ */
+static inline float32x4_t _sw_mve_exp_f32(float32x4_t x)
+{
+  const float32x4_t nf = vcvtq_f32_s32(vcvtnq_s32_f32(vmulq_n_f32(x, 1.44269504088896341f)));
+
+  /* two-part ln(2) to keep the residual accurate */
+  float32x4_t r = vfmaq_n_f32(x, nf, -0.693359375f);
+  r = vfmaq_n_f32(r, nf, 2.12194440e-4f);
+
+  /* p(r) ~= exp(r) = 1 + r + r^2*poly(r), |r| <= ln(2)/2 */
+  float32x4_t p = vdupq_n_f32(1.9875691500e-4f);
+  p = vfmaq_f32(vdupq_n_f32(1.3981999507e-3f), p, r);
+  p = vfmaq_f32(vdupq_n_f32(8.3334519073e-3f), p, r);
+  p = vfmaq_f32(vdupq_n_f32(4.1665795894e-2f), p, r);
+  p = vfmaq_f32(vdupq_n_f32(1.6666665459e-1f), p, r);
+  p = vfmaq_f32(vdupq_n_f32(5.0000001201e-1f), p, r);
+  p = vfmaq_f32(vaddq_f32(vdupq_n_f32(1.0f), r), vmulq_f32(r, r), p);
+
+  /* scale by 2^n, n clamped to the normalized exponent range */
+  int32x4_t n = vcvtnq_s32_f32(nf);
+  n = vmaxq_s32(n, vdupq_n_s32(-126));
+  n = vminq_s32(n, vdupq_n_s32(127));
+  const float32x4_t pow2n = vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(n, vdupq_n_s32(127)), 23));
+
+  return vmulq_f32(p, pow2n);
+}
+
+/** Softmax over one contiguous row of floats (max-reduce, exp, normalize) */
+static void _sw_mve_softmax_row(const float *in, float *out, uint32_t len)
+{
+  uint32_t i;
+  float vmax = in[0];
+  float sum = 0.0f;
+
+  for (i = 0; (i + 4) <= len; i += 4)
+    vmax = vmaxnmvq_f32(vmax, vld1q_f32(&in[i]));
+  for (; i < len; i++)
+    vmax = (in[i] > vmax) ? in[i] : vmax;
+
+  float32x4_t vsum = vdupq_n_f32(0.0f);
+  for (i = 0; (i + 4) <= len; i += 4)
+  {
+    const float32x4_t e = _sw_mve_exp_f32(vsubq_n_f32(vld1q_f32(&in[i]), vmax));
+    vst1q_f32(&out[i], e);
+    vsum = vaddq_f32(vsum, e);
+  }
+  sum = vgetq_lane_f32(vsum, 0) + vgetq_lane_f32(vsum, 1) + vgetq_lane_f32(vsum, 2) + vgetq_lane_f32(vsum, 3);
+  for (; i < len; i++)
+  {
+    const float e = expf(in[i] - vmax);
+    out[i] = e;
+    sum += e;
+  }
+
+  const float inv_sum = 1.0f / sum;
+  for (i = 0; (i + 4) <= len; i += 4)
+    vst1q_f32(&out[i], vmulq_n_f32(vld1q_f32(&out[i]), inv_sum));
+  for (; i < len; i++)
+    out[i] *= inv_sum;
+}
+
+/** Number of elements along the (ONNX) softmax axis */
+static uint32_t _sw_softmax_axis_num_elem(const Softmax_sw_info *sw_info)
+{
+  switch (sw_info->axis)
+  {
+  case 0:
+    return sw_info->general.input.dim.tensor_b;
+  case 1:
+    return sw_info->general.input.dim.tensor_c;
+  case 2:
+    return sw_info->general.input.dim.tensor_h;
+  case 3:
+    return sw_info->general.input.dim.tensor_w;
+  default:
+    return 0;
+  }
+}
+
+/* Lookup tables for the bounded transcendental activations. 1024 linear
+ * interpolation segments over [-8, 8] (one extra entry for the upper
+ * segment bound) keep the error below ~1e-5 while replacing one libm call
+ * per element with a gather and an FMA. Built once on first use. */
+#define __SW_LUT_BITS (10)
+#define __SW_LUT_SIZE (1 << __SW_LUT_BITS)
+#define __SW_LUT_XMAX (8.0f)
+
+static float _sw_lut_sigmoid[__SW_LUT_SIZE + 1];
+static float _sw_lut_tanh[__SW_LUT_SIZE + 1];
+static bool _sw_lut_init_done = false;
+
+static void _sw_lut_init(void)
+{
+  for (uint32_t i = 0; i <= __SW_LUT_SIZE; i++)
+  {
+    const float x = -__SW_LUT_XMAX + ((2.0f * __SW_LUT_XMAX * (float)i) / (float)__SW_LUT_SIZE);
+    _sw_lut_sigmoid[i] = 1.0f / (1.0f + expf(-x));
+    _sw_lut_tanh[i] = tanhf(x);
+  }
+  _sw_lut_init_done = true;
+}
+
+/** Interpolated table lookup with Helium gathers, one contiguous row.
+ *  Inputs beyond [-8, 8] clamp to the saturated table ends. */
+static void _sw_mve_lut_activ(const float *in, float *out, uint32_t len, const float *lut)
+{
+  const float pos_scale = ((float)__SW_LUT_SIZE / (2.0f * __SW_LUT_XMAX));
+  const float32x4_t vmax_pos = vdupq_n_f32((float)__SW_LUT_SIZE - 1.0f);
+  const float32x4_t vzero = vdupq_n_f32(0.0f);
+  uint32_t i;
+
+  for (i = 0; (i + 4) <= len; i += 4)
+  {
+    /* table position, clamped to [0, SIZE - 1] (segment `SIZE - 1` may read
+       entry `SIZE`, which is the extra upper bound entry) */
+    float32x4_t pos = vmulq_n_f32(vaddq_n_f32(vld1q_f32(&in[i]), __SW_LUT_XMAX), pos_scale);
+    pos = vminnmq_f32(vmaxnmq_f32(pos, vzero), vmax_pos);
+
+    const int32x4_t idx = vcvtq_s32_f32(pos); /* truncation == floor, pos >= 0 */
+    const float32x4_t frac = vsubq_f32(pos, vcvtq_f32_s32(idx));
+
+    const float32x4_t t0 = vldrwq_gather_shifted_offset_f32(lut, vreinterpretq_u32_s32(idx));
+    const float32x4_t t1 = vldrwq_gather_shifted_offset_f32(&lut[1], vreinterpretq_u32_s32(idx));
+
+    vst1q_f32(&out[i], vfmaq_f32(t0, vsubq_f32(t1, t0), frac));
+  }
+  for (; i < len; i++)
+  {
+    float pos = (in[i] + __SW_LUT_XMAX) * pos_scale;
+    pos = (pos < 0.0f) ? 0.0f : ((pos > ((float)__SW_LUT_SIZE - 1.0f)) ? ((float)__SW_LUT_SIZE - 1.0f) : pos);
+    const uint32_t idx = (uint32_t)pos;
+    out[i] = lut[idx] + ((lut[idx + 1] - lut[idx]) * (pos - (float)idx));
+  }
+}
+
+/** HardSwish needs no table: y = x * clamp(x / 6 + 0.5, 0, 1) */
+static void _sw_mve_hard_swish(const float *in, float *out, uint32_t len)
+{
+  const float32x4_t vone = vdupq_n_f32(1.0f);
+  const float32x4_t vzero = vdupq_n_f32(0.0f);
+  uint32_t i;
+
+  for (i = 0; (i + 4) <= len; i += 4)
+  {
+    const float32x4_t x = vld1q_f32(&in[i]);
+    float32x4_t gate = vfmaq_n_f32(vdupq_n_f32(0.5f), x, (1.0f / 6.0f));
+    gate = vminnmq_f32(vmaxnmq_f32(gate, vzero), vone);
+    vst1q_f32(&out[i], vmulq_f32(x, gate));
+  }
+  for (; i < len; i++)
+  {
+    float gate = (in[i] * (1.0f / 6.0f)) + 0.5f;
+    gate = (gate < 0.0f) ? 0.0f : ((gate > 1.0f) ? 1.0f : gate);
+    out[i] = in[i] * gate;
+  }
+}
+
+/** LUT/Helium fast path for the bounded activations on contiguous float
+ *  tensors. Returns false when the node type has no table so that the
+ *  caller falls back to the generic embednets kernel. */
+static bool _sw_lut_activ(const Activ_sw_info *sw_info)
+{
+  const float *in = (const float *)sw_info->general.input.mem.start_offset;
+  float *out = (float *)sw_info->general.output.mem.start_offset;
+  const uint32_t len = sw_info->general.input.dim.num_elem;
+
+  if (len != sw_info->general.output.dim.num_elem)
+    return false;
+
+  switch (sw_info->general.type)
+  {
+  case LL_SW_SIGMOID:
+    if (!_sw_lut_init_done)
+      _sw_lut_init();
+    _sw_mve_lut_activ(in, out, len, _sw_lut_sigmoid);
+    return true;
+  case LL_SW_TANH:
+    if (!_sw_lut_init_done)
+      _sw_lut_init();
+    _sw_mve_lut_activ(in, out, len, _sw_lut_tanh);
+    return true;
+  case LL_SW_HARDSWISH:
+    _sw_mve_hard_swish(in, out, len);
+    return true;
+  default:
+    return false;
+  }
+}
+
+/* Broadcast-aware elementwise arithmetic. The generic eltwise kernel
+ * performs full index arithmetic per element even for the common residual
+ * shapes; here the broadcast pattern is classified once per epoch and the
+ * inner loops are plain vector streams. */
+typedef enum
+{
+  _SW_ARITH_ADD,
+  _SW_ARITH_SUB,
+  _SW_ARITH_MUL
+} _sw_arith_op;
+
+/** y[i] = a[i] <op> b[i] over one contiguous row */
+static void _sw_mve_arith_rows(const float *a, const float *b, float *y, uint32_t len, _sw_arith_op aop)
+{
+  uint32_t i = 0;
+
+  switch (aop)
+  {
+  case _SW_ARITH_ADD:
+    for (; (i + 4) <= len; i += 4)
+      vst1q_f32(&y[i], vaddq_f32(vld1q_f32(&a[i]), vld1q_f32(&b[i])));
+    for (; i < len; i++)
+      y[i] = a[i] + b[i];
+    break;
+  case _SW_ARITH_SUB:
+    for (; (i + 4) <= len; i += 4)
+      vst1q_f32(&y[i], vsubq_f32(vld1q_f32(&a[i]), vld1q_f32(&b[i])));
+    for (; i < len; i++)
+      y[i] = a[i] - b[i];
+    break;
+  case _SW_ARITH_MUL:
+    for (; (i + 4) <= len; i += 4)
+      vst1q_f32(&y[i], vmulq_f32(vld1q_f32(&a[i]), vld1q_f32(&b[i])));
+    for (; i < len; i++)
+      y[i] = a[i] * b[i];
+    break;
+  }
+}
+
+/** y[i] = a[i] <op> b_val (scalar broadcast) */
+static void _sw_mve_arith_scalar(const float *a, float b_val, float *y, uint32_t len, _sw_arith_op aop)
+{
+  uint32_t i = 0;
+
+  switch (aop)
+  {
+  case _SW_ARITH_ADD:
+    for (; (i + 4) <= len; i += 4)
+      vst1q_f32(&y[i], vaddq_n_f32(vld1q_f32(&a[i]), b_val));
+    for (; i < len; i++)
+      y[i] = a[i] + b_val;
+    break;
+  case _SW_ARITH_SUB:
+    for (; (i + 4) <= len; i += 4)
+      vst1q_f32(&y[i], vsubq_n_f32(vld1q_f32(&a[i]), b_val));
+    for (; i < len; i++)
+      y[i] = a[i] - b_val;
+    break;
+  case _SW_ARITH_MUL:
+    for (; (i + 4) <= len; i += 4)
+      vst1q_f32(&y[i], vmulq_n_f32(vld1q_f32(&a[i]), b_val));
+    for (; i < len; i++)
+      y[i] = a[i] * b_val;
+    break;
+  }
+}
+
+/** Helium fast path for the two-input arithmetic shapes (contiguous,
+ *  scalar broadcast, per-channel broadcast on channel-innermost data).
+ *  Returns false when the node does not match so that the caller falls
+ *  back to the generic embednets kernel. */
+static bool _sw_mve_arith(const Arith_sw_info *sw_info)
+{
+  const uint32_t len = sw_info->general.input.dim.num_elem;
+  const uint32_t op_len = sw_info->operand.dim.num_elem;
+  _sw_arith_op aop;
+
+  if (sw_info->num_of_inputs != 2)
+    return false;
+  if ((len == 0) || (sw_info->general.output.dim.num_elem != len))
+    return false;
+
+  switch (sw_info->general.type)
+  {
+  case LL_SW_ARITHADD:
+  case LL_SW_ARITHSUM:
+    aop = _SW_ARITH_ADD;
+    break;
+  case LL_SW_ARITHSUB:
+    aop = _SW_ARITH_SUB;
+    break;
+  case LL_SW_ARITHMUL:
+    aop = _SW_ARITH_MUL;
+    break;
+  default:
+    return false;
+  }
+
+  const float *a = (const float *)sw_info->general.input.mem.start_offset;
+  const float *b = (const float *)sw_info->operand.mem.start_offset;
+  float *y = (float *)sw_info->general.output.mem.start_offset;
+
+  if (op_len == len)
+  { /* same shape, one contiguous stream (residual add) */
+    _sw_mve_arith_rows(a, b, y, len, aop);
+    return true;
+  }
+
+  if (op_len == 1)
+  { /* scalar broadcast */
+    _sw_mve_arith_scalar(a, b[0], y, len, aop);
+    return true;
+  }
+
+  if ((op_len == sw_info->general.input.dim.tensor_c) && ((len % op_len) == 0))
+  { /* per-channel broadcast, channels innermost: the operand repeats
+       every `op_len` contiguous elements */
+    for (uint32_t off = 0; off < len; off += op_len)
+      _sw_mve_arith_rows(&a[off], b, &y[off], op_len, aop);
+    return true;
+  }
+
+  return false;
+}
+
+/* Half-precision (FP16) variants of the memory-bound fast paths. The
+ * generated descriptors carry no element type, so the byte strides are the
+ * only type evidence available: a dense FP16 tensor has a channel stride of
+ * 2 bytes where FP32 data always has 4. The FP16 paths therefore engage
+ * only when the tensors are dense with 2-byte strides, which FP32 data can
+ * never match, and halve the load/store traffic through the CM55 caches
+ * (8 lanes per vector op instead of 4). */
+
+/** true iff `t` is dense FP16 in (h, w, c) memory order with c innermost */
+static bool _sw_is_dense_f16(const Tensor_info *t)
+{
+  const uint32_t ch = t->dim.tensor_c;
+  const uint32_t w = t->dim.tensor_w;
+
+  if (t->stride.c != 2)
+    return false;
+  if (t->stride.w != (ch * 2))
+    return false;
+  if (t->stride.h != (ch * w * 2))
+    return false;
+  if (t->dim.num_elem != (t->dim.tensor_b * ch * t->dim.tensor_h * w))
+    return false;
+
+  return true;
+}
+
+/** y[i] = a[i] <op> b[i] over one contiguous FP16 row */
+static void _sw_mve_arith_rows_f16(const float16_t *a, const float16_t *b, float16_t *y, uint32_t len,
+                                   _sw_arith_op aop)
+{
+  uint32_t i = 0;
+
+  switch (aop)
+  {
+  case _SW_ARITH_ADD:
+    for (; (i + 8) <= len; i += 8)
+      vst1q_f16(&y[i], vaddq_f16(vld1q_f16(&a[i]), vld1q_f16(&b[i])));
+    for (; i < len; i++)
+      y[i] = a[i] + b[i];
+    break;
+  case _SW_ARITH_SUB:
+    for (; (i + 8) <= len; i += 8)
+      vst1q_f16(&y[i], vsubq_f16(vld1q_f16(&a[i]), vld1q_f16(&b[i])));
+    for (; i < len; i++)
+      y[i] = a[i] - b[i];
+    break;
+  case _SW_ARITH_MUL:
+    for (; (i + 8) <= len; i += 8)
+      vst1q_f16(&y[i], vmulq_f16(vld1q_f16(&a[i]), vld1q_f16(&b[i])));
+    for (; i < len; i++)
+      y[i] = a[i] * b[i];
+    break;
+  }
+}
+
+/** y[i] = a[i] <op> b_val (FP16 scalar broadcast) */
+static void _sw_mve_arith_scalar_f16(const float16_t *a, float16_t b_val, float16_t *y, uint32_t len,
+                                     _sw_arith_op aop)
+{
+  uint32_t i = 0;
+
+  switch (aop)
+  {
+  case _SW_ARITH_ADD:
+    for (; (i + 8) <= len; i += 8)
+      vst1q_f16(&y[i], vaddq_n_f16(vld1q_f16(&a[i]), b_val));
+    for (; i < len; i++)
+      y[i] = a[i] + b_val;
+    break;
+  case _SW_ARITH_SUB:
+    for (; (i + 8) <= len; i += 8)
+      vst1q_f16(&y[i], vsubq_n_f16(vld1q_f16(&a[i]), b_val));
+    for (; i < len; i++)
+      y[i] = a[i] - b_val;
+    break;
+  case _SW_ARITH_MUL:
+    for (; (i + 8) <= len; i += 8)
+      vst1q_f16(&y[i], vmulq_n_f16(vld1q_f16(&a[i]), b_val));
+    for (; i < len; i++)
+      y[i] = a[i] * b_val;
+    break;
+  }
+}
+
+/** FP16 twin of `_sw_mve_arith`, same broadcast classification */
+static bool _sw_mve_arith_f16(const Arith_sw_info *sw_info)
+{
+  const uint32_t len = sw_info->general.input.dim.num_elem;
+  const uint32_t op_len = sw_info->operand.dim.num_elem;
+  _sw_arith_op aop;
+
+  if (sw_info->num_of_inputs != 2)
+    return false;
+  if ((len == 0) || (sw_info->general.output.dim.num_elem != len))
+    return false;
+  if (!_sw_is_dense_f16(&sw_info->general.input) || !_sw_is_dense_f16(&sw_info->general.output))
+    return false;
+
+  switch (sw_info->general.type)
+  {
+  case LL_SW_ARITHADD:
+  case LL_SW_ARITHSUM:
+    aop = _SW_ARITH_ADD;
+    break;
+  case LL_SW_ARITHSUB:
+    aop = _SW_ARITH_SUB;
+    break;
+  case LL_SW_ARITHMUL:
+    aop = _SW_ARITH_MUL;
+    break;
+  default:
+    return false;
+  }
+
+  const float16_t *a = (const float16_t *)sw_info->general.input.mem.start_offset;
+  const float16_t *b = (const float16_t *)sw_info->operand.mem.start_offset;
+  float16_t *y = (float16_t *)sw_info->general.output.mem.start_offset;
+
+  if (op_len == len)
+  { /* same shape, one contiguous stream (residual add) */
+    if (!_sw_is_dense_f16(&sw_info->operand))
+      return false;
+    _sw_mve_arith_rows_f16(a, b, y, len, aop);
+    return true;
+  }
+
+  if (op_len == 1)
+  { /* scalar broadcast */
+    _sw_mve_arith_scalar_f16(a, b[0], y, len, aop);
+    return true;
+  }
+
+  if ((op_len == sw_info->general.input.dim.tensor_c) && ((len % op_len) == 0))
+  { /* per-channel broadcast, channels innermost */
+    for (uint32_t off = 0; off < len; off += op_len)
+      _sw_mve_arith_rows_f16(&a[off], b, &y[off], op_len, aop);
+    return true;
+  }
+
+  return false;
+}
+
+/** Softmax over one contiguous row of FP16 values. Loads and stores stay
+ *  half precision; the exponentials and the sum are computed in FP32
+ *  through the widening converts so the accuracy of the FP32 path is kept. */
+static void _sw_mve_softmax_row_f16(const float16_t *in, float16_t *out, uint32_t len)
+{
+  uint32_t i;
+  float16_t vmax16 = in[0];
+  float sum = 0.0f;
+
+  for (i = 0; (i + 8) <= len; i += 8)
+    vmax16 = vmaxnmvq_f16(vmax16, vld1q_f16(&in[i]));
+  for (; i < len; i++)
+    vmax16 = (in[i] > vmax16) ? in[i] : vmax16;
+  const float vmax = (float)vmax16;
+
+  float32x4_t vsum = vdupq_n_f32(0.0f);
+  for (i = 0; (i + 8) <= len; i += 8)
+  {
+    const float16x8_t v = vld1q_f16(&in[i]);
+    const float32x4_t e_b = _sw_mve_exp_f32(vsubq_n_f32(vcvtbq_f32_f16(v), vmax));
+    const float32x4_t e_t = _sw_mve_exp_f32(vsubq_n_f32(vcvttq_f32_f16(v), vmax));
+    float16x8_t e = vcvtbq_f16_f32(vdupq_n_f16((float16_t)0.0f), e_b);
+    e = vcvttq_f16_f32(e, e_t);
+    vst1q_f16(&out[i], e);
+    vsum = vaddq_f32(vsum, vaddq_f32(e_b, e_t));
+  }
+  sum = vgetq_lane_f32(vsum, 0) + vgetq_lane_f32(vsum, 1) + vgetq_lane_f32(vsum, 2) + vgetq_lane_f32(vsum, 3);
+  for (; i < len; i++)
+  {
+    const float e = expf((float)in[i] - vmax);
+    out[i] = (float16_t)e;
+    sum += e;
+  }
+
+  const float16_t inv_sum = (float16_t)(1.0f / sum);
+  for (i = 0; (i + 8) <= len; i += 8)
+    vst1q_f16(&out[i], vmulq_n_f16(vld1q_f16(&out[i]), inv_sum));
+  for (; i < len; i++)
+    out[i] = out[i] * inv_sum;
+}
+
+/* Sum or max `nptr` input rows of `ch` contiguous floats into `out`,
+ * 4 channels per vector op. Used as the window kernel for the
+ * specialized pooling geometries below (`nptr` = kernel_h * kernel_w). */
+static void _sw_mve_pool_window(const float *const *rows, uint32_t nptr, uint32_t ch, float *out, bool is_max,
+                                float inv_area)
+{
+  uint32_t c = 0;
+
+  for (; (c + 4) <= ch; c += 4)
+  {
+    float32x4_t acc = vld1q_f32(&rows[0][c]);
+    for (uint32_t p = 1; p < nptr; p++)
+    {
+      float32x4_t v = vld1q_f32(&rows[p][c]);
+      acc = is_max ? vmaxnmq_f32(acc, v) : vaddq_f32(acc, v);
+    }
+    if (!is_max)
+      acc = vmulq_n_f32(acc, inv_area);
+    vst1q_f32(&out[c], acc);
+  }
+
+  for (; c < ch; c++)
+  {
+    float acc = rows[0][c];
+    for (uint32_t p = 1; p < nptr; p++)
+      acc = is_max ? fmaxf(acc, rows[p][c]) : (acc + rows[p][c]);
+    out[c] = is_max ? acc : (acc * inv_area);
+  }
+}
+
+/* Specialized max/average pooling for the common small geometries
+ * (2x2/s2 and 3x3/s2, no padding) on dense channel-innermost data.
+ * Padded or exotic windows keep the generic embednets kernel. */
+static bool _sw_mve_pool(const Pool_sw_info *sw_info)
+{
+  const Tensor_info *in = &sw_info->general.input;
+  const Tensor_info *out = &sw_info->general.output;
+  const long int k = sw_info->k_shape[0];
+  bool is_max;
+
+  switch (sw_info->general.type)
+  {
+  case LL_SW_MAXPOOL:
+    is_max = true;
+    break;
+  case LL_SW_AVGPOOL:
+    is_max = false;
+    break;
+  default:
+    return false;
+  }
+
+  /* supported geometries: square 2x2 or 3x3 window, stride 2, no padding */
+  if (((k != 2) && (k != 3)) || (sw_info->k_shape[1] != k))
+    return false;
+  if ((sw_info->strides[0] != 2) || (sw_info->strides[1] != 2))
+    return false;
+  if ((sw_info->pads[0] != 0) || (sw_info->pads[1] != 0) || (sw_info->pads[2] != 0) || (sw_info->pads[3] != 0))
+    return false;
+
+  const uint32_t ch = in->dim.tensor_c;
+  const uint32_t w_in = in->dim.tensor_w;
+  const uint32_t h_out = out->dim.tensor_h;
+  const uint32_t w_out = out->dim.tensor_w;
+
+  if ((in->dim.tensor_b != 1) || (out->dim.tensor_b != 1) || (out->dim.tensor_c != ch) || (ch == 0))
+    return false;
+  if ((h_out == 0) || (w_out == 0) || (((h_out - 1) * 2 + k) > in->dim.tensor_h) || (((w_out - 1) * 2 + k) > w_in))
+    return false;
+  /* dense channel-innermost layout on both sides (byte strides) */
+  if ((in->stride.c != sizeof(float)) || (in->stride.w != (ch * sizeof(float))) ||
+      (in->stride.h != (ch * w_in * sizeof(float))))
+    return false;
+  if ((out->stride.c != sizeof(float)) || (out->stride.w != (ch * sizeof(float))) ||
+      (out->stride.h != (ch * w_out * sizeof(float))))
+    return false;
+
+  const float *x = (const float *)in->mem.start_offset;
+  float *y = (float *)out->mem.start_offset;
+  const float inv_area = 1.0f / (float)(k * k);
+  const float *rows[9];
+
+  for (uint32_t oh = 0; oh < h_out; oh++)
+  {
+    for (uint32_t ow = 0; ow < w_out; ow++)
+    {
+      uint32_t nptr = 0;
+      for (long int kh = 0; kh < k; kh++)
+      {
+        const float *row = &x[(((oh * 2) + kh) * w_in + (ow * 2)) * ch];
+        for (long int kw = 0; kw < k; kw++)
+          rows[nptr++] = &row[kw * ch];
+      }
+      _sw_mve_pool_window(rows, nptr, ch, &y[(oh * w_out + ow) * ch], is_max, inv_area);
+    }
+  }
+
+  return true;
+}
+
+/* Global average pooling over the full feature map, vectorized across
+ * channels. This is the guaranteed software epoch in front of every
+ * classifier head, so it gets its own reduction loop. */
+static bool _sw_mve_global_avgpool(const Global_pool_sw_info *sw_info)
+{
+  const Tensor_info *in = &sw_info->general.input;
+  const Tensor_info *out = &sw_info->general.output;
+
+  if (sw_info->general.type != LL_SW_AVGPOOL)
+    return false;
+
+  const uint32_t ch = in->dim.tensor_c;
+  const uint32_t pixels = in->dim.tensor_h * in->dim.tensor_w;
+
+  if ((ch == 0) || (pixels == 0) || (in->dim.tensor_b != 1))
+    return false;
+  if ((out->dim.tensor_h != 1) || (out->dim.tensor_w != 1) || (out->dim.tensor_c != ch) || (out->dim.tensor_b != 1))
+    return false;
+  /* dense channel-innermost input, contiguous channel vector out */
+  if ((in->stride.c != sizeof(float)) || (in->stride.w != (ch * sizeof(float))) ||
+      (in->dim.num_elem != (pixels * ch)) || (out->stride.c != sizeof(float)))
+    return false;
+
+  const float *x = (const float *)in->mem.start_offset;
+  float *y = (float *)out->mem.start_offset;
+  const float inv_area = 1.0f / (float)pixels;
+  uint32_t c = 0;
+
+  for (; (c + 4) <= ch; c += 4)
+  {
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    for (uint32_t p = 0; p < pixels; p++)
+      acc = vaddq_f32(acc, vld1q_f32(&x[(p * ch) + c]));
+    vst1q_f32(&y[c], vmulq_n_f32(acc, inv_area));
+  }
+
+  for (; c < ch; c++)
+  {
+    float acc = 0.0f;
+    for (uint32_t p = 0; p < pixels; p++)
+      acc += x[(p * ch) + c];
+    y[c] = acc * inv_area;
+  }
+
+  return true;
+}
+
+/* Tree reduction over one contiguous row: two independent vector
+ * accumulators hide the add latency, folded into one lane sum at the
+ * end. Max reduces through the cross-lane vmaxnmvq directly. */
+static float _sw_mve_reduce_row(const float *in, uint32_t n, bool is_max)
+{
+  uint32_t i = 0;
+
+  if (is_max)
+  {
+    float m = in[0];
+    for (; (i + 4) <= n; i += 4)
+      m = vmaxnmvq_f32(m, vld1q_f32(&in[i]));
+    for (; i < n; i++)
+      m = fmaxf(m, in[i]);
+    return m;
+  }
+
+  float32x4_t acc0 = vdupq_n_f32(0.0f);
+  float32x4_t acc1 = vdupq_n_f32(0.0f);
+  for (; (i + 8) <= n; i += 8)
+  {
+    acc0 = vaddq_f32(acc0, vld1q_f32(&in[i]));
+    acc1 = vaddq_f32(acc1, vld1q_f32(&in[i + 4]));
+  }
+  for (; (i + 4) <= n; i += 4)
+    acc0 = vaddq_f32(acc0, vld1q_f32(&in[i]));
+  acc0 = vaddq_f32(acc0, acc1);
+
+  float s = vgetq_lane_f32(acc0, 0) + vgetq_lane_f32(acc0, 1) + vgetq_lane_f32(acc0, 2) + vgetq_lane_f32(acc0, 3);
+  for (; i < n; i++)
+    s += in[i];
+  return s;
+}
+
+/** Elementwise fold of one input slice into the output stripe. This is the
+ *  transposed walk for the outer-axis reductions: instead of gathering the
+ *  reduced axis per output element, whole contiguous slices stream into
+ *  the (cache-resident) output, so both sides stay sequential. */
+static void _sw_mve_reduce_stripe(const float *in, float *acc, uint32_t len, bool is_max)
+{
+  uint32_t i = 0;
+
+  for (; (i + 4) <= len; i += 4)
+  {
+    const float32x4_t v = vld1q_f32(&in[i]);
+    const float32x4_t a = vld1q_f32(&acc[i]);
+    vst1q_f32(&acc[i], is_max ? vmaxnmq_f32(a, v) : vaddq_f32(a, v));
+  }
+  for (; i < len; i++)
+    acc[i] = is_max ? fmaxf(acc[i], in[i]) : (acc[i] + in[i]);
+}
+
+/** Dense channel-innermost layout (byte strides), h/w/c fully packed */
+static bool _sw_reduce_is_dense(const Tensor_info *t)
+{
+  const uint32_t ch = t->dim.tensor_c;
+
+  return (t->stride.c == sizeof(float)) && (t->stride.w == (ch * sizeof(float))) &&
+         (t->stride.h == (ch * t->dim.tensor_w * sizeof(float))) &&
+         (t->dim.num_elem == (t->dim.tensor_b * ch * t->dim.tensor_h * t->dim.tensor_w));
+}
+
+/** Helium fast path for the single-axis sum/mean/max reductions on dense
+ *  channel-innermost float tensors (batch 1). The innermost (channel)
+ *  axis reduces row-wise with a vector tree reduction, one contiguous row
+ *  per output element; the outer axes accumulate whole contiguous slices
+ *  into the output stripe. Other ops, axes or layouts keep the generic
+ *  embednets kernel. */
+static bool _sw_mve_reduce(const Reduce_sw_info *sw_info)
+{
+  const Tensor_info *in = &sw_info->general.input;
+  const Tensor_info *out = &sw_info->general.output;
+  bool is_max = false;
+  bool is_mean = false;
+
+  switch (sw_info->general.type)
+  {
+  case LL_SW_REDUCESUM:
+    break;
+  case LL_SW_REDUCEMEAN:
+    is_mean = true;
+    break;
+  case LL_SW_REDUCEMAX:
+    is_max = true;
+    break;
+  default:
+    return false;
+  }
+
+  if ((in->dim.tensor_b != 1) || (out->dim.tensor_b != 1))
+    return false;
+  if (!_sw_reduce_is_dense(in) || !_sw_reduce_is_dense(out))
+    return false;
+
+  const uint32_t c = in->dim.tensor_c;
+  const uint32_t h = in->dim.tensor_h;
+  const uint32_t w = in->dim.tensor_w;
+  uint32_t n; /* reduced axis length */
+
+  switch (sw_info->axis) /* ONNX axis: 0 = b, 1 = c, 2 = h, 3 = w */
+  {
+  case 1:
+    n = c;
+    break;
+  case 2:
+    n = h;
+    break;
+  case 3:
+    n = w;
+    break;
+  default:
+    return false;
+  }
+  if ((n == 0) || ((out->dim.num_elem * n) != in->dim.num_elem))
+    return false;
+
+  const float *x = (const float *)in->mem.start_offset;
+  float *y = (float *)out->mem.start_offset;
+  const float inv_n = 1.0f / (float)n;
+
+  if (sw_info->axis == 1)
+  { /* innermost axis: one contiguous row per output element */
+    const uint32_t rows = in->dim.num_elem / n;
+    for (uint32_t r = 0; r < rows; r++)
+    {
+      const float v = _sw_mve_reduce_row(&x[r * n], n, is_max);
+      y[r] = is_mean ? (v * inv_n) : v;
+    }
+    return true;
+  }
+
+  /* outer axis: fold `n` contiguous input slices into each output stripe */
+  const uint32_t stripe = (sw_info->axis == 2) ? (w * c) : c;
+  const uint32_t outer = (sw_info->axis == 2) ? 1U : h;
+
+  for (uint32_t o = 0; o < outer; o++)
+  {
+    const float *xo = &x[o * n * stripe];
+    float *yo = &y[o * stripe];
+
+    uint32_t j = 0;
+    for (; (j + 4) <= stripe; j += 4)
+      vst1q_f32(&yo[j], vld1q_f32(&xo[j]));
+    for (; j < stripe; j++)
+      yo[j] = xo[j];
+    for (uint32_t k = 1; k < n; k++)
+      _sw_mve_reduce_stripe(&xo[k * stripe], yo, stripe, is_max);
+
+    if (is_mean)
+    {
+      uint32_t i = 0;
+      for (; (i + 4) <= stripe; i += 4)
+        vst1q_f32(&yo[i], vmulq_n_f32(vld1q_f32(&yo[i]), inv_n));
+      for (; i < stripe; i++)
+        yo[i] *= inv_n;
+    }
+  }
+
+  return true;
+}
+
+/* Fused batch-norm scale/bias. The affine form of the normalization is
+ * folded once per call into per-channel multiplier/offset vectors
+ * (a = scale / sqrt(var + eps), b = bias - mean * a), turning the
+ * per-element mean/var/scale/bias math into a single FMA streamed over
+ * the channel-innermost rows. */
+#define __SW_BN_MAX_CH (1024)
+
+static float _sw_bn_mult[__SW_BN_MAX_CH];
+static float _sw_bn_off[__SW_BN_MAX_CH];
+
+static bool _sw_mve_bn(const Bn_sw_info *sw_info)
+{
+  const Tensor_info *in = &sw_info->general.input;
+  const Tensor_info *out = &sw_info->general.output;
+  const uint32_t ch = in->dim.tensor_c;
+  const uint32_t len = in->dim.num_elem;
+
+  if ((ch == 0) || (ch > __SW_BN_MAX_CH) || ((len % ch) != 0) || (out->dim.num_elem != len))
+    return false;
+  if (!_sw_reduce_is_dense(in) || !_sw_reduce_is_dense(out))
+    return false;
+  /* one parameter per channel on all four vectors */
+  if ((sw_info->scale.dim.num_elem != ch) || (sw_info->bias.dim.num_elem != ch) ||
+      (sw_info->mean.dim.num_elem != ch) || (sw_info->var.dim.num_elem != ch))
+    return false;
+
+  const float *x = (const float *)in->mem.start_offset;
+  float *y = (float *)out->mem.start_offset;
+  const float *scale = (const float *)sw_info->scale.mem.start_offset;
+  const float *bias = (const float *)sw_info->bias.mem.start_offset;
+  const float *mean = (const float *)sw_info->mean.mem.start_offset;
+  const float *var = (const float *)sw_info->var.mem.start_offset;
+  const float epsilon = 0.00001f; /* same constant as the generic kernel */
+
+  for (uint32_t c = 0; c < ch; c++)
+  {
+    const float a = scale[c] / sqrtf(var[c] + epsilon);
+    _sw_bn_mult[c] = a;
+    _sw_bn_off[c] = bias[c] - (mean[c] * a);
+  }
+
+  for (uint32_t i = 0; i < len; i += ch)
+  {
+    uint32_t c = 0;
+    for (; (c + 4) <= ch; c += 4)
+      vst1q_f32(&y[i + c], vfmaq_f32(vld1q_f32(&_sw_bn_off[c]), vld1q_f32(&x[i + c]), vld1q_f32(&_sw_bn_mult[c])));
+    for (; c < ch; c++)
+      y[i + c] = (x[i + c] * _sw_bn_mult[c]) + _sw_bn_off[c];
+  }
+
+  return true;
+}
+
+/* Gather with a precomputed offset table. The index tensor is constant
+ * across inferences in the embedding-style models, so the indices x
+ * strides arithmetic is resolved once into an element-offset table and
+ * the inner loop just streams table entries (Helium gather loads for
+ * the per-element innermost-axis form). The table is revalidated by a
+ * cheap XOR signature of the index contents so that dynamic indices
+ * stay correct - one sequential pass instead of the full rebuild. */
+#define __SW_GATHER_MAX_IDX (2048)
+
+static uint32_t _sw_gather_offs[__SW_GATHER_MAX_IDX];
+static const void *_sw_gather_key; /* indices buffer identity */
+static uint32_t _sw_gather_n;
+static uint32_t _sw_gather_slice;
+static uint32_t _sw_gather_sig;
+
+static bool _sw_mve_gather(const Gather_sw_info *sw_info)
+{
+  const Tensor_info *in = &sw_info->general.input;
+  const Tensor_info *out = &sw_info->general.output;
+  const uint32_t n_idx = sw_info->operand.dim.num_elem;
+  const int32_t *idx = (const int32_t *)sw_info->operand.mem.start_offset;
+
+  if ((n_idx == 0) || (n_idx > __SW_GATHER_MAX_IDX))
+    return false;
+  if ((in->dim.tensor_b != 1) || (out->dim.tensor_b != 1))
+    return false;
+  if (!_sw_reduce_is_dense(in) || !_sw_reduce_is_dense(out))
+    return false;
+
+  /* memory order is (h, w, c) with c innermost: the gather axis fixes the
+     contiguous slice selected per index */
+  uint32_t slice;    /* elements copied per index */
+  uint32_t outer;    /* independent gather repetitions */
+  uint32_t axis_len; /* valid index range */
+
+  switch (sw_info->axis) /* ONNX axis: 0 = b, 1 = c, 2 = h, 3 = w */
+  {
+  case 1:
+    slice = 1;
+    outer = in->dim.tensor_h * in->dim.tensor_w;
+    axis_len = in->dim.tensor_c;
+    break;
+  case 2:
+    slice = in->dim.tensor_w * in->dim.tensor_c;
+    outer = 1;
+    axis_len = in->dim.tensor_h;
+    break;
+  case 3:
+    slice = in->dim.tensor_c;
+    outer = in->dim.tensor_h;
+    axis_len = in->dim.tensor_w;
+    break;
+  default:
+    return false;
+  }
+  if ((slice == 0) || (out->dim.num_elem != (outer * n_idx * slice)))
+    return false;
+
+  uint32_t sig = 0;
+  for (uint32_t k = 0; k < n_idx; k++)
+    sig ^= ((uint32_t)idx[k]) + (k << 16);
+
+  if ((_sw_gather_key != (const void *)idx) || (_sw_gather_n != n_idx) || (_sw_gather_slice != slice) ||
+      (_sw_gather_sig != sig))
+  {
+    _sw_gather_key = NULL;
+    for (uint32_t k = 0; k < n_idx; k++)
+    {
+      const uint32_t v = (uint32_t)idx[k];
+      if (v >= axis_len)
+        return false; /* negative/out-of-range index: generic kernel */
+      _sw_gather_offs[k] = v * slice;
+    }
+    _sw_gather_key = idx;
+    _sw_gather_n = n_idx;
+    _sw_gather_slice = slice;
+    _sw_gather_sig = sig;
+  }
+
+  const float *x = (const float *)in->mem.start_offset;
+  float *y = (float *)out->mem.start_offset;
+
+  if (slice == 1)
+  { /* innermost axis: Helium gather loads straight off the table */
+    for (uint32_t o = 0; o < outer; o++)
+    {
+      const float *xo = &x[o * axis_len];
+      float *yo = &y[o * n_idx];
+      uint32_t k = 0;
+      for (; (k + 4) <= n_idx; k += 4)
+        vst1q_f32(&yo[k], vldrwq_gather_shifted_offset_f32(xo, vld1q_u32(&_sw_gather_offs[k])));
+      for (; k < n_idx; k++)
+        yo[k] = xo[_sw_gather_offs[k]];
+    }
+    return true;
+  }
+
+  for (uint32_t o = 0; o < outer; o++)
+  { /* outer axes: stream one contiguous slice per table entry */
+    const float *xo = &x[o * axis_len * slice];
+    float *yo = &y[o * n_idx * slice];
+    for (uint32_t k = 0; k < n_idx; k++)
+    {
+      const float *src = &xo[_sw_gather_offs[k]];
+      float *dst = &yo[k * slice];
+      uint32_t i = 0;
+      for (; (i + 4) <= slice; i += 4)
+        vst1q_f32(&dst[i], vld1q_f32(&src[i]));
+      for (; i < slice; i++)
+        dst[i] = src[i];
+    }
+  }
+
+  return true;
+}
+
+#endif // LL_ATON_SW_USE_MVE
+
 //##########################################################################################
 /** Softmax forward function */
 void ll_sw_forward_softmax(/* int processor, */ void *sw_info_struct)
 {
   Softmax_sw_info *sw_info = (Softmax_sw_info *)sw_info_struct;
 
+#if LL_ATON_SW_USE_MVE == 1
+  /* Helium fast path for the dominant fallback shape (classifier head):
+   * the softmax axis spans the whole tensor, which is then one contiguous
+   * row of floats. Axis/strided variants keep the generic kernel below. */
+  const uint32_t axis_num_elem = _sw_softmax_axis_num_elem(sw_info);
+  if ((axis_num_elem > 0) && (axis_num_elem == sw_info->general.input.dim.num_elem))
+  {
+    if (_sw_is_dense_f16(&sw_info->general.input) && _sw_is_dense_f16(&sw_info->general.output))
+    {
+      _sw_mve_softmax_row_f16((const float16_t *)sw_info->general.input.mem.start_offset,
+                              (float16_t *)sw_info->general.output.mem.start_offset, axis_num_elem);
+      return;
+    }
+    _sw_mve_softmax_row((const float *)sw_info->general.input.mem.start_offset,
+                        (float *)sw_info->general.output.mem.start_offset, axis_num_elem);
+    return;
+  }
+#endif // LL_ATON_SW_USE_MVE
+
   // array init
   int32_t format = sw_info->general.input.format.is_signed ? (AI_ARRAY_FORMAT_S8 | AI_FMT_FLAG_IS_IO)
                                                            : (AI_ARRAY_FORMAT_U8 | AI_FMT_FLAG_IS_IO);
@@ -369,6 +1565,16 @@ void ll_sw_forward_softmax(/* int processor, */ void *sw_info_struct)
 void ll_sw_forward_activ(/* int processor, */ void *sw_info_struct)
 {
   Activ_sw_info *sw_info = (Activ_sw_info *)sw_info_struct;
+
+#if LL_ATON_SW_USE_MVE == 1
+  if (!_sw_dispatch_is_generic(&sw_info->general))
+  {
+    if (_sw_lut_activ(sw_info))
+      return;
+    _sw_dispatch_set_generic(&sw_info->general);
+  }
+#endif // LL_ATON_SW_USE_MVE
+
   // array init
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
                        sw_info->general.input.mem.start_offset, sw_info->general.input.dim.num_elem, )
@@ -682,6 +1888,18 @@ void ll_sw_forward_activ(/* int processor, */ void *sw_info_struct)
 void ll_sw_forward_arith(/* int processor, */ void *sw_info_struct)
 {
   Arith_sw_info *sw_info = (Arith_sw_info *)sw_info_struct;
+
+#if LL_ATON_SW_USE_MVE == 1
+  if (!_sw_dispatch_is_generic(&sw_info->general))
+  {
+    if (_sw_mve_arith_f16(sw_info))
+      return;
+    if (_sw_mve_arith(sw_info))
+      return;
+    _sw_dispatch_set_generic(&sw_info->general);
+  }
+#endif // LL_ATON_SW_USE_MVE
+
   // array init
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
                        sw_info->general.input.mem.start_offset, sw_info->general.input.dim.num_elem, )
@@ -842,6 +2060,16 @@ void ll_sw_forward_arith(/* int processor, */ void *sw_info_struct)
 void ll_sw_forward_pool(/* int processor, */ void *sw_info_struct)
 {
   Pool_sw_info *sw_info = (Pool_sw_info *)sw_info_struct;
+
+#if LL_ATON_SW_USE_MVE == 1
+  if (!_sw_dispatch_is_generic(&sw_info->general))
+  {
+    if (_sw_mve_pool(sw_info))
+      return;
+    _sw_dispatch_set_generic(&sw_info->general);
+  }
+#endif // LL_ATON_SW_USE_MVE
+
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
                        sw_info->general.input.mem.start_offset, sw_info->general.input.dim.num_elem, )
   AI_ARRAY_OBJ_DECLARE(pool_output_array, FORMAT, sw_info->general.output.mem.start_offset,
@@ -892,6 +2120,16 @@ void ll_sw_forward_pool(/* int processor, */ void *sw_info_struct)
 void ll_sw_forward_global_pool(/* int processor, */ void *sw_info_struct)
 {
   Global_pool_sw_info *sw_info = (Global_pool_sw_info *)sw_info_struct;
+
+#if LL_ATON_SW_USE_MVE == 1
+  if (!_sw_dispatch_is_generic(&sw_info->general))
+  {
+    if (_sw_mve_global_avgpool(sw_info))
+      return;
+    _sw_dispatch_set_generic(&sw_info->general);
+  }
+#endif // LL_ATON_SW_USE_MVE
+
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
                        sw_info->general.input.mem.start_offset, sw_info->general.input.dim.num_elem, )
   AI_ARRAY_OBJ_DECLARE(pool_output_array, FORMAT, sw_info->general.output.mem.start_offset,
@@ -972,6 +2210,19 @@ void ll_sw_forward_argmax(/* int processor, */ void *sw_info_struct)
 void ll_sw_forward_gather(/* int processor, */ void *sw_info_struct)
 {
   Gather_sw_info *sw_info = (Gather_sw_info *)sw_info_struct;
+
+#if LL_ATON_SW_USE_MVE == 1
+  /* Fast path for the constant-index embedding-style gathers: offsets are
+   * resolved once into a table and streamed. Strided layouts and exotic
+   * index shapes keep the generic kernel below. */
+  if (!_sw_dispatch_is_generic(&sw_info->general))
+  {
+    if (_sw_mve_gather(sw_info))
+      return;
+    _sw_dispatch_set_generic(&sw_info->general);
+  }
+#endif
+
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
                        sw_info->general.input.mem.start_offset, sw_info->general.input.dim.num_elem, )
   AI_ARRAY_OBJ_DECLARE(indexes_array, AI_ARRAY_FORMAT_S32, sw_info->operand.mem.start_offset,
@@ -1048,6 +2299,19 @@ void ll_sw_forward_argmin(/* int processor, */ void *sw_info_struct)
 void ll_sw_forward_reduce(/* int processor, */ void *sw_info_struct)
 {
   Reduce_sw_info *sw_info = (Reduce_sw_info *)sw_info_struct;
+
+#if LL_ATON_SW_USE_MVE == 1
+  /* Helium fast path for the single-axis sum/mean/max reductions on dense
+   * tensors (the ReduceMean-over-sequence-length epochs of the transformer
+   * candidates). Other ops and layouts keep the generic kernel below. */
+  if (!_sw_dispatch_is_generic(&sw_info->general))
+  {
+    if (_sw_mve_reduce(sw_info))
+      return;
+    _sw_dispatch_set_generic(&sw_info->general);
+  }
+#endif
+
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
                        sw_info->general.input.mem.start_offset, sw_info->general.input.dim.num_elem, )
   AI_ARRAY_OBJ_DECLARE(reduce_output_array, FORMAT, sw_info->general.output.mem.start_offset,
@@ -1125,6 +2389,18 @@ void ll_sw_forward_bn(/* int processor, */ void *sw_info_struct)
 {
   Bn_sw_info *sw_info = (Bn_sw_info *)sw_info_struct;
 
+#if LL_ATON_SW_USE_MVE == 1
+  /* Helium fast path: per-channel parameters folded to one multiplier and
+   * one offset, applied as a single FMA stream. Strided layouts keep the
+   * scalar loop below. */
+  if (!_sw_dispatch_is_generic(&sw_info->general))
+  {
+    if (_sw_mve_bn(sw_info))
+      return;
+    _sw_dispatch_set_generic(&sw_info->general);
+  }
+#endif
+
   AI_ARRAY_OBJ_DECLARE(input_output_array, FORMAT, sw_info->general.input.mem.start_offset,
                        sw_info->general.input.mem.start_offset, sw_info->general.input.dim.num_elem, )
   AI_ARRAY_OBJ_DECLARE(bn_output_array, FORMAT, sw_info->general.output.mem.start_offset,
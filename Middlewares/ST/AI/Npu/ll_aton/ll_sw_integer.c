@@ -63,11 +63,215 @@ static int helper_emit_shape_index_axis(int onnx_axis)
   }
 }
 
+#if LL_ATON_SW_USE_MVE == 1
+
+#if !defined(__ARM_FEATURE_MVE) || !(__ARM_FEATURE_MVE & 1)
+#error "LL_ATON_SW_USE_MVE requires an integer MVE enabled target (e.g. Cortex-M55)"
+#endif
+
+#include <arm_mve.h>
+#include <math.h>
+
+/** s8 dot product over one weight row (16-byte tiles, predicated tail),
+ *  also returns the row sum needed for the zero-point correction */
+static inline int32_t _sw_mve_dot_s8(const int8_t *a, const int8_t *b, uint32_t len, int32_t *sum_b)
+{
+  int32_t acc = 0;
+  int32_t bsum = 0;
+  uint32_t i;
+
+  for (i = 0; (i + 16) <= len; i += 16)
+  {
+    const int8x16_t va = vld1q_s8(&a[i]);
+    const int8x16_t vb = vld1q_s8(&b[i]);
+    acc = vmladavaq_s8(acc, va, vb);
+    bsum = vaddvaq_s8(bsum, vb);
+  }
+  if (i < len)
+  {
+    const mve_pred16_t p = vctp8q(len - i);
+    const int8x16_t va = vldrbq_z_s8(&a[i], p);
+    const int8x16_t vb = vldrbq_z_s8(&b[i], p);
+    acc = vmladavaq_p_s8(acc, va, vb, p);
+    bsum = vaddvaq_p_s8(bsum, vb, p);
+  }
+
+  *sum_b = bsum;
+  return acc;
+}
+
+/** Helium dense/GEMM kernel for the s8 scale-offset layout the dense
+ *  mapping produces (input 1,1,NIN,1 / weights already permuted NOUT x NIN,
+ *  per-tensor input/output quantization, per-tensor or per-channel weight
+ *  scales). Returns false when the shape/format does not match so that the
+ *  caller falls back to the generic embednets kernel.
+ */
+static bool _sw_mve_dense_integer(const General *general, const Tensor_info *weights, const Tensor_info *bias,
+                                  const Tensor_info *ws, const Tensor_info *wzp, const Tensor_info *is,
+                                  const Tensor_info *izp, const Tensor_info *os, const Tensor_info *ozp)
+{
+  const uint32_t n_in = general->input.dim.num_elem;
+  const uint32_t n_out = general->output.dim.num_elem;
+
+  if (!general->input.format.is_signed || !weights->format.is_signed || !general->output.format.is_signed)
+    return false;
+  if ((n_in == 0) || (n_out == 0) || (weights->dim.num_elem != (n_in * n_out)))
+    return false;
+  if ((is->dim.num_elem != 1) || (os->dim.num_elem != 1))
+    return false;
+  if ((ws->dim.num_elem != 1) && (ws->dim.num_elem != n_out))
+    return false;
+  if (wzp->dim.num_elem > 1)
+    return false;
+
+  const int8_t *x = (const int8_t *)general->input.mem.start_offset;
+  const int8_t *w = (const int8_t *)weights->mem.start_offset;
+  int8_t *y = (int8_t *)general->output.mem.start_offset;
+  const int32_t *bias32 = (bias != NULL) ? (const int32_t *)bias->mem.start_offset : NULL;
+
+  const float s_in = *(const float *)is->mem.start_offset;
+  const float s_out = *(const float *)os->mem.start_offset;
+  const float *s_w = (const float *)ws->mem.start_offset;
+  const int32_t x_zp = (izp->mem.start_offset != NULL) ? (int32_t)*(const int8_t *)izp->mem.start_offset : 0;
+  const int32_t w_zp = (wzp->mem.start_offset != NULL) ? (int32_t)*(const int8_t *)wzp->mem.start_offset : 0;
+  const int32_t y_zp = (ozp->mem.start_offset != NULL) ? (int32_t)*(const int8_t *)ozp->mem.start_offset : 0;
+
+  /* input sum for the weight zero-point correction, computed once */
+  int32_t x_sum = 0;
+  {
+    uint32_t i;
+    for (i = 0; (i + 16) <= n_in; i += 16)
+      x_sum = vaddvaq_s8(x_sum, vld1q_s8(&x[i]));
+    if (i < n_in)
+    {
+      const mve_pred16_t p = vctp8q(n_in - i);
+      x_sum = vaddvaq_p_s8(x_sum, vldrbq_z_s8(&x[i], p), p);
+    }
+  }
+
+  for (uint32_t o = 0; o < n_out; o++)
+  {
+    int32_t w_sum;
+    int32_t acc = _sw_mve_dot_s8(x, &w[o * n_in], n_in, &w_sum);
+
+    /* sum((x - x_zp) * (w - w_zp)) from the raw dot product */
+    acc += ((int32_t)n_in * x_zp * w_zp) - (x_zp * w_sum) - (w_zp * x_sum);
+    if (bias32 != NULL)
+      acc += bias32[o];
+
+    const float scale = (s_in * ((ws->dim.num_elem == 1) ? s_w[0] : s_w[o])) / s_out;
+    int32_t q = (int32_t)lrintf((float)acc * scale) + y_zp;
+    q = (q > 127) ? 127 : ((q < -128) ? -128 : q);
+    y[o] = (int8_t)q;
+  }
+
+  return true;
+}
+
+/** Helium pointwise (1x1) convolution kernel for the s8 channel-format
+ *  layout (`LL_SW_SSSA_PW_CONV`, channels innermost). Every output pixel is
+ *  a dense dot product of length C_in, so the GEMM machinery above can be
+ *  reused pixel by pixel. Returns false when the shape/format does not match
+ *  so that the caller falls back to the generic embednets kernel.
+ */
+static bool _sw_mve_pw_conv_integer(const Conv_integer_sw_info *sw_info)
+{
+  const General *general = &sw_info->general;
+  const Tensor_info *weights = &sw_info->weights;
+  const uint32_t c_in = general->input.dim.tensor_c;
+  const uint32_t c_out = general->output.dim.tensor_c;
+  const uint32_t pixels =
+      general->input.dim.tensor_h * general->input.dim.tensor_w * general->input.dim.tensor_b;
+
+  if (sw_info->fwd_func != LL_SW_SSSA_PW_CONV)
+    return false;
+  if ((sw_info->ngroup != 1) || (sw_info->strides[0] != 1) || (sw_info->strides[1] != 1))
+    return false;
+  if ((sw_info->pads[0] != 0) || (sw_info->pads[1] != 0) || (sw_info->pads[2] != 0) || (sw_info->pads[3] != 0))
+    return false;
+  if (!general->input.format.is_signed || !weights->format.is_signed || !general->output.format.is_signed)
+    return false;
+  if ((c_in == 0) || (c_out == 0) || (pixels == 0))
+    return false;
+  /* densely packed channel-innermost tensors only */
+  if ((general->input.dim.num_elem != (pixels * c_in)) || (general->output.dim.num_elem != (pixels * c_out)))
+    return false;
+  if (weights->dim.num_elem != (c_in * c_out))
+    return false;
+  if ((sw_info->is.dim.num_elem != 1) || (sw_info->os.dim.num_elem != 1))
+    return false;
+  if ((sw_info->ws.dim.num_elem != 1) && (sw_info->ws.dim.num_elem != c_out))
+    return false;
+  if (sw_info->wzp.dim.num_elem > 1)
+    return false;
+
+  const int8_t *x = (const int8_t *)general->input.mem.start_offset;
+  const int8_t *w = (const int8_t *)weights->mem.start_offset;
+  int8_t *y = (int8_t *)general->output.mem.start_offset;
+  const int32_t *bias32 = (const int32_t *)sw_info->bias.mem.start_offset;
+
+  const float s_in = *(const float *)sw_info->is.mem.start_offset;
+  const float s_out = *(const float *)sw_info->os.mem.start_offset;
+  const float *s_w = (const float *)sw_info->ws.mem.start_offset;
+  const int32_t x_zp =
+      (sw_info->izp.mem.start_offset != NULL) ? (int32_t)*(const int8_t *)sw_info->izp.mem.start_offset : 0;
+  const int32_t w_zp =
+      (sw_info->wzp.mem.start_offset != NULL) ? (int32_t)*(const int8_t *)sw_info->wzp.mem.start_offset : 0;
+  const int32_t y_zp =
+      (sw_info->ozp.mem.start_offset != NULL) ? (int32_t)*(const int8_t *)sw_info->ozp.mem.start_offset : 0;
+
+  for (uint32_t p = 0; p < pixels; p++)
+  {
+    const int8_t *x_pix = &x[p * c_in];
+    int8_t *y_pix = &y[p * c_out];
+
+    /* input sum for the weight zero-point correction, computed once per pixel */
+    int32_t x_sum = 0;
+    {
+      uint32_t i;
+      for (i = 0; (i + 16) <= c_in; i += 16)
+        x_sum = vaddvaq_s8(x_sum, vld1q_s8(&x_pix[i]));
+      if (i < c_in)
+      {
+        const mve_pred16_t q = vctp8q(c_in - i);
+        x_sum = vaddvaq_p_s8(x_sum, vldrbq_z_s8(&x_pix[i], q), q);
+      }
+    }
+
+    for (uint32_t o = 0; o < c_out; o++)
+    {
+      int32_t w_sum;
+      int32_t acc = _sw_mve_dot_s8(x_pix, &w[o * c_in], c_in, &w_sum);
+
+      /* sum((x - x_zp) * (w - w_zp)) from the raw dot product */
+      acc += ((int32_t)c_in * x_zp * w_zp) - (x_zp * w_sum) - (w_zp * x_sum);
+      if (bias32 != NULL)
+        acc += bias32[o];
+
+      const float scale = (s_in * ((sw_info->ws.dim.num_elem == 1) ? s_w[0] : s_w[o])) / s_out;
+      int32_t q = (int32_t)lrintf((float)acc * scale) + y_zp;
+      q = (q > 127) ? 127 : ((q < -128) ? -128 : q);
+      y_pix[o] = (int8_t)q;
+    }
+  }
+
+  return true;
+}
+
+#endif // LL_ATON_SW_USE_MVE
+
 /** QLinearMatMul forward function */
 void ll_sw_forward_qlinearmatmul(/* int processor, */ void *sw_info_struct)
 {
   Qlinearmatmul_sw_info *sw_info = (Qlinearmatmul_sw_info *)sw_info_struct;
 
+#if LL_ATON_SW_USE_MVE == 1
+  /* bias is zeroed in this mapping (see the memset below), drop it */
+  if (_sw_mve_dense_integer(&sw_info->general, &sw_info->weights, NULL, &sw_info->ws, &sw_info->wzp, &sw_info->is,
+                            &sw_info->izp, &sw_info->os, &sw_info->ozp))
+    return;
+#endif // LL_ATON_SW_USE_MVE
+
   /*
   1. reshape of the weights from weights tensor -> weights_perm tensor
   2. map the matmul operation on the library dense_forward function.
@@ -183,6 +387,14 @@ void ll_sw_forward_gemm_integer(/* int processor, */ void *sw_info_struct)
 {
   Gemm_integer_sw_info *sw_info = (Gemm_integer_sw_info *)sw_info_struct;
 
+#if LL_ATON_SW_USE_MVE == 1
+  /* the dense mapping already has the weights permuted, tA/tB are not
+     relevant here (as in the generic path below) */
+  if (_sw_mve_dense_integer(&sw_info->general, &sw_info->weights, &sw_info->bias, &sw_info->ws, &sw_info->wzp,
+                            &sw_info->is, &sw_info->izp, &sw_info->os, &sw_info->ozp))
+    return;
+#endif // LL_ATON_SW_USE_MVE
+
   /*
   1. reshape of the weights from weights tensor -> weights_perm tensor
   2. map the matmul operation on the library dense_forward function.
@@ -450,6 +662,11 @@ void ll_sw_forward_conv_integer(/* int processor, */ void *sw_info_struct)
 {
   Conv_integer_sw_info *sw_info = (Conv_integer_sw_info *)sw_info_struct;
 
+#if LL_ATON_SW_USE_MVE == 1
+  if (_sw_mve_pw_conv_integer(sw_info))
+    return;
+#endif // LL_ATON_SW_USE_MVE
+
   int32_t format;
   // array init
   format = sw_info->general.input.format.is_signed ? (AI_ARRAY_FORMAT_S8 | AI_FMT_FLAG_IS_IO)
@@ -32,6 +32,451 @@
 /* UART usage/configuration */
 #define USE_UART_BAUDRATE               921600 // 5529600 // 3686400  // 921600          /* 921600 115200 */
 
+/* COM DMA usage/configuration
+ * 1: ping-pong DMA buffering of the PB packets (UART/USART port only),
+ *    the host transfer of the previous packet is overlapped with the
+ *    fill/decode of the current one. Requires the DMA channels associated
+ *    to UartHandle (see bsp_ai.h).
+ */
+#ifndef USE_COM_DMA_DOUBLE_BUFFER
+#define USE_COM_DMA_DOUBLE_BUFFER       0
+#endif
+
+/* Circular-DMA UART reception with IDLE-line framing
+ * 1: a GPDMA channel streams USART1 RX bytes into a circular ring (a
+ *    self-reloading linked-list item wraps the channel forever) and the
+ *    IDLE-line interrupt marks the end of a burst: a whole packet costs
+ *    one interrupt instead of the per-byte servicing that caps the
+ *    usable baud rate. UART/USART port only, not combinable with
+ *    USE_COM_DMA_DOUBLE_BUFFER (both would claim the RX stream).
+ */
+#ifndef USE_COM_DMA_IDLE_RX
+#define USE_COM_DMA_IDLE_RX             0
+#endif
+/* RX ring size in bytes, a power of two larger than the biggest burst
+ * the host emits back-to-back (one large packet is 4096 bytes) */
+#ifndef COM_RX_RING_SIZE
+#define COM_RX_RING_SIZE                (8192)
+#endif
+
+/* Credit-based RX flow control
+ * 1: the per-packet sync byte becomes a credit - the device grants up to
+ *    a window of syncs ahead of consumption, sized so the outstanding
+ *    packets fit the transport's elastic RX buffer (the circular-DMA ring
+ *    on UART, the CDC user fifo on USB), and the host streams the window
+ *    back-to-back instead of paying one round-trip per packet. Without an
+ *    elastic buffer (polled UART reception) the window degrades to 1,
+ *    i.e. the legacy stop-and-wait exchange. Host-transparent: a host
+ *    waiting for the sync before each packet finds it already buffered.
+ */
+#ifndef USE_COM_RX_CREDITS
+#define USE_COM_RX_CREDITS              1
+#endif
+/* window cap in packets, bounds the burst whatever the packet size */
+#ifndef COM_RX_CREDITS_MAX
+#define COM_RX_CREDITS_MAX              (8)
+#endif
+/* USB CDC user fifo size in bytes (reception elastic buffer) */
+#ifndef USB_RX_FIFO_SIZE
+#define USB_RX_FIFO_SIZE                (4096)
+#endif
+
+/* CRC-protected packet framing with selective retransmit
+ * 1: every packet carries a 5-byte sequence/CRC-32 trailer (AHB4 CRC
+ *    unit) and a corrupted frame is asked for again with a 3-byte NAK
+ *    instead of desynchronizing the protobuf stream and costing the
+ *    whole session - for links run at baud rates where occasional
+ *    corruption is expected. Wire-format change: the host library must
+ *    be built with the same option. Not combinable with
+ *    USE_COM_DMA_DOUBLE_BUFFER (the ping-pong streams fixed frames).
+ */
+#ifndef USE_COM_CRC_FRAMES
+#define USE_COM_CRC_FRAMES              0
+#endif
+
+/* Memory checksum service
+ * 1: CMD_MEMORY_CHECKSUM is computed with the CRC unit (CRC-32/MPEG-2,
+ *    see stm32_utility.crc32_mpeg2() on the host side) instead of the
+ *    byte-wise BSD software loop. The per-chunk write acknowledge keeps
+ *    the BSD value for wire compatibility.
+ */
+#ifndef USE_HW_CRC_CHECKSUM
+#define USE_HW_CRC_CHECKSUM             1
+#endif
+
+/* Tensor dump compression
+ * 1: intermediate tensor payloads are LZ4-compressed before being sent
+ *    (per-layer-with-data mode). Advertised to the host through a spare
+ *    capability bit, the ai_runner decompresses transparently.
+ */
+#ifndef USE_TENSOR_DUMP_LZ4
+#define USE_TENSOR_DUMP_LZ4             0
+#endif
+
+/* Coalesced tensor dump
+ * 1: in bulk mode (P_RUN_CONF_DIRECT_READ) the dump payloads of an epoch
+ *    are gathered by a GPDMA linked-list chain into one contiguous pool
+ *    (TENSOR_DUMP_GATHER_POOL_BYTES, default 128KB) while the descriptors
+ *    go out, then streamed as a single framed raw transfer instead of one
+ *    blob per tensor. Flagged per tensor through a spare tensor flag;
+ *    epochs that do not fit the pool fall back to per-tensor blobs.
+ */
+#ifndef USE_TENSOR_DUMP_GATHER
+#define USE_TENSOR_DUMP_GATHER          0
+#endif
+
+/* Probe-visible bulk-readback window
+ * 1: a spare command publishes a memory region descriptor in a fixed
+ *    64-byte SRAM slot at the top of AXISRAM1 (.probe_window, see
+ *    STM32N657xx.ld) and the host dumps the region directly through the
+ *    debug probe (scripts/N6_scripts/n6_utils_pkg/probe_window.py) while
+ *    the CDC/UART link carries only control - dual-path transfers for
+ *    large tensor readbacks.
+ */
+#ifndef USE_PROBE_WINDOW
+#define USE_PROBE_WINDOW                0
+#endif
+
+/* On-device int8 conversion of float validation I/O
+ * 1: float32 tensors travel int8-quantized on the wire. A float input may
+ *    be sent as an 8-byte scale/zero-point header followed by one int8
+ *    value per element and is dequantized in place on reception; float
+ *    output payloads are quantized with device-computed affine parameters,
+ *    advertised per tensor through a spare tensor flag plus the descriptor
+ *    scale/zeropoint fields. Conversion is MVE-vectorized. Cuts float
+ *    tensor transfers 4x at ~1/256 full-scale precision (lossy, for
+ *    bandwidth-bound validation runs).
+ */
+#ifndef USE_TENSOR_IO_QUANT
+#define USE_TENSOR_IO_QUANT             0
+#endif
+
+/* ITM/SWO binary trace backend
+ * 1: the binary event ring and the per-epoch counter reports are emitted
+ *    as compact binary records over dedicated ITM stimulus ports (SWO)
+ *    instead of s-msg log lines, keeping the main UART/USB link dedicated
+ *    to the tensor traffic. Silent no-op when the debug probe has not
+ *    enabled the ITM / the stimulus ports (see itmTraceEnabled).
+ */
+#ifndef USE_ITM_TRACE
+#define USE_ITM_TRACE                   0
+#endif
+
+/* Statistical PC sampling profiler
+ * 1: the SysTick handler captures the interrupted PC into a ring while an
+ *    inference runs (debug option of the RUN command), giving a 1 kHz
+ *    statistical profile of the software epochs. Samples are reported as
+ *    s:pcs log lines and symbolized offline against the ELF with
+ *    scripts/N6_scripts/pc_symbolize.py.
+ */
+#ifndef USE_PC_SAMPLING
+#define USE_PC_SAMPLING                 0
+#endif
+
+/* DMA-drained log output
+ * 1: lc_print characters land in a ring buffer and a GPDMA channel
+ *    drains them to USART1 in the background: a log call costs the ring
+ *    store instead of a blocking UART write, so verbose debug output no
+ *    longer perturbs the timings it is meant to explain. Drop-oldest
+ *    overflow policy, the newest output always survives (dropped byte
+ *    count in log_dma_dropped()). For builds where USART1 carries the
+ *    logs and not the binary protocol (USB transport).
+ */
+#ifndef USE_LOG_DMA
+#define USE_LOG_DMA                     0
+#endif
+/* log ring size in bytes, must be a power of two */
+#ifndef LOG_DMA_RING_SIZE
+#define LOG_DMA_RING_SIZE               (4096)
+#endif
+
+/* Pipelined NNRun
+ * 1: the input tensors of the next sample are received in background (RX
+ *    DMA into a staging pool) while the NPU executes the current one, then
+ *    copied into the activations pool before the next run. Only applies to
+ *    the bulk upload path and requires USE_COM_DMA_DOUBLE_BUFFER=1.
+ */
+#ifndef USE_PIPELINED_RUN
+#define USE_PIPELINED_RUN               0
+#endif
+
+/* Epoch watchdog
+ * 1: npu_run re-arms a tick-based timeout at every epoch-block transition
+ *    and aborts the inference when an epoch hangs (bad blob, clock
+ *    misconfig) instead of waiting forever, reporting the offending epoch
+ *    block index through the NNRun error ack. Based on the HAL tick, the
+ *    DWT cycle counter is reset by the per-epoch instrumentation.
+ */
+#ifndef USE_EPOCH_WATCHDOG
+#define USE_EPOCH_WATCHDOG              1
+#endif
+
+#ifndef EPOCH_WATCHDOG_TIMEOUT_MS
+#define EPOCH_WATCHDOG_TIMEOUT_MS       2000
+#endif
+
+/* Warm-run fast path
+ * 1: back-to-back inferences skip the whole-NPU-cache invalidate in
+ *    npu_run; only the input buffer windows are invalidated by range.
+ *    The memory-write service marks the memory dirty, which forces the
+ *    full scrub back on the next run (weights/activations rewritten).
+ */
+#ifndef USE_WARM_RUN
+#define USE_WARM_RUN                    0
+#endif
+
+/* Fast-boot path
+ * 1: the synchronous non-essentials of the boot sequence are skipped: the
+ *    external-memory test pattern (a 16 MB hyperRAM memset) and the
+ *    verbose boot banner (the host queries the same facts with SYS_INFO).
+ *    The USB device is initialized before the NPU/memory bring-up either
+ *    way, so the host-driven enumeration overlaps the model install. The
+ *    boot-phase DWT timestamps (boot_ts_mark, reported as an s:boot line
+ *    by SYS_INFO) quantify what is left.
+ */
+#ifndef USE_FAST_BOOT
+#define USE_FAST_BOOT                   0
+#endif
+
+/* Command overlay
+ * 1: the rarely used command handlers (stats, digest, replay, fetch, ...)
+ *    are linked into .ovl_text in the memory-mapped external flash and
+ *    executed in place through the caches, instead of being copied into
+ *    AXISRAM with the rest of the image. Shrinks the resident image; the
+ *    hot inference/transport path stays resident. The overlay is not part
+ *    of the boot image: extract/flash it with `make flash_cmdovl` (the
+ *    .ovl_text address in STM32N657xx.ld must match CMDOVL_BASE there).
+ */
+#ifndef USE_CMD_OVERLAY
+#define USE_CMD_OVERLAY                 0
+#endif
+
+/* Epoch fusion
+ * 1: at bootstrap, runs of adjacent pure-SW epoch blocks are collapsed
+ *    into single scheduled units (trampoline descriptors in the DTCM
+ *    copy), cutting the fixed per-epoch runtime/bookkeeping cost. Note:
+ *    per-epoch reports/dumps then see the fused unit as one epoch.
+ */
+#ifndef USE_EPOCH_FUSION
+#define USE_EPOCH_FUSION                0
+#endif
+
+/* Software-epoch result memoization
+ * 1: at bootstrap, single-epoch pure-SW blocks are wrapped with a
+ *    capture/verify/restore trampoline: outputs byte-identical across
+ *    the first two inferences are restored by memcpy afterwards instead
+ *    of being recomputed, guarded by a hash over the epoch's param
+ *    buffers. Targets constant-producing subgraphs (positional-encoding
+ *    generation, constant reshapes). The save pool is
+ *    NPU_MEMO_POOL_BYTES (default 32KB); needs LL_ATON_EB_DBG_INFO.
+ */
+#ifndef USE_EPOCH_MEMO
+#define USE_EPOCH_MEMO                  0
+#endif
+
+/* Inter-epoch overlap analyzer
+ * 1: at bootstrap, consecutive pure-HW epoch blocks whose terminal wait
+ *    covers stream engines the next block does not reuse are reported
+ *    (compiler-feedback material, printed with the model summary).
+ *    Needs a descriptor list built with LL_ATON_EB_DBG_INFO for the
+ *    per-epoch engine usage masks. The optional wait-mask rewrite
+ *    (npu_overlap_analyze(.., 1)) is opt-in per model, see the wrapper.
+ */
+#ifndef USE_OVERLAP_ANALYZER
+#define USE_OVERLAP_ANALYZER            0
+#endif
+
+/* Next-epoch weight prefetch
+ * 1: from the PRE_START epoch hook a spare GPDMA channel reads the
+ *    parameter window of the next epoch (memory-to-memory, fixed sink)
+ *    while the current epoch runs on the ATON units, warming the
+ *    external-memory path ahead of the streaming engines. Experimental,
+ *    check the stream-engine counters before enabling per model.
+ */
+#ifndef USE_WEIGHT_PREFETCH
+#define USE_WEIGHT_PREFETCH             0
+#endif
+
+/* Lazy per-epoch parameter loading (relocatable models only)
+ * 1: the install-time bulk copy of the params pool is skipped
+ *    (AI_RELOC_RT_LOAD_MODE_LAZY_PARAMS) and each epoch's parameter
+ *    window is staged from the flash image just-in-time from the
+ *    PRE_START hook, with the next window DMA'd one epoch ahead. Only
+ *    the first inference pays the staging cost.
+ */
+#ifndef USE_LAZY_PARAMS
+#define USE_LAZY_PARAMS                 0
+#endif
+
+/* Encrypted parameter image (requires USE_LAZY_PARAMS)
+ * 1: the flash image holds cipher-text produced by the scripts/N6_encrypt
+ *    flow and the lazy stager decrypts each epoch's parameter window
+ *    through the ATON cipher DMA while staging it, instead of copying
+ *    plain-text. The one-epoch look-ahead is disabled in this mode (the
+ *    cipher path needs the stream engines, busy while the NPU runs).
+ */
+#ifndef USE_ENCRYPTED_PARAMS
+#define USE_ENCRYPTED_PARAMS            0
+#endif
+
+/* 4-bit packed parameter image (requires USE_LAZY_PARAMS)
+ * 1: the flash image holds the params pool repacked with
+ *    scripts/N6_scripts/pack_weights4.py: parameter windows whose int8
+ *    weights all fit in [-8, 7] are stored two per byte and expanded with
+ *    an MVE nibble-unpack pass while being staged, the rest stays
+ *    byte-per-byte. Halves the flash footprint and read traffic of the
+ *    eligible tensors. Exclusive with USE_ENCRYPTED_PARAMS, the cipher
+ *    keystream is tied to the plain image layout.
+ */
+#ifndef USE_WEIGHTS_4BIT
+#define USE_WEIGHTS_4BIT                0
+#endif
+
+/* Shared IO arena for models generated with user-allocated IO buffers.
+ * > 0: the buffers of every instance are carved out of a single aligned
+ *      pool at npu_init time, driven by the LL_Buffer_InfoTypeDef
+ *      metadata, instead of build-time worst-case static arrays. Size it
+ *      for the sum of the concurrently resident models' IO footprints.
+ */
+#ifndef NPU_IO_ARENA_SIZE
+#define NPU_IO_ARENA_SIZE               0
+#endif
+
+/* Ping-pong output buffers (requires NPU_IO_ARENA_SIZE > 0)
+ * 1: npu_connect_io_arena carves two banks for the (user-allocated)
+ *    output buffers and npu_flip_output_buffers() re-points the model at
+ *    the other bank after each run: the bank being drained to the host
+ *    stays stable while the NPU already writes the next sample, removing
+ *    the strict run->send->run ordering when the host pipelines the RUN
+ *    commands. Size the arena for inputs + 2x outputs.
+ */
+#ifndef USE_PINGPONG_OUTPUTS
+#define USE_PINGPONG_OUTPUTS            0
+#endif
+
+/* NPU cache weight pinning (best effort)
+ * 1: npu_init registers the parameter windows of networks with a small
+ *    weight set (<= NPU_CACHE_PIN_MAX_BYTES) as pinned, and the run path
+ *    then skips the per-run whole-NPU-cache invalidate in favour of
+ *    ranged maintenance of the IO windows. Keeps e.g. the kws weights
+ *    warm across runs when the img network executes in between; the
+ *    CACHEAXI has no line locks, capacity eviction remains possible.
+ */
+#ifndef USE_NPU_CACHE_PIN
+#define USE_NPU_CACHE_PIN               0
+#endif
+
+#ifndef NPU_CACHE_PIN_MAX_BYTES
+#define NPU_CACHE_PIN_MAX_BYTES         (128 * 1024)
+#endif
+
+/* Asynchronous NPU cache maintenance
+ * 1: npu_cache_clean_range() queues the range and returns; the CACHEAXI
+ *    completion interrupt chains the queued CleanByAddr commands, so
+ *    cleaning epoch N's output windows overlaps with epoch N+1's
+ *    execution (the NPU's own accesses go through the cache, only
+ *    external readers need the clean to have landed). npu_cache_sync()
+ *    is called before outputs are consumed (end of npu_run) and before
+ *    tensor dumps read NPU-written data. Needs USE_NPU_CACHE.
+ */
+#ifndef USE_NPU_CACHE_ASYNC
+#define USE_NPU_CACHE_ASYNC             0
+#endif
+
+/* Input preprocessing stage
+ * 1: a stage registered with npu_set_preproc() (crop / normalize / layout
+ *    conversion of a sensor-format frame into the first input buffer,
+ *    built-in MVE kernels or a custom one) runs at the top of npu_run
+ *    inside the timed window; its cycles join the PRE tier (cpu_start)
+ *    so the reported numbers are end-to-end, preprocessing included.
+ */
+#ifndef USE_PREPROC
+#define USE_PREPROC                     0
+#endif
+
+/* Write-through MPU mapping of the IO buffer arenas
+ * 1: the IO arenas are covered by ARMv8-M MPU regions with a
+ *    write-through/read-allocate attribute. CPU stores (tensor uploads)
+ *    reach the backing memory immediately, so the pre-run clean of the
+ *    input windows disappears; the output windows, written by the NPU,
+ *    still take the ranged invalidate. Only effective with arena-based
+ *    IO (NPU_IO_ARENA_SIZE or the default-network arena): pool-allocated
+ *    buffers live outside the mapped regions and keep the cleans.
+ */
+#ifndef USE_MPU_WT_IO
+#define USE_MPU_WT_IO                   0
+#endif
+
+/* Profile-driven activations placement (relocatable models only)
+ * 1: npu_reloc_place_acts() can move the whole activations/external pool
+ *    of the installed model between the external PSRAM default and a fast
+ *    on-chip AXISRAM window, through a re-install of the relocatable
+ *    image. The RUN path applies it automatically after a profile-summary
+ *    run when the per-epoch NPU-cache miss rate shows a memory-bound
+ *    model whose pool fits on-chip. Granularity is the pool: the buffer
+ *    offsets inside it are baked into the relocatable image.
+ */
+#ifndef USE_ACTS_PLACEMENT
+#define USE_ACTS_PLACEMENT              0
+#endif
+
+/* Epoch Controller blob flash partition
+ * 1: at init time the blob epoch-block descriptors are re-pointed at the
+ *    matching Epoch Controller binary of a directory-based partition in
+ *    the memory-mapped external flash (npu_connect_ec_partition, needs
+ *    the mutable DTCM descriptor copy), instead of the blob arrays
+ *    compiled in through the <network>_ecblobs.h headers. The partition
+ *    image is packed with scripts/N6_scripts/ec_partition_pack.py and
+ *    flashed on its own (make flash_ecpart), so a model iteration is a
+ *    blob write instead of a full firmware reflash. Models absent from
+ *    the partition keep their compiled-in blobs.
+ */
+#ifndef USE_EC_FLASH_PARTITION
+#define USE_EC_FLASH_PARTITION          0
+#endif
+
+/* Base address of the mapped blob partition (XSPI2 NOR window, keep clear
+ * of the weights images, see scripts/N6_scripts config) */
+#ifndef EC_PARTITION_BASE
+#define EC_PARTITION_BASE               (0x71000000UL)
+#endif
+
+/* Epoch Controller blob residency tiers (builds on the flash partition)
+ * 1: npu_ec_tier_blobs() ranks the partition-resident blobs by profiled
+ *    epoch cost: the hottest ones are copied into a resident fast pool
+ *    (EC_TIER_FAST_POOL_BYTES), the cold rest stays in the mapped flash
+ *    and is staged on demand through two rotating EC_TIER_STAGE_BYTES
+ *    buffers at the PRE_START hook of the owning epoch block - the EC
+ *    footprint of a big model shrinks to the pool plus the buffers while
+ *    the hot loop keeps SRAM fetch speed. The validation RUN path applies
+ *    it automatically after a profile-summary run.
+ */
+#ifndef USE_EC_BLOB_TIERS
+#define USE_EC_BLOB_TIERS               0
+#endif
+
+#ifndef EC_TIER_FAST_POOL_BYTES
+#define EC_TIER_FAST_POOL_BYTES         (16 * 1024)
+#endif
+
+#ifndef EC_TIER_STAGE_BYTES
+#define EC_TIER_STAGE_BYTES             (4 * 1024)
+#endif
+
+/* Scripted benchmark harness (BUILD_CONF=N6-DK-harness)
+ * 1: main() boots straight into aiBenchHarnessRun() instead of the
+ *    host-driven command loop: the steps of a benchmark plan (model,
+ *    iteration count, counter preset) baked at build time into the
+ *    generated bench_plan.h (scripts/N6_scripts/gen_bench_plan.py) are
+ *    executed on synthesized inputs and a single machine-readable
+ *    b:-line report goes out over the UART. No host tooling in the
+ *    measured path - the same flashed image reproduces its numbers on
+ *    every reset.
+ */
+#ifndef USE_BENCH_HARNESS
+#define USE_BENCH_HARNESS               0
+#endif
+
 /* RELOC configuration */
 #ifndef USE_RELOC_MODE
 #define USE_RELOC_MODE                  0
@@ -45,7 +490,58 @@
 #define USE_RELOC_EXT_EXEC_RAM          0
 #endif
 
-#define USE_USB_PACKET_SIZE             382 // max size works on MAC, but can be increase to 4094 on Windows and Linux
+/* PB packet payload negotiated over the USB CDC-ACM link (sinfo.com_param).
+ * 4094 (+2 header) spans eight 512-byte HS bulk packets, queued as a single
+ * USBX transfer request (see UX_SLAVE_REQUEST_DATA_MAX_LENGTH). Fall back
+ * to 382 (single short USB packet) on hosts splitting the CDC writes (MAC).
+ */
+#ifndef USE_USB_PACKET_SIZE
+#define USE_USB_PACKET_SIZE             4094
+#endif
+
+/* Autonomous soak-test mode (see aiPbCmdSoak in aiValidation_ATON.c).
+ * SOAK_NOR_OFFSET locates the flash-persisted statistics record (one 4KB
+ * NOR sector, keep it clear of the weight images and the EC partition);
+ * SOAK_SAVE_PERIOD_S is the persist cadence and bounds the statistics
+ * window lost to a watchdog reset.
+ */
+#ifndef SOAK_NOR_OFFSET
+#if NUCLEO_N6_CONFIG == 0
+#define SOAK_NOR_OFFSET                 (0x07FFF000UL)  /* last 4KB sector (128MB part) */
+#else
+#define SOAK_NOR_OFFSET                 (0x03FFF000UL)  /* last 4KB sector (64MB part) */
+#endif
+#endif
+
+#ifndef SOAK_SAVE_PERIOD_S
+#define SOAK_SAVE_PERIOD_S              (60U)
+#endif
+
+/* Device configuration store (see aiPbCmdCfgStore in aiValidation_ATON.c).
+ * One 4KB NOR sector, right below the soak record sector, holding the
+ * persisted session settings as appended slots - the sector is erased
+ * only once every slot is consumed (wear-aware).
+ */
+#ifndef CFG_NOR_OFFSET
+#if NUCLEO_N6_CONFIG == 0
+#define CFG_NOR_OFFSET                  (0x07FFE000UL)  /* 128MB part */
+#else
+#define CFG_NOR_OFFSET                  (0x03FFE000UL)  /* 64MB part */
+#endif
+#endif
+
+/* Performance baseline store (see aiPbCmdBaseline in aiValidation_ATON.c).
+ * One 4KB NOR sector, right below the configuration store, holding one
+ * per-epoch cycle baseline record per embedded network. Rewritten only
+ * when a baseline is (re)captured.
+ */
+#ifndef BASE_NOR_OFFSET
+#if NUCLEO_N6_CONFIG == 0
+#define BASE_NOR_OFFSET                 (0x07FFD000UL)  /* 128MB part */
+#else
+#define BASE_NOR_OFFSET                 (0x03FFD000UL)  /* 64MB part */
+#endif
+#endif
 
 #endif /* __APP_CONFIG_H__ */
 
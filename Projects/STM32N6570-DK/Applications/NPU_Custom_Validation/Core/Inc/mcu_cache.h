@@ -37,6 +37,23 @@ int mcu_cache_clean_invalidate(void);
 int mcu_cache_invalidate_range(uint32_t start_addr, uint32_t end_addr);
 int mcu_cache_clean_range(uint32_t start_addr, uint32_t end_addr);
 int mcu_cache_clean_invalidate_range(uint32_t start_addr, uint32_t end_addr);
+
+/* batched range maintenance: adjacent/overlapping ranges are merged, the
+   line loops run back-to-back and a single DSB/ISB is issued at the end
+   (the per-range functions above pay one barrier sequence per call).
+   Note: the range list is sorted in place. */
+enum mcu_cache_op {
+  MCU_CACHE_OP_CLEAN = 0,
+  MCU_CACHE_OP_INVALIDATE,
+  MCU_CACHE_OP_CLEAN_INVALIDATE,
+};
+
+struct mcu_cache_range {
+  uint32_t start_addr;
+  uint32_t end_addr;
+};
+
+int mcu_cache_op_ranges(enum mcu_cache_op op, struct mcu_cache_range *ranges, int n_ranges);
 void set_mcu_cache_state(uint8_t i_cache_state, uint8_t d_cache_state);
 
 #endif // __MCU_CACHE_H
@@ -18,6 +18,7 @@
 #ifndef MISC_TOOLBOX_H
 #define MISC_TOOLBOX_H
 /* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
 #include "stm32n6xx_hal.h"
 #if NUCLEO_N6_CONFIG == 0
 #include "stm32n6570_discovery.h"
@@ -59,9 +60,107 @@ void set_vector_table_addr(void);
 // Basic initialization of the board after startup: Activates all RAMs, allow caches to be enabled.
 void system_init_post(void);
 
+// Maps [start_addr, start_addr+size) write-through/read-allocate through the
+// given MPU region (used for the IO buffer arenas, see USE_MPU_WT_IO)
+void MPU_WT_Region_Config(uint32_t region, uint32_t start_addr, uint32_t size);
+
+// PC sampling profiler (USE_PC_SAMPLING): arms/disarms the SysTick PC capture,
+// pc_sample_capture is called from the SysTick handler with the stacked PC
+void pc_sample_start(void);
+void pc_sample_stop(void);
+void pc_sample_capture(uint32_t pc);
+int pc_sample_read(uint32_t *pc);
+uint32_t pc_sample_dropped(void);
+
+// Fast xorshift32 PRNG step (seed/state must be non-zero)
+uint32_t toolbox_prng_next(uint32_t *state);
+
+// Fills a buffer with xorshift32 pseudo-random bytes, advancing the state
+void toolbox_prng_fill(void *dst, uint32_t size, uint32_t *state);
+
+// True-random 32-bit word from the RNG peripheral (seeds the fills below)
+uint32_t toolbox_trng_word(void);
+
+// Fills a buffer with a constant 32-bit pattern (replicated on 4-byte strides
+// from dst) through the GPDMA; the CPU only writes the unaligned head/tail
+void toolbox_fill_const(void *dst, uint32_t size, uint32_t pattern);
+
+// Fills a buffer with TRNG-seeded xorshift32 data: the CPU expands the stream
+// into cache-resident blocks while the GPDMA drains the previous block into
+// the arena. Returns the seed, so the fill can be replayed with toolbox_prng_fill
+uint32_t toolbox_fill_random(void *dst, uint32_t size);
+
+// Bulk memcpy through a reserved GPDMA channel, cache maintenance on both
+// ranges included (the DMA-copied destination ends up in memory, not the
+// MCU cache); small copies fall back to memcpy and stay cached. The async
+// variant leaves the transfer in flight and must be closed with
+// toolbox_copy_wait before the destination is read or the next copy starts
+void toolbox_copy(void *dst, const void *src, uint32_t size);
+void toolbox_copy_async(void *dst, const void *src, uint32_t size);
+void toolbox_copy_wait(void);
+
 #ifdef HAL_BSEC_MODULE_ENABLED
 // Fuse OTP bits to set VDDIO2/3 I/O segments below 2.5V for I/O mode
 void fuse_vddio(void);
 #endif
 
+// Boot-phase timestamps (DWT cycle stamps from boot_ts_start, reported by
+// the SYS_INFO command): each mark records the raw DWT cycle count at a
+// boot-phase boundary. Stamps before BOOT_TS_CLOCK count at the reset
+// clock, the later ones at the configured system clock.
+enum boot_ts_phase {
+  BOOT_TS_CLOCK = 0,  /* system clock configured, caches on */
+  BOOT_TS_COM,        /* UART up, USB device started (enumeration pending) */
+  BOOT_TS_NPU,        /* NPU, external memories and RISAF configured */
+  BOOT_TS_READY,      /* models installed, command loop entered */
+  BOOT_TS_COUNT
+};
+void boot_ts_start(void);       // starts the DWT cycle counter (call first in main)
+void boot_ts_mark(int phase);   // stamps the DWT cycle count for a phase
+uint32_t boot_ts_get(int phase);
+
+// Runtime clock profiles: the boot configuration is the thermally
+// sustainable baseline, the boost profile re-divides IC6 (NPU) and IC11
+// (NPU RAMs/NIC) for the duration of a run only (duty-cycled, applied
+// around npu_run with settle-time handling). Host-driven through the
+// CLK_PROFILE command; achieved frequencies are reported per run.
+#define CLK_PROFILE_NORMAL  (0)
+#define CLK_PROFILE_BOOST   (1)
+
+// Programs a profile (boost dividers apply to the ICs' current PLLs,
+// 0 = divider 1); rejects peaks above the datasheet maxima. Returns 0 on
+// success, -1 on an invalid profile/divider.
+int clk_profile_set(int profile, uint32_t npu_div, uint32_t nic_div);
+int clk_profile_get(void);
+
+// Applies/restores the boost dividers around a run (no-ops when the
+// normal profile is active); both wait for the divider retiming to settle
+void clk_profile_run_enter(void);
+void clk_profile_run_exit(void);
+
+// Achieved (register-derived) NPU / NPU-RAM frequencies a run executes
+// at, in Hz (with a boost profile armed, the boosted values)
+void clk_profile_freqs(uint32_t *npu_hz, uint32_t *nic_hz);
+
+// DMA-drained log backend (USE_LOG_DMA): characters land in a ring buffer
+// and a GPDMA channel feeds them to USART1 in the background. Overflow
+// policy is drop-oldest, the newest output always survives (sacrificed
+// byte count in log_dma_dropped). log_dma_irq is the channel IRQ body,
+// called from the GPDMA1 channel handler in stm32n6xx_it.c.
+void log_dma_putc(const char c);
+void log_dma_flush(void);       // busy-waits until the ring is drained
+uint32_t log_dma_dropped(void);
+void log_dma_irq(void);
+
+// Circular-DMA UART reception (USE_COM_DMA_IDLE_RX): a GPDMA channel
+// streams USART1 RX bytes into a ring and the IDLE-line interrupt frames
+// the bursts, one interrupt per packet instead of per-byte servicing.
+// com_rx_start is called from UART_Config; the read/get/wait functions
+// back the port_io_* hooks of ai_device_adaptor.h.
+void com_rx_start(void);
+bool com_rx_read(uint8_t *buff, int count);       // blocking
+bool com_rx_get(uint8_t *c, uint32_t timeout);    // false on timeout
+bool com_rx_pending(void);
+void com_rx_wait(void);
+
 #endif // MISC_TOOLBOX_H
\ No newline at end of file
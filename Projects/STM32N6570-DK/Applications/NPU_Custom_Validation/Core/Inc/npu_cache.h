@@ -31,6 +31,28 @@ void npu_cache_invalidate(void);
 void npu_cache_clean_invalidate_range(uint32_t start_addr, uint32_t end_addr);
 void npu_cache_clean_range(uint32_t start_addr, uint32_t end_addr);
 
+/* Best-effort pinning of hot (read-only) windows. The CACHEAXI has no
+   line-lock hardware, so a registered range is not protected from capacity
+   eviction; instead the run path keeps the resident lines alive by skipping
+   the whole-cache scrub while pins are registered (the IO windows are then
+   maintained by range, see _prepare_input_buffers). */
+#define NPU_CACHE_PIN_SLOTS (4)
+
+int npu_cache_pin_range(uint32_t start_addr, uint32_t end_addr);
+void npu_cache_unpin_all(void);
+int npu_cache_has_pins(void);
+
+/* Asynchronous maintenance (USE_NPU_CACHE_ASYNC). When armed, clean-range
+   requests are queued and retired from the CACHEAXI completion interrupt,
+   overlapping the maintenance of a finished epoch's output windows with the
+   next epoch's execution. npu_cache_sync() blocks until the queue is empty
+   and must precede any read of the cleaned data from outside the NPU (CPU,
+   DMA, debug probe). Both are no-ops when the flag is off. */
+#define NPU_CACHE_ASYNC_SLOTS (8)
+
+void npu_cache_set_async(int enable);
+void npu_cache_sync(void);
+
 #ifdef __cplusplus
 }
 #endif
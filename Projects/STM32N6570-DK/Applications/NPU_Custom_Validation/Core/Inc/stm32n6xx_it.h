@@ -25,11 +25,52 @@
 #endif 
 
 /* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
 /* Exported types ------------------------------------------------------------*/
 /* Exported constants --------------------------------------------------------*/
+/* Per-vector IRQ activity counters, free-running since boot. Read as
+   before/after deltas by the jitter analyzer of the benchmark command. */
+#define IT_IRQ_SYSTICK  (0)
+#define IT_IRQ_USART1   (1)
+#define IT_IRQ_USB      (2)
+#define IT_IRQ_LOGDMA   (3)
+#define IT_IRQ_NUM      (4)
+
+extern volatile uint32_t it_irq_count[IT_IRQ_NUM];
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
 
+/* Benchmark interrupt quiescing: masks the non-essential interrupt set
+   (USB, USART1, SysTick tick interrupt) for the duration of a measured
+   run and restores it afterwards. it_quiesce_exit() takes the measured
+   duration in CPU cycles to credit the frozen HAL timebase and returns
+   the number of masked vectors that latched a pending arrival (a lower
+   bound on the suppressed interrupts: NVIC keeps one pending bit per
+   vector). Not nestable. */
+void it_quiesce_enter(void);
+uint32_t it_quiesce_exit(uint32_t elapsed_cycles);
+
+/* Interrupt priority tiers (preemption level, lower runs first). The
+   whole scheme is configured in one place by it_set_priorities() - audit
+   or extend the tier map there, not at the individual enable sites. The
+   NPU completion lines must never wait behind transport servicing. */
+#define IT_PRIO_NPU           (1)   /* ATON completion lines (NPU0..3) */
+#define IT_PRIO_DMA           (3)   /* GPDMA transfer-complete lines */
+#define IT_PRIO_TRANSPORT     (5)   /* USART1, USB */
+#define IT_PRIO_HOUSEKEEPING  (7)   /* SysTick timebase */
+
+void it_set_priorities(void);
+
+/* IRQ-entry latency probe (DWT cycle counter): the vector is software
+   pended with a cycle stamp taken right before, the instrumented handler
+   captures the delta on entry - the NVIC-entry latency under whatever is
+   running/masked at that moment. it_lat_probe returns the latency in
+   cycles, 0 when the vector is not instrumented or never fired;
+   it_lat_capture is the handler side and returns 1 when it consumed a
+   probe (for SysTick: a probe entry must not advance the timebase). */
+uint32_t it_lat_probe(int32_t irq);
+int it_lat_capture(int32_t irq);
+
 void NMI_Handler(void);
 void HardFault_Handler(void);
 void MemManage_Handler(void);
@@ -27,6 +27,7 @@
 
 #include "main.h"
 #include "misc_toolbox.h"
+#include "stm32n6xx_it.h"   /* it_set_priorities() */
 
 #include "aiValidation.h"
 #if defined(USE_USB_CDC_CLASS)
@@ -49,7 +50,9 @@ int main(void)
 {
   // Set VTOR to proper address and ack possible pending IRQs
   set_vector_table_addr();
-  
+
+  boot_ts_start();  /* reset-to-ready budget, see boot_ts_mark() below */
+
   HAL_Init();
   
   // Ensure proper clocking after a reset / after exiting the bootloader
@@ -91,11 +94,14 @@ int main(void)
   /* Clear SLEEPDEEP bit of Cortex System Control Register */
   CLEAR_BIT(SCB->SCR, SCB_SCR_SLEEPDEEP_Msk);
 
+  boot_ts_mark(BOOT_TS_CLOCK);
+
   UART_Config();
 #if defined(USE_USB_CDC_CLASS)
   MX_USBX_Device_Init();
   USB_RIF_Config();
 #endif
+  boot_ts_mark(BOOT_TS_COM);  /* USB started, enumeration continues in background */
   NPU_Config();
   
 #if defined(USE_EXTERNAL_MEMORY_DEVICES) && USE_EXTERNAL_MEMORY_DEVICES == 1
@@ -122,8 +128,10 @@ int main(void)
   
   RISAF_Config();
 
-/* USED FOR TESTING ACCESS TO EXTERNAL MEMORIES */  
-#if defined(USE_EXTERNAL_MEMORY_DEVICES) && USE_EXTERNAL_MEMORY_DEVICES == 1
+/* USED FOR TESTING ACCESS TO EXTERNAL MEMORIES */
+/* (skipped on the fast-boot path: the 16 MB hyperRAM test pattern alone is
+   tens of milliseconds, multiplied by every farm reboot) */
+#if defined(USE_EXTERNAL_MEMORY_DEVICES) && USE_EXTERNAL_MEMORY_DEVICES == 1 && !(defined(USE_FAST_BOOT) && USE_FAST_BOOT == 1)
   uint32_t x[20];
   memcpy((uint32_t*)x, (uint32_t*)0x70000000, 20*4);
 #if (NUCLEO_N6_CONFIG == 0)
@@ -133,9 +141,24 @@ int main(void)
 #endif
   
   set_clk_sleep_mode();
-  
+
+  /* all interrupt sources are configured: apply the priority tier map
+     (overrides the per-peripheral defaults set during init) */
+  it_set_priorities();
+
+  boot_ts_mark(BOOT_TS_NPU);
+
+#if defined(USE_BENCH_HARNESS) && USE_BENCH_HARNESS == 1
+  /* push-button benchmark image: no host command loop, the generated plan
+     runs at boot and the report goes out over the UART */
+  aiBenchHarnessRun();
+  while (1) {
+    __WFI();
+  }
+#else
   aiValidationInit();
   aiValidationProcess();
+#endif
 
 }
 
@@ -274,7 +297,7 @@ void HAL_PCD_MspInit(PCD_HandleTypeDef* pcdHandle)
     __HAL_RCC_USB1_OTG_HS_PHY_CLK_ENABLE();
 
     /* USB_OTG_HS interrupt Init */
-    HAL_NVIC_SetPriority(USB1_OTG_HS_IRQn, 7, 0);
+    HAL_NVIC_SetPriority(USB1_OTG_HS_IRQn, IT_PRIO_TRANSPORT, 0);
     HAL_NVIC_EnableIRQ(USB1_OTG_HS_IRQn);
 
     /* USER CODE BEGIN USB_OTG_HS_MspInit 1 */
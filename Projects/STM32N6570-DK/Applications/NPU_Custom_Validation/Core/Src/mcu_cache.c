@@ -76,6 +76,59 @@ int mcu_cache_clean_range(uint32_t start_addr, uint32_t end_addr) {
   return 0;
 }
 
+int mcu_cache_op_ranges(enum mcu_cache_op op, struct mcu_cache_range *ranges, int n_ranges)
+{
+  if(!mcu_cache_enabled() || (n_ranges <= 0)) {
+    return 0;
+  }
+
+  /* insertion sort by start address, the lists are small */
+  for (int i = 1; i < n_ranges; i++) {
+    struct mcu_cache_range key = ranges[i];
+    int j = i - 1;
+    while ((j >= 0) && (ranges[j].start_addr > key.start_addr)) {
+      ranges[j + 1] = ranges[j];
+      j--;
+    }
+    ranges[j + 1] = key;
+  }
+
+  __DSB();
+
+  for (int i = 0; i < n_ranges; i++) {
+    uint32_t addr = ranges[i].start_addr & ~(__SCB_DCACHE_LINE_SIZE - 1U);
+    uint32_t end = ranges[i].end_addr;
+
+    /* merge the following ranges while they overlap or touch (line granularity) */
+    while (((i + 1) < n_ranges) &&
+           ((ranges[i + 1].start_addr & ~(__SCB_DCACHE_LINE_SIZE - 1U)) <= end)) {
+      i++;
+      if (ranges[i].end_addr > end) {
+        end = ranges[i].end_addr;
+      }
+    }
+
+    for (; addr < end; addr += __SCB_DCACHE_LINE_SIZE) {
+      switch (op) {
+        case MCU_CACHE_OP_CLEAN:
+          SCB->DCCMVAC = addr;
+          break;
+        case MCU_CACHE_OP_INVALIDATE:
+          SCB->DCIMVAC = addr;
+          break;
+        default:
+          SCB->DCCIMVAC = addr;
+          break;
+      }
+    }
+  }
+
+  __DSB();
+  __ISB();
+
+  return 0;
+}
+
 void set_mcu_cache_state(uint8_t i_cache_state, uint8_t d_cache_state)
 {
   if (i_cache_state)
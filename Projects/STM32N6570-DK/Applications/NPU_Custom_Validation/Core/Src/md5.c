@@ -76,8 +76,16 @@
  * inlined into a calling function, or with future and dangerously advanced
  * link-time optimizations.  For the time being, keeping these MD5 routines in
  * their own translation unit avoids the problem.
+ *
+ * Little-endian Arm cores with hardware unaligned-access support (such as the
+ * Cortex-M55 this firmware runs on) take the same direct-load fast path: it
+ * removes the per-word byte assembly into ctx->block, which dominates when
+ * hashing multi-MB weight regions.  Note the STM32N6 HASH peripheral cannot
+ * take over here: it implements the SHA family only, and the host protocol
+ * expects MD5 digests.
  */
-#if defined(__i386__) || defined(__x86_64__) || defined(__vax__)
+#if defined(__i386__) || defined(__x86_64__) || defined(__vax__) || \
+	(defined(__ARM_FEATURE_UNALIGNED) && !defined(__ARM_BIG_ENDIAN))
 #define SET(n) \
 	(*(MD5_u32plus *)&ptr[(n) * 4])
 #define GET(n) \
@@ -20,7 +20,9 @@
 
 #include "misc_toolbox.h"
 #include "app_config.h"
+#include "stm32n6xx_it.h"  // Priority tiers (IT_PRIO_*)
 #include "npu_cache.h"  // Used in NPU_config
+#include "mcu_cache.h"  // Cache maintenance around the fill DMA
 #include "stm32n6xx_ll_usart.h" // Used for configuring UART
 #include "ai_wrapper_ATON.h"    // Used to get NPU cache enable / counters info
 
@@ -225,6 +227,15 @@ void UART_Config(void)
   }
   // Disable FIFO mode
   UartHandle.Instance->CR1 &= ~USART_CR1_FIFOEN;
+
+  /* The RX interrupt is only used as a WFI wake-up event by the validation
+     event loop, no data is moved under interrupt (see port_io_wait_for_rx) */
+  HAL_NVIC_SetPriority(USART1_IRQn, IT_PRIO_TRANSPORT, 0);
+  HAL_NVIC_EnableIRQ(USART1_IRQn);
+
+#if defined(USE_COM_DMA_IDLE_RX) && USE_COM_DMA_IDLE_RX == 1
+  com_rx_start();
+#endif
 }
 
 /**
@@ -262,8 +273,11 @@ void NPU_Config(void)
   // __HAL_RCC_RAMCFG_CLK_SLEEP_DISABLE();
   npu_cache_init(); 
 
-#ifdef USE_NPU_CACHE  
+#ifdef USE_NPU_CACHE
    npu_cache_enable(); // Useless: already enabled by init
+#if defined(USE_NPU_CACHE_ASYNC) && USE_NPU_CACHE_ASYNC == 1
+   npu_cache_set_async(1); // interrupt-driven clean-range maintenance
+#endif
 #else
    npu_cache_disable();
 #endif
@@ -343,6 +357,376 @@ void system_init_post(void)
   MEMSYSCTL->MSCR |= MEMSYSCTL_MSCR_DCACTIVE_Msk | MEMSYSCTL_MSCR_ICACTIVE_Msk;
 }
 
+/* MPU attribute slot used for the write-through IO mappings */
+#define _MPU_ATTR_WT_RA_IDX   (0)
+
+void MPU_WT_Region_Config(uint32_t region, uint32_t start_addr, uint32_t size)
+{
+  ARM_MPU_Disable();
+
+  /* normal memory, outer/inner write-through, read-allocate: CPU stores
+     reach the backing memory immediately, there are no dirty lines to
+     clean before handing the window to the NPU. Non-shareable: the CM55
+     has no coherency hardware, marking the region shareable would only
+     disable the read caching. */
+  ARM_MPU_SetMemAttr(_MPU_ATTR_WT_RA_IDX,
+                     ARM_MPU_ATTR(ARM_MPU_ATTR_MEMORY_(1, 0, 1, 0),
+                                  ARM_MPU_ATTR_MEMORY_(1, 0, 1, 0)));
+
+  ARM_MPU_SetRegion(region,
+                    ARM_MPU_RBAR(start_addr, ARM_MPU_SH_NON, 0 /* RW */, 1, 1 /* XN */),
+                    ARM_MPU_RLAR(start_addr + size - 1, _MPU_ATTR_WT_RA_IDX));
+
+  /* the default memory map stays in place for everything not covered */
+  ARM_MPU_Enable(MPU_CTRL_PRIVDEFENA_Msk | MPU_CTRL_HFNMIENA_Msk);
+}
+
+/* PC sampling profiler (USE_PC_SAMPLING)
+   The SysTick handler stores the interrupted PC here while sampling is
+   armed (pc_sample_start/stop bracket the inference). Single producer
+   (the SysTick ISR) / single consumer (the RUN handler drain, with
+   sampling already disarmed): free-running indices, no masking needed.
+   Drop-newest on full so the drained history stays consistent. */
+
+#ifndef PC_SAMPLE_RING_SZ
+#define PC_SAMPLE_RING_SZ   (2048)  /* power of two, 2 s at the 1 kHz tick */
+#endif
+
+static uint32_t _pcs_ring[PC_SAMPLE_RING_SZ];
+static volatile uint32_t _pcs_head;
+static volatile uint32_t _pcs_tail;
+static volatile uint32_t _pcs_dropped;
+static volatile int _pcs_armed;
+
+void pc_sample_start(void)
+{
+  _pcs_head = 0;
+  _pcs_tail = 0;
+  _pcs_dropped = 0;
+  _pcs_armed = 1;
+}
+
+void pc_sample_stop(void)
+{
+  _pcs_armed = 0;
+}
+
+void pc_sample_capture(uint32_t pc)
+{
+  if (!_pcs_armed)
+    return;
+  uint32_t head = _pcs_head;
+  if ((head - _pcs_tail) >= PC_SAMPLE_RING_SZ) {
+    _pcs_dropped++;
+    return;
+  }
+  _pcs_ring[head % PC_SAMPLE_RING_SZ] = pc;
+  _pcs_head = head + 1;
+}
+
+int pc_sample_read(uint32_t *pc)
+{
+  uint32_t tail = _pcs_tail;
+  if (tail == _pcs_head)
+    return 0;
+  *pc = _pcs_ring[tail % PC_SAMPLE_RING_SZ];
+  _pcs_tail = tail + 1;
+  return 1;
+}
+
+uint32_t pc_sample_dropped(void)
+{
+  return _pcs_dropped;
+}
+
+/* Fast xorshift32 PRNG (Marsaglia), used to synthesize input tensors for
+   link-free performance runs. Not cryptographic, fully reproducible from
+   the 32-bit seed. State must be non-zero. */
+uint32_t toolbox_prng_next(uint32_t *state)
+{
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+void toolbox_prng_fill(void *dst, uint32_t size, uint32_t *state)
+{
+  uint8_t *p = (uint8_t *)dst;
+
+  while (size >= 4) {
+    uint32_t w = toolbox_prng_next(state);
+    memcpy(p, &w, 4);  /* destination is not necessarily aligned */
+    p += 4;
+    size -= 4;
+  }
+  if (size) {
+    uint32_t w = toolbox_prng_next(state);
+    memcpy(p, &w, size);
+  }
+}
+
+/* Fast arena fills: the large IO/weight arenas live in external or AXI
+   memory and filling them with CPU stores runs at store speed through the
+   write buffer. The fills below push the bulk of the traffic through a
+   GPDMA channel instead; the RNG peripheral has no GPDMA request line on
+   this device, so random fills seed the xorshift32 stream from the TRNG
+   and let the CPU expand it into small cache-resident blocks while the
+   DMA drains the previous block into the arena. */
+
+#define _FILL_DMA_CHANNEL_IDX   (12)    /* 13/15 used by the lazy stager / weight prefetch */
+#define _FILL_DMA_CHANNEL       GPDMA1_Channel12
+#define _FILL_BOUNCE_SZ         (1024)
+
+static bool _fill_dma_ready;
+static uint32_t _fill_pattern;          /* fixed source of the constant fills */
+static uint32_t _fill_bounce[2][_FILL_BOUNCE_SZ / 4];
+
+static void _fill_dma_wait(void)
+{
+  while (_FILL_DMA_CHANNEL->CCR & DMA_CCR_EN) {}
+}
+
+static void _fill_dma_kick(const void *src, void *dst, uint32_t size, uint32_t ctr1)
+{
+  DMA_Channel_TypeDef *ch = _FILL_DMA_CHANNEL;
+
+  if (!_fill_dma_ready) {
+    __HAL_RCC_GPDMA1_CLK_ENABLE();
+    GPDMA1_S->SECCFGR |= (1UL << _FILL_DMA_CHANNEL_IDX);
+    _fill_dma_ready = true;
+  }
+
+  ch->CFCR = 0x00007F00UL;  /* clear the transfer flags */
+  ch->CTR1 = ctr1;
+  ch->CTR2 = DMA_CTR2_SWREQ;  /* memory-to-memory */
+  ch->CSAR = (uint32_t)src;
+  ch->CDAR = (uint32_t)dst;
+  ch->CBR1 = size & DMA_CBR1_BNDT_Msk;
+  ch->CCR = DMA_CCR_EN;
+}
+
+/* 4-byte incrementing source / destination bursts */
+#define _FILL_CTR1_COPY  ((2UL << DMA_CTR1_SDW_LOG2_Pos) | DMA_CTR1_SINC | \
+                          (7UL << DMA_CTR1_SBL_1_Pos) | \
+                          (2UL << DMA_CTR1_DDW_LOG2_Pos) | DMA_CTR1_DINC | \
+                          (7UL << DMA_CTR1_DBL_1_Pos))
+/* fixed 4-byte source, 4-byte incrementing destination bursts */
+#define _FILL_CTR1_CONST ((2UL << DMA_CTR1_SDW_LOG2_Pos) | \
+                          (2UL << DMA_CTR1_DDW_LOG2_Pos) | DMA_CTR1_DINC | \
+                          (7UL << DMA_CTR1_DBL_1_Pos))
+
+/* CPU reference fill: pattern replicated on 4-byte strides from dst */
+static void _fill_const_cpu(uint8_t *p, uint32_t size, uint32_t pattern)
+{
+  while (size >= 4) {
+    memcpy(p, &pattern, 4);
+    p += 4;
+    size -= 4;
+  }
+  if (size)
+    memcpy(p, &pattern, size);
+}
+
+uint32_t toolbox_trng_word(void)
+{
+  __HAL_RCC_RNG_CLK_ENABLE();
+  if (!(RNG->CR & RNG_CR_RNGEN))
+    RNG->CR |= RNG_CR_RNGEN;
+  while (!(RNG->SR & RNG_SR_DRDY)) {}
+  return RNG->DR;
+}
+
+void toolbox_fill_const(void *dst, uint32_t size, uint32_t pattern)
+{
+  uint8_t *p = (uint8_t *)dst;
+  uint32_t head = (4U - ((uintptr_t)p & 3U)) & 3U;
+
+  if (size <= 64U) {  /* not worth the cache maintenance */
+    _fill_const_cpu(p, size, pattern);
+    return;
+  }
+
+  uint32_t body = (size - head) & ~3UL;
+  uint32_t tail = size - head - body;
+
+  /* the word stream past the unaligned head is offset by 'head' bytes:
+     rotate the pattern so the byte lanes still match a fill replicated on
+     4-byte strides from dst (little-endian) */
+  _fill_pattern = (head == 0U) ? pattern
+      : (pattern >> (8U * head)) | (pattern << (8U * (4U - head)));
+
+  /* head/tail by CPU first, so the later clean pushes them out before the
+     DMA owns the body lines */
+  _fill_const_cpu(p, head, pattern);
+  _fill_const_cpu(p + head + body, tail, _fill_pattern);
+
+  mcu_cache_clean_range((uint32_t)&_fill_pattern, (uint32_t)&_fill_pattern + 4U);
+  mcu_cache_clean_invalidate_range((uint32_t)p, (uint32_t)p + size);
+
+  p += head;
+  while (body) {
+    uint32_t chunk = (body > (DMA_CBR1_BNDT_Msk & ~3UL)) ? (DMA_CBR1_BNDT_Msk & ~3UL) : body;
+    _fill_dma_kick(&_fill_pattern, p, chunk, _FILL_CTR1_CONST);
+    _fill_dma_wait();
+    p += chunk;
+    body -= chunk;
+  }
+}
+
+uint32_t toolbox_fill_random(void *dst, uint32_t size)
+{
+  uint8_t *p = (uint8_t *)dst;
+  uint32_t seed = toolbox_trng_word();
+  uint32_t state;
+  int cur = 0;
+  bool inflight = false;
+
+  if (seed == 0U)       /* xorshift32 state must be non-zero */
+    seed = 0xB5297A4DUL;
+  state = seed;
+
+  /* small fills (or an unaligned destination) are cheaper by CPU */
+  if ((size <= _FILL_BOUNCE_SZ) || (((uintptr_t)p & 3U) != 0U)) {
+    toolbox_prng_fill(p, size, &state);
+    return seed;
+  }
+
+  mcu_cache_clean_invalidate_range((uint32_t)p, (uint32_t)p + size);
+
+  while (size >= 4U) {
+    uint32_t chunk = (size > _FILL_BOUNCE_SZ) ? _FILL_BOUNCE_SZ : (size & ~3UL);
+    /* expand the next block while the previous one is still draining */
+    toolbox_prng_fill(_fill_bounce[cur], chunk, &state);
+    mcu_cache_clean_range((uint32_t)_fill_bounce[cur], (uint32_t)_fill_bounce[cur] + chunk);
+    if (inflight)
+      _fill_dma_wait();
+    _fill_dma_kick(_fill_bounce[cur], p, chunk, _FILL_CTR1_COPY);
+    inflight = true;
+    p += chunk;
+    size -= chunk;
+    cur ^= 1;
+  }
+  if (inflight)
+    _fill_dma_wait();
+  if (size)
+    toolbox_prng_fill(p, size, &state);  /* trailing bytes, already invalidated above */
+
+  return seed;
+}
+
+/* Bulk copies: the big data moves outside the NPU path (host uploads into
+   external memory, staging-pool copies) run at CPU store speed when done
+   with memcpy. The copy below pushes the aligned body of the transfer
+   through a reserved GPDMA channel - mutually aligned buffers go as
+   4-byte bursts, the rest byte-wide (still bursted) - and handles the
+   cache maintenance on both ranges. The async variant returns with the
+   transfer in flight so the caller can overlap its own work; it must be
+   closed with toolbox_copy_wait before the destination is read or the
+   next copy is started. */
+
+#define _COPY_DMA_CHANNEL_IDX   (10)    /* 11 log drain, 12 arena fills, 13/15 lazy stager / weight prefetch, 14 com rx */
+#define _COPY_DMA_CHANNEL       GPDMA1_Channel10
+#define _COPY_DMA_MIN           (512U)      /* below this the channel setup costs more than the copy */
+#define _COPY_DMA_MAX           (0xFFC0U)   /* BNDT is 16 bits, keep chunks 4-byte multiples */
+
+/* byte-wide incrementing source / destination bursts */
+#define _COPY_CTR1_BYTE  (DMA_CTR1_SINC | (7UL << DMA_CTR1_SBL_1_Pos) | \
+                          DMA_CTR1_DINC | (7UL << DMA_CTR1_DBL_1_Pos))
+
+static bool _copy_dma_ready;
+static bool _copy_inflight;
+static uint32_t _copy_inv_start;    /* destination body, invalidated on wait */
+static uint32_t _copy_inv_end;
+
+void toolbox_copy_wait(void)
+{
+  if (!_copy_inflight)
+    return;
+  while (_COPY_DMA_CHANNEL->CCR & DMA_CCR_EN) {}
+  /* guards against lines speculatively refetched while the DMA wrote */
+  mcu_cache_invalidate_range(_copy_inv_start, _copy_inv_end);
+  _copy_inflight = false;
+}
+
+void toolbox_copy_async(void *dst, const void *src, uint32_t size)
+{
+  uint8_t *d = (uint8_t *)dst;
+  const uint8_t *s = (const uint8_t *)src;
+  uint32_t head = 0, body, ctr1;
+
+  toolbox_copy_wait();    /* single channel, close a pending transfer */
+
+  if (size < _COPY_DMA_MIN) {
+    memcpy(d, s, size);
+    return;
+  }
+
+  if ((((uintptr_t)d ^ (uintptr_t)s) & 3U) == 0U) {
+    /* mutually aligned: 4-byte bursts, the CPU takes the unaligned head
+       and the sub-word tail */
+    head = (4U - ((uintptr_t)d & 3U)) & 3U;
+    body = (size - head) & ~3UL;
+    ctr1 = _FILL_CTR1_COPY;
+  } else {
+    body = size;
+    ctr1 = _COPY_CTR1_BYTE;
+  }
+
+  memcpy(d, s, head);
+  memcpy(d + head + body, s + head + body, size - head - body);
+
+  DMA_Channel_TypeDef *ch = _COPY_DMA_CHANNEL;
+
+  if (!_copy_dma_ready) {
+    __HAL_RCC_GPDMA1_CLK_ENABLE();
+    GPDMA1_S->SECCFGR |= (1UL << _COPY_DMA_CHANNEL_IDX);
+    _copy_dma_ready = true;
+  }
+
+  /* full ranges: the CPU-written head/tail share the body's boundary
+     lines and must reach memory before the DMA touches them */
+  mcu_cache_clean_range((uint32_t)s, (uint32_t)s + size);
+  mcu_cache_clean_invalidate_range((uint32_t)d, (uint32_t)d + size);
+
+  _copy_inv_start = (uint32_t)d;
+  _copy_inv_end = (uint32_t)d + size;
+
+  uint32_t off = head;
+
+  /* BNDT is 16 bits: everything but the last chunk drains synchronously */
+  while (body > _COPY_DMA_MAX) {
+    ch->CFCR = 0x00007F00UL;  /* clear the transfer flags */
+    ch->CTR1 = ctr1;
+    ch->CTR2 = DMA_CTR2_SWREQ;  /* memory-to-memory */
+    ch->CSAR = (uint32_t)(s + off);
+    ch->CDAR = (uint32_t)(d + off);
+    ch->CBR1 = _COPY_DMA_MAX;
+    ch->CCR = DMA_CCR_EN;
+    while (ch->CCR & DMA_CCR_EN) {}
+    off += _COPY_DMA_MAX;
+    body -= _COPY_DMA_MAX;
+  }
+
+  ch->CFCR = 0x00007F00UL;
+  ch->CTR1 = ctr1;
+  ch->CTR2 = DMA_CTR2_SWREQ;
+  ch->CSAR = (uint32_t)(s + off);
+  ch->CDAR = (uint32_t)(d + off);
+  ch->CBR1 = body & DMA_CBR1_BNDT_Msk;
+  ch->CCR = DMA_CCR_EN;
+
+  _copy_inflight = true;
+}
+
+void toolbox_copy(void *dst, const void *src, uint32_t size)
+{
+  toolbox_copy_async(dst, src, size);
+  toolbox_copy_wait();
+}
+
 #ifdef HAL_BSEC_MODULE_ENABLED
 void fuse_vddio(void)
 {
@@ -351,4 +735,400 @@ void fuse_vddio(void)
     // Fuse bit for VDDIO3 (HSLV_VDDIO3): used for external Flash / XSPIM2
     fuse_hardware_conf(15);
 }
-#endif
\ No newline at end of file
+#endif
+/* Boot-phase timestamps. The DWT cycle counter is started as the very
+   first thing in main() and stamped at each boot-phase boundary; the
+   SYS_INFO command reports the marks so the farm dashboards can budget
+   reset-to-ready time per phase. The DWT counter is independent of the
+   PMU CCNTR used by the per-run instrumentation, so the marks survive a
+   cyclesCounterInit(). Marks before BOOT_TS_CLOCK count at the reset
+   clock, the later ones at the configured system clock. */
+static uint32_t _boot_ts[BOOT_TS_COUNT];
+
+void boot_ts_start(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+void boot_ts_mark(int phase)
+{
+  if ((phase >= 0) && (phase < BOOT_TS_COUNT))
+    _boot_ts[phase] = DWT->CYCCNT;
+}
+
+uint32_t boot_ts_get(int phase)
+{
+  if ((phase < 0) || (phase >= BOOT_TS_COUNT))
+    return 0;
+  return _boot_ts[phase];
+}
+
+/* Runtime clock profiles. The boot configuration (system_clock_config.c)
+   stays the thermally sustainable baseline; a boost profile re-divides
+   IC6 (NPU) and IC11 (NPU RAMs/NIC) from their already-running PLLs for
+   the duration of a run only (clk_profile_run_enter/exit around
+   npu_run), so latency-critical inferences get the burst without the
+   sustained thermal cost. The CPU/bus/peripheral clocks (IC1/IC2, PCLKx)
+   are never touched, the UART baud rate and HAL tick are unaffected. */
+#include "stm32n6xx_ll_rcc.h"
+
+static uint32_t _boost_ic6_div;     /* 0 = no boost profile programmed */
+static uint32_t _boost_ic11_div;
+static uint32_t _saved_ic6_div;
+static uint32_t _saved_ic11_div;
+static int _clk_profile = CLK_PROFILE_NORMAL;
+static bool _boost_applied;
+
+/* PLL output feeding an IC, from the LL_RCC_ICCLKSOURCE_* selection */
+static uint32_t _ic_src_freq(uint32_t source)
+{
+  switch (source) {
+  case LL_RCC_ICCLKSOURCE_PLL2:
+    return HAL_RCCEx_GetPLL2CLKFreq();
+  case LL_RCC_ICCLKSOURCE_PLL3:
+    return HAL_RCCEx_GetPLL3CLKFreq();
+  case LL_RCC_ICCLKSOURCE_PLL4:
+    return HAL_RCCEx_GetPLL4CLKFreq();
+  default:
+    return HAL_RCCEx_GetPLL1CLKFreq();
+  }
+}
+
+/* the IC divider update is glitch-free but is retimed over a few ic_ck
+   cycles; DSB plus a ~1us spin covers the settle at every supported
+   frequency before the caller starts timing */
+static void _clk_settle(void)
+{
+  __DSB();
+  for (volatile uint32_t i = 0; i < 800U; i++) {
+    __NOP();
+  }
+}
+
+int clk_profile_set(int profile, uint32_t npu_div, uint32_t nic_div)
+{
+  if (profile == CLK_PROFILE_NORMAL) {
+    clk_profile_run_exit();  /* drop an applied boost right away */
+    _clk_profile = CLK_PROFILE_NORMAL;
+    return 0;
+  }
+
+  if (profile != CLK_PROFILE_BOOST)
+    return -1;
+
+  npu_div = (npu_div == 0U) ? 1U : npu_div;
+  nic_div = (nic_div == 0U) ? 1U : nic_div;
+  if ((npu_div > 256U) || (nic_div > 256U))
+    return -1;
+
+  /* keep the duty-cycled peaks within the datasheet maxima */
+  if ((_ic_src_freq(LL_RCC_IC6_GetSource()) / npu_div) > 1000000000UL)
+    return -1;
+  if ((_ic_src_freq(LL_RCC_IC11_GetSource()) / nic_div) > 900000000UL)
+    return -1;
+
+  _boost_ic6_div = npu_div;
+  _boost_ic11_div = nic_div;
+  _clk_profile = CLK_PROFILE_BOOST;
+  return 0;
+}
+
+int clk_profile_get(void)
+{
+  return _clk_profile;
+}
+
+void clk_profile_run_enter(void)
+{
+  if ((_clk_profile != CLK_PROFILE_BOOST) || _boost_applied)
+    return;
+  _saved_ic6_div = LL_RCC_IC6_GetDivider();
+  _saved_ic11_div = LL_RCC_IC11_GetDivider();
+  LL_RCC_IC6_SetDivider(_boost_ic6_div);
+  LL_RCC_IC11_SetDivider(_boost_ic11_div);
+  _boost_applied = true;
+  _clk_settle();
+}
+
+void clk_profile_run_exit(void)
+{
+  if (!_boost_applied)
+    return;
+  LL_RCC_IC6_SetDivider(_saved_ic6_div);
+  LL_RCC_IC11_SetDivider(_saved_ic11_div);
+  _boost_applied = false;
+  _clk_settle();
+}
+
+void clk_profile_freqs(uint32_t *npu_hz, uint32_t *nic_hz)
+{
+  /* the boost dividers are only applied while a run is in flight: report
+     the frequencies a run executes at, not the idle-time ones */
+  uint32_t ic6_div = LL_RCC_IC6_GetDivider();
+  uint32_t ic11_div = LL_RCC_IC11_GetDivider();
+  if ((_clk_profile == CLK_PROFILE_BOOST) && !_boost_applied) {
+    ic6_div = _boost_ic6_div;
+    ic11_div = _boost_ic11_div;
+  }
+  if (npu_hz)
+    *npu_hz = _ic_src_freq(LL_RCC_IC6_GetSource()) / ic6_div;
+  if (nic_hz)
+    *nic_hz = _ic_src_freq(LL_RCC_IC11_GetSource()) / ic11_div;
+}
+
+#if defined(USE_LOG_DMA) && USE_LOG_DMA == 1
+/* DMA-drained log backend (USE_LOG_DMA). lc_print characters land in the
+   ring below and a GPDMA channel feeds them to USART1 under hardware
+   request, so a log call costs the ring store and the drain runs in the
+   background. Overflow policy is drop-oldest: the active transfer is
+   suspended and its unsent remainder sacrificed together with the oldest
+   pending bytes, the newest output always survives. */
+
+#include "stm32n6xx_ll_dma.h"   /* LL_GPDMA1_REQUEST_USART1_TX */
+
+#if (LOG_DMA_RING_SIZE & (LOG_DMA_RING_SIZE - 1)) != 0
+#error "LOG_DMA_RING_SIZE must be a power of two"
+#endif
+
+#define _LOG_DMA_CHANNEL_IDX    (11)    /* 12 arena fills, 13/15 lazy stager / weight prefetch */
+#define _LOG_DMA_CHANNEL        GPDMA1_Channel11
+#define _LOG_DMA_MAX_CHUNK      (256U)  /* keeps most of the ring reclaimable on overflow */
+
+/* byte-wide incrementing source, fixed byte-wide destination (TDR) */
+#define _LOG_CTR1               (DMA_CTR1_SINC)
+
+static uint8_t _log_ring[LOG_DMA_RING_SIZE];
+static volatile uint32_t _log_head;      /* producer index, free-running */
+static volatile uint32_t _log_tail;      /* oldest byte not yet handed to the DMA */
+static volatile uint32_t _log_retire;    /* oldest byte still owned by the DMA */
+static volatile uint32_t _log_inflight;  /* bytes in the active transfer, 0 = idle */
+static uint32_t _log_dropped;
+static bool _log_ready;
+
+static void _log_dma_init(void)
+{
+  __HAL_RCC_GPDMA1_CLK_ENABLE();
+  GPDMA1_S->SECCFGR |= (1UL << _LOG_DMA_CHANNEL_IDX);
+  USART1->CR3 |= USART_CR3_DMAT;
+  HAL_NVIC_SetPriority(GPDMA1_Channel11_IRQn, IT_PRIO_DMA, 0);
+  HAL_NVIC_EnableIRQ(GPDMA1_Channel11_IRQn);
+  _log_ready = true;
+}
+
+/* hands the next contiguous run of pending bytes to the DMA; called with
+   interrupts masked or from the channel IRQ */
+static void _log_dma_kick(void)
+{
+  DMA_Channel_TypeDef *ch = _LOG_DMA_CHANNEL;
+
+  if (_log_inflight || (_log_tail == _log_head))
+    return;
+
+  uint32_t off = _log_tail & (LOG_DMA_RING_SIZE - 1U);
+  uint32_t chunk = _log_head - _log_tail;
+  if (chunk > (LOG_DMA_RING_SIZE - off))
+    chunk = LOG_DMA_RING_SIZE - off;   /* stop at the wrap */
+  if (chunk > _LOG_DMA_MAX_CHUNK)
+    chunk = _LOG_DMA_MAX_CHUNK;
+
+  mcu_cache_clean_range((uint32_t)&_log_ring[off],
+                        (uint32_t)&_log_ring[off] + chunk);
+
+  _log_inflight = chunk;
+  _log_tail += chunk;
+
+  ch->CFCR = 0x00007F00UL;  /* clear the transfer flags */
+  ch->CTR1 = _LOG_CTR1;
+  ch->CTR2 = DMA_CTR2_DREQ | LL_GPDMA1_REQUEST_USART1_TX;
+  ch->CSAR = (uint32_t)&_log_ring[off];
+  ch->CDAR = (uint32_t)&USART1->TDR;
+  ch->CBR1 = chunk & DMA_CBR1_BNDT_Msk;
+  ch->CCR = DMA_CCR_EN | DMA_CCR_TCIE;
+}
+
+/* reclaims the in-flight chunk on overflow: the unsent remainder is
+   dropped so its ring slots can be overwritten by newer output */
+static void _log_dma_abort(void)
+{
+  DMA_Channel_TypeDef *ch = _LOG_DMA_CHANNEL;
+
+  if (!(ch->CCR & DMA_CCR_EN)) {
+    _log_retire = _log_tail;
+    _log_inflight = 0;
+    return;
+  }
+
+  ch->CCR |= DMA_CCR_SUSP;
+  while (!(ch->CSR & DMA_CSR_SUSPF)) {}
+  _log_dropped += ch->CBR1 & DMA_CBR1_BNDT_Msk;
+  ch->CCR |= DMA_CCR_RESET;
+  ch->CFCR = 0x00007F00UL;
+  _log_retire = _log_tail;
+  _log_inflight = 0;
+}
+
+void log_dma_putc(const char c)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  if (!_log_ready)
+    _log_dma_init();
+
+  if ((_log_head - _log_retire) >= LOG_DMA_RING_SIZE) {
+    /* full: drop-oldest, reclaim the in-flight chunk and the oldest
+       pending byte so the newest output always finds a slot */
+    _log_dma_abort();
+    _log_tail++;
+    _log_retire = _log_tail;
+    _log_dropped++;
+  }
+
+  _log_ring[_log_head & (LOG_DMA_RING_SIZE - 1U)] = (uint8_t)c;
+  _log_head++;
+  _log_dma_kick();
+
+  __set_PRIMASK(primask);
+}
+
+void log_dma_flush(void)
+{
+  /* drains through the channel IRQ, call with interrupts enabled */
+  while (_log_retire != _log_head) {
+    __NOP();
+  }
+}
+
+uint32_t log_dma_dropped(void)
+{
+  return _log_dropped;
+}
+
+void log_dma_irq(void)
+{
+  _LOG_DMA_CHANNEL->CFCR = 0x00007F00UL;
+  _log_retire += _log_inflight;
+  _log_inflight = 0;
+  _log_dma_kick();
+}
+
+#endif /* USE_LOG_DMA */
+
+#if defined(USE_COM_DMA_IDLE_RX) && USE_COM_DMA_IDLE_RX == 1
+/* Circular-DMA UART reception (USE_COM_DMA_IDLE_RX). A GPDMA channel
+   streams every USART1 RX byte into the ring below; a self-pointing
+   linked-list item reloads the block size and destination so the channel
+   wraps forever (GPDMA circular mode). The IDLE-line interrupt marks the
+   end of a burst and ends the read-path sleep: a whole packet costs one
+   interrupt, nothing is serviced per byte. The write index is derived
+   from the channel's remaining-byte count, the ring is never touched by
+   the CPU except to read. */
+
+#include "stm32n6xx_ll_dma.h"   /* LL_GPDMA1_REQUEST_USART1_RX */
+
+#if defined(USE_COM_DMA_DOUBLE_BUFFER) && USE_COM_DMA_DOUBLE_BUFFER == 1
+#error "USE_COM_DMA_IDLE_RX and USE_COM_DMA_DOUBLE_BUFFER both claim the RX stream"
+#endif
+#if (COM_RX_RING_SIZE & (COM_RX_RING_SIZE - 1)) != 0
+#error "COM_RX_RING_SIZE must be a power of two"
+#endif
+
+#define _COM_RX_CHANNEL_IDX     (14)    /* 11 log drain, 12 arena fills, 13/15 lazy stager / weight prefetch */
+#define _COM_RX_CHANNEL         GPDMA1_Channel14
+
+/* cache-line aligned: the ring is invalidated ahead of every read */
+static uint8_t _com_rx_ring[COM_RX_RING_SIZE] __attribute__((aligned(32)));
+/* self-pointing linked-list item, fetch order CBR1 / CDAR / CLLR */
+static uint32_t _com_rx_lli[3] __attribute__((aligned(32)));
+static uint32_t _com_rx_tail;   /* ring index of the oldest unread byte */
+
+/* ring index the DMA will write next, derived from the live BNDT count */
+static uint32_t _com_rx_widx(void)
+{
+  return (COM_RX_RING_SIZE - (_COM_RX_CHANNEL->CBR1 & DMA_CBR1_BNDT_Msk))
+         & (COM_RX_RING_SIZE - 1U);
+}
+
+void com_rx_start(void)
+{
+  DMA_Channel_TypeDef *ch = _COM_RX_CHANNEL;
+
+  __HAL_RCC_GPDMA1_CLK_ENABLE();
+  GPDMA1_S->SECCFGR |= (1UL << _COM_RX_CHANNEL_IDX);
+
+  _com_rx_lli[0] = COM_RX_RING_SIZE;              /* CBR1 */
+  _com_rx_lli[1] = (uint32_t)&_com_rx_ring[0];    /* CDAR */
+  _com_rx_lli[2] = DMA_CLLR_UB1 | DMA_CLLR_UDA | DMA_CLLR_ULL
+                   | ((uint32_t)&_com_rx_lli[0] & DMA_CLLR_LA_Msk);
+  mcu_cache_clean_range((uint32_t)&_com_rx_lli[0],
+                        (uint32_t)&_com_rx_lli[0] + sizeof(_com_rx_lli));
+
+  ch->CFCR = 0x00007F00UL;  /* clear the transfer flags */
+  ch->CLBAR = (uint32_t)&_com_rx_lli[0] & DMA_CLBAR_LBA_Msk;
+  /* byte-wide, fixed RDR source, incrementing ring destination */
+  ch->CTR1 = DMA_CTR1_DINC;
+  ch->CTR2 = LL_GPDMA1_REQUEST_USART1_RX;   /* source-driven request */
+  ch->CSAR = (uint32_t)&USART1->RDR;
+  ch->CDAR = (uint32_t)&_com_rx_ring[0];
+  ch->CBR1 = COM_RX_RING_SIZE;
+  ch->CLLR = _com_rx_lli[2];
+  ch->CCR = DMA_CCR_EN;
+
+  USART1->CR3 |= USART_CR3_DMAR;
+  /* one interrupt per burst: IDLE ends the read-path WFI, the handler
+     (stm32n6xx_it.c) only clears the flag */
+  __HAL_UART_ENABLE_IT(&UartHandle, UART_IT_IDLE);
+}
+
+bool com_rx_pending(void)
+{
+  return (_com_rx_widx() != _com_rx_tail);
+}
+
+void com_rx_wait(void)
+{
+  while (!com_rx_pending())
+    __WFI();
+}
+
+bool com_rx_read(uint8_t *buff, int count)
+{
+  while (count > 0) {
+    uint32_t widx = _com_rx_widx();
+    if (widx == _com_rx_tail) {
+      /* mid-burst there is nothing to wake us before the IDLE line, the
+         bytes keep landing in the ring while we sleep */
+      __WFI();
+      continue;
+    }
+    uint32_t avail = (widx - _com_rx_tail) & (COM_RX_RING_SIZE - 1U);
+    uint32_t chunk = (avail < (uint32_t)count) ? avail : (uint32_t)count;
+    if (chunk > (COM_RX_RING_SIZE - _com_rx_tail))
+      chunk = COM_RX_RING_SIZE - _com_rx_tail;   /* stop at the wrap */
+
+    mcu_cache_invalidate_range((uint32_t)&_com_rx_ring[_com_rx_tail],
+                               (uint32_t)&_com_rx_ring[_com_rx_tail] + chunk);
+    memcpy(buff, &_com_rx_ring[_com_rx_tail], chunk);
+
+    buff += chunk;
+    count -= (int)chunk;
+    _com_rx_tail = (_com_rx_tail + chunk) & (COM_RX_RING_SIZE - 1U);
+  }
+  return true;
+}
+
+bool com_rx_get(uint8_t *c, uint32_t timeout)
+{
+  uint32_t start = HAL_GetTick();
+
+  while (!com_rx_pending()) {
+    if ((timeout != HAL_MAX_DELAY) && ((HAL_GetTick() - start) >= timeout))
+      return false;
+    __WFI();
+  }
+  return com_rx_read(c, 1);
+}
+
+#endif /* USE_COM_DMA_IDLE_RX */
@@ -18,8 +18,23 @@
 #include "npu_cache.h"
 #include "stm32n6xx_hal_cacheaxi.h"
 
+#include "app_config.h"
+
 static CACHEAXI_HandleTypeDef hcacheaxi_s;
 
+#if defined(USE_NPU_CACHE_ASYNC) && USE_NPU_CACHE_ASYNC == 1
+static void _async_drain(void);
+static int _async_push(uint32_t start_addr, uint32_t end_addr);
+#else
+static inline void _async_drain(void) {}
+static inline int _async_push(uint32_t start_addr, uint32_t end_addr)
+{
+  (void)start_addr;
+  (void)end_addr;
+  return 0;
+}
+#endif
+
 void npu_cache_init(void)
 {
   hcacheaxi_s.Instance = CACHEAXI;
@@ -48,20 +63,185 @@ void npu_cache_disable(void)
 
 void npu_cache_invalidate(void)
 {
+  _async_drain();  /* the command engine runs one operation at a time */
   HAL_CACHEAXI_Invalidate(&hcacheaxi_s);
 }
 
 void npu_cache_clean_range(uint32_t start_addr, uint32_t end_addr)
 {
+  if (_async_push(start_addr, end_addr))
+    return;  /* queued, completion is interrupt-driven (npu_cache_sync) */
   HAL_CACHEAXI_CleanByAddr(&hcacheaxi_s, (uint32_t*)start_addr, end_addr-start_addr);
 }
 
 void npu_cache_clean_invalidate_range(uint32_t start_addr, uint32_t end_addr)
 {
+  _async_drain();  /* the command engine runs one operation at a time */
   HAL_CACHEAXI_CleanInvalidByAddr(&hcacheaxi_s, (uint32_t*)start_addr, end_addr-start_addr);
 }
 
+/* pinned (hot, read-only) windows, see the note in npu_cache.h */
+static struct {
+  uint32_t start_addr;
+  uint32_t end_addr;
+} _pins[NPU_CACHE_PIN_SLOTS];
+
+static int _n_pins;
+
+int npu_cache_pin_range(uint32_t start_addr, uint32_t end_addr)
+{
+  if ((_n_pins >= NPU_CACHE_PIN_SLOTS) || (end_addr <= start_addr))
+    return -1;
+
+  _pins[_n_pins].start_addr = start_addr;
+  _pins[_n_pins].end_addr = end_addr;
+  _n_pins++;
+
+  return 0;
+}
+
+void npu_cache_unpin_all(void)
+{
+  _n_pins = 0;
+}
+
+int npu_cache_has_pins(void)
+{
+  return _n_pins;
+}
+
+#if defined(USE_NPU_CACHE_ASYNC) && USE_NPU_CACHE_ASYNC == 1
+
+/* Asynchronous clean mode (USE_NPU_CACHE_ASYNC)
+ *
+ * Cleaning the output windows of a finished epoch does not have to block
+ * the CPU: the NPU's own accesses go through CACHEAXI, so a pending clean
+ * only matters for external readers (CPU, gather DMA, debug probe). When
+ * async mode is armed, npu_cache_clean_range() queues the range and the
+ * CACHEAXI interrupt chains the next CleanByAddr command from the
+ * completion callback, overlapping the maintenance with the next epoch's
+ * execution. npu_cache_sync() is the rendezvous: it must be called before
+ * anything outside the NPU reads the cleaned data.
+ *
+ * The command engine runs one maintenance operation at a time, so every
+ * synchronous entry point above drains the queue before issuing its own
+ * (blocking) command. */
+
+static struct {
+  uint32_t start_addr;
+  uint32_t end_addr;
+} _async_q[NPU_CACHE_ASYNC_SLOTS];
+
+static volatile uint32_t _async_head;   /* producer index (thread) */
+static volatile uint32_t _async_tail;   /* consumer index (ISR) */
+static volatile int _async_busy;        /* a CleanByAddr_IT is in flight */
+static int _async_mode;
+
+static void _async_kick(void)
+{
+  HAL_StatusTypeDef status;
+  uint32_t idx = _async_tail % NPU_CACHE_ASYNC_SLOTS;
+  /* same HAL_BUSY retry idiom as npu_cache_enable(): the engine reports
+     busy for a few cycles while the previous command retires */
+  do
+  {
+    status = HAL_CACHEAXI_CleanByAddr_IT(&hcacheaxi_s,
+                                         (uint32_t*)_async_q[idx].start_addr,
+                                         _async_q[idx].end_addr - _async_q[idx].start_addr);
+  } while (status == HAL_BUSY);
+}
+
+static int _async_push(uint32_t start_addr, uint32_t end_addr)
+{
+  if (!_async_mode || (end_addr <= start_addr))
+    return 0;
+
+  if ((_async_head - _async_tail) >= NPU_CACHE_ASYNC_SLOTS)
+    _async_drain();  /* queue full: fall back to waiting, never drop a clean */
+
+  _async_q[_async_head % NPU_CACHE_ASYNC_SLOTS].start_addr = start_addr;
+  _async_q[_async_head % NPU_CACHE_ASYNC_SLOTS].end_addr = end_addr;
+  __DSB();
+  _async_head++;
+
+  /* hand the new entry to the ISR chain, or start it when idle */
+  NVIC_DisableIRQ(CACHEAXI_IRQn);
+  if (!_async_busy)
+  {
+    _async_busy = 1;
+    _async_kick();
+  }
+  NVIC_EnableIRQ(CACHEAXI_IRQn);
+
+  return 1;
+}
+
+static void _async_drain(void)
+{
+  while (_async_busy)
+  {
+    /* the ISR retires the queue */
+  }
+}
+
+/* Completion callback (ISR context): chain the next queued range, or go
+   idle when the queue is empty. */
+void HAL_CACHEAXI_CleanByAddrCallback(CACHEAXI_HandleTypeDef *hcacheaxi)
+{
+  (void)hcacheaxi;
+  _async_tail++;
+  if (_async_tail != _async_head)
+    _async_kick();
+  else
+    _async_busy = 0;
+}
+
+void npu_cache_set_async(int enable)
+{
+  if (enable)
+  {
+    /* priority comes from it_prio_map (stm32n6xx_it.c) */
+    HAL_NVIC_EnableIRQ(CACHEAXI_IRQn);
+    _async_mode = 1;
+  }
+  else
+  {
+    npu_cache_sync();
+    _async_mode = 0;
+  }
+}
+
+void npu_cache_sync(void)
+{
+  _async_drain();
+}
+
+void NPU_CACHE_IRQHandler(void)
+{
+  HAL_CACHEAXI_IRQHandler(&hcacheaxi_s);
+}
+
+#else /* !USE_NPU_CACHE_ASYNC */
+
+void npu_cache_set_async(int enable)
+{
+  (void)enable;
+}
+
+void npu_cache_sync(void)
+{
+}
+
 void NPU_CACHE_IRQHandler(void)
 {
   __NOP();
 }
+
+#endif /* USE_NPU_CACHE_ASYNC */
+
+/* CACHEAXI_IRQn vector entry (the weak symbol in startup_stm32n657xx.s is
+   named after the peripheral) */
+void CACHEAXI_IRQHandler(void)
+{
+  NPU_CACHE_IRQHandler();
+}
@@ -21,6 +21,12 @@
 /* Includes ------------------------------------------------------------------*/
 #include "stm32n6xx_hal.h"
 #include "stm32n6xx_it.h"
+#include "app_config.h"
+
+#if (defined(USE_PC_SAMPLING) && USE_PC_SAMPLING == 1) || \
+    (defined(USE_LOG_DMA) && USE_LOG_DMA == 1)
+#include "misc_toolbox.h"   /* pc_sample_capture(), log_dma_irq() */
+#endif
 
 #if defined(USE_USB_CDC_CLASS)
 #include "app_usbx_device.h"
@@ -32,6 +38,17 @@
 #if defined(USE_USB_CDC_CLASS)
 extern PCD_HandleTypeDef hpcd_USB1_OTG_HS;
 #endif
+extern UART_HandleTypeDef UartHandle;
+
+/* per-vector IRQ activity counters (see stm32n6xx_it.h), wrap-around is
+   fine: only before/after deltas are ever consumed */
+volatile uint32_t it_irq_count[IT_IRQ_NUM];
+
+/* IRQ-entry latency probe state (see it_lat_probe below) */
+#define IT_LAT_IDLE (0x7FFFFFFFL)
+static volatile int32_t it_lat_armed = IT_LAT_IDLE;
+static volatile uint32_t it_lat_t0;
+static volatile uint32_t it_lat_cycles;
 /* Private function prototypes -----------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
 
@@ -146,6 +163,36 @@ void PendSV_Handler(void)
   }
 }
 
+#if defined(USE_PC_SAMPLING) && USE_PC_SAMPLING == 1
+/**
+  * @brief  This function handles SysTick Handler (PC sampling variant).
+  * @param  None
+  * @retval None
+  *
+  * Naked trampoline: picks the active stack from EXC_RETURN bit 2 and hands
+  * the exception frame pointer to the C part, which samples the stacked PC.
+  */
+void SysTick_Handler_C(uint32_t *frame);
+
+__attribute__((naked)) void SysTick_Handler(void)
+{
+  __asm volatile("tst lr, #4      \n"
+                 "ite eq          \n"
+                 "mrseq r0, msp   \n"
+                 "mrsne r0, psp   \n"
+                 "b SysTick_Handler_C");
+}
+
+void SysTick_Handler_C(uint32_t *frame)
+{
+  if (it_lat_capture(SysTick_IRQn))
+    return;   /* latency probe, not a tick: don't advance the timebase */
+  it_irq_count[IT_IRQ_SYSTICK]++;
+  HAL_IncTick();
+  /* stacked exception frame: r0-r3, r12, lr, pc, xPSR */
+  pc_sample_capture(frame[6]);
+}
+#else
 /**
   * @brief  This function handles SysTick Handler.
   * @param  None
@@ -153,8 +200,12 @@ void PendSV_Handler(void)
   */
 void SysTick_Handler(void)
 {
+  if (it_lat_capture(SysTick_IRQn))
+    return;   /* latency probe, not a tick: don't advance the timebase */
+  it_irq_count[IT_IRQ_SYSTICK]++;
   HAL_IncTick();
 }
+#endif
 
 #if defined(USE_USB_CDC_CLASS)
 /**
@@ -167,13 +218,204 @@ void USB1_OTG_HS_IRQHandler(void)
   /* USER CODE BEGIN OTG_HS_IRQHandler 0 */
 
   /* USER CODE END OTG_HS_IRQHandler 0 */
+  it_lat_capture(USB1_OTG_HS_IRQn);
+  it_irq_count[IT_IRQ_USB]++;
   HAL_PCD_IRQHandler(&hpcd_USB1_OTG_HS);
   /* USER CODE BEGIN OTG_HS_IRQHandler 1 */
   
   /* USER CODE END OTG_HS_IRQHandler 1 */
 }
 #endif
-  
+
+/**
+  * @brief  This function handles USART1 global interrupt.
+  * @param  None
+  * @retval None
+  */
+void USART1_IRQHandler(void)
+{
+  it_lat_capture(USART1_IRQn);
+  it_irq_count[IT_IRQ_USART1]++;
+#if defined(USE_COM_DMA_IDLE_RX) && USE_COM_DMA_IDLE_RX == 1
+  /* IDLE-line framing: the interrupt only marks the end of a burst and
+     ends the read-path sleep, the bytes travel on the RX DMA channel */
+  __HAL_UART_CLEAR_IDLEFLAG(&UartHandle);
+#else
+  /* RXNE is armed as a WFI wake-up event only: disarm it here, the data
+     byte is drained by the polled read path (see port_io_wait_for_rx) */
+  __HAL_UART_DISABLE_IT(&UartHandle, UART_IT_RXNE);
+#endif
+}
+
+#if defined(USE_LOG_DMA) && USE_LOG_DMA == 1
+/**
+  * @brief  This function handles the log-drain GPDMA channel interrupt.
+  * @param  None
+  * @retval None
+  */
+void GPDMA1_Channel11_IRQHandler(void)
+{
+  it_lat_capture(GPDMA1_Channel11_IRQn);
+  it_irq_count[IT_IRQ_LOGDMA]++;
+  log_dma_irq();
+}
+#endif
+
+/******************************************************************************/
+/*                    Interrupt priority tiers                                */
+/******************************************************************************/
+
+/* Every vector the firmware uses, pinned to its tier (stm32n6xx_it.h).
+   Vectors of compiled-out features are listed anyway: setting a priority
+   on a never-enabled vector is harmless and keeps the audit complete. */
+static const struct {
+  IRQn_Type irq;
+  uint32_t prio;
+} it_prio_map[] = {
+  { NPU0_IRQn,             IT_PRIO_NPU },          /* ATON completion lines */
+  { NPU1_IRQn,             IT_PRIO_NPU },
+  { NPU2_IRQn,             IT_PRIO_NPU },
+  { NPU3_IRQn,             IT_PRIO_NPU },
+  { GPDMA1_Channel10_IRQn, IT_PRIO_DMA },          /* bulk copy */
+  { GPDMA1_Channel11_IRQn, IT_PRIO_DMA },          /* log drain */
+  { GPDMA1_Channel12_IRQn, IT_PRIO_DMA },          /* arena fills */
+  { GPDMA1_Channel13_IRQn, IT_PRIO_DMA },          /* lazy stager */
+  { GPDMA1_Channel14_IRQn, IT_PRIO_DMA },          /* com RX ring */
+  { GPDMA1_Channel15_IRQn, IT_PRIO_DMA },          /* weight prefetch */
+  { CACHEAXI_IRQn,         IT_PRIO_DMA },          /* async NPU-cache maintenance */
+  { USART1_IRQn,           IT_PRIO_TRANSPORT },
+#if defined(USE_USB_CDC_CLASS)
+  { USB1_OTG_HS_IRQn,      IT_PRIO_TRANSPORT },
+#endif
+};
+
+/**
+  * @brief  Apply the interrupt priority tier map.
+  * @param  None
+  * @retval None
+  */
+void it_set_priorities(void)
+{
+  for (uint32_t i = 0; i < sizeof(it_prio_map) / sizeof(it_prio_map[0]); i++)
+    HAL_NVIC_SetPriority(it_prio_map[i].irq, it_prio_map[i].prio, 0);
+
+  /* core exception, armed by HAL_Init(): pin it to its tier explicitly */
+  HAL_NVIC_SetPriority(SysTick_IRQn, IT_PRIO_HOUSEKEEPING, 0);
+}
+
+/******************************************************************************/
+/*                    IRQ-entry latency probe                                 */
+/******************************************************************************/
+
+/**
+  * @brief  Handler-side capture of an armed latency probe.
+  * @param  irq vector number of the calling handler
+  * @retval 1 when a probe was consumed, 0 on a genuine interrupt
+  */
+int it_lat_capture(int32_t irq)
+{
+  if (it_lat_armed != irq)
+    return 0;
+  it_lat_cycles = DWT->CYCCNT - it_lat_t0;
+  it_lat_armed = IT_LAT_IDLE;
+  return 1;
+}
+
+/**
+  * @brief  Measure the NVIC-entry latency of one vector.
+  * @param  irq vector to probe (must have an instrumented handler)
+  * @retval entry latency in DWT cycles, 0 when the probe never fired
+  *
+  * The vector is software-pended right after the cycle stamp, so the
+  * delta captured at handler entry is exception-entry plus whatever
+  * higher-priority or masked activity delayed it - probing under load
+  * (or from a masked caller) measures the real worst-case contribution.
+  */
+uint32_t it_lat_probe(int32_t irq)
+{
+  uint32_t spin = 1000000U;
+
+  it_lat_armed = irq;
+  __DSB();
+  it_lat_t0 = DWT->CYCCNT;
+  if (irq == (int32_t)SysTick_IRQn)
+    SCB->ICSR = SCB_ICSR_PENDSTSET_Msk;
+  else
+    NVIC_SetPendingIRQ((IRQn_Type)irq);
+
+  while ((it_lat_armed != IT_LAT_IDLE) && --spin) {}
+  if (spin == 0U) {
+    it_lat_armed = IT_LAT_IDLE;   /* not instrumented, or vector masked */
+    return 0;
+  }
+  return it_lat_cycles;
+}
+
+/******************************************************************************/
+/*                    Benchmark interrupt quiescing                           */
+/******************************************************************************/
+
+/* The set of NVIC vectors considered non-essential for a measured run.
+   The ATON IRQ is deliberately absent (the runtime depends on it in async
+   mode); SysTick is a core exception and is handled separately below by
+   suspending its tick interrupt while the counter keeps running. */
+static const IRQn_Type it_quiesce_irqs[] = {
+#if defined(USE_USB_CDC_CLASS)
+  USB1_OTG_HS_IRQn,
+#endif
+  USART1_IRQn,
+#if defined(USE_LOG_DMA) && USE_LOG_DMA == 1
+  GPDMA1_Channel11_IRQn,  /* the log ring absorbs output during the run */
+#endif
+};
+#define IT_QUIESCE_NUM (sizeof(it_quiesce_irqs) / sizeof(it_quiesce_irqs[0]))
+
+static uint32_t it_quiesce_saved[IT_QUIESCE_NUM];
+
+/**
+  * @brief  Mask the non-essential interrupt set for a measured run.
+  * @param  None
+  * @retval None
+  */
+void it_quiesce_enter(void)
+{
+  for (uint32_t i = 0; i < IT_QUIESCE_NUM; i++) {
+    it_quiesce_saved[i] = NVIC_GetEnableIRQ(it_quiesce_irqs[i]);
+    NVIC_DisableIRQ(it_quiesce_irqs[i]);
+  }
+  __DSB();
+  __ISB();
+
+  /* suspend the tick interrupt, the SysTick counter keeps running */
+  SysTick->CTRL &= ~SysTick_CTRL_TICKINT_Msk;
+}
+
+/**
+  * @brief  Restore the interrupt set masked by it_quiesce_enter().
+  * @param  elapsed_cycles measured duration of the quiesced window, used
+  *         to credit the frozen HAL timebase (sub-ms remainder is lost)
+  * @retval number of masked vectors with a latched pending arrival
+  */
+uint32_t it_quiesce_exit(uint32_t elapsed_cycles)
+{
+  extern __IO uint32_t uwTick;
+  uint32_t deferred = 0;
+
+  /* the tick interrupt was suspended for the whole window: compensate
+     the HAL timebase before anything reads it again */
+  uwTick += elapsed_cycles / (SystemCoreClock / 1000U);
+  SysTick->CTRL |= SysTick_CTRL_TICKINT_Msk;
+
+  for (uint32_t i = 0; i < IT_QUIESCE_NUM; i++) {
+    if (NVIC_GetPendingIRQ(it_quiesce_irqs[i]))
+      deferred++;
+    if (it_quiesce_saved[i])
+      NVIC_EnableIRQ(it_quiesce_irqs[i]);
+  }
+
+  return deferred;
+}
+
 /******************************************************************************/
 /*                 STM32N6xx Peripherals Interrupt Handlers                   */
 /*  Add here the Interrupt Handler for the used peripheral(s) (PPP), for the  */
@@ -29,6 +29,12 @@
  */
 static uint8_t *__sbrk_heap_end = NULL;
 
+/**
+ * Highest address ever handed out by _sbrk (the break can move back down
+ * when newlib trims the top of the heap, this one never does)
+ */
+static uint8_t *__sbrk_heap_max = NULL;
+
 /**
  * @brief _sbrk() allocates memory to the newlib heap and is used by malloc
  *        and others from the C library
@@ -74,6 +80,26 @@ void *_sbrk(ptrdiff_t incr)
 
   prev_heap_end = __sbrk_heap_end;
   __sbrk_heap_end += incr;
+  if (__sbrk_heap_end > __sbrk_heap_max)
+  {
+    __sbrk_heap_max = __sbrk_heap_end;
+  }
 
   return (void *)prev_heap_end;
 }
+
+/**
+ * @brief Returns the heap high watermark as an offset from '_end' (bytes of
+ *        the heap region ever claimed through _sbrk), for the stack/heap
+ *        report command
+ */
+uint32_t _sbrk_watermark(void)
+{
+  extern uint8_t _end; /* Symbol defined in the linker script */
+
+  if (NULL == __sbrk_heap_max)
+  {
+    return 0;
+  }
+  return (uint32_t)(__sbrk_heap_max - &_end);
+}
@@ -190,15 +190,18 @@ static int usb_init(PCD_HandleTypeDef *pcd_handle, PCD_TypeDef *pcd_instance)
   if (ret)
     return ret;
   
-  /* Set Rx FIFO */
+  /* Set Rx FIFO - 2KB, buffers four 512-byte HS bulk OUT packets so the
+     host can burst multi-packet transfers without NAK between packets */
   HAL_PCDEx_SetRxFiFo(&hpcd_USB1_OTG_HS, 0x200);
   /* Set Tx FIFO 0 */
   HAL_PCDEx_SetTxFiFo(&hpcd_USB1_OTG_HS, 0, 0x10);
-  /* Set Tx FIFO 1 */
-  HAL_PCDEx_SetTxFiFo(&hpcd_USB1_OTG_HS, 1, 0x80);
+  /* Set Tx FIFO 1 - 1.5KB, queues three 512-byte HS bulk IN packets:
+     the core always has the next packet staged when the host IN token
+     arrives, no dead bus time between consecutive packets of a stream */
+  HAL_PCDEx_SetTxFiFo(&hpcd_USB1_OTG_HS, 1, 0x180);
   /* Set Tx FIFO 2 */
   HAL_PCDEx_SetTxFiFo(&hpcd_USB1_OTG_HS, 2, 0x20);
-  
+
   ux_dcd_stm32_initialize((ULONG)USB1_OTG_HS, (ULONG)&hpcd_USB1_OTG_HS);
 
   return 0;
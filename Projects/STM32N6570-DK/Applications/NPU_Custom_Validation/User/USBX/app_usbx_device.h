@@ -45,7 +45,8 @@ extern PCD_HandleTypeDef hpcd_USB1_OTG_HS;
 
 /* Exported constants --------------------------------------------------------*/
 #define USBX_DEVICE_APP_MEMORY_BUFFER_SIZE  60 * 1024
-#define USBX_DEVICE_MEMORY_STACK_SIZE       32 * 1024
+/* sized for UX_SLAVE_REQUEST_DATA_MAX_LENGTH=4096 endpoint buffers */
+#define USBX_DEVICE_MEMORY_STACK_SIZE       64 * 1024
 
 /* USER CODE BEGIN EC */
 
@@ -205,16 +205,21 @@
 
 /* Defined, this value represents the endpoint buffer owner.
    0 - The default, endpoint buffer is managed by core stack. Each endpoint takes UX_SLAVE_REQUEST_DATA_MAX_LENGTH bytes.
-   1 - Endpoint buffer managed by classes. In this case not all endpoints consume UX_SLAVE_REQUEST_DATA_MAX_LENGTH bytes.  */
+   1 - Endpoint buffer managed by classes. In this case not all endpoints consume UX_SLAVE_REQUEST_DATA_MAX_LENGTH bytes.
+   Set to 1 to allow the CDC ACM zero-copy mode below.  */
 
-/* #define UX_DEVICE_ENDPOINT_BUFFER_OWNER              0 */
+#define UX_DEVICE_ENDPOINT_BUFFER_OWNER              1
 
 /* Defined, it enables device CDC ACM zero copy for bulk in/out endpoints (write/read).
    Enabled, the endpoint buffer is not allocated in class, application must provide the buffer for read/write,
    and the buffer must meet device controller driver (DCD) buffer requirements (e.g., aligned and cache safe).
-   It only works if  UX_DEVICE_ENDPOINT_BUFFER_OWNER is 1 (endpoint buffer managed by class).  */
+   It only works if  UX_DEVICE_ENDPOINT_BUFFER_OWNER is 1 (endpoint buffer managed by class).
+   Enabled: the bulk transfers issue straight from the application buffers instead of being
+   bounced through the class endpoint buffer, so consecutive packets of a tensor stream queue
+   back-to-back (the inter-packet copy was dead bus time). The DCD runs in PIO mode
+   (dma_enable is DISABLE in app_usbx_device.c), no cache/alignment constraint applies.  */
 
-/* #define UX_DEVICE_CLASS_CDC_ACM_ZERO_COPY */
+#define UX_DEVICE_CLASS_CDC_ACM_ZERO_COPY
 
 /* Defined, it enables device HID zero copy and flexible queue support (works if HID owns endpoint buffer).
     Enabled, the internal queue buffer is directly used for transfer, the APIs are kept to keep
@@ -254,7 +259,7 @@
    is 2048 bytes but can be reduced in memory constrained environments. For cd-rom support in the storage
    class, this value cannot be less than 2048.  */
 
-#define UX_SLAVE_REQUEST_DATA_MAX_LENGTH                    512
+#define UX_SLAVE_REQUEST_DATA_MAX_LENGTH                    4096
 
 /* Defined, it enables zero copy support (works if PRINTER owns endpoint buffer).
     Defined, it enables zero copy for bulk in/out endpoints (write/read). In this case, the endpoint
@@ -439,9 +444,13 @@
 
 /* #define UX_DEVICE_CLASS_AUDIO_INTERRUPT_SUPPORT  */
 
-/* Defined, class _write is pending ZLP automatically (complete transfer) after buffer is sent.  */
+/* Defined, class _write is pending ZLP automatically (complete transfer) after buffer is sent.
+   Left disabled: the validation protocol is length-prefixed on both sides, the host never relies
+   on short-packet termination, and the automatic ZLP costs one bus transaction plus a turnaround
+   after every transfer that is an exact multiple of the 512-byte bulk packet (the raw tensor
+   side-channel bodies usually are).  */
 
-#define UX_DEVICE_CLASS_CDC_ACM_WRITE_AUTO_ZLP
+/* #define UX_DEVICE_CLASS_CDC_ACM_WRITE_AUTO_ZLP */
 
 /* #define UX_DEVICE_CLASS_PRINTER_WRITE_AUTO_ZLP  */
 
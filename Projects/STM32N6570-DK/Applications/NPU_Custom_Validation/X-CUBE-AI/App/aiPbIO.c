@@ -49,6 +49,13 @@
 
 #define _PACKET_HEADER_SIZE sizeof(uint16_t)
 
+/* out-of-band escape lane byte values (see the note ahead of
+   pb_io_encode_ctrl) */
+#define _OOB_ESCAPE   (0xA5)
+#define _OOB_OP_ABORT (0x5A)
+#define _OOB_OP_NAK   (0x4E)  /* + seq byte: frame retransmit request
+                                 (USE_COM_CRC_FRAMES) */
+
 
 uint16_t packet_size = _PACKET_PAYLOAD_IN_SIZE;
 
@@ -70,13 +77,252 @@ void pb_io_reset_packet_size(void)
 }
 
 
-static struct o_packet {
+/* Link-health counters (see aiPbIO.h): every port access below goes
+ * through the _port_read/_port_write wrappers, so the byte counters see
+ * the whole traffic - packets, sync/credit bytes, NAKs, raw blobs. The
+ * DMA ping-pong paths bypass the port layer and count at their call
+ * sites instead. */
+static struct pb_io_link_stats _link_stats;
+
+const struct pb_io_link_stats *pb_io_get_link_stats(void)
+{
+  return &_link_stats;
+}
+
+void pb_io_reset_link_stats(void)
+{
+  memset(&_link_stats, 0, sizeof(_link_stats));
+}
+
+static bool _port_write(const uint8_t *buf, int count)
+{
+  bool res = ioRawWriteBuffer((uint8_t *)buf, count);
+  if (res)
+    _link_stats.tx_bytes += (uint32_t)count;
+  return res;
+}
+
+static bool _port_read(uint8_t *buf, int count)
+{
+  if (!ioRawHasRxEvent())
+    _link_stats.rx_waits++;  /* host-bound: entered with an idle port */
+  bool res = ioRawReadBuffer(buf, count);
+  if (res)
+    _link_stats.rx_bytes += (uint32_t)count;
+  return res;
+}
+
+
+#if defined(USE_COM_DMA_DOUBLE_BUFFER) && USE_COM_DMA_DOUBLE_BUFFER == 1 && !(defined(USE_USB_CDC_CLASS) && USE_USB_CDC_CLASS == 1)
+#define _COM_DMA_DOUBLE_BUFFER 1
+#else
+#define _COM_DMA_DOUBLE_BUFFER 0
+#endif
+
+#if _COM_DMA_DOUBLE_BUFFER == 1
+extern UART_HandleTypeDef UartHandle;
+#endif
+
+#if defined(USE_COM_CRC_FRAMES) && USE_COM_CRC_FRAMES == 1
+
+#if _COM_DMA_DOUBLE_BUFFER == 1
+#error "USE_COM_CRC_FRAMES and USE_COM_DMA_DOUBLE_BUFFER: the DMA ping-pong streams fixed frames and cannot carry the CRC trailer"
+#endif
+
+/*
+ * CRC-protected framing with selective retransmit (USE_COM_CRC_FRAMES).
+ *
+ * A single corrupted byte on the link used to desynchronize the protobuf
+ * stream and cost the session. Each packet now carries a 5-byte trailer:
+ * a direction-local sequence number plus the CRC-32/MPEG-2 of the
+ * header+payload wire bytes, computed by the AHB4 CRC unit (same value
+ * as stm32_utility.crc32_mpeg2() on the host side).
+ *  - RX: a frame failing its CRC is NAKed (0xA5 0x4E expected-seq) and
+ *    re-read, up to _FRAME_MAX_RETRY times; a stale sequence number
+ *    (spurious retransmit) is dropped silently; frames lost outright
+ *    still fall back to the session teardown.
+ *  - TX: the last _TX_RETAIN emitted frames are retained verbatim and a
+ *    host NAK, arriving through the OOB escape lane (see
+ *    _decode_delimited), re-emits the requested one as-is.
+ * The sync/credit bytes and the raw-blob side channel stay uncovered:
+ * this protects the packet layer only. Sequence numbers free-run from
+ * boot in each direction, the host library mirrors them.
+ */
+
+#define _FRAME_TRAILER_SIZE (5)
+#define _FRAME_MAX_RETRY    (4)
+#define _TX_RETAIN          (2)
+
+static uint8_t _tx_seq;
+static uint8_t _rx_seq;
+
+static struct {
+  uint16_t len;     /* full frame length, 0 = slot empty */
+  uint8_t seq;
+  uint8_t frame[LARGE_PACKET_PAYLOAD_IN_SIZE + _PACKET_HEADER_SIZE
+                + _FRAME_TRAILER_SIZE];
+} _tx_ring[_TX_RETAIN];
+static int _tx_ring_widx;
+
+/* CRC-32/MPEG-2 with the AHB4 CRC unit, as hwCrc32() in
+   aiPbMemRWServices.c (poly 0x04C11DB7, init 0xFFFFFFFF, no reflection) */
+static uint32_t _frame_crc(const uint8_t *buffer, uint32_t length)
+{
+  uint32_t w;
+
+  RCC->AHB4ENR |= RCC_AHB4ENR_CRCEN;
+  (void)RCC->AHB4ENR;  /* delay after an RCC peripheral clock enabling */
+
+  CRC->CR = CRC_CR_RESET;  /* default config: 32-bit poly, no bit-reversal */
+
+  while (length >= 4) {
+    memcpy(&w, buffer, 4);  /* the payload pointer may be unaligned */
+    CRC->DR = __REV(w);     /* byte-serial order, MSB first */
+    buffer += 4;
+    length -= 4;
+  }
+  while (length--) {
+    *(__IO uint8_t *)&CRC->DR = *buffer++;
+  }
+
+  return CRC->DR;
+}
+
+/* stage header+payload with the trailer, retain, emit: every TX packet
+   funnels through here (the gather fast path pays the staging copy back,
+   a frame cannot be retransmitted from a buffer the caller reuses) */
+static bool _write_frame(const uint8_t *hdr, const uint8_t *payload,
+    uint16_t plen)
+{
+  uint8_t *f = &_tx_ring[_tx_ring_widx].frame[0];
+  const uint16_t len = (uint16_t)(plen + _PACKET_HEADER_SIZE);
+  uint32_t crc;
+
+  memcpy(f, hdr, _PACKET_HEADER_SIZE);
+  memcpy(f + _PACKET_HEADER_SIZE, payload, plen);
+  crc = _frame_crc(f, len);
+  f[len] = _tx_seq;
+  f[len + 1] = (uint8_t)(crc & 0xFF);
+  f[len + 2] = (uint8_t)((crc >> 8) & 0xFF);
+  f[len + 3] = (uint8_t)((crc >> 16) & 0xFF);
+  f[len + 4] = (uint8_t)((crc >> 24) & 0xFF);
+
+  _tx_ring[_tx_ring_widx].len = (uint16_t)(len + _FRAME_TRAILER_SIZE);
+  _tx_ring[_tx_ring_widx].seq = _tx_seq;
+  _tx_seq++;
+  _tx_ring_widx = (_tx_ring_widx + 1) % _TX_RETAIN;
+
+  return _port_write(f, len + _FRAME_TRAILER_SIZE);
+}
+
+/* host-requested retransmit of a retained frame (OOB NAK opcode); a
+   frame not retained anymore cannot be recovered here, the host falls
+   back to the teardown it would have done anyway */
+static void _resend_frame(uint8_t seq)
+{
+  for (int i = 0; i < _TX_RETAIN; i++) {
+    if ((_tx_ring[i].len != 0) && (_tx_ring[i].seq == seq)) {
+      _link_stats.tx_resends++;
+      _port_write(&_tx_ring[i].frame[0], _tx_ring[i].len);
+      return;
+    }
+  }
+}
+
+#endif /* USE_COM_CRC_FRAMES */
+
+struct o_packet {
   uint16_t pw;
   uint8_t payload[LARGE_PACKET_PAYLOAD_IN_SIZE];
-} o_packet;
+};
+
+#if _COM_DMA_DOUBLE_BUFFER == 1
+
+/* Ping-pong TX packets: while one packet is streamed by the UART DMA channel,
+ * the nanopb encoder fills the other one. */
+static struct o_packet o_packets[2];
+static int o_fill_idx = 0;
+#define o_packet (o_packets[o_fill_idx])
+
+static bool _o_dma_pending = false;
+
+static bool _wait_tx_dma_done(void)
+{
+  if (!_o_dma_pending)
+    return true;
+  while (UartHandle.gState == HAL_UART_STATE_BUSY_TX) {};
+  _o_dma_pending = false;
+  return true;
+}
 
 static bool write_packet(void) {
-  return ioRawWriteBuffer((uint8_t *)&o_packet, packet_size + _PACKET_HEADER_SIZE);
+  _wait_tx_dma_done();
+  if (HAL_UART_Transmit_DMA(&UartHandle, (uint8_t *)&o_packets[o_fill_idx],
+                            packet_size + _PACKET_HEADER_SIZE) != HAL_OK)
+    return false;
+  _o_dma_pending = true;
+  _link_stats.tx_bytes += (uint32_t)(packet_size + _PACKET_HEADER_SIZE);
+  _link_stats.tx_packets++;
+  o_fill_idx ^= 1;
+  o_packets[o_fill_idx].pw = 0;
+  return true;
+}
+
+#else  /* _COM_DMA_DOUBLE_BUFFER */
+
+static struct o_packet o_packet;
+
+static bool write_packet(void) {
+#if defined(USE_COM_CRC_FRAMES) && USE_COM_CRC_FRAMES == 1
+  bool res = _write_frame((const uint8_t *)&o_packet.pw, &o_packet.payload[0],
+                          packet_size);
+#else
+  bool res = _port_write((uint8_t *)&o_packet, packet_size + _PACKET_HEADER_SIZE);
+#endif
+  if (res)
+    _link_stats.tx_packets++;
+  return res;
+}
+
+#endif /* !_COM_DMA_DOUBLE_BUFFER */
+
+/*
+ * Gather variant of write_packet() - the payload of a full packet is sent
+ * directly from the source buffer, only the 2-byte header is staged. Used
+ * for the large contiguous payloads (tensor bodies), removing the staging
+ * copy into the packet buffer. The source must stay valid until the next
+ * emission (guaranteed by the flush closing every PB message).
+ */
+static bool write_packet_from(const uint8_t *payload)
+{
+  uint8_t header[_PACKET_HEADER_SIZE] = {
+      (uint8_t)((packet_size >> 8) & 0xFF), (uint8_t)(packet_size & 0xFF)
+  };
+
+#if _COM_DMA_DOUBLE_BUFFER == 1
+  _wait_tx_dma_done();
+  if (!_port_write(&header[0], sizeof(header)))
+    return false;
+  if (HAL_UART_Transmit_DMA(&UartHandle, (uint8_t *)payload,
+                            packet_size) != HAL_OK)
+    return false;
+  _o_dma_pending = true;
+  _link_stats.tx_bytes += packet_size;
+  _link_stats.tx_packets++;
+  return true;
+#elif defined(USE_COM_CRC_FRAMES) && USE_COM_CRC_FRAMES == 1
+  bool res = _write_frame(&header[0], payload, packet_size);
+  if (res)
+    _link_stats.tx_packets++;
+  return res;
+#else
+  if (!_port_write(&header[0], sizeof(header)))
+    return false;
+  if (!_port_write((uint8_t *)payload, packet_size))
+    return false;
+  _link_stats.tx_packets++;
+  return true;
+#endif
 }
 
 void pb_io_flush_ostream(void)
@@ -97,6 +343,16 @@ static bool write_callback(pb_ostream_t *stream, const uint8_t *buf,
   UNUSED(stream);
 
   while (count) {
+    /* packet boundary and at least one full packet left: emit it directly
+       from the source buffer (gather), bypassing the staging copy */
+    if (o_packet.pw == 0 && count >= (size_t)packet_size) {
+      res = write_packet_from(pr);
+      if (!res)
+        return res;
+      pr += packet_size;
+      count -= packet_size;
+      continue;
+    }
     for (; o_packet.pw < packet_size && count; o_packet.pw++) {
       o_packet.payload[o_packet.pw] = *pr;
       pr++;
@@ -117,17 +373,119 @@ static bool write_callback(pb_ostream_t *stream, const uint8_t *buf,
 #define _PACKET_PAYLOAD_OUT_SIZE (EnumLowLevelIO_IO_OUT_PACKET_SIZE)
 #define LARGE_PACKET_PAYLOAD_OUT_SIZE (EnumLowLevelIO_IO_OUT_PACKET_SIZE_LARGE)
 
-static struct i_packet {
+struct i_packet {
   uint16_t pr;
   uint8_t payload[LARGE_PACKET_PAYLOAD_OUT_SIZE];
-} i_packet;
+};
 
 static int i_ridx = 0;
 
+#if _COM_DMA_DOUBLE_BUFFER == 1
+
+/* Ping-pong RX packets: reception of the next packet is armed on the DMA
+ * channel before the sync byte is emitted, the UART streams it while the
+ * current packet is decoded. */
+static struct i_packet i_packets[2];
+static int i_read_idx = 0;
+#define i_packet (i_packets[i_read_idx])
+
+static bool _i_dma_armed = false;
+static bool _raw_rx_pending = false;
+
+static void _wait_raw_rx_done(void)
+{
+  if (!_raw_rx_pending)
+    return;
+  while (UartHandle.RxState == HAL_UART_STATE_BUSY_RX) {};
+  _raw_rx_pending = false;
+}
+
+static bool _arm_rx_dma(int idx)
+{
+  return (HAL_UART_Receive_DMA(&UartHandle, (uint8_t *)&i_packets[idx],
+                               packet_size + _PACKET_HEADER_SIZE) == HAL_OK);
+}
+
 static bool read_packet(void) {
 
-  bool res = ioRawReadBuffer((uint8_t *)&i_packet,
+  bool res = true;
+
+  /* an in-flight background reception owns the RX channel, its bytes
+     precede any packet in the stream */
+  _wait_raw_rx_done();
+
+  if (!_i_dma_armed)
+    res = _arm_rx_dma(i_read_idx);
+  else
+    i_read_idx ^= 1;  /* slot armed by the previous call */
+
+  while (UartHandle.RxState == HAL_UART_STATE_BUSY_RX) {};
+
+  _link_stats.rx_bytes += (uint32_t)(packet_size + _PACKET_HEADER_SIZE);
+  _link_stats.rx_packets++;
+
+  /* arm the reception of the next packet in the other slot */
+  _i_dma_armed = _arm_rx_dma(i_read_idx ^ 1);
+
+  i_ridx = 0;
+
+  uint8_t tmp = (i_packet.pr >> 8) & 0xFF;
+  i_packet.pr = (i_packet.pr << 8) | tmp;
+
+  return res;
+}
+
+#else  /* _COM_DMA_DOUBLE_BUFFER */
+
+static struct i_packet i_packet;
+
+#if defined(USE_COM_CRC_FRAMES) && USE_COM_CRC_FRAMES == 1
+
+/* read and verify one frame, NAK + re-read on corruption (see the
+   framing note ahead of _write_frame) */
+static bool _read_frame(void)
+{
+  uint8_t trailer[_FRAME_TRAILER_SIZE];
+
+  for (int retry = 0; retry < _FRAME_MAX_RETRY; retry++) {
+    if (!_port_read((uint8_t *)&i_packet,
+        packet_size + _PACKET_HEADER_SIZE))
+      return false;
+    if (!_port_read(&trailer[0], sizeof(trailer)))
+      return false;
+
+    uint32_t crc = (uint32_t)trailer[1] | ((uint32_t)trailer[2] << 8)
+                 | ((uint32_t)trailer[3] << 16) | ((uint32_t)trailer[4] << 24);
+    if (crc == _frame_crc((const uint8_t *)&i_packet,
+                          packet_size + _PACKET_HEADER_SIZE)) {
+      if (trailer[0] == _rx_seq) {
+        _rx_seq++;
+        return true;
+      }
+      if ((uint8_t)(_rx_seq - trailer[0]) < 8U)
+        continue;   /* stale retransmit, drop it */
+      return false; /* frames lost outright, not recoverable here */
+    }
+
+    uint8_t nak[3] = { _OOB_ESCAPE, _OOB_OP_NAK, _rx_seq };
+    _link_stats.crc_errors++;
+    _port_write(&nak[0], sizeof(nak));
+  }
+  return false;
+}
+
+#endif /* USE_COM_CRC_FRAMES */
+
+static bool read_packet(void) {
+
+#if defined(USE_COM_CRC_FRAMES) && USE_COM_CRC_FRAMES == 1
+  bool res = _read_frame();
+#else
+  bool res = _port_read((uint8_t *)&i_packet,
       packet_size + _PACKET_HEADER_SIZE);
+#endif
+  if (res)
+    _link_stats.rx_packets++;
   i_ridx = 0;
 
   uint8_t tmp = (i_packet.pr >> 8) & 0xFF;
@@ -136,10 +494,69 @@ static bool read_packet(void) {
   return res;
 }
 
+#endif /* !_COM_DMA_DOUBLE_BUFFER */
+
+#if defined(USE_COM_RX_CREDITS) && USE_COM_RX_CREDITS == 1
+
+/*
+ * Credit-based RX flow control - the sync byte the host waits for before
+ * sending each packet becomes a credit. Instead of granting one sync per
+ * packet (stop-and-wait, one host round-trip per packet), up to a window
+ * of syncs is granted ahead of consumption and the host streams the
+ * whole window back-to-back while the packets are decoded. The window is
+ * sized so the outstanding packets fit the transport's elastic RX buffer
+ * (bytes landing while the CPU decodes must have somewhere to go); with
+ * no elastic buffer it degrades to 1, the legacy exchange. The host side
+ * is untouched: its per-packet sync wait completes immediately because
+ * the syncs are already buffered.
+ */
+static uint16_t _rx_credits;   /* syncs granted for packets not yet read */
+
+static uint16_t _rx_credit_depth(void)
+{
+  uint32_t depth;
+#if defined(USE_USB_CDC_CLASS) && USE_USB_CDC_CLASS == 1
+  depth = USB_RX_FIFO_SIZE / (packet_size + _PACKET_HEADER_SIZE);
+#elif defined(USE_COM_DMA_IDLE_RX) && USE_COM_DMA_IDLE_RX == 1
+  depth = COM_RX_RING_SIZE / (packet_size + _PACKET_HEADER_SIZE);
+#else
+  depth = 1;  /* polled reception: no elastic buffer, stop-and-wait */
+#endif
+  if (depth == 0)
+    depth = 1;
+  if (depth > COM_RX_CREDITS_MAX)
+    depth = COM_RX_CREDITS_MAX;
+  return (uint16_t)depth;
+}
+
+static void _rx_grant(size_t pending_bytes)
+{
+  uint8_t sync = 0xAA;
+  /* a packet never carries more than packet_size payload bytes, so the
+     host still has at least this many packets to send for the bytes the
+     decoder asked for - the window can never be over-granted and no
+     stray sync survives the message */
+  uint32_t want = ((uint32_t)pending_bytes + packet_size - 1U) / packet_size;
+  uint16_t depth = _rx_credit_depth();
+
+  while ((_rx_credits < depth) && (_rx_credits < want)) {
+#if _COM_DMA_DOUBLE_BUFFER == 1
+    _wait_tx_dma_done();  /* TX channel is shared with the packet DMA */
+#endif
+    _port_write(&sync, 1);
+    _rx_credits++;
+  }
+}
+
+#endif /* USE_COM_RX_CREDITS */
+
 void pb_io_flush_istream(void)
 {
   i_packet.pr = 0xFFFF;
   i_ridx = 0;
+#if defined(USE_COM_RX_CREDITS) && USE_COM_RX_CREDITS == 1
+  _rx_credits = 0;
+#endif
 }
 
 static bool read_callback(pb_istream_t *stream, uint8_t *buf, size_t count)
@@ -167,15 +584,125 @@ static bool read_callback(pb_istream_t *stream, uint8_t *buf, size_t count)
       i_ridx++;
     }
     if (count && i_packet.pr  == 0) {
+#if defined(USE_COM_RX_CREDITS) && USE_COM_RX_CREDITS == 1
+      _rx_grant(count);   /* top the window up, at least one credit */
+      read_packet();
+      _rx_credits--;
+#else
       uint8_t sync = 0xAA;
-      ioRawWriteBuffer(&sync, 1);
+#if _COM_DMA_DOUBLE_BUFFER == 1
+      _wait_tx_dma_done();  /* TX channel is shared with the packet DMA */
+#endif
+      _port_write(&sync, 1);
       read_packet();
+#endif /* !USE_COM_RX_CREDITS */
     }
   }
 
   return res;
 }
 
+/*
+ * Raw binary side-channel - tensor contents do not need the varint/field
+ * framing, the blob is emitted as [u32 LE length][raw bytes] directly on
+ * the low-level port, bypassing the nanopb encode path and the packet
+ * fragmentation. Should be used only after a PB message announcing it.
+ */
+bool pb_io_write_raw(const uint8_t *buf, uint32_t count)
+{
+  uint8_t header[4] = {
+      (uint8_t)(count & 0xFF), (uint8_t)((count >> 8) & 0xFF),
+      (uint8_t)((count >> 16) & 0xFF), (uint8_t)((count >> 24) & 0xFF)
+  };
+
+#if _COM_DMA_DOUBLE_BUFFER == 1
+  _wait_tx_dma_done();
+#endif
+
+  if (!_port_write(&header[0], sizeof(header)))
+    return false;
+
+  return _port_write((uint8_t *)buf, count);
+}
+
+/*
+ * Read counterpart of pb_io_write_raw() - the host pushes the blob as
+ * [u32 LE length][raw bytes], without packet fragmentation or per-packet
+ * sync byte. Up to count bytes are stored in buf, the announced length is
+ * returned (the caller checks it against the expected size).
+ */
+uint32_t pb_io_read_raw(uint8_t *buf, uint32_t count)
+{
+  uint8_t header[4];
+  uint32_t len;
+
+#if _COM_DMA_DOUBLE_BUFFER == 1
+  /* a packet reception may have been pre-armed, release the RX channel -
+     the host only streams the blob after the announcing PB message, no
+     byte can be in flight at this point */
+  _wait_raw_rx_done();
+  if (_i_dma_armed) {
+    HAL_UART_AbortReceive(&UartHandle);
+    _i_dma_armed = false;
+  }
+#endif
+
+  if (!_port_read(&header[0], sizeof(header)))
+    return 0;
+
+  len = (uint32_t)header[0] | ((uint32_t)header[1] << 8) |
+      ((uint32_t)header[2] << 16) | ((uint32_t)header[3] << 24);
+
+  if (len < count)
+    count = len;
+
+  if (count && !_port_read(buf, count))
+    return 0;
+
+  return len;
+}
+
+/*
+ * Background raw reception - arm a DMA transfer of count raw bytes (no
+ * framing) into buf and return immediately, so the transfer proceeds while
+ * the CPU is busy (typically during an NPU run). Single DMA block, count
+ * is limited to 64KB-1. Returns false when the port has no RX DMA channel,
+ * the caller then falls back to the synchronous path.
+ */
+#if _COM_DMA_DOUBLE_BUFFER == 1
+
+bool pb_io_arm_raw_rx(uint8_t *buf, uint32_t count)
+{
+  _wait_raw_rx_done();
+  if (_i_dma_armed) {
+    HAL_UART_AbortReceive(&UartHandle);
+    _i_dma_armed = false;
+  }
+  _raw_rx_pending =
+      (HAL_UART_Receive_DMA(&UartHandle, buf, (uint16_t)count) == HAL_OK);
+  return _raw_rx_pending;
+}
+
+void pb_io_raw_rx_wait(void)
+{
+  _wait_raw_rx_done();
+}
+
+#else  /* _COM_DMA_DOUBLE_BUFFER */
+
+bool pb_io_arm_raw_rx(uint8_t *buf, uint32_t count)
+{
+  UNUSED(buf);
+  UNUSED(count);
+  return false;
+}
+
+void pb_io_raw_rx_wait(void)
+{
+}
+
+#endif /* !_COM_DMA_DOUBLE_BUFFER */
+
 pb_ostream_t pb_io_ostream(int fd)
 {
 #ifndef PB_NO_ERRMSG
@@ -196,6 +723,117 @@ pb_istream_t pb_io_istream(int fd)
   return stream;
 }
 
+/*
+ * Buffer-only fast path for bounded control messages.
+ *
+ * The streaming pb_io_ostream/pb_io_istream pay an indirect callback call
+ * per primitive read/write (tag, varint, string header), which adds up
+ * over the thousands of req/ack/log round trips of a session. The control
+ * messages are bounded (reqMsg 87B, logMsg 137B encoded), so they fit a
+ * stack buffer: encode/decode run against nanopb's inline buffer streams
+ * and the packet layer is crossed once with the whole message. Oversized
+ * messages (tensor-bearing payloads) keep the streaming path, the bytes
+ * on the wire are identical either way.
+ */
+#define _CTRL_MSG_BUF_SIZE (192)  /* largest control resp is a log (8 + 137B) */
+
+/*
+ * Out-of-band escape lane - the single stream serializes control behind
+ * bulk traffic, so a cancel sent the regular way would queue behind the
+ * transfer it is meant to stop. Instead the host may inject a 2-byte
+ * escape frame (_OOB_ESCAPE + opcode) immediately ahead of any control
+ * message; it is consumed while the length prefix is read and the abort
+ * opcode is latched in _oob_abort. A control length prefix is a single
+ * byte < 0x80 (reqMsg/ackMsg are bounded well under 128B), so the
+ * escape value is unambiguous there. Data messages can carry any length
+ * prefix and use the scan-free decoder below. The long-running emitters
+ * poll pb_io_oob_pending() at their ack exchanges, which is how a
+ * mid-dump cancel reaches them; other opcodes are reserved and ignored.
+ * (Byte values near the top of the file, the CRC framing NAK uses the
+ * same lane.)
+ */
+static volatile bool _oob_abort;
+
+bool pb_io_oob_pending(void)
+{
+  return _oob_abort;
+}
+
+void pb_io_oob_clear(void)
+{
+  _oob_abort = false;
+}
+
+bool pb_io_encode_ctrl(const pb_field_t fields[], const void *msg)
+{
+  uint8_t buf[_CTRL_MSG_BUF_SIZE];
+  pb_ostream_t stream = pb_ostream_from_buffer(buf, sizeof(buf));
+
+  if (!pb_encode(&stream, fields, msg))
+    return false;  /* does not fit: the caller reruns the streaming path */
+
+  return write_callback(NULL, buf, stream.bytes_written);
+}
+
+static bool _decode_delimited(const pb_field_t fields[], void *msg,
+    bool scan_oob)
+{
+  uint8_t buf[_CTRL_MSG_BUF_SIZE];
+  uint32_t len = 0;
+  uint8_t shift = 0;
+  uint8_t byte;
+
+  /* delimited framing: the length prefix is a varint */
+  do {
+    if ((shift >= 32) || !read_callback(NULL, &byte, 1))
+      return false;
+    if (scan_oob && (shift == 0) && (byte == _OOB_ESCAPE)) {
+      /* escape frame injected ahead of the message, the real length
+         prefix follows */
+      if (!read_callback(NULL, &byte, 1))
+        return false;
+      if (byte == _OOB_OP_ABORT) {
+        _oob_abort = true;
+        _link_stats.oob_aborts++;
+      }
+#if defined(USE_COM_CRC_FRAMES) && USE_COM_CRC_FRAMES == 1
+      else if (byte == _OOB_OP_NAK) {
+        /* retransmit request for a corrupted device-to-host frame */
+        if (!read_callback(NULL, &byte, 1))
+          return false;
+        _resend_frame(byte);
+      }
+#endif
+      continue;
+    }
+    len |= (uint32_t)(byte & 0x7FU) << shift;
+    shift += 7;
+  } while (byte & 0x80U);
+
+  if (len <= sizeof(buf)) {
+    if (!read_callback(NULL, buf, len))
+      return false;
+    pb_istream_t stream = pb_istream_from_buffer(buf, len);
+    return pb_decode(&stream, fields, msg);
+  }
+
+  /* oversized (tensor-bearing) message: streaming decoder, the length
+     prefix is already consumed */
+  pb_istream_t stream = pb_io_istream(0);
+  stream.bytes_left = len;
+  return pb_decode(&stream, fields, msg);
+}
+
+bool pb_io_decode_ctrl_delimited(const pb_field_t fields[], void *msg)
+{
+  return _decode_delimited(fields, msg, true);
+}
+
+bool pb_io_decode_data_delimited(const pb_field_t fields[], void *msg)
+{
+  return _decode_delimited(fields, msg, false);
+}
+
 int pb_io_stream_init(void)
 {
   ioRawDisableLLWrite();
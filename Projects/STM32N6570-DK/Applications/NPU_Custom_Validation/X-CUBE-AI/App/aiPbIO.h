@@ -29,8 +29,53 @@ void pb_io_flush_istream(void);
 pb_ostream_t pb_io_ostream(int fd);
 pb_istream_t pb_io_istream(int fd);
 
+/* Buffer-only fast path for the bounded control messages (req/ack/log
+ * acks): the message is encoded/decoded against a stack buffer with the
+ * nanopb buffer streams, skipping the per-read/per-write callback
+ * dispatch of the streaming path, and moved through the packet layer in
+ * one bulk call. Messages larger than the internal buffer (tensor-bearing
+ * payloads) transparently keep the streaming path: pb_io_encode_ctrl
+ * returns false and the caller falls back, pb_io_decode_ctrl_delimited
+ * falls back internally. The bytes on the wire are identical. */
+bool pb_io_encode_ctrl(const pb_field_t fields[], const void *msg);
+bool pb_io_decode_ctrl_delimited(const pb_field_t fields[], void *msg);
+bool pb_io_decode_data_delimited(const pb_field_t fields[], void *msg);
+
+/* Out-of-band escape lane: a 2-byte frame (0xA5 + opcode) the host may
+ * inject ahead of any control message (req/ack). The abort opcode is
+ * latched here and polled by the long-running emitters (tensor dumps),
+ * so a cancel lands at the next ack exchange instead of after the full
+ * transfer. The flag scope is one command, the manager clears it. */
+bool pb_io_oob_pending(void);
+void pb_io_oob_clear(void);
+
+bool pb_io_write_raw(const uint8_t *buf, uint32_t count);
+uint32_t pb_io_read_raw(uint8_t *buf, uint32_t count);
+
+bool pb_io_arm_raw_rx(uint8_t *buf, uint32_t count);
+void pb_io_raw_rx_wait(void);
+
 uint16_t pb_io_get_packet_size(uint16_t *max_size);
 void pb_io_set_packet_size(uint16_t val);
 void pb_io_reset_packet_size(void);
 
+/* Link-health telemetry: cumulative transport counters at the packet
+ * layer, queried and reset through a spare command (see aiPbCmdLinkStat).
+ * An effective-bandwidth figure is the byte-count delta between two
+ * queries over the query interval; the RX elastic-fifo pressure is
+ * reported separately by the port layer (see ioRawGetRxFifoStats). */
+struct pb_io_link_stats {
+  uint32_t tx_bytes;      /* bytes handed to the port, headers included */
+  uint32_t rx_bytes;      /* bytes consumed from the port */
+  uint32_t tx_packets;
+  uint32_t rx_packets;
+  uint32_t rx_waits;      /* reads entered with an idle port (host-bound) */
+  uint32_t crc_errors;    /* inbound frames NAKed (USE_COM_CRC_FRAMES) */
+  uint32_t tx_resends;    /* retained frames resent on a host NAK */
+  uint32_t oob_aborts;    /* abort escape frames latched */
+};
+
+const struct pb_io_link_stats *pb_io_get_link_stats(void);
+void pb_io_reset_link_stats(void);
+
 #endif /* _AI_PB_IO_H_ */
@@ -0,0 +1,163 @@
+/**
+ ******************************************************************************
+ * @file    aiPbLz4.c
+ * @author  MCD/AIS Team
+ * @brief   Minimal LZ4 block compressor for the tensor dump path
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/*
+ * Description:
+ *
+ * Greedy single-pass LZ4 block compressor (compatible with the reference
+ * LZ4_decompress_safe()/lz4.block implementations). Quantized activation
+ * maps typically shrink 3-5x, which directly multiplies the effective
+ * bandwidth of the COM link during per-epoch validation.
+ *
+ * Only the compression side is implemented, the host (ai_runner) performs
+ * the decompression.
+ */
+
+#include <string.h>
+
+#include <aiPbLz4.h>
+
+#define _HASH_LOG       (12)
+#define _MIN_MATCH      (4)
+#define _MF_LIMIT       (12)    /* last match must start before iend - 12 */
+#define _LAST_LITERALS  (5)     /* last 5 bytes are always literals */
+#define _MAX_DISTANCE   (0xFFFF)
+
+/* match candidates, indexed by a hash of the next 4 input bytes */
+static uint32_t _hash_tab[1 << _HASH_LOG];
+
+static inline uint32_t _read32(const uint8_t *p)
+{
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline uint32_t _hash(uint32_t v)
+{
+  return (v * 2654435761U) >> (32 - _HASH_LOG);
+}
+
+/* emit a 15+ length with the 255-saturated extension bytes */
+static inline uint8_t *_write_length(uint8_t *op, uint32_t len)
+{
+  for (; len >= 255; len -= 255)
+    *op++ = 255;
+  *op++ = (uint8_t)len;
+  return op;
+}
+
+uint32_t aiPbLz4Compress(const uint8_t *src, uint32_t src_size,
+                         uint8_t *dst, uint32_t dst_max)
+{
+  const uint8_t *ip = src;
+  const uint8_t *anchor = src;
+  const uint8_t *const iend = src + src_size;
+  const uint8_t *const mflimit = iend - _MF_LIMIT;
+  const uint8_t *const matchlimit = iend - _LAST_LITERALS;
+  uint8_t *op = dst;
+  uint8_t *const oend = dst + dst_max;
+
+  if (src_size < _MF_LIMIT + 1)
+    goto _last_literals;
+
+  memset(_hash_tab, 0, sizeof(_hash_tab));
+  _hash_tab[_hash(_read32(ip))] = 0;
+  ip++;
+
+  for (;;) {
+    const uint8_t *match;
+    uint8_t *token;
+    uint32_t lit_len, match_len;
+
+    /* find a 4-byte match in the 64KB window */
+    for (;;) {
+      uint32_t h;
+      if (ip > mflimit)
+        goto _last_literals;
+      h = _hash(_read32(ip));
+      match = src + _hash_tab[h];
+      _hash_tab[h] = (uint32_t)(ip - src);
+      if ((match < ip) && ((uint32_t)(ip - match) <= _MAX_DISTANCE) &&
+          (_read32(match) == _read32(ip)))
+        break;
+      ip++;
+    }
+
+    /* extend the match backward over pending literals */
+    while ((ip > anchor) && (match > src) && (ip[-1] == match[-1])) {
+      ip--;
+      match--;
+    }
+
+    /* literal run */
+    lit_len = (uint32_t)(ip - anchor);
+    if (op + 1 + lit_len + (lit_len / 255) + 1 + 2 > oend)
+      return 0;
+    token = op++;
+    if (lit_len >= 15) {
+      *token = (15 << 4);
+      op = _write_length(op, lit_len - 15);
+    } else {
+      *token = (uint8_t)(lit_len << 4);
+    }
+    memcpy(op, anchor, lit_len);
+    op += lit_len;
+
+    /* match: 2-byte LE offset + length */
+    *op++ = (uint8_t)(ip - match);
+    *op++ = (uint8_t)((uint32_t)(ip - match) >> 8);
+
+    ip += _MIN_MATCH;
+    match += _MIN_MATCH;
+    while ((ip < matchlimit) && (*ip == *match)) {
+      ip++;
+      match++;
+    }
+    match_len = (uint32_t)(ip - anchor) - lit_len - _MIN_MATCH;
+    if (match_len >= 15) {
+      if (op + (match_len / 255) + 1 > oend)
+        return 0;
+      *token |= 15;
+      op = _write_length(op, match_len - 15);
+    } else {
+      *token |= (uint8_t)match_len;
+    }
+
+    anchor = ip;
+    if (ip > mflimit)
+      goto _last_literals;
+  }
+
+_last_literals:
+  {
+    uint32_t lit_len = (uint32_t)(iend - anchor);
+    if (op + 1 + lit_len + (lit_len / 255) > oend)
+      return 0;
+    if (lit_len >= 15) {
+      *op++ = (15 << 4);
+      op = _write_length(op, lit_len - 15);
+    } else {
+      *op++ = (uint8_t)(lit_len << 4);
+    }
+    memcpy(op, anchor, lit_len);
+    op += lit_len;
+  }
+
+  return (uint32_t)(op - dst);
+}
@@ -0,0 +1,35 @@
+/**
+ ******************************************************************************
+ * @file    aiPbLz4.h
+ * @author  MCD/AIS Team
+ * @brief   Minimal LZ4 block compressor for the tensor dump path
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#ifndef _AI_PB_LZ4_H_
+#define _AI_PB_LZ4_H_
+
+#include <stdint.h>
+
+/*
+ * Compress src[0..src_size[ in the LZ4 block format (see lz4_Block_format.md,
+ * decodable with the reference lz4 library or lz4.block on the host side).
+ *
+ * Returns the compressed size, or 0 if the data does not fit in dst_max
+ * bytes (i.e. not compressible enough) - in this case the caller should
+ * send the original buffer.
+ */
+uint32_t aiPbLz4Compress(const uint8_t *src, uint32_t src_size,
+                         uint8_t *dst, uint32_t dst_max);
+
+#endif /* _AI_PB_LZ4_H_ */
@@ -16,26 +16,163 @@
  ******************************************************************************
  */
 
+#include <string.h>
+
 #include <aiPbMemRWServices.h>
+#include <aiTestUtility.h>  /* ioRawHasRxEvent() */
 
+#include "app_config.h"
+#include "misc_toolbox.h"   /* toolbox_copy() */
+#include "mcu_cache.h"      /* probe window: push published regions to RAM */
 
-/** Computes BSD checksum if a given buffer. Same as 'sum -r' on Unix
+#if defined(USE_HW_CRC_CHECKSUM) && USE_HW_CRC_CHECKSUM == 1
+#include <bsp_ai.h>  /* generated STM32 platform file to import the HAL and the UART definition */
+#endif
+
+#include "ai_wrapper_ATON.h"  /* npu_is_active()/npu_poll(), npu_mark_memory_dirty() */
+
+
+/** Incremental form of the BSD checksum: folds a buffer into a running
+ *  checksum (start from 0). The algorithm has no finalization step, so the
+ *  state is the checksum and the buffer can be fed in arbitrary chunks -
+ *  e.g. straight from the transport receive path, while the transfer is
+ *  still in progress.
  */
-int bsdChecksum(uint8_t* buffer, int length)
+int bsdChecksumUpdate(int checksum, const uint8_t* buffer, int length)
 {
   int i;
   int ch;                       /* Each character read. */
-  int checksum = 0;             /* The checksum mod 2^16. */
 
   for(i=0; i<length; i++){
     ch = buffer[i];
     checksum = (checksum >> 1) + ((checksum & 1) << 15);
     checksum += ch;
-    checksum &= 0xffff;       /* Keep it within bounds. */
+    checksum &= 0xffff;       /* Keep it within bounds (mod 2^16). */
   }
   return checksum;
 }
 
+/** Computes BSD checksum if a given buffer. Same as 'sum -r' on Unix
+ */
+int bsdChecksum(uint8_t* buffer, int length)
+{
+  return bsdChecksumUpdate(0, buffer, length);
+}
+
+/** aiPbHashUpdateFunc_t hook: checksums each received chunk on the fly
+ *  (arg points to the running checksum)
+ */
+static void _rx_checksum_cb(void *arg, const uint8_t *data, uint32_t size)
+{
+  uint32_t *checksum = (uint32_t *)arg;
+  *checksum = (uint32_t)bsdChecksumUpdate((int)*checksum, data, (int)size);
+}
+
+#if defined(USE_HW_CRC_CHECKSUM) && USE_HW_CRC_CHECKSUM == 1
+
+/** Computes CRC-32/MPEG-2 (poly 0x04C11DB7, init 0xFFFFFFFF, no reflection,
+ *  no final xor) with the AHB4 CRC unit, fed word-wise by the CPU. One AHB
+ *  write per 4 bytes instead of ~6 CPU operations per byte for the BSD loop,
+ *  which matters for the multi-MB weight regions checked at each deployment.
+ *  Same value as stm32_utility.crc32_mpeg2() on the host side.
+ */
+static uint32_t hwCrc32(const uint8_t* buffer, uint32_t length)
+{
+  uint32_t w;
+
+  RCC->AHB4ENR |= RCC_AHB4ENR_CRCEN;
+  (void)RCC->AHB4ENR;  /* delay after an RCC peripheral clock enabling */
+
+  CRC->CR = CRC_CR_RESET;  /* default config: 32-bit poly, no bit-reversal */
+
+  while (length >= 4) {
+    memcpy(&w, buffer, 4);  /* base address is not necessarily aligned */
+    CRC->DR = __REV(w);     /* byte-serial order, MSB first */
+    buffer += 4;
+    length -= 4;
+  }
+  while (length--) {
+    *(__IO uint8_t *)&CRC->DR = *buffer++;
+  }
+
+  return CRC->DR;
+}
+
+#endif /* USE_HW_CRC_CHECKSUM */
+
+/* Concurrent memory-read window (live inspection during inference)
+ *
+ * A MEMORY_READ arriving while queued inferences are in flight must not
+ * read the requested range directly: the stream engines may be rewriting
+ * it mid-epoch (torn data) and the extra AXI traffic lands in the middle
+ * of a measured epoch block. The read loop instead arms a batch of chunk
+ * descriptors and keeps the queue progressing with npu_poll(); the
+ * epoch-boundary service hook (npu_set_epoch_service) snapshots the whole
+ * batch at the next boundary, where the engines are quiescent. The wire
+ * transfer then runs from the snapshots while the NPU continues: only the
+ * memcpy sits inside the window, so the run is perturbed by one batched
+ * copy per _MEM_RD_WIN_BATCH chunks instead of one bus intrusion per
+ * host-paced chunk.
+ */
+#define _MEM_RD_WIN_BATCH  (4)   /* chunks snapshotted per boundary window */
+
+struct _mem_rd_win_chunk {
+  uintptr_t addr;
+  uint32_t size;
+};
+
+static struct _mem_rd_win_chunk _mem_rd_win_req[_MEM_RD_WIN_BATCH];
+static uint32_t _mem_rd_win_stage[_MEM_RD_WIN_BATCH][1024 / 4];
+static volatile uint32_t _mem_rd_win_armed;  /* armed chunk count, 0: idle */
+static volatile bool _mem_rd_win_done;
+
+/* npu_epoch_service_t hook (registered at init, see aiValidation_ATON.c):
+ * runs in the epoch-boundary window, snapshots the armed batch */
+void memory_read_epoch_service(void)
+{
+  uint32_t i;
+
+  if ((_mem_rd_win_armed == 0) || (_mem_rd_win_done))
+    return;
+
+  for (i = 0; i < _mem_rd_win_armed; i++)
+    memcpy(&_mem_rd_win_stage[i][0], (const void *)_mem_rd_win_req[i].addr,
+        _mem_rd_win_req[i].size);
+  _mem_rd_win_done = true;
+}
+
+/* Snapshots up to _MEM_RD_WIN_BATCH chunks of [addr, addr+size) in the
+ * next epoch-boundary window and returns the staged byte count. Falls
+ * back to a direct copy when the queue drains before a boundary occurs
+ * (the engines are then idle anyway). */
+static uint32_t _mem_rd_win_snapshot(uintptr_t addr, uint32_t size)
+{
+  uint32_t n = 0, staged = 0;
+
+  while ((n < _MEM_RD_WIN_BATCH) && (size)) {
+    const uint32_t chunk = size > 1024 ? 1024 : size;
+    _mem_rd_win_req[n].addr = addr;
+    _mem_rd_win_req[n].size = chunk;
+    addr += chunk;
+    size -= chunk;
+    staged += chunk;
+    n++;
+  }
+
+  _mem_rd_win_done = false;
+  _mem_rd_win_armed = n;  /* arm last: the hook fires from npu_poll() */
+
+  while (!_mem_rd_win_done) {
+    if (npu_poll() == 0) {
+      memory_read_epoch_service();
+      break;
+    }
+  }
+  _mem_rd_win_armed = 0;
+
+  return staged;
+}
+
 bool memory_valid_addr_range(uint32_t base_addr, uint32_t size, int mode)
 {
   (void)base_addr;
@@ -49,13 +186,22 @@ void memory_checksum(uintptr_t base_addr, uint32_t size, uint32_t *hash)
   if ((size == 0) && hash)
     *hash = ~0UL;
 
+#if defined(USE_HW_CRC_CHECKSUM) && USE_HW_CRC_CHECKSUM == 1
+  *hash = hwCrc32((uint8_t *)base_addr, size);
+#else
   *hash = bsdChecksum((uint8_t *)base_addr, size);
+#endif
 }
 
-bool memory_write(uintptr_t src, uintptr_t dest, uint32_t size, uint32_t *hash)
+bool memory_write(uintptr_t src, uintptr_t dest, uint32_t size)
 {
-  memcpy((void *)dest, (void *)src, size);
-  *hash = bsdChecksum((uint8_t *)dest, size);
+  /* the ack checksum is computed while the payload is received (see
+   * _rx_checksum_cb), not by re-reading the destination - the possibly
+   * slow external memory is only written */
+  toolbox_copy((void *)dest, (const void *)src, size);
+#if defined(USE_WARM_RUN) && USE_WARM_RUN == 1
+  npu_mark_memory_dirty();
+#endif
   return true;
 }
 
@@ -84,19 +230,21 @@ void aiPbCmdRWMemory(const reqMsg *req, respMsg *resp, void *param)
         res, EnumError_E_NONE);
   }
   else if ((uint32_t)param == EnumCmd_CMD_MEMORY_WRITE) {
-    aiPbData data = {0, size>1024?1024:size, (uintptr_t)buffer, 0};
+    aiPbData data = {0, size>1024?1024:size, (uintptr_t)buffer, 0,
+        &_rx_checksum_cb, &res};
     aiPbMgrSendAck(req, resp, (size == 0)?EnumState_S_DONE:EnumState_S_WAITING,
           data.size, EnumError_E_NONE);
     while (size) {
+      res = 0;  /* per-chunk checksum, updated during the reception */
       aiPbMgrReceiveData(&data);
       if (data.nb_read > data.size) {
         aiPbMgrSendAck(req, resp, EnumState_S_ERROR, data.nb_read - data.size,
             EnumError_E_MEM_OVERFLOW);
       }
 #if defined(AI_PB_TEST) && (AI_PB_TEST == 1)
-      memory_write((uintptr_t)buffer, (uint32_t)test, data.nb_read, &res);
+      memory_write((uintptr_t)buffer, (uint32_t)test, data.nb_read);
 #else
-      memory_write((uintptr_t)buffer, addr, data.nb_read, &res);
+      memory_write((uintptr_t)buffer, addr, data.nb_read);
 #endif
       size -= data.nb_read;
       addr += data.nb_read;
@@ -111,11 +259,214 @@ void aiPbCmdRWMemory(const reqMsg *req, respMsg *resp, void *param)
     aiPbMgrSendAck(req, resp, (size == 0)?EnumState_S_DONE:EnumState_S_PROCESSING,
           data.size, EnumError_E_NONE);
     while (size) {
-      data.addr = addr;
-      size -= data.size;
-      addr += data.size;
-      aiPbMgrSendData(req, resp, (size == 0)?EnumState_S_DONE:EnumState_S_PROCESSING, &data);
+      if (npu_is_active()) {
+        /* live inspection: batch-snapshot at the next epoch boundary and
+         * send from the snapshots while the NPU keeps running */
+        uint32_t staged = _mem_rd_win_snapshot(addr, size);
+        uint32_t i;
+        size -= staged;
+        addr += staged;
+        for (i = 0; staged; i++) {
+          data.addr = (uintptr_t)&_mem_rd_win_stage[i][0];
+          data.size = _mem_rd_win_req[i].size;
+          staged -= data.size;
+          aiPbMgrSendData(req, resp,
+              ((size == 0) && (staged == 0))?EnumState_S_DONE:EnumState_S_PROCESSING, &data);
+        }
+      }
+      else {
+        data.addr = addr;
+        size -= data.size;
+        addr += data.size;
+        aiPbMgrSendData(req, resp, (size == 0)?EnumState_S_DONE:EnumState_S_PROCESSING, &data);
+      }
       data.size = size>1024?1024:size;
     };
   }
 }
+
+/* Memory-subscription (watch) service - push instead of poll.
+ *
+ * The host registers up to _MEM_WATCH_MAX_RANGES address ranges and a
+ * sampling period, then the session stays open: the device samples the
+ * ranges itself and only pushes a compact change record (range address,
+ * timestamp in us, new contents) when a sample differs from the previous
+ * one. Monitoring a counter during a long run thus costs zero host-driven
+ * round trips while nothing changes, instead of one MEMORY_READ per poll.
+ *
+ * Session flow:
+ *  - req: param = number of ranges, opt = sampling period in ms;
+ *  - S_WAITING ack, then the host sends one aiDataMsg with the packed
+ *    {uint32 addr, uint32 size} descriptors;
+ *  - the initial contents of every range are pushed as baseline records,
+ *    then a record is pushed on each change (each push is a S_PROCESSING
+ *    data msg, acknowledged by the host as for a chunked MEMORY_READ);
+ *  - the host closes the session by sending one more ack: the device polls
+ *    for pending RX between samples, drains it and answers the final
+ *    S_DONE ack with the number of pushed records.
+ */
+#define _MEM_WATCH_MAX_RANGES  (4)
+#define _MEM_WATCH_MAX_SIZE    (64)
+
+struct _mem_watch_range {
+  uint32_t addr;
+  uint32_t size;
+  uint8_t snap[_MEM_WATCH_MAX_SIZE];  /* previous sample, for comparison */
+};
+
+static bool _mem_watch_push(const reqMsg *req, respMsg *resp,
+    const struct _mem_watch_range *range, uint32_t timestamp)
+{
+  /* contents are encoded straight from the watched address, the wire addr
+   * field identifies the range and the type field carries the timestamp */
+  aiPbData data = { timestamp, range->size, (uintptr_t)range->addr, 0 };
+  return aiPbMgrSendData(req, resp, EnumState_S_PROCESSING, &data);
+}
+
+void aiPbCmdMemWatch(const reqMsg *req, respMsg *resp, void *param)
+{
+  aiPbClockFunc_t now_fn = (aiPbClockFunc_t)param;
+  static struct _mem_watch_range ranges[_MEM_WATCH_MAX_RANGES];
+  uint32_t descs[_MEM_WATCH_MAX_RANGES * 2];
+  const uint32_t n_ranges = req->param;
+  const uint32_t period_us = req->opt * 1000U;
+  uint32_t pushed = 0;
+  uint32_t next, i;
+  bool stop = false;
+
+  if ((n_ranges == 0) || (n_ranges > _MEM_WATCH_MAX_RANGES) || (now_fn == NULL)) {
+    aiPbMgrSendAck(req, resp, EnumState_S_ERROR,
+        _MEM_WATCH_MAX_RANGES, EnumError_E_INVALID_PARAM);
+    return;
+  }
+
+  /* receive the {addr, size} descriptors */
+  aiPbData data = {0, n_ranges * 8, (uintptr_t)descs, 0};
+  aiPbMgrSendAck(req, resp, EnumState_S_WAITING, data.size, EnumError_E_NONE);
+  aiPbMgrReceiveData(&data);
+  if (data.nb_read != n_ranges * 8) {
+    aiPbMgrSendAck(req, resp, EnumState_S_ERROR,
+        data.nb_read, EnumError_E_INVALID_SIZE);
+    return;
+  }
+
+  for (i = 0; i < n_ranges; i++) {
+    ranges[i].addr = descs[2 * i];
+    ranges[i].size = descs[2 * i + 1];
+    if ((ranges[i].size == 0) || (ranges[i].size > _MEM_WATCH_MAX_SIZE) ||
+        !memory_valid_addr_range(ranges[i].addr, ranges[i].size, 0 /* read */)) {
+      aiPbMgrSendAck(req, resp, EnumState_S_ERROR,
+          i, EnumError_E_INVALID_PARAM);
+      return;
+    }
+    memcpy(ranges[i].snap, (const void *)(uintptr_t)ranges[i].addr, ranges[i].size);
+  }
+
+  /* baseline: push the initial contents of every range */
+  for (i = 0; i < n_ranges; i++) {
+    _mem_watch_push(req, resp, &ranges[i], now_fn());
+    pushed++;
+  }
+
+  next = now_fn() + period_us;
+  while (!stop) {
+    /* timed wait until the next sampling point, aborted as soon as the
+     * host sends its closing ack (wrap-safe on the 32-bit us clock) */
+    while ((int32_t)(next - now_fn()) > 0) {
+      if (ioRawHasRxEvent()) {
+        stop = true;
+        break;
+      }
+    }
+    if (stop)
+      break;
+    next += period_us;
+    for (i = 0; i < n_ranges; i++) {
+      if (memcmp(ranges[i].snap, (const void *)(uintptr_t)ranges[i].addr,
+          ranges[i].size) != 0) {
+        memcpy(ranges[i].snap, (const void *)(uintptr_t)ranges[i].addr,
+            ranges[i].size);
+        _mem_watch_push(req, resp, &ranges[i], now_fn());
+        pushed++;
+      }
+    }
+  }
+
+  /* drain the closing ack and terminate the session */
+  aiPbMgrWaitAck();
+  aiPbMgrSendAck(req, resp, EnumState_S_DONE, pushed, EnumError_E_NONE);
+}
+
+#if defined(USE_PROBE_WINDOW) && USE_PROBE_WINDOW == 1
+
+/* Probe-visible bulk-readback window (dual-path transfers)
+ *
+ * Beyond the CDC/UART link, the on-board debug probe can read target
+ * memory through the system access port while the firmware runs. The
+ * handler below publishes a region descriptor in a fixed 64-byte SRAM
+ * slot (.probe_window at the top of AXISRAM1, see STM32N657xx.ld) and
+ * the host reads the region directly via the probe (see
+ * scripts/N6_scripts/n6_utils_pkg/probe_window.py) while the CDC link
+ * carries only the control traffic, so both paths move data at once.
+ *
+ * Consistency: the sequence count is odd while an update is in flight
+ * and even once the descriptor is stable; the host samples it before and
+ * after the probe read and retries on a change. The published region is
+ * cleaned to RAM before the descriptor flips, the probe reads behind the
+ * CPU cache.
+ *
+ * Request: param = region base address, opt = size in bytes (both zero
+ * to unpublish). The S_DONE ack carries the new sequence count, the
+ * descriptor echoes the reqid as token.
+ */
+
+#define _PROBE_WIN_MAGIC  (0x30574250UL)  /* 'PBW0' */
+
+struct _probe_win_desc {
+  uint32_t magic;   /* _PROBE_WIN_MAGIC */
+  uint32_t seq;     /* bumped twice per publish, odd while updating */
+  uint32_t addr;    /* published region base, 0: nothing published */
+  uint32_t size;    /* published region size in bytes */
+  uint32_t token;   /* reqid of the publishing request */
+  uint32_t reserved[3];
+};
+
+/* fixed slot, NOLOAD: the contents survive a firmware reload, the magic
+   tells a fresh boot from a previously published descriptor */
+static volatile struct _probe_win_desc _probe_win
+    __attribute__((used, section(".probe_window")));
+
+void aiPbCmdProbeWindow(const reqMsg *req, respMsg *resp, void *param)
+{
+  const uint32_t addr = req->param;
+  const uint32_t size = req->opt;
+  (void)param;
+
+  if (size && !memory_valid_addr_range(addr, size, 0 /* read */)) {
+    aiPbMgrSendAck(req, resp, EnumState_S_ERROR, 0, EnumError_E_INVALID_PARAM);
+    return;
+  }
+
+  /* the slot is NOLOAD and holds garbage on a fresh boot */
+  if (_probe_win.magic != _PROBE_WIN_MAGIC)
+    _probe_win.seq = 0;
+
+  /* push the region to RAM first, the probe does not snoop the cache */
+  if (size)
+    mcu_cache_clean_range(addr, addr + size);
+
+  _probe_win.seq++;          /* odd: update in flight */
+  __DSB();
+  _probe_win.magic = _PROBE_WIN_MAGIC;
+  _probe_win.addr = size ? addr : 0;
+  _probe_win.size = size;
+  _probe_win.token = req->reqid;
+  __DSB();
+  _probe_win.seq++;          /* even: stable */
+  mcu_cache_clean_range((uint32_t)&_probe_win,
+                        (uint32_t)&_probe_win + sizeof(_probe_win));
+
+  aiPbMgrSendAck(req, resp, EnumState_S_DONE, _probe_win.seq, EnumError_E_NONE);
+}
+
+#endif /* USE_PROBE_WINDOW */
@@ -23,9 +23,37 @@
 
 void aiPbCmdRWMemory(const reqMsg *req, respMsg *resp, void *param);
 
+/* Epoch-boundary window service for safe concurrent reads: register with
+ * npu_set_epoch_service() so a MEMORY_READ issued while queued inferences
+ * run is snapshotted between epoch blocks instead of racing the stream
+ * engines */
+void memory_read_epoch_service(void);
+
 #define AI_PB_MEMORY_RW_SERVICES()\
     { EnumCmd_CMD_MEMORY_READ, &aiPbCmdRWMemory, (void *)EnumCmd_CMD_MEMORY_READ },\
     { EnumCmd_CMD_MEMORY_WRITE, &aiPbCmdRWMemory, (void* )EnumCmd_CMD_MEMORY_WRITE },\
     { EnumCmd_CMD_MEMORY_CHECKSUM, &aiPbCmdRWMemory, (void *)EnumCmd_CMD_MEMORY_CHECKSUM }
 
+void aiPbCmdMemWatch(const reqMsg *req, respMsg *resp, void *param);
+
+/* 'cmd' is a spare EnumCmd value chosen by the application, 'clk' an
+ * aiPbClockFunc_t returning microseconds, used to timestamp the pushed
+ * change records */
+#define AI_PB_MEMORY_WATCH_SERVICE(cmd, clk)\
+    { (EnumCmd)(cmd), &aiPbCmdMemWatch, (void *)(clk) }
+
+#if defined(USE_PROBE_WINDOW) && USE_PROBE_WINDOW == 1
+
+/* Publishes a region descriptor in the fixed probe-visible SRAM slot so
+ * the host dumps the region through the debug probe while the CDC link
+ * carries only control (see the implementation notes and the host-side
+ * scripts/N6_scripts/n6_utils_pkg/probe_window.py) */
+void aiPbCmdProbeWindow(const reqMsg *req, respMsg *resp, void *param);
+
+/* 'cmd' is a spare EnumCmd value chosen by the application */
+#define AI_PB_PROBE_WINDOW_SERVICE(cmd)\
+    { (EnumCmd)(cmd), &aiPbCmdProbeWindow, NULL }
+
+#endif /* USE_PROBE_WINDOW */
+
 #endif /* _AI_PB_MEM_RW_SERVICES_ */
@@ -88,7 +88,7 @@ int aiPbMgrWaitAndProcess(void)
   const aiPbCmdFunc *cfunc;
 
   pb_io_flush_istream();
-  if (pb_decode_delimited(&pbContextMgr.input, reqMsg_fields, &(pbContextMgr.req))) {
+  if (pb_io_decode_ctrl_delimited(reqMsg_fields, &(pbContextMgr.req))) {
     pb_io_flush_istream();
     pbContextMgr.state = PB_MGR_ON_GOING;
     for (idx = 0; idx < pbContextMgr.n_func; idx++) {
@@ -103,6 +103,8 @@ int aiPbMgrWaitAndProcess(void)
           EnumError_E_INVALID_PARAM, EnumError_E_INVALID_PARAM);
     }
     pbContextMgr.state = PB_MGR_READY;
+    /* an OOB abort only spans the command it interrupted */
+    pb_io_oob_clear();
   }
 
   pb_io_flush_istream();
@@ -176,23 +178,76 @@ void aiPbStrCopy(const char *src, char *dst, uint32_t max)
 
 /*
  * Callback function to encode array of uint32
+ *
+ * Batched: this callback carries the repeated varints of the hot report
+ * messages (per-epoch operator counters, tensor shapes), thousands of
+ * values for a profiled multi-hundred-epoch network. Instead of one
+ * pb_encode_tag_for_field/pb_encode_varint round trip per value (each a
+ * per-byte stream write), the constant tag is encoded once and 8 values
+ * per iteration are staged in a stack buffer emitted with a single
+ * pb_write. A whole batch of sub-128 values (the common case for shapes
+ * and per-epoch counters) takes the fixed-stride tag/byte path with no
+ * data-dependent branches.
  */
 bool encode_uint32(pb_ostream_t *stream, const pb_field_t *field,
                    void * const *arg)
 {
   struct _encode_uint32* array = (struct _encode_uint32 *)*arg;
   int offset = (array->offset == 0)?4:array->offset;
-  for (size_t i = 0; i < array->size; i++)
+  uint8_t tag[4];
+  size_t tag_len;
+  uint8_t buf[8 * (sizeof(tag) + 5)];  /* 8 x worst-case tag + 5B varint */
+  size_t i = 0;
+
+  /* the tag bytes are the same for every element of the repeated field */
   {
-    if (!pb_encode_tag_for_field(stream, field))
+    pb_ostream_t ts = pb_ostream_from_buffer(tag, sizeof(tag));
+    if (!pb_encode_tag_for_field(&ts, field))
       return false;
-    uint32_t c_val = 0;
-    if (offset == 2)
-      c_val = *(uint16_t*)((uint8_t *)array->data + i * offset);
-    else
-      c_val = *(uint32_t*)((uint8_t *)array->data + i * offset);
-    if (!pb_encode_varint(stream, (intptr_t)(c_val)))
+    tag_len = ts.bytes_written;
+  }
+
+  while (i < array->size)
+  {
+    uint32_t vals[8];
+    uint32_t all = 0;
+    uint8_t *p = &buf[0];
+    size_t n = array->size - i;
+    if (n > 8)
+      n = 8;
+
+    for (size_t j = 0; j < n; j++) {
+      uint32_t c_val;
+      if (offset == 2)
+        c_val = *(uint16_t*)((uint8_t *)array->data + (i + j) * offset);
+      else
+        c_val = *(uint32_t*)((uint8_t *)array->data + (i + j) * offset);
+      vals[j] = c_val;
+      all |= c_val;
+    }
+
+    if ((all < 0x80U) && (tag_len == 1)) {
+      for (size_t j = 0; j < n; j++) {
+        *p++ = tag[0];
+        *p++ = (uint8_t)vals[j];
+      }
+    }
+    else {
+      for (size_t j = 0; j < n; j++) {
+        for (size_t t = 0; t < tag_len; t++)
+          *p++ = tag[t];
+        uint32_t v = vals[j];
+        while (v >= 0x80U) {
+          *p++ = (uint8_t)(v | 0x80U);
+          v >>= 7;
+        }
+        *p++ = (uint8_t)v;
+      }
+    }
+
+    if (!pb_write(stream, &buf[0], (size_t)(p - &buf[0])))
       return false;
+    i += n;
   }
   return true;
 }
@@ -235,22 +290,33 @@ static bool decode_data_cb(pb_istream_t *stream, const pb_field_t *field,
   aiPbData *data = (aiPbData *)*arg;
 
   int maxr = data->size;
-  size_t itsize = 1;
   uint8_t *pw = (uint8_t *)data->addr;
   data->nb_read = 0;
 
-  /* Read data */
+  /* Read data - payload bytes are written directly in the destination
+   * buffer (chunked), no intermediate staging. */
   while (stream->bytes_left) {
-    uint64_t number;
-    if (!pb_read(stream, (pb_byte_t *)&number, itsize))
-      return false;
-    if ((pw) && (maxr > 0)) /* additional data are skipped */
-    {
-      *pw = *(uint8_t *)&number;
-      pw += itsize;
-      maxr--;
+    size_t chunk = stream->bytes_left;
+    if ((pw) && (maxr > 0)) {
+      if (chunk > (size_t)maxr)
+        chunk = (size_t)maxr;
+      if (!pb_read(stream, (pb_byte_t *)pw, chunk))
+        return false;
+      /* hash the chunk while it is still warm in the cache, the next
+       * bytes of the payload are meanwhile in flight on the transport */
+      if (data->hash_fn)
+        data->hash_fn(data->hash_arg, (const uint8_t *)pw, chunk);
+      pw += chunk;
+      maxr -= chunk;
     }
-    data->nb_read += itsize;
+    else { /* additional data are skipped */
+      uint64_t number;
+      if (chunk > sizeof(number))
+        chunk = sizeof(number);
+      if (!pb_read(stream, (pb_byte_t *)&number, chunk))
+        return false;
+    }
+    data->nb_read += chunk;
   }
 
   return true;
@@ -283,7 +349,14 @@ void aiPbMgrSendResp(const reqMsg *req, respMsg *resp,
 {
   resp->reqid = req->reqid;
   resp->state = state;
-  pb_encode(&pbContextMgr.output, respMsg_fields, resp);
+  /* bounded control payloads take the buffer-only fast path; the tensor
+     and operator payloads - or anything spilling the control buffer -
+     keep the streaming encoder */
+  if ((resp->which_payload == respMsg_data_tag) ||
+      (resp->which_payload == respMsg_op_tag) ||
+      (resp->which_payload == respMsg_tensor_tag) ||
+      !pb_io_encode_ctrl(respMsg_fields, resp))
+    pb_encode(&pbContextMgr.output, respMsg_fields, resp);
   pb_io_flush_ostream();
 }
 
@@ -300,7 +373,7 @@ bool aiPbMgrWaitAck(void)
 {
   bool res;
   ackMsg ack = ackMsg_init_default;
-  res = pb_decode_delimited(&pbContextMgr.input, ackMsg_fields, &ack);
+  res = pb_io_decode_ctrl_delimited(ackMsg_fields, &ack);
   pb_io_flush_istream();
   return res;
 }
@@ -322,7 +395,7 @@ bool aiPbMgrSendLog(const reqMsg *req, respMsg *resp,
 
   aiPbMgrSendResp(req, resp, state);
 
-  res = pb_decode_delimited(&pbContextMgr.input, ackMsg_fields, &ack);
+  res = pb_io_decode_ctrl_delimited(ackMsg_fields, &ack);
   pb_io_flush_istream();
   return res;
 }
@@ -346,7 +419,7 @@ bool aiPbMgrSendLogV2(EnumState state, uint32_t lvl, const char *str)
 
   aiPbMgrSendResp(&(pbContextMgr.req), &(pbContextMgr.resp), state);
 
-  res = pb_decode_delimited(&pbContextMgr.input, ackMsg_fields, &ack);
+  res = pb_io_decode_ctrl_delimited(ackMsg_fields, &ack);
   pb_io_flush_istream();
   return res;
 }
@@ -358,8 +431,9 @@ bool aiPbMgrReceiveData(aiPbData *data)
   msg.datas.funcs.decode = &decode_data_cb;
   msg.datas.arg = (void *)data;
 
-  /* Waiting and decoding aiDataMsg message */
-  pb_decode_delimited(&pbContextMgr.input, aiDataMsg_fields, &msg);
+  /* Waiting and decoding aiDataMsg message - scan-free decoder, a data
+     length prefix may legitimately collide with the OOB escape value */
+  pb_io_decode_data_delimited(aiDataMsg_fields, &msg);
   pb_io_flush_istream();
 
   data->type = msg.type;
@@ -485,6 +559,24 @@ void aiPbCmdSync(const reqMsg *req, respMsg *resp, void *param)
 }
 
 
+/*
+ * Host/device clock-sync probe.
+ *
+ * The device timestamp is sampled first thing after the request has been
+ * decoded and is echoed back in the ack param, so the host can bracket each
+ * probe with its own clock (t0/t1 around the round trip), keep the low-RTT
+ * samples and fit offset plus drift over a short probe train. param is the
+ * application clock getter (aiPbClockFunc_t, microseconds).
+ */
+void aiPbCmdClockSync(const reqMsg *req, respMsg *resp, void *param)
+{
+  aiPbClockFunc_t now_fn = (aiPbClockFunc_t)param;
+  uint32_t ts = now_fn ? now_fn() : 0;
+
+  aiPbMgrSendAck(req, resp, EnumState_S_DONE, ts, EnumError_E_NONE);
+}
+
+
 /*---------------------------------------------------------------------------*/
 
 #if defined(AI_PB_TEST) && (AI_PB_TEST == 1)
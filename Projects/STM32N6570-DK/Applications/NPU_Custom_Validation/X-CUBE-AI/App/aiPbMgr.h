@@ -49,6 +49,13 @@ int aiPbMgrWaitAndProcess(void);
 void aiPbCmdSync(const reqMsg *req, respMsg *resp, void *param);
 #define AI_PB_CMD_SYNC(par) { EnumCmd_CMD_SYNC, &aiPbCmdSync, (par) }
 
+/* Clock getter used by the clock-sync command: returns the current device
+ * timestamp in microseconds, from a free-running source (i.e. not reset by
+ * the per-run instrumentation). Registered as the table param. */
+typedef uint32_t (*aiPbClockFunc_t)(void);
+
+void aiPbCmdClockSync(const reqMsg *req, respMsg *resp, void *param);
+
 #define AI_PB_CMD_END      { (EnumCmd)0, NULL, NULL }
 
 #if defined(AI_PB_TEST) && (AI_PB_TEST == 1)
@@ -77,11 +84,18 @@ bool aiPbMgrSendLogV2(EnumState state, uint32_t lvl, const char *str);
 
 bool aiPbMgrWaitAck(void);
 
+/* Incremental hash hook fed by the transport receive path: each payload
+ * chunk is passed to the function as soon as it is decoded, so the caller
+ * gets the hash of the whole transfer without a re-read of the buffer. */
+typedef void (*aiPbHashUpdateFunc_t)(void *arg, const uint8_t *data, uint32_t size);
+
 typedef struct aiPbData {
   uint32_t  type;
   uint32_t  size;
   uintptr_t addr;
   uint32_t  nb_read;
+  aiPbHashUpdateFunc_t hash_fn; /* optional on-the-fly hash of the received payload */
+  void *hash_arg;               /* opaque context passed back to hash_fn */
 } aiPbData;
 
 bool aiPbMgrReceiveData(aiPbData *data);
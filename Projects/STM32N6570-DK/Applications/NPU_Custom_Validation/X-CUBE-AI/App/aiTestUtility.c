@@ -154,8 +154,11 @@ extern UX_SLAVE_CLASS_CDC_ACM *cdc_acm;
 #else
 
 #include "usbd_cdc_if.h"
+#include "app_config.h"  /* USB_RX_FIFO_SIZE */
 
-#define _MAX_USB_USER_ELEM (128)
+/* sized to hold a full credit window of packets (see USE_COM_RX_CREDITS),
+   the fifo is the elastic buffer backing the RX flow-control credits */
+#define _MAX_USB_USER_ELEM (USB_RX_FIFO_SIZE)
 
 uint8_t _usb_fifo[_MAX_USB_USER_ELEM];
 volatile uint32_t _usb_nb_w_item = 0;
@@ -163,10 +166,27 @@ volatile uint32_t _usb_nb_r_item = 0;
 uint8_t *_usb_p_read = &_usb_fifo[0];
 uint8_t *_usb_p_write = &_usb_fifo[0];
 
+/* fifo pressure gauges (see ioRawGetRxFifoStats): high-water mark and
+   bytes dropped on overrun - an overrun means the credit window was
+   over-granted or the host ignored it, never silent corruption */
+volatile uint32_t _usb_fifo_peak = 0;
+volatile uint32_t _usb_fifo_lost = 0;
+
 void ioPushInUserUsb(uint8_t *pw, uint32_t *len)
 {
   uint8_t *pr = pw;
-  for (int i=0; i < *len; i++) {
+  uint32_t level = _usb_nb_w_item - _usb_nb_r_item;
+  uint32_t count = *len;
+
+  if (count > _MAX_USB_USER_ELEM - level) {
+    /* count and drop the excess rather than overwriting unread bytes */
+    _usb_fifo_lost += count - (_MAX_USB_USER_ELEM - level);
+    count = _MAX_USB_USER_ELEM - level;
+  }
+  if (level + count > _usb_fifo_peak)
+    _usb_fifo_peak = level + count;
+
+  for (uint32_t i=0; i < count; i++) {
     *_usb_p_write++ = *pr++;
     if (_usb_p_write == &_usb_fifo[_MAX_USB_USER_ELEM])
       _usb_p_write = &_usb_fifo[0];
@@ -231,7 +251,8 @@ bool ioRawReadBuffer(uint8_t *buff, int count)
   };
 #else
   HAL_StatusTypeDef status = HAL_OK;
-  while ((_usb_nb_w_item - _usb_nb_r_item) < count) {};
+  /* the fifo is fed from the USB IRQ, sleep instead of spinning */
+  while ((_usb_nb_w_item - _usb_nb_r_item) < count) { __WFI(); };
 
   uint8_t *pw = buff;
   for (int i=0; i < count; i++) {
@@ -248,6 +269,36 @@ void ioRawDisableLLWrite(void)
 {
 }
 
+void ioRawWaitForEvent(void)
+{
+#if defined(UX_INCLUDE_USER_DEFINE_FILE) && defined(UX_STANDALONE)
+  /* USBX standalone is polled, the read path must run the USB tasks */
+#else
+  while (_usb_nb_w_item == _usb_nb_r_item)
+    __WFI();
+#endif
+}
+
+bool ioRawHasRxEvent(void)
+{
+#if defined(UX_INCLUDE_USER_DEFINE_FILE) && defined(UX_STANDALONE)
+  return true; /* polled stack, the read path must run the USB tasks */
+#else
+  return (_usb_nb_w_item != _usb_nb_r_item);
+#endif
+}
+
+void ioRawGetRxFifoStats(uint32_t *peak, uint32_t *lost)
+{
+#if defined(UX_INCLUDE_USER_DEFINE_FILE) && defined(UX_STANDALONE)
+  *peak = 0;  /* the USBX stack reads straight into the caller buffer */
+  *lost = 0;
+#else
+  *peak = _usb_fifo_peak;
+  *lost = _usb_fifo_lost;
+#endif
+}
+
 #else /* defined(USE_USB_CDC_CLASS) */
 
 bool ioRawWriteBuffer(uint8_t *buff, int count)
@@ -260,6 +311,28 @@ bool ioRawReadBuffer(uint8_t *buff, int count)
   return port_io_read(buff, count);
 }
 
+void ioRawWaitForEvent(void)
+{
+#if defined(HAS_IO_WFI_IDLE) && HAS_IO_WFI_IDLE == 1
+  port_io_wait_for_rx();
+#endif
+}
+
+bool ioRawHasRxEvent(void)
+{
+#if defined(HAS_IO_WFI_IDLE) && HAS_IO_WFI_IDLE == 1
+  return port_io_rx_pending();
+#else
+  return true; /* no RX poll available, never delay the transport */
+#endif
+}
+
+void ioRawGetRxFifoStats(uint32_t *peak, uint32_t *lost)
+{
+  *peak = 0;  /* UART reception has no application-side elastic fifo */
+  *lost = 0;
+}
+
 void ioRawDisableLLWrite(void)
 {
   _ioWriteAllowed = false;
@@ -407,10 +480,19 @@ void uint32_to_str(uint32_t val, char* dest, int max)
 #if !defined(USE_PRINTF_FROM_TOOL) || USE_PRINTF_FROM_TOOL != 1
 
 #include "lc_print.h"
+#include "app_config.h"
+
+#if defined(USE_LOG_DMA) && USE_LOG_DMA == 1
+/* ring-buffered, GPDMA-drained USART1 backend (see misc_toolbox.c): the
+   log call costs the ring store, the UART drain runs in the background */
+extern void log_dma_putc(const char c);
+#endif
 
 static void _put_c_driver(void *user, const char c)
 {
-#if defined(HAS_DEDICATED_PRINT_PORT) && HAS_DEDICATED_PRINT_PORT == 1
+#if defined(USE_LOG_DMA) && USE_LOG_DMA == 1
+  log_dma_putc(c);
+#elif defined(HAS_DEDICATED_PRINT_PORT) && HAS_DEDICATED_PRINT_PORT == 1
   port_io_dedicated_putc(c);
 #else
   if (_ioWriteAllowed)
@@ -471,9 +553,37 @@ struct io_malloc io_malloc;
 void* __real_malloc(size_t bytes);
 void __real_free(void *ptr);
 
+/* size-class of an allocation: <=32 is bin 0, each next bin doubles */
+static int _mon_alloc_bin(size_t bytes)
+{
+  size_t top = 32;
+  int bin = 0;
+
+  while ((bin < (_IO_MALLOC_N_BINS - 1)) && (bytes > top)) {
+    top <<= 1;
+    bin++;
+  }
+  return bin;
+}
+
+/* find/claim the per-call-site slot, -1 when the table is full */
+static int _mon_alloc_site(uint32_t ret_addr)
+{
+  for (int i = 0; i < _IO_MALLOC_N_SITES; i++) {
+    if (io_malloc.sites[i].ret_addr == ret_addr)
+      return i;
+    if (io_malloc.sites[i].ret_addr == 0) {
+      io_malloc.sites[i].ret_addr = ret_addr;
+      return i;
+    }
+  }
+  return -1;
+}
+
 void* __wrap_malloc(size_t bytes)
 {
   uint8_t *ptr;
+  int site;
 
   io_malloc.cfg |= 1 << 1;
 
@@ -483,9 +593,12 @@ void* __wrap_malloc(size_t bytes)
   /* add 2x32-bit for size and magic  number */
   ptr = (uint8_t*)__real_malloc(bytes + 8);
 
-  /* remember size */
+  site = _mon_alloc_site((uint32_t)(uintptr_t)__builtin_return_address(0));
+
+  /* remember size, the call-site slot is tagged in the top byte so the
+     free path can credit the right site (sizes stay below 16MB here) */
   if (ptr) {
-    *((uint32_t*)ptr) = bytes;
+    *((uint32_t*)ptr) = (uint32_t)bytes | ((uint32_t)(site + 1) << 24);
     *((uint32_t*)(ptr + 4 + bytes)) = MAGIC_MALLOC_NUMBER;
   }
 
@@ -493,6 +606,18 @@ void* __wrap_malloc(size_t bytes)
     io_malloc.alloc_req++;
     io_malloc.alloc += bytes;
 
+    io_malloc.bins[_mon_alloc_bin(bytes)]++;
+    if (site >= 0) {
+      struct io_malloc_site *s = &io_malloc.sites[site];
+      s->alloc_req++;
+      s->alloc += bytes;
+      s->used += bytes;
+      if (s->used > s->max)
+        s->max = s->used;
+    } else {
+      io_malloc.site_drop++;
+    }
+
     io_malloc.used += bytes;
 
     if (io_malloc.used > io_malloc.max) {
@@ -515,6 +640,7 @@ void __wrap_free(void *ptr)
 {
   uint8_t* p;
   uint32_t bytes;
+  int site;
 
   io_malloc.cfg |= 1 << 2;
 
@@ -523,6 +649,8 @@ void __wrap_free(void *ptr)
 
   p = (uint8_t*)ptr - 4;
   bytes = *((uint32_t*)p);
+  site = (int)(bytes >> 24) - 1;
+  bytes &= 0x00FFFFFFUL;
 
   if (*((uint32_t*)(p + 4 + bytes)) == MAGIC_MALLOC_NUMBER) {
     *((uint32_t*)(p + 4 + bytes)) = 0;
@@ -533,6 +661,9 @@ void __wrap_free(void *ptr)
     io_malloc.free += bytes;
     io_malloc.used -= bytes;
 
+    if ((site >= 0) && (site < _IO_MALLOC_N_SITES))
+      io_malloc.sites[site].used -= bytes;
+
 #if _IO_MALLOC_TRACK_MODE == 1
     io_malloc.f_ptr[io_malloc.f_idx] = ptr;
     io_malloc.f_s[io_malloc.f_idx] = bytes;
@@ -605,6 +736,29 @@ void stackMonInit(uint32_t ctrl, uint32_t cstack, uint32_t msize)
 
 #endif
 
+/* -----------------------------------------------------------------------------
+ * ITM/SWO binary trace helpers
+ * -----------------------------------------------------------------------------
+ */
+
+int itmTraceEnabled(uint32_t port)
+{
+  /* same gating as ITM_SendChar, per stimulus port: nothing is emitted
+     unless the probe has enabled the ITM and the target port */
+  return ((ITM->TCR & ITM_TCR_ITMENA_Msk) != 0UL) &&
+         ((ITM->TER & (1UL << port)) != 0UL);
+}
+
+void itmTraceWords(uint32_t port, const uint32_t *words, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; i++) {
+    while (ITM->PORT[port].u32 == 0UL)
+      __NOP();
+    ITM->PORT[port].u32 = words[i];
+  }
+}
+
+
 /* -----------------------------------------------------------------------------
  * Device HW-setting functions
  * -----------------------------------------------------------------------------
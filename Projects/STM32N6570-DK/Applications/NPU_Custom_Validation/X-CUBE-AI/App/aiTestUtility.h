@@ -122,6 +122,20 @@ extern "C" {
 #define _IO_MALLOC_TRACK_MODE       0  /* allows to track the allocated/released @/s */
 #define _IO_MALLOC_TRACK_DEPTH_SIZE (16)
 
+/* size-class bins of the heap monitor: <=32, <=64, .. <=2048, larger */
+#define _IO_MALLOC_N_BINS           (8)
+/* distinct malloc call sites tracked by return address (first come) */
+#define _IO_MALLOC_N_SITES          (8)
+
+/* per-call-site statistics of the wrapped allocator */
+struct io_malloc_site {
+  uint32_t ret_addr;      /* call-site return address, 0 = free slot */
+  uint32_t alloc_req;     /* number of requested alloc */
+  uint32_t alloc;         /* accumulated size of allocated memory */
+  uint32_t used;          /* current allocated memory */
+  uint32_t max;           /* maximum allocated memory */
+};
+
 struct io_malloc {
   uint32_t cfg;           /* configuration and state */
   uint32_t alloc;         /* accumulated size of allocated memory */
@@ -130,6 +144,9 @@ struct io_malloc {
   uint32_t free_req;      /* number of requested free */
   uint32_t max;           /* maximum allocated memory */
   uint32_t used;          /* current allocated memory */
+  uint32_t bins[_IO_MALLOC_N_BINS];  /* alloc requests per size class */
+  struct io_malloc_site sites[_IO_MALLOC_N_SITES];
+  uint32_t site_drop;     /* allocations from untracked sites (table full) */
 #if _IO_MALLOC_TRACK_MODE == 1
   void* a_ptr[_IO_MALLOC_TRACK_DEPTH_SIZE];
   size_t a_s[_IO_MALLOC_TRACK_DEPTH_SIZE];
@@ -281,6 +298,24 @@ void stackMonInit(uint32_t ctrl, uint32_t cstack, uint32_t msize);
 #endif
 
 
+/* -----------------------------------------------------------------------------
+ * ITM/SWO binary trace helpers (USE_ITM_TRACE)
+ *
+ * Compact binary records over dedicated ITM stimulus ports: port 0 stays
+ * the char console (SWO_OUTPUT), port 1 carries the event ring records,
+ * port 2 the per-epoch counter reports. The writes are 32-bit stimulus
+ * accesses and only happen when the probe has enabled the ITM and the
+ * target port, so the main link is never perturbed by trace traffic.
+ * -----------------------------------------------------------------------------
+ */
+
+#define ITM_TRACE_PORT_EVT (1) /* event ring records, 2 words per event */
+#define ITM_TRACE_PORT_CNT (2) /* per-epoch counter records */
+
+int itmTraceEnabled(uint32_t port);
+void itmTraceWords(uint32_t port, const uint32_t *words, uint32_t count);
+
+
 /* -----------------------------------------------------------------------------
  * Timer/clock count functions
  * -----------------------------------------------------------------------------
@@ -428,6 +463,13 @@ int ioRawGetUint8(uint8_t *c, uint32_t timeout);
 void ioRawDisableLLWrite(void);
 bool ioRawWriteBuffer(uint8_t *buff, int count);
 bool ioRawReadBuffer(uint8_t *buff, int count);
+void ioRawWaitForEvent(void);
+bool ioRawHasRxEvent(void);
+
+/* RX elastic-fifo pressure: high-water mark (bytes) and bytes dropped on
+   overrun, both zero on ports without an application-side fifo (link
+   telemetry, see pb_io_get_link_stats) */
+void ioRawGetRxFifoStats(uint32_t *peak, uint32_t *lost);
 
 
 /* -----------------------------------------------------------------------------
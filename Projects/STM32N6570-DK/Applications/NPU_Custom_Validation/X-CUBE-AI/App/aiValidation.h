@@ -29,6 +29,12 @@ int aiValidationInit(void);
 int aiValidationProcess(void);
 void aiValidationDeInit(void);
 
+/* Scripted benchmark harness entry point (USE_BENCH_HARNESS builds only,
+   see aiBenchHarness_ATON.c): runs the generated bench_plan.h and emits
+   one machine-readable report over the UART, never returns to a host
+   command loop. Returns 0 when every step completed. */
+int aiBenchHarnessRun(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -277,7 +277,8 @@ __STATIC_INLINE bool port_io_read(uint8_t *buff, int count)
  */
 
 #include <bsp_ai.h>  /* generated STM32 platform file to import the HAL and the UART definition */
-   
+#include "app_config.h"  /* COM transport options (USE_COM_DMA_IDLE_RX) */
+
 #define port_hal_get_hal_version()        HAL_GetHalVersion()
 #define port_hal_get_dev_id()             0x486
 #define port_hal_get_rev_id()             0
@@ -304,8 +305,23 @@ __STATIC_INLINE bool port_io_read(uint8_t *buff, int count)
 
 extern UART_HandleTypeDef UartHandle;
 
+#if defined(USE_COM_DMA_IDLE_RX) && USE_COM_DMA_IDLE_RX == 1
+/* circular-DMA reception with IDLE-line framing (see misc_toolbox.c):
+   the RX bytes stream into a DMA ring, the read hooks below drain it */
+extern bool com_rx_read(uint8_t *buff, int count);
+extern bool com_rx_get(uint8_t *c, uint32_t timeout);
+extern bool com_rx_pending(void);
+extern void com_rx_wait(void);
+#endif
+
 __STATIC_INLINE bool port_io_get(uint8_t *c, uint32_t timeout)
 {
+#if defined(USE_COM_DMA_IDLE_RX) && USE_COM_DMA_IDLE_RX == 1
+  if (!c)
+    return false;
+
+  return com_rx_get(c, timeout);
+#else
   HAL_StatusTypeDef status;
 
   if (!c)
@@ -317,6 +333,7 @@ __STATIC_INLINE bool port_io_get(uint8_t *c, uint32_t timeout)
     return false;
 
   return (status == HAL_OK);
+#endif
 }
 
 
@@ -350,13 +367,59 @@ __STATIC_INLINE bool port_io_write(uint8_t *buff, int count)
 
 __STATIC_INLINE bool port_io_read(uint8_t *buff, int count)
 {
+#if defined(USE_COM_DMA_IDLE_RX) && USE_COM_DMA_IDLE_RX == 1
+  return com_rx_read(buff, count);
+#else
   HAL_StatusTypeDef status;
-  
+
   status = HAL_UART_Receive(&UartHandle, buff, count, HAL_MAX_DELAY);
-  
+
   return (status == HAL_OK);
+#endif
+}
+
+#define HAS_IO_WFI_IDLE                   1
+
+#if defined(USE_COM_DMA_IDLE_RX) && USE_COM_DMA_IDLE_RX == 1
+
+/* Sleep (WFI) until the host transport shows activity. The bytes stream
+   into the RX DMA ring on their own, the IDLE-line interrupt (one per
+   burst, see stm32n6xx_it.c) ends the sleep once a frame is complete. */
+__STATIC_INLINE void port_io_wait_for_rx(void)
+{
+  com_rx_wait();
 }
 
+/* Non-blocking check for host transport activity (see ioRawHasRxEvent) */
+__STATIC_INLINE bool port_io_rx_pending(void)
+{
+  return com_rx_pending();
+}
+
+#else  /* !USE_COM_DMA_IDLE_RX */
+
+/* Sleep (WFI) until the host transport shows activity. The USART RXNE
+   interrupt is armed as a wake-up event only: the handler (stm32n6xx_it.c)
+   disarms it and the data byte is then drained by the regular polled
+   HAL_UART_Receive(). Any other enabled interrupt (SysTick, USB,...) ends
+   the sleep as well, the loop simply re-checks the RX flag. */
+__STATIC_INLINE void port_io_wait_for_rx(void)
+{
+  while (__HAL_UART_GET_FLAG(&UartHandle, UART_FLAG_RXNE) == RESET) {
+    __HAL_UART_ENABLE_IT(&UartHandle, UART_IT_RXNE);
+    __WFI();
+  }
+  __HAL_UART_DISABLE_IT(&UartHandle, UART_IT_RXNE);
+}
+
+/* Non-blocking check for host transport activity (see ioRawHasRxEvent) */
+__STATIC_INLINE bool port_io_rx_pending(void)
+{
+  return (__HAL_UART_GET_FLAG(&UartHandle, UART_FLAG_RXNE) != RESET);
+}
+
+#endif /* USE_COM_DMA_IDLE_RX */
+
 #elif defined(SR5E1)
 
 /* --------------------------------------------
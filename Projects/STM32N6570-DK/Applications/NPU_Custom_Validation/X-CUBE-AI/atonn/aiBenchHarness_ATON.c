@@ -0,0 +1,255 @@
+/**
+ ******************************************************************************
+ * @file    aiBenchHarness_ATON.c
+ * @author  MCD/AIS Team
+ * @brief   Scripted benchmark harness - ATON/NPU runtime
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2024 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software is licensed under terms that can be found in the LICENSE file in
+ * the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Description
+ *
+ * Push-button, host-independent benchmark entry point (USE_BENCH_HARNESS,
+ * BUILD_CONF=N6-DK-harness): main() calls aiBenchHarnessRun() instead of
+ * entering the host-driven command loop. The benchmark plan - which models,
+ * how many warm-up and measured iterations, which counter preset per step -
+ * is baked at build time into the generated bench_plan.h (see
+ * scripts/N6_scripts/gen_bench_plan.py and the armgcc Makefile), the inputs
+ * are synthesized on-device from a fixed seed, and the results go out over
+ * the UART as one line-oriented machine-readable report. The same flashed
+ * image reproduces its numbers on every reset, so a CI runner only needs
+ * power, a serial port and the report grammar below - no protobuf stack,
+ * no python session, no transport jitter inside the measured window.
+ *
+ * Report grammar (every record is one "b:"-prefixed line, ':'-separated
+ * fields, numbers in decimal unless prefixed 0x):
+ *   b:begin:<plan>:<git>:<conf>:<flags_crc>:<sclk>
+ *   b:model:<step>:<name>:<n_epochs>          once per step
+ *   b:run:<step>:<iters>:<preset>:<seed>      measured loop parameters
+ *   b:cpu_all:<step>:<min>:<mean>:<max>       cycles, over the measured runs
+ *   b:time_ms:<step>:<mean>                   mean inference time
+ *   b:cache:<step>:<r_miss>:<w_miss>          NPU cache, measured-loop delta
+ *   b:hwc:<step>:<fmt>:<v0>:...               HW counter totals (preset only)
+ *   b:error:<step>:<code>                     a failing step, plan continues
+ *   b:end:<ok>:<total>:<status>               status 0: every step completed
+ *
+ * The cpu_all min/mean/max come from the same npu_run()/npu_counters path
+ * the hosted benchmarks use, so harness numbers and _CMD_NETWORK_BENCH
+ * numbers are directly comparable. Steps with a counter preset register the
+ * per-epoch callback to harvest the HW counters and therefore carry the
+ * epoch instrumentation overhead; keep a COUNTER_PRESET_NONE step in the
+ * plan for the clean timing reference.
+ */
+
+/* System headers */
+#include <stdint.h>
+#include <string.h>
+
+#include "ll_aton_runtime.h"
+
+/* APP Header files */
+#include "app_config.h"
+#include "aiValidation.h"
+
+#include <aiTestUtility.h>
+
+#include "ai_wrapper_ATON.h"
+#include "mcu_cache.h"
+#include "misc_toolbox.h"  /* toolbox_prng_fill() for the synthesized inputs */
+
+#if defined(USE_BENCH_HARNESS) && USE_BENCH_HARNESS == 1
+
+/* Per-build manifest, generated by the armgcc Makefile (see the
+   _build_manifest notes in aiValidation_ATON.c): the report header ties
+   every number to the exact build it was measured on. */
+#if defined(__has_include)
+#if __has_include("build_manifest.h")
+#include "build_manifest.h"
+#endif
+#endif
+#ifndef BUILD_GIT_DESC
+#define BUILD_GIT_DESC "unknown"
+#endif
+#ifndef BUILD_CONF_NAME
+#define BUILD_CONF_NAME "unknown"
+#endif
+#ifndef BUILD_FLAGS_CRC
+#define BUILD_FLAGS_CRC (0UL)
+#endif
+
+/* One step of the plan; bench_plan.h provides the BENCH_PLAN_* macros and
+   the BENCH_PLAN_STEPS initializer list in field order. The option field
+   is a ready-made instance run option (counter preset already positioned,
+   see COUNTER_PRESET_POS), the label is the preset name for the report. */
+struct _bench_step {
+  uint8_t model;               /* npu_get_instance_by_index() index */
+  uint8_t warmup;              /* unmeasured runs before the loop */
+  uint32_t iters;              /* measured runs */
+  uint32_t option;             /* instance option (counter preset field) */
+  const char *label;           /* preset name, report only */
+};
+
+#include "bench_plan.h"
+
+static const struct _bench_step _bench_plan[BENCH_PLAN_N_STEPS] = {
+  BENCH_PLAN_STEPS
+};
+
+/* fixed xorshift seed of the synthesized inputs (per step: seed + index),
+   non-zero and stable so two boards running the same image compute on the
+   same bit patterns */
+#define _BENCH_SEED (0x42u)
+
+/* HW counter harvest of the current step (presets only): totals over every
+   epoch of every measured run, the format word captured from the first
+   notification */
+static uint64_t _hwc_total[NPU_MAX_COUNTERS];
+static uint32_t _hwc_fmt;
+
+static void _bench_epoch_cb(const LL_ATON_RT_Callbacktype_t ctype,
+                            const int16_t cidx,
+                            const LL_ATON_RT_EpochBlockItem_t *epoch_block,
+                            struct npu_epoch_counters *counters)
+{
+  UNUSED(ctype);
+  UNUSED(cidx);
+  UNUSED(epoch_block);
+
+  uint32_t n = COUNTER_FMT_NUMBER(counters->counter_fmt);
+  if (n > NPU_MAX_COUNTERS)
+    n = NPU_MAX_COUNTERS;
+  if (_hwc_fmt == 0)
+    _hwc_fmt = counters->counter_fmt;
+  for (uint32_t i = 0; i < n; i++)
+    _hwc_total[i] += counters->counters[i];
+}
+
+/* Runs one plan step: init, synthesize the inputs, warm up, measure.
+   Returns 0 on success, <0 on error (already reported). */
+static int _bench_step_run(int idx, const struct _bench_step *step)
+{
+  struct npu_instance instance;
+  struct npu_counters counters = {0};
+  uint64_t sum = 0, min = UINT64_MAX, max = 0;
+  int res;
+
+  if (npu_get_instance_by_index(step->model, &instance) != 0) {
+    LC_PRINT("b:error:%d:%d\r\n", idx, -1);
+    return -1;
+  }
+
+  res = npu_init(&instance, 1);
+  if (res != 0) {
+    LC_PRINT("b:error:%d:%d\r\n", idx, res);
+    return res;
+  }
+
+  LC_PRINT("b:model:%d:%s:%d\r\n", idx, instance.info.name,
+           (int)instance.info.n_epochs);
+
+  /* deterministic inputs, same fill/cache idiom as the self-input RUN */
+  uint32_t state = _BENCH_SEED + (uint32_t)idx;
+  for (uint32_t i = 0; i < instance.info.n_inputs; i++) {
+    toolbox_prng_fill((void *)LL_Buffer_addr_start(instance.info.in_bufs[i]),
+                      get_ll_buffer_size(instance.info.in_bufs[i]), &state);
+    mcu_cache_clean_invalidate_range(
+        (uint32_t)LL_Buffer_addr_start(instance.info.in_bufs[i]),
+        (uint32_t)LL_Buffer_addr_end(instance.info.in_bufs[i]));
+  }
+
+  instance.option = step->option;
+  /* HW counters need the per-epoch callback; a preset-less step runs
+     callback-free like the deployment steady state */
+  npu_set_callback(&instance,
+      ((step->option >> COUNTER_PRESET_POS) & COUNTER_PRESET_MSK)
+          != COUNTER_PRESET_NONE ? &_bench_epoch_cb : NULL);
+
+  LC_PRINT("b:run:%d:%u:%s:0x%x\r\n", idx, (unsigned int)step->iters,
+           step->label, (unsigned int)(_BENCH_SEED + (uint32_t)idx));
+
+  for (uint32_t it = 0; it < step->warmup; it++) {
+    res = npu_run(&instance, &counters);
+    if (res < 0) {
+      LC_PRINT("b:error:%d:%d\r\n", idx, res);
+      npu_init(&instance, 0);
+      return res;
+    }
+  }
+  /* cache-miss counters are cumulative since npu_init, the warm-up runs
+     only establish the baseline */
+  uint64_t r_base = counters.cache_r_miss;
+  uint64_t w_base = counters.cache_w_miss;
+
+  memset(_hwc_total, 0, sizeof(_hwc_total));  /* drop the warm-up epochs */
+  _hwc_fmt = 0;
+
+  for (uint32_t it = 0; it < step->iters; it++) {
+    res = npu_run(&instance, &counters);
+    if (res < 0) {
+      LC_PRINT("b:error:%d:%d\r\n", idx, res);
+      npu_init(&instance, 0);
+      return res;
+    }
+    sum += counters.cpu_all;
+    if (counters.cpu_all < min)
+      min = counters.cpu_all;
+    if (counters.cpu_all > max)
+      max = counters.cpu_all;
+  }
+
+  LC_PRINT("b:cpu_all:%d:%u:%u:%u\r\n", idx,
+           (unsigned int)min, (unsigned int)(sum / step->iters),
+           (unsigned int)max);
+  LC_PRINT("b:time_ms:%d:%f\r\n", idx,
+           dwtCyclesToFloatMs(sum / step->iters));
+  LC_PRINT("b:cache:%d:%u:%u\r\n", idx,
+           (unsigned int)(counters.cache_r_miss - r_base),
+           (unsigned int)(counters.cache_w_miss - w_base));
+
+  if (_hwc_fmt != 0) {
+    uint32_t n = COUNTER_FMT_NUMBER(_hwc_fmt);
+    if (n > NPU_MAX_COUNTERS)
+      n = NPU_MAX_COUNTERS;
+    LC_PRINT("b:hwc:%d:0x%x", idx, (unsigned int)_hwc_fmt);
+    for (uint32_t i = 0; i < n; i++)
+      LC_PRINT(":%u", (unsigned int)_hwc_total[i]);
+    LC_PRINT("\r\n");
+  }
+
+  npu_init(&instance, 0);  /* release before the next step re-installs */
+  return 0;
+}
+
+int aiBenchHarnessRun(void)
+{
+  struct mcu_conf conf;
+  int ok = 0;
+
+  cyclesCounterInit();
+  getSysConf(&conf);
+
+  LC_PRINT("b:begin:%s:%s:%s:0x%08x:%u\r\n", BENCH_PLAN_NAME,
+           BUILD_GIT_DESC, BUILD_CONF_NAME,
+           (unsigned int)BUILD_FLAGS_CRC, (unsigned int)conf.sclk);
+
+  for (int i = 0; i < BENCH_PLAN_N_STEPS; i++) {
+    if (_bench_step_run(i, &_bench_plan[i]) == 0)
+      ok++;
+  }
+
+  LC_PRINT("b:end:%d:%d:%d\r\n", ok, BENCH_PLAN_N_STEPS,
+           (ok == BENCH_PLAN_N_STEPS) ? 0 : 1);
+
+  return (ok == BENCH_PLAN_N_STEPS) ? 0 : -1;
+}
+
+#endif /* USE_BENCH_HARNESS */
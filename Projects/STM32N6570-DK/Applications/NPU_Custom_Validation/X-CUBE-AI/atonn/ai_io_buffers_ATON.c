@@ -19,343 +19,127 @@
 #include "ai_io_buffers_ATON.h"
 #include "ll_aton_NN_interface.h"
 
+#include "app_config.h"
+#include "mcu_cache.h"
+#if defined(USE_MPU_WT_IO) && USE_MPU_WT_IO == 1
+#include "misc_toolbox.h"
+#endif
+
 // #include "network.h"
 #include "kws.h"
 #include "img.h"
 
+/* ------ IO arena ------
+ *
+ * The IO buffers of the default network are carved out of a single aligned
+ * arena, sized by the LL_Buffer_InfoTypeDef metadata at connect time. The
+ * previous per-count static data_in_N/data_out_N arrays reserved the build
+ * worst case for every buffer slot; with the arena only the bytes actually
+ * requested by the resident model are committed, and the same storage is
+ * re-carved when another model becomes the default.
+ */
+
+#if (defined(LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS) && (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS > 0)) ||                 \
+    (defined(LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS) && (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS > 0))
 
-/* ------ Allocated inputs ------ */
+#define HAS_USER_ALLOCATED_IO 1
 
-#if (defined(LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS) && (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS > 0))
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS == 1)
-static int8_t data_in_1[LL_ATON_DEFAULT_IN_1_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_1_ALIGNMENT));
-#endif   /* USER_ALLOCATED_INPUTS == 1 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS == 2)
-static int8_t data_in_1[LL_ATON_DEFAULT_IN_1_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_1_ALIGNMENT));
-static int8_t data_in_2[LL_ATON_DEFAULT_IN_2_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_2_ALIGNMENT));
-#endif   /* USER_ALLOCATED_INPUTS == 2 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS == 3)
-static int8_t data_in_1[LL_ATON_DEFAULT_IN_1_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_1_ALIGNMENT));
-static int8_t data_in_2[LL_ATON_DEFAULT_IN_2_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_2_ALIGNMENT));
-static int8_t data_in_3[LL_ATON_DEFAULT_IN_3_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_3_ALIGNMENT));
-#endif   /* USER_ALLOCATED_INPUTS == 3 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS == 4)
-static int8_t data_in_1[LL_ATON_DEFAULT_IN_1_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_1_ALIGNMENT));
-static int8_t data_in_2[LL_ATON_DEFAULT_IN_2_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_2_ALIGNMENT));
-static int8_t data_in_3[LL_ATON_DEFAULT_IN_3_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_3_ALIGNMENT));
-static int8_t data_in_4[LL_ATON_DEFAULT_IN_4_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_4_ALIGNMENT));
-#endif   /* USER_ALLOCATED_INPUTS == 4 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS == 5)
-static int8_t data_in_1[LL_ATON_DEFAULT_IN_1_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_1_ALIGNMENT));
-static int8_t data_in_2[LL_ATON_DEFAULT_IN_2_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_2_ALIGNMENT));
-static int8_t data_in_3[LL_ATON_DEFAULT_IN_3_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_3_ALIGNMENT));
-static int8_t data_in_4[LL_ATON_DEFAULT_IN_4_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_4_ALIGNMENT));
-static int8_t data_in_5[LL_ATON_DEFAULT_IN_5_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_5_ALIGNMENT));
-#endif   /* USER_ALLOCATED_INPUTS == 5 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS == 6)
-static int8_t data_in_1[LL_ATON_DEFAULT_IN_1_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_1_ALIGNMENT));
-static int8_t data_in_2[LL_ATON_DEFAULT_IN_2_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_2_ALIGNMENT));
-static int8_t data_in_3[LL_ATON_DEFAULT_IN_3_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_3_ALIGNMENT));
-static int8_t data_in_4[LL_ATON_DEFAULT_IN_4_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_4_ALIGNMENT));
-static int8_t data_in_5[LL_ATON_DEFAULT_IN_5_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_5_ALIGNMENT));
-static int8_t data_in_6[LL_ATON_DEFAULT_IN_6_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_6_ALIGNMENT));
-#endif   /* USER_ALLOCATED_INPUTS == 6 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS == 7)
-static int8_t data_in_1[LL_ATON_DEFAULT_IN_1_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_1_ALIGNMENT));
-static int8_t data_in_2[LL_ATON_DEFAULT_IN_2_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_2_ALIGNMENT));
-static int8_t data_in_3[LL_ATON_DEFAULT_IN_3_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_3_ALIGNMENT));
-static int8_t data_in_4[LL_ATON_DEFAULT_IN_4_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_4_ALIGNMENT));
-static int8_t data_in_5[LL_ATON_DEFAULT_IN_5_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_5_ALIGNMENT));
-static int8_t data_in_6[LL_ATON_DEFAULT_IN_6_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_6_ALIGNMENT));
-static int8_t data_in_7[LL_ATON_DEFAULT_IN_7_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_7_ALIGNMENT));
-#endif   /* USER_ALLOCATED_INPUTS == 7 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS == 8)
-static int8_t data_in_1[LL_ATON_DEFAULT_IN_1_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_1_ALIGNMENT));
-static int8_t data_in_2[LL_ATON_DEFAULT_IN_2_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_2_ALIGNMENT));
-static int8_t data_in_3[LL_ATON_DEFAULT_IN_3_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_3_ALIGNMENT));
-static int8_t data_in_4[LL_ATON_DEFAULT_IN_4_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_4_ALIGNMENT));
-static int8_t data_in_5[LL_ATON_DEFAULT_IN_5_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_5_ALIGNMENT));
-static int8_t data_in_6[LL_ATON_DEFAULT_IN_6_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_6_ALIGNMENT));
-static int8_t data_in_7[LL_ATON_DEFAULT_IN_7_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_7_ALIGNMENT));
-static int8_t data_in_8[LL_ATON_DEFAULT_IN_8_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_8_ALIGNMENT));
-#endif   /* USER_ALLOCATED_INPUTS == 8 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS == 9)
-static int8_t data_in_1[LL_ATON_DEFAULT_IN_1_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_1_ALIGNMENT));
-static int8_t data_in_2[LL_ATON_DEFAULT_IN_2_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_2_ALIGNMENT));
-static int8_t data_in_3[LL_ATON_DEFAULT_IN_3_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_3_ALIGNMENT));
-static int8_t data_in_4[LL_ATON_DEFAULT_IN_4_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_4_ALIGNMENT));
-static int8_t data_in_5[LL_ATON_DEFAULT_IN_5_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_5_ALIGNMENT));
-static int8_t data_in_6[LL_ATON_DEFAULT_IN_6_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_6_ALIGNMENT));
-static int8_t data_in_7[LL_ATON_DEFAULT_IN_7_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_7_ALIGNMENT));
-static int8_t data_in_8[LL_ATON_DEFAULT_IN_8_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_8_ALIGNMENT));
-static int8_t data_in_9[LL_ATON_DEFAULT_IN_9_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_9_ALIGNMENT));
-#endif   /* USER_ALLOCATED_INPUTS == 9 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS == 10)
-static int8_t data_in_1[LL_ATON_DEFAULT_IN_1_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_1_ALIGNMENT));
-static int8_t data_in_2[LL_ATON_DEFAULT_IN_2_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_2_ALIGNMENT));
-static int8_t data_in_3[LL_ATON_DEFAULT_IN_3_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_3_ALIGNMENT));
-static int8_t data_in_4[LL_ATON_DEFAULT_IN_4_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_4_ALIGNMENT));
-static int8_t data_in_5[LL_ATON_DEFAULT_IN_5_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_5_ALIGNMENT));
-static int8_t data_in_6[LL_ATON_DEFAULT_IN_6_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_6_ALIGNMENT));
-static int8_t data_in_7[LL_ATON_DEFAULT_IN_7_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_7_ALIGNMENT));
-static int8_t data_in_8[LL_ATON_DEFAULT_IN_8_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_8_ALIGNMENT));
-static int8_t data_in_9[LL_ATON_DEFAULT_IN_9_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_9_ALIGNMENT));
-static int8_t data_in_10[LL_ATON_DEFAULT_IN_10_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_IN_10_ALIGNMENT));
-#endif   /* USER_ALLOCATED_INPUTS == 10 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS > 10)
-#error "LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS is too large"
+#ifndef AI_IO_ARENA_SIZE_BYTES
+#define AI_IO_ARENA_SIZE_BYTES (256 * 1024)
 #endif
-#endif   /* LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS */
 
-/* ------ Allocated outputs ------ */
+/* 32-byte slices: NPU cache-line aligned, covers the generated per-buffer
+   alignment requirements */
+#define _IO_ARENA_ALIGN (32)
 
-#if (defined(LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS) && (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS > 0))
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS == 1)
-static int8_t data_out_1[LL_ATON_DEFAULT_OUT_1_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_1_ALIGNMENT));
-#endif   /* USER_ALLOCATED_OUTPUTS == 1 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS == 2)
-static int8_t data_out_1[LL_ATON_DEFAULT_OUT_1_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_1_ALIGNMENT));
-static int8_t data_out_2[LL_ATON_DEFAULT_OUT_2_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_2_ALIGNMENT));
-#endif   /* USER_ALLOCATED_OUTPUTS == 2 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS == 3)
-static int8_t data_out_1[LL_ATON_DEFAULT_OUT_1_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_1_ALIGNMENT));
-static int8_t data_out_2[LL_ATON_DEFAULT_OUT_2_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_2_ALIGNMENT));
-static int8_t data_out_3[LL_ATON_DEFAULT_OUT_3_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_3_ALIGNMENT));
-#endif   /* USER_ALLOCATED_OUTPUTS == 3 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS == 4)
-static int8_t data_out_1[LL_ATON_DEFAULT_OUT_1_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_1_ALIGNMENT));
-static int8_t data_out_2[LL_ATON_DEFAULT_OUT_2_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_2_ALIGNMENT));
-static int8_t data_out_3[LL_ATON_DEFAULT_OUT_3_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_3_ALIGNMENT));
-static int8_t data_out_4[LL_ATON_DEFAULT_OUT_4_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_4_ALIGNMENT));
-#endif   /* USER_ALLOCATED_OUTPUTS == 4 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS == 5)
-static int8_t data_out_1[LL_ATON_DEFAULT_OUT_1_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_1_ALIGNMENT));
-static int8_t data_out_2[LL_ATON_DEFAULT_OUT_2_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_2_ALIGNMENT));
-static int8_t data_out_3[LL_ATON_DEFAULT_OUT_3_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_3_ALIGNMENT));
-static int8_t data_out_4[LL_ATON_DEFAULT_OUT_4_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_4_ALIGNMENT));
-static int8_t data_out_5[LL_ATON_DEFAULT_OUT_5_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_5_ALIGNMENT));
-#endif   /* USER_ALLOCATED_OUTPUTS == 5 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS == 6)
-static int8_t data_out_1[LL_ATON_DEFAULT_OUT_1_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_1_ALIGNMENT));
-static int8_t data_out_2[LL_ATON_DEFAULT_OUT_2_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_2_ALIGNMENT));
-static int8_t data_out_3[LL_ATON_DEFAULT_OUT_3_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_3_ALIGNMENT));
-static int8_t data_out_4[LL_ATON_DEFAULT_OUT_4_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_4_ALIGNMENT));
-static int8_t data_out_5[LL_ATON_DEFAULT_OUT_5_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_5_ALIGNMENT));
-static int8_t data_out_6[LL_ATON_DEFAULT_OUT_6_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_6_ALIGNMENT));
-#endif   /* USER_ALLOCATED_OUTPUTS == 6 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS == 7)
-static int8_t data_out_1[LL_ATON_DEFAULT_OUT_1_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_1_ALIGNMENT));
-static int8_t data_out_2[LL_ATON_DEFAULT_OUT_2_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_2_ALIGNMENT));
-static int8_t data_out_3[LL_ATON_DEFAULT_OUT_3_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_3_ALIGNMENT));
-static int8_t data_out_4[LL_ATON_DEFAULT_OUT_4_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_4_ALIGNMENT));
-static int8_t data_out_5[LL_ATON_DEFAULT_OUT_5_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_5_ALIGNMENT));
-static int8_t data_out_6[LL_ATON_DEFAULT_OUT_6_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_6_ALIGNMENT));
-static int8_t data_out_7[LL_ATON_DEFAULT_OUT_7_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_7_ALIGNMENT));
-#endif   /* USER_ALLOCATED_OUTPUTS == 7 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS == 8)
-static int8_t data_out_1[LL_ATON_DEFAULT_OUT_1_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_1_ALIGNMENT));
-static int8_t data_out_2[LL_ATON_DEFAULT_OUT_2_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_2_ALIGNMENT));
-static int8_t data_out_3[LL_ATON_DEFAULT_OUT_3_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_3_ALIGNMENT));
-static int8_t data_out_4[LL_ATON_DEFAULT_OUT_4_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_4_ALIGNMENT));
-static int8_t data_out_5[LL_ATON_DEFAULT_OUT_5_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_5_ALIGNMENT));
-static int8_t data_out_6[LL_ATON_DEFAULT_OUT_6_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_6_ALIGNMENT));
-static int8_t data_out_7[LL_ATON_DEFAULT_OUT_7_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_7_ALIGNMENT));
-static int8_t data_out_8[LL_ATON_DEFAULT_OUT_8_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_8_ALIGNMENT));
-#endif   /* USER_ALLOCATED_OUTPUTS == 8 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS == 9)
-static int8_t data_out_1[LL_ATON_DEFAULT_OUT_1_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_1_ALIGNMENT));
-static int8_t data_out_2[LL_ATON_DEFAULT_OUT_2_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_2_ALIGNMENT));
-static int8_t data_out_3[LL_ATON_DEFAULT_OUT_3_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_3_ALIGNMENT));
-static int8_t data_out_4[LL_ATON_DEFAULT_OUT_4_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_4_ALIGNMENT));
-static int8_t data_out_5[LL_ATON_DEFAULT_OUT_5_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_5_ALIGNMENT));
-static int8_t data_out_6[LL_ATON_DEFAULT_OUT_6_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_6_ALIGNMENT));
-static int8_t data_out_7[LL_ATON_DEFAULT_OUT_7_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_7_ALIGNMENT));
-static int8_t data_out_8[LL_ATON_DEFAULT_OUT_8_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_8_ALIGNMENT));
-static int8_t data_out_9[LL_ATON_DEFAULT_OUT_9_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_9_ALIGNMENT));
-#endif   /* USER_ALLOCATED_OUTPUTS == 9 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS == 10)
-static int8_t data_out_1[LL_ATON_DEFAULT_OUT_1_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_1_ALIGNMENT));
-static int8_t data_out_2[LL_ATON_DEFAULT_OUT_2_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_2_ALIGNMENT));
-static int8_t data_out_3[LL_ATON_DEFAULT_OUT_3_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_3_ALIGNMENT));
-static int8_t data_out_4[LL_ATON_DEFAULT_OUT_4_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_4_ALIGNMENT));
-static int8_t data_out_5[LL_ATON_DEFAULT_OUT_5_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_5_ALIGNMENT));
-static int8_t data_out_6[LL_ATON_DEFAULT_OUT_6_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_6_ALIGNMENT));
-static int8_t data_out_7[LL_ATON_DEFAULT_OUT_7_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_7_ALIGNMENT));
-static int8_t data_out_8[LL_ATON_DEFAULT_OUT_8_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_8_ALIGNMENT));
-static int8_t data_out_9[LL_ATON_DEFAULT_OUT_9_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_9_ALIGNMENT));
-static int8_t data_out_10[LL_ATON_DEFAULT_OUT_10_SIZE_BYTES] __attribute__((aligned LL_ATON_DEFAULT_OUT_10_ALIGNMENT));
-#endif   /* USER_ALLOCATED_OUTPUTS == 10 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS > 10)
-#error "LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS is too large"
-#endif
-#endif   /* LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS */
+/* The arena lives in bank A of the linker NN overlay (.nn_overlay_a, see
+   STM32N657xx.ld): other mutually exclusive arenas placed in bank B share
+   the same physical AXISRAM addresses. The current owner is tracked so a
+   takeover by another model restarts the carving and scrubs the MCU cache
+   lines left over the bank by the previous owner. */
+static int8_t _io_arena[AI_IO_ARENA_SIZE_BYTES]
+    __attribute__((aligned(_IO_ARENA_ALIGN), section(".nn_overlay_a")));
+static uint32_t _io_arena_used;
+static const void *_io_arena_owner;
+
+static void *_io_arena_alloc(uint32_t size)
+{
+  size = (size + (_IO_ARENA_ALIGN - 1)) & ~(_IO_ARENA_ALIGN - 1);
+
+  if (_io_arena_used + size > AI_IO_ARENA_SIZE_BYTES)
+    return NULL;
+
+  void *ptr = &_io_arena[_io_arena_used];
+  _io_arena_used += size;
+
+  return ptr;
+}
+
+#endif /* user-allocated IO */
 
-                
 /* ------ External definitions from the .c file ------ */
-                
+
 extern LL_ATON_User_IO_Result_t LL_ATON_Set_User_Input_Buffer_Default(uint32_t num, void* buffer, uint32_t size);
 extern LL_ATON_User_IO_Result_t LL_ATON_Set_User_Output_Buffer_Default(uint32_t num, void* buffer, uint32_t size);
+#if defined(HAS_USER_ALLOCATED_IO)
+extern const LL_Buffer_InfoTypeDef *LL_ATON_Input_Buffers_Info_Default(void);
+extern const LL_Buffer_InfoTypeDef *LL_ATON_Output_Buffers_Info_Default(void);
+#endif
 
 /* ------ Utilities ------ */
-                
 
 void connect_input_buffers(void)
 {
-#if (defined(LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS) && (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS > 0))
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS == 1)
-LL_ATON_Set_User_Input_Buffer_Default(0, data_in_1, LL_ATON_DEFAULT_IN_1_SIZE_BYTES);
-#endif   /* USER_ALLOCATED_INPUTS == 1 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS == 2)
-LL_ATON_Set_User_Input_Buffer_Default(0, data_in_1, LL_ATON_DEFAULT_IN_1_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(1, data_in_2, LL_ATON_DEFAULT_IN_2_SIZE_BYTES);
-#endif   /* USER_ALLOCATED_INPUTS == 2 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS == 3)
-LL_ATON_Set_User_Input_Buffer_Default(0, data_in_1, LL_ATON_DEFAULT_IN_1_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(1, data_in_2, LL_ATON_DEFAULT_IN_2_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(2, data_in_3, LL_ATON_DEFAULT_IN_3_SIZE_BYTES);
-#endif   /* USER_ALLOCATED_INPUTS == 3 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS == 4)
-LL_ATON_Set_User_Input_Buffer_Default(0, data_in_1, LL_ATON_DEFAULT_IN_1_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(1, data_in_2, LL_ATON_DEFAULT_IN_2_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(2, data_in_3, LL_ATON_DEFAULT_IN_3_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(3, data_in_4, LL_ATON_DEFAULT_IN_4_SIZE_BYTES);
-#endif   /* USER_ALLOCATED_INPUTS == 4 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS == 5)
-LL_ATON_Set_User_Input_Buffer_Default(0, data_in_1, LL_ATON_DEFAULT_IN_1_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(1, data_in_2, LL_ATON_DEFAULT_IN_2_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(2, data_in_3, LL_ATON_DEFAULT_IN_3_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(3, data_in_4, LL_ATON_DEFAULT_IN_4_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(4, data_in_5, LL_ATON_DEFAULT_IN_5_SIZE_BYTES);
-#endif   /* USER_ALLOCATED_INPUTS == 5 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS == 6)
-LL_ATON_Set_User_Input_Buffer_Default(0, data_in_1, LL_ATON_DEFAULT_IN_1_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(1, data_in_2, LL_ATON_DEFAULT_IN_2_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(2, data_in_3, LL_ATON_DEFAULT_IN_3_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(3, data_in_4, LL_ATON_DEFAULT_IN_4_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(4, data_in_5, LL_ATON_DEFAULT_IN_5_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(5, data_in_6, LL_ATON_DEFAULT_IN_6_SIZE_BYTES);
-#endif   /* USER_ALLOCATED_INPUTS == 6 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS == 7)
-LL_ATON_Set_User_Input_Buffer_Default(0, data_in_1, LL_ATON_DEFAULT_IN_1_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(1, data_in_2, LL_ATON_DEFAULT_IN_2_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(2, data_in_3, LL_ATON_DEFAULT_IN_3_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(3, data_in_4, LL_ATON_DEFAULT_IN_4_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(4, data_in_5, LL_ATON_DEFAULT_IN_5_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(5, data_in_6, LL_ATON_DEFAULT_IN_6_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(6, data_in_7, LL_ATON_DEFAULT_IN_7_SIZE_BYTES);
-#endif   /* USER_ALLOCATED_INPUTS == 7 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS == 8)
-LL_ATON_Set_User_Input_Buffer_Default(0, data_in_1, LL_ATON_DEFAULT_IN_1_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(1, data_in_2, LL_ATON_DEFAULT_IN_2_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(2, data_in_3, LL_ATON_DEFAULT_IN_3_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(3, data_in_4, LL_ATON_DEFAULT_IN_4_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(4, data_in_5, LL_ATON_DEFAULT_IN_5_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(5, data_in_6, LL_ATON_DEFAULT_IN_6_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(6, data_in_7, LL_ATON_DEFAULT_IN_7_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(7, data_in_8, LL_ATON_DEFAULT_IN_8_SIZE_BYTES);
-#endif   /* USER_ALLOCATED_INPUTS == 8 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS == 9)
-LL_ATON_Set_User_Input_Buffer_Default(0, data_in_1, LL_ATON_DEFAULT_IN_1_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(1, data_in_2, LL_ATON_DEFAULT_IN_2_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(2, data_in_3, LL_ATON_DEFAULT_IN_3_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(3, data_in_4, LL_ATON_DEFAULT_IN_4_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(4, data_in_5, LL_ATON_DEFAULT_IN_5_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(5, data_in_6, LL_ATON_DEFAULT_IN_6_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(6, data_in_7, LL_ATON_DEFAULT_IN_7_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(7, data_in_8, LL_ATON_DEFAULT_IN_8_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(8, data_in_9, LL_ATON_DEFAULT_IN_9_SIZE_BYTES);
-#endif   /* USER_ALLOCATED_INPUTS == 9 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS == 10)
-LL_ATON_Set_User_Input_Buffer_Default(0, data_in_1, LL_ATON_DEFAULT_IN_1_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(1, data_in_2, LL_ATON_DEFAULT_IN_2_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(2, data_in_3, LL_ATON_DEFAULT_IN_3_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(3, data_in_4, LL_ATON_DEFAULT_IN_4_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(4, data_in_5, LL_ATON_DEFAULT_IN_5_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(5, data_in_6, LL_ATON_DEFAULT_IN_6_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(6, data_in_7, LL_ATON_DEFAULT_IN_7_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(7, data_in_8, LL_ATON_DEFAULT_IN_8_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(8, data_in_9, LL_ATON_DEFAULT_IN_9_SIZE_BYTES);
-LL_ATON_Set_User_Input_Buffer_Default(9, data_in_10, LL_ATON_DEFAULT_IN_10_SIZE_BYTES);
-#endif   /* USER_ALLOCATED_INPUTS == 10 */
-#endif   /* LL_ATON_DEFAULT_USER_ALLOCATED_INPUTS */
+#if defined(HAS_USER_ALLOCATED_IO)
+  const LL_Buffer_InfoTypeDef *buf = LL_ATON_Input_Buffers_Info_Default();
+
+#if defined(USE_MPU_WT_IO) && USE_MPU_WT_IO == 1
+  /* map the whole arena write-through once, the carving stays inside it */
+  static bool _mpu_mapped;
+  if (!_mpu_mapped) {
+    MPU_WT_Region_Config(0, (uint32_t)(uintptr_t)_io_arena, sizeof(_io_arena));
+    _mpu_mapped = true;
+  }
+#endif
+
+  if (_io_arena_owner != (const void *)buf) {
+    /* overlay bank takeover: write back and drop the cache lines left over
+       the bank by the previous owner, a late eviction must not land on the
+       new owner's NPU-written outputs */
+    if (_io_arena_owner != NULL)
+      mcu_cache_clean_invalidate_range((uint32_t)(uintptr_t)_io_arena,
+                                       (uint32_t)(uintptr_t)_io_arena + sizeof(_io_arena));
+    _io_arena_owner = (const void *)buf;
+  }
+
+  /* inputs are carved first: a fresh connect restarts the carving */
+  _io_arena_used = 0;
+
+  for (uint32_t num = 0; buf && buf->name != NULL; num++, buf++) {
+    uint32_t size = LL_Buffer_len(buf);
+    void *ptr = _io_arena_alloc(size);
+
+    if (ptr == NULL)
+      return; /* arena exhausted, the buffer stays unconnected */
+
+    LL_ATON_Set_User_Input_Buffer_Default(num, ptr, size);
+  }
+#endif
 }
+
 void connect_output_buffers(void)
 {
-#if (defined(LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS) && (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS > 0))
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS == 1)
-LL_ATON_Set_User_Output_Buffer_Default(0, data_out_1, LL_ATON_DEFAULT_OUT_1_SIZE_BYTES);
-#endif   /* USER_ALLOCATED_OUTPUTS == 1 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS == 2)
-LL_ATON_Set_User_Output_Buffer_Default(0, data_out_1, LL_ATON_DEFAULT_OUT_1_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(1, data_out_2, LL_ATON_DEFAULT_OUT_2_SIZE_BYTES);
-#endif   /* USER_ALLOCATED_OUTPUTS == 2 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS == 3)
-LL_ATON_Set_User_Output_Buffer_Default(0, data_out_1, LL_ATON_DEFAULT_OUT_1_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(1, data_out_2, LL_ATON_DEFAULT_OUT_2_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(2, data_out_3, LL_ATON_DEFAULT_OUT_3_SIZE_BYTES);
-#endif   /* USER_ALLOCATED_OUTPUTS == 3 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS == 4)
-LL_ATON_Set_User_Output_Buffer_Default(0, data_out_1, LL_ATON_DEFAULT_OUT_1_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(1, data_out_2, LL_ATON_DEFAULT_OUT_2_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(2, data_out_3, LL_ATON_DEFAULT_OUT_3_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(3, data_out_4, LL_ATON_DEFAULT_OUT_4_SIZE_BYTES);
-#endif   /* USER_ALLOCATED_OUTPUTS == 4 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS == 5)
-LL_ATON_Set_User_Output_Buffer_Default(0, data_out_1, LL_ATON_DEFAULT_OUT_1_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(1, data_out_2, LL_ATON_DEFAULT_OUT_2_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(2, data_out_3, LL_ATON_DEFAULT_OUT_3_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(3, data_out_4, LL_ATON_DEFAULT_OUT_4_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(4, data_out_5, LL_ATON_DEFAULT_OUT_5_SIZE_BYTES);
-#endif   /* USER_ALLOCATED_OUTPUTS == 5 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS == 6)
-LL_ATON_Set_User_Output_Buffer_Default(0, data_out_1, LL_ATON_DEFAULT_OUT_1_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(1, data_out_2, LL_ATON_DEFAULT_OUT_2_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(2, data_out_3, LL_ATON_DEFAULT_OUT_3_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(3, data_out_4, LL_ATON_DEFAULT_OUT_4_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(4, data_out_5, LL_ATON_DEFAULT_OUT_5_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(5, data_out_6, LL_ATON_DEFAULT_OUT_6_SIZE_BYTES);
-#endif   /* USER_ALLOCATED_OUTPUTS == 6 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS == 7)
-LL_ATON_Set_User_Output_Buffer_Default(0, data_out_1, LL_ATON_DEFAULT_OUT_1_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(1, data_out_2, LL_ATON_DEFAULT_OUT_2_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(2, data_out_3, LL_ATON_DEFAULT_OUT_3_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(3, data_out_4, LL_ATON_DEFAULT_OUT_4_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(4, data_out_5, LL_ATON_DEFAULT_OUT_5_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(5, data_out_6, LL_ATON_DEFAULT_OUT_6_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(6, data_out_7, LL_ATON_DEFAULT_OUT_7_SIZE_BYTES);
-#endif   /* USER_ALLOCATED_OUTPUTS == 7 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS == 8)
-LL_ATON_Set_User_Output_Buffer_Default(0, data_out_1, LL_ATON_DEFAULT_OUT_1_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(1, data_out_2, LL_ATON_DEFAULT_OUT_2_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(2, data_out_3, LL_ATON_DEFAULT_OUT_3_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(3, data_out_4, LL_ATON_DEFAULT_OUT_4_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(4, data_out_5, LL_ATON_DEFAULT_OUT_5_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(5, data_out_6, LL_ATON_DEFAULT_OUT_6_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(6, data_out_7, LL_ATON_DEFAULT_OUT_7_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(7, data_out_8, LL_ATON_DEFAULT_OUT_8_SIZE_BYTES);
-#endif   /* USER_ALLOCATED_OUTPUTS == 8 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS == 9)
-LL_ATON_Set_User_Output_Buffer_Default(0, data_out_1, LL_ATON_DEFAULT_OUT_1_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(1, data_out_2, LL_ATON_DEFAULT_OUT_2_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(2, data_out_3, LL_ATON_DEFAULT_OUT_3_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(3, data_out_4, LL_ATON_DEFAULT_OUT_4_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(4, data_out_5, LL_ATON_DEFAULT_OUT_5_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(5, data_out_6, LL_ATON_DEFAULT_OUT_6_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(6, data_out_7, LL_ATON_DEFAULT_OUT_7_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(7, data_out_8, LL_ATON_DEFAULT_OUT_8_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(8, data_out_9, LL_ATON_DEFAULT_OUT_9_SIZE_BYTES);
-#endif   /* USER_ALLOCATED_OUTPUTS == 9 */
-#if (LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS == 10)
-LL_ATON_Set_User_Output_Buffer_Default(0, data_out_1, LL_ATON_DEFAULT_OUT_1_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(1, data_out_2, LL_ATON_DEFAULT_OUT_2_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(2, data_out_3, LL_ATON_DEFAULT_OUT_3_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(3, data_out_4, LL_ATON_DEFAULT_OUT_4_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(4, data_out_5, LL_ATON_DEFAULT_OUT_5_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(5, data_out_6, LL_ATON_DEFAULT_OUT_6_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(6, data_out_7, LL_ATON_DEFAULT_OUT_7_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(7, data_out_8, LL_ATON_DEFAULT_OUT_8_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(8, data_out_9, LL_ATON_DEFAULT_OUT_9_SIZE_BYTES);
-LL_ATON_Set_User_Output_Buffer_Default(9, data_out_10, LL_ATON_DEFAULT_OUT_10_SIZE_BYTES);
-#endif   /* USER_ALLOCATED_OUTPUTS == 10 */
-#endif   /* LL_ATON_DEFAULT_USER_ALLOCATED_OUTPUTS */
-}
\ No newline at end of file
+#if defined(HAS_USER_ALLOCATED_IO)
+  const LL_Buffer_InfoTypeDef *buf = LL_ATON_Output_Buffers_Info_Default();
+
+  for (uint32_t num = 0; buf && buf->name != NULL; num++, buf++) {
+    uint32_t size = LL_Buffer_len(buf);
+    void *ptr = _io_arena_alloc(size);
+
+    if (ptr == NULL)
+      return; /* arena exhausted, the buffer stays unconnected */
+
+    LL_ATON_Set_User_Output_Buffer_Default(num, ptr, size);
+  }
+#endif
+}
@@ -36,6 +36,14 @@
 
 
 #include "app_config.h"
+#if defined(USE_MPU_WT_IO) && USE_MPU_WT_IO == 1
+#include "misc_toolbox.h"
+#endif
+#if defined(USE_EC_FLASH_PARTITION) && USE_EC_FLASH_PARTITION == 1
+#include <stdio.h> /* snprintf */
+
+#include "ecloader.h"
+#endif
 
 #include "aiTestUtility.h"
 
@@ -48,6 +56,10 @@
 
 #define USE_COUNTER_NPU_CACHE           1
 
+/* monitor values at epoch PRE_START, the POST_END readings are reported as
+   deltas against this base (see _npu_counters_PRE_START/_POST_END) */
+static uint32_t _npu_cache_base[8];
+
 int npu_cache_counters_enable(void)
 {
   if (CACHEAXI->CR1 & CACHEAXI_CR1_EN) {
@@ -78,6 +90,27 @@ int npu_cache_counters_get(uint32_t *counters)
   }
   return 1;
 }
+
+/* 64-bit software accumulation of the (32-bit, wrapping) monitor values:
+   the per-epoch deltas snapshotted by the counter hooks are summed here,
+   so hours-long soak runs keep trustworthy totals. Cleared at npu_init
+   (mode 1), see also _npu_counters_POST_END */
+static uint64_t _npu_cache_acc[8];
+
+int npu_cache_counters_acc_get(uint64_t *counters)
+{
+  if (!counters)
+    return 1;
+  for (int i=0; i<8; i++) {
+    counters[i] = _npu_cache_acc[i];
+  }
+  return 0;
+}
+
+void npu_cache_counters_acc_reset(void)
+{
+  memset(&_npu_cache_acc[0], 0, sizeof(_npu_cache_acc));
+}
 #else
 #define USE_COUNTER_NPU_CACHE           0
 
@@ -140,6 +173,17 @@ int npu_cache_counters_get(uint32_t *counters)
 #define _RELOC_EXEC_RAM_ADDR   (0x34060000)
 #endif
 
+#if defined(USE_ACTS_PLACEMENT) && USE_ACTS_PLACEMENT == 1
+/* Fast on-chip window for the activations pool: AXIRAM2, free when the
+   exec RAM keeps its AXIRAM1 default (see npu_reloc_place_acts) */
+#define _RELOC_FAST_ACTS_ADDR  (0x34100000)
+#define _RELOC_FAST_ACTS_SZ    (1 * 1024 * 1024)  /* 1MB */
+
+#if defined(USE_RELOC_AB_BANKS) && USE_RELOC_AB_BANKS == 1
+#error "USE_ACTS_PLACEMENT is not supported with USE_RELOC_AB_BANKS (banked ext RAM bases)"
+#endif
+#endif /* USE_ACTS_PLACEMENT */
+
 #if defined(USE_RELOC_XIP_MODE) && USE_RELOC_XIP_MODE == 1
 #define _USED_RELOC_MODE   AI_RELOC_RT_LOAD_MODE_XIP
 #else
@@ -149,11 +193,67 @@ int npu_cache_counters_get(uint32_t *counters)
 
 static NN_Instance_TypeDef NN_Instance_Default;
 
+#if defined(USE_ACTS_PLACEMENT) && USE_ACTS_PLACEMENT == 1
+/* current placement of the activations/external pool,
+   npu_reloc_place_acts() moves it */
+static uintptr_t _acts_ram_addr = (uintptr_t)_RELOC_EXT_RAM_ADDR;
+static uint32_t _acts_ram_sz = _RELOC_MAX_EXT_RAM_SZ;
+#define _ACTS_RAM_ADDR  _acts_ram_addr
+#define _ACTS_RAM_SZ    _acts_ram_sz
+#else
+#define _ACTS_RAM_ADDR  ((uintptr_t)_RELOC_EXT_RAM_ADDR)
+#define _ACTS_RAM_SZ    _RELOC_MAX_EXT_RAM_SZ
+#endif
+
+#if defined(USE_RELOC_AB_BANKS) && USE_RELOC_AB_BANKS == 1
+
+/* A/B network banks: the exec and ext RAM budgets are halved, so the next
+   model can be installed in the inactive bank while the active one keeps
+   serving npu_run(). The switchover is a single pointer update. */
+#define _RELOC_BANK_EXEC_RAM_SZ     (_RELOC_MAX_EXEC_RAM_SZ / 2)
+#define _RELOC_BANK_EXT_RAM_SZ      (_RELOC_MAX_EXT_RAM_SZ / 2)
+#define _RELOC_BANK_EXEC_ADDR(_b)   ((uintptr_t)_RELOC_EXEC_RAM_ADDR + (_b) * _RELOC_BANK_EXEC_RAM_SZ)
+#define _RELOC_BANK_EXT_ADDR(_b)    ((uintptr_t)_RELOC_EXT_RAM_ADDR + (_b) * _RELOC_BANK_EXT_RAM_SZ)
+
+static NN_Instance_TypeDef NN_Instance_Banks[2];
+static NN_Instance_TypeDef *volatile _nn_active_inst;  /* instance served to the run path */
+static int _nn_active_bank;
+static int _nn_prepared_bank = -1;
+
+#endif /* USE_RELOC_AB_BANKS */
+
 #else /* !USE_RELOC_MODE */
 
-// LL_ATON_DECLARE_NAMED_NN_INSTANCE_AND_INTERFACE(Default)
-LL_ATON_DECLARE_NAMED_NN_INSTANCE_AND_INTERFACE(kws) 
-LL_ATON_DECLARE_NAMED_NN_INSTANCE_AND_INTERFACE(img)  
+/* List of the embedded networks, one _NPU_NET() entry per model. The list can
+   be overridden from 'app_config.h' (together with NPU_NETWORK_NUMBER) to
+   change the model zoo without editing this wrapper. */
+#ifndef NPU_NETWORK_LIST
+#define NPU_NETWORK_LIST \
+  _NPU_NET(kws)          \
+  _NPU_NET(img)
+#endif
+
+#define _NPU_NET(_name) LL_ATON_DECLARE_NAMED_NN_INSTANCE_AND_INTERFACE(_name)
+NPU_NETWORK_LIST
+#undef _NPU_NET
+
+/* Instance registry - indexed as npu_get_instance_by_index() */
+struct _nn_registry_entry {
+  const char *name;
+  NN_Instance_TypeDef *inst;
+};
+
+static const struct _nn_registry_entry _nn_registry[] = {
+#define _NPU_NET(_name) { #_name, &NN_Instance_##_name },
+    NPU_NETWORK_LIST
+#undef _NPU_NET
+};
+
+#define _NN_REGISTRY_COUNT ((int)(sizeof(_nn_registry) / sizeof(_nn_registry[0])))
+
+/* the per-network tables (exec contexts,...) are sized with
+   NPU_NETWORK_NUMBER, keep it consistent with the list */
+typedef char _nn_registry_size_check[(sizeof(_nn_registry) / sizeof(_nn_registry[0])) == NPU_NETWORK_NUMBER ? 1 : -1];
 
 #endif
 
@@ -172,13 +272,16 @@ uint32_t get_ll_element_size(const LL_Buffer_InfoTypeDef *aton_buf)
 * Return a pointer of the instance for a given model
 */
 
-static NN_Instance_TypeDef* _get_nn_instance(int idx)
-{
-  if (idx > 1)
-    return NULL;
-
 #if defined(USE_RELOC_MODE) && USE_RELOC_MODE == 1
 
+/*
+* Install the pending relocatable binary (PSRAM slot first, flash slot as
+* fallback) into the given memory region and bind it to 'nn_instance'.
+*/
+static NN_Instance_TypeDef* _reloc_install_instance(uintptr_t exec_ram_addr, uint32_t exec_ram_size,
+                                                    uintptr_t ext_ram_addr, uint32_t ext_ram_size_max,
+                                                    NN_Instance_TypeDef *nn_instance)
+{
   int res;
   uint32_t *rom_addr = (uint32_t *)_RELOC_BASE_ADDR_1;
   uintptr_t ext_param_addr = NULL;
@@ -200,36 +303,82 @@ static NN_Instance_TypeDef* _get_nn_instance(int idx)
   if (rt.params_off == 0)
     ext_param_addr = _RELOC_BASE_PARAMS_ADDR_0;
 
-  if (res || rt.ext_ram_sz > _RELOC_MAX_EXT_RAM_SZ)
+  if (res || rt.ext_ram_sz > ext_ram_size_max)
+    return NULL;
+
+  /* Load mode: compile-time default (see USE_RELOC_XIP_MODE), with an
+     automatic fallback to XIP when the COPY image does not fit the exec
+     RAM budget. In XIP only the data/got/bss sections are installed in
+     RAM, code/rodata (and the weights) stay memory-mapped in the flash -
+     this also skips the multi-second install copy of large models. */
+  uint32_t load_mode = _USED_RELOC_MODE;
+
+  if ((load_mode & AI_RELOC_RT_LOAD_MODE_COPY) &&
+      (rt.rt_ram_copy > exec_ram_size)) {
+    load_mode = AI_RELOC_RT_LOAD_MODE_XIP;
+  }
+
+  if ((load_mode & AI_RELOC_RT_LOAD_MODE_XIP) &&
+      (rt.rt_ram_xip > exec_ram_size))
     return NULL;
 
+#if defined(USE_LAZY_PARAMS) && USE_LAZY_PARAMS == 1
+  /* the params pool copy is deferred, the windows are staged per-epoch
+     from the PRE_START hook (see _lz_pre_start) */
+  load_mode |= AI_RELOC_RT_LOAD_MODE_LAZY_PARAMS;
+#endif
+
   // Create and install an instance of the relocatable model
   ll_aton_reloc_config config;
-  config.exec_ram_addr = (uintptr_t)_RELOC_EXEC_RAM_ADDR;
-  config.exec_ram_size = _RELOC_MAX_EXEC_RAM_SZ;
-  config.ext_ram_addr = (uintptr_t)_RELOC_EXT_RAM_ADDR;
+  config.exec_ram_addr = exec_ram_addr;
+  config.exec_ram_size = exec_ram_size;
+  config.ext_ram_addr = ext_ram_addr;
   config.ext_ram_size = rt.ext_ram_sz;
   config.ext_param_addr = ext_param_addr;
-  config.mode = _USED_RELOC_MODE; // AI_RELOC_RT_LOAD_MODE_CLEAR
+  config.mode = load_mode; // AI_RELOC_RT_LOAD_MODE_CLEAR
+
+  /* Fast path: the identical binary is already resident from a previous
+     session (content checked through its CRC-32), skip the full install */
+  if (ll_aton_reloc_is_installed((uintptr_t)rom_addr, &config, nn_instance))
+    return nn_instance;
 
-  res = ll_aton_reloc_install((uintptr_t)rom_addr, &config, &NN_Instance_Default);
+  res = ll_aton_reloc_install((uintptr_t)rom_addr, &config, nn_instance);
 
   if (res)
     return NULL;
 
-  return &NN_Instance_Default;
+  return nn_instance;
+}
+
+#endif /* USE_RELOC_MODE */
+
+static NN_Instance_TypeDef* _get_nn_instance(int idx)
+{
+  if (idx < 0)
+    return NULL;
+
+#if defined(USE_RELOC_MODE) && USE_RELOC_MODE == 1
+
+#if defined(USE_RELOC_AB_BANKS) && USE_RELOC_AB_BANKS == 1
+  if (_nn_active_inst == NULL) {
+    _nn_active_inst = _reloc_install_instance(_RELOC_BANK_EXEC_ADDR(0), _RELOC_BANK_EXEC_RAM_SZ,
+                                              _RELOC_BANK_EXT_ADDR(0), _RELOC_BANK_EXT_RAM_SZ,
+                                              &NN_Instance_Banks[0]);
+    _nn_active_bank = 0;
+  }
+  return _nn_active_inst;
+#else
+  return _reloc_install_instance((uintptr_t)_RELOC_EXEC_RAM_ADDR, _RELOC_MAX_EXEC_RAM_SZ,
+                                 _ACTS_RAM_ADDR, _ACTS_RAM_SZ,
+                                 &NN_Instance_Default);
+#endif
 
 #else
-  // [수정] idx가 0이면 kws, 1이면 img 반환 
-  if (idx == 0) { 
-    return &NN_Instance_kws; 
-  } 
-  else if (idx == 1) { 
-    return &NN_Instance_img; 
-  } 
-  else { 
-    return NULL; // 잘못된 인덱스 
-  } 
+  // [수정] 하드코딩된 kws/img 대신 레지스트리에서 반환
+  if (idx < _NN_REGISTRY_COUNT)
+    return _nn_registry[idx].inst;
+
+  return NULL; // 잘못된 인덱스
 #endif
 }
 
@@ -416,13 +565,13 @@ static void _populate_nn_info(struct npu_instance *instance)
   nn_info->version = ATONN_RT_VERSION;
   nn_info->rt_desc = ATONN_RT_DESC;
 
-  // [수정] 인스턴스 주소를 비교해서 이름을 다르게 설정 
-  if (instance->impl == &NN_Instance_img) { 
-    nn_info->name = "img"; 
-  } 
-  else if (instance->impl == &NN_Instance_kws) { 
-    nn_info->name = "kws"; 
-  } 
+  // [수정] 인스턴스 주소를 비교해서 레지스트리의 이름을 설정
+  for (int i = 0; i < _NN_REGISTRY_COUNT; i++) {
+    if (instance->impl == _nn_registry[i].inst) {
+      nn_info->name = _nn_registry[i].name;
+      break;
+    }
+  }
 
   bool has_no_desc;
 
@@ -507,10 +656,16 @@ static void _populate_nn_info(struct npu_instance *instance)
 /*
 * Internal structure to handle
 * the current ATON execution context
+*
+* Layout: the accumulators written on every epoch callback come first in
+* one cache-line-aligned group so the per-epoch updates dirty a single
+* line; the run/init configuration (written once per run) sits on its
+* own line after them. The per-epoch snapshot structs are line-aligned
+* as well - they are rewritten wholesale each epoch.
 */
 struct _npu_exec_context
 {
-  uint32_t mode;                      /* exec mode */
+  /* hot: written on every epoch callback */
   uint64_t cpu_cycles_start;          /* Accumulated number of CPU cycles between PRE_START and POST_START */
   uint64_t cpu_cycles_npu;            /* Accumulated number of CPU cycles between POST_START and PRE_END (npu core) */
   uint64_t cpu_cycles_end;            /* Accumulated number of CPU cycles between PRE_END and POST_END */
@@ -519,14 +674,20 @@ struct _npu_exec_context
   uint64_t npu_cycles_all;
 
   uint16_t exec_epoch_idx;
+  uint32_t cb_pending;                /* epoch blocks accumulated since the last delivery */
+  const LL_ATON_RT_EpochBlockItem_t *cb_last_eb; /* last epoch block of the current batch */
 
-  npu_user_cb user_cb;
+  struct npu_epoch_counters cur_epoch LL_ATON_ALIGNED(32);
+  struct npu_epoch_counters batch_epoch LL_ATON_ALIGNED(32); /* accumulated over cb_batch epoch blocks */
 
-  struct npu_epoch_counters cur_epoch;
+  /* cold: run/init configuration */
+  uint32_t mode LL_ATON_ALIGNED(32);  /* exec mode */
+  npu_user_cb user_cb;
+  uint32_t cb_batch;                  /* user cb aggregation factor (<=1: per-epoch) */
 };
 
 
-struct _npu_exec_context g_npu_exec_ctx;
+struct _npu_exec_context g_npu_exec_ctx LL_ATON_ALIGNED(32);
 
 
 #define _NPU_CLK_COUNTER         0
@@ -579,6 +740,29 @@ __STATIC_INLINE uint32_t _get_cycles_npu_free_counter(uint32_t fmt)
 }
 
 
+/* Named counter preset profiles (see COUNTER_PRESET_* in the header): the
+   preset id carried in the run option is replaced by the combination of
+   counter mux options it stands for. An unknown id leaves the option
+   untouched, so raw mux bits keep working unchanged. The NPU_CACHE bit of
+   the CACHE preset is silently ignored by the hooks below when the build
+   has no cache monitors, as for the raw bit. */
+uint32_t npu_counter_preset_expand(uint32_t option)
+{
+  static const uint32_t presets[] = {
+    0,                                               /* NONE */
+    COUNTER_OPT_BUSIF_RW_DATA,                       /* BANDWIDTH */
+    COUNTER_OPT_STRG_HENV | COUNTER_OPT_EPOCH_LEN,   /* STALL */
+    COUNTER_OPT_STRG_ACTIVE | COUNTER_OPT_EPOCH_LEN, /* ACTIVITY */
+    COUNTER_OPT_NPU_CACHE | COUNTER_OPT_EPOCH_LEN,   /* CACHE */
+  };
+  uint32_t id = (option >> COUNTER_PRESET_POS) & COUNTER_PRESET_MSK;
+
+  if ((id == COUNTER_PRESET_NONE) ||
+      (id >= sizeof(presets) / sizeof(presets[0])))
+    return option;
+  return (option & ~(COUNTER_PRESET_MSK << COUNTER_PRESET_POS)) | presets[id];
+}
+
 static void _npu_counters_PRE_START(struct _npu_exec_context *ctx,
                                     const LL_ATON_RT_EpochBlockItem_t *epoch_block)
 {
@@ -641,6 +825,10 @@ static void _npu_counters_PRE_START(struct _npu_exec_context *ctx,
   if (ctx->cur_epoch.counter_fmt & COUNTER_FMT_OPT(COUNTER_OPT_NPU_CACHE))
   {
     npu_cache_counters_enable();
+    /* snapshot the (cumulative) monitor values, POST_END reports the
+       per-epoch delta so the misses are attributed to the right epoch */
+    if (npu_cache_counters_get(&_npu_cache_base[0]) != 0)
+      memset(&_npu_cache_base[0], 0, sizeof(_npu_cache_base));
   }
 #endif
 
@@ -706,6 +894,14 @@ static void _npu_counters_POST_END(struct _npu_exec_context *ctx, const uint32_t
   {
     npu_cache_counters_get(&g_npu_exec_ctx.cur_epoch.cache_counters[0]);
     npu_cache_counters_disable();
+    /* per-epoch delta against the PRE_START snapshot (unsigned subtraction
+       also covers a monitor wrap-around) */
+    for (int i = 0; i < 8; i++) {
+      g_npu_exec_ctx.cur_epoch.cache_counters[i] -= _npu_cache_base[i];
+      /* fold the delta into the 64-bit software totals, the per-epoch
+         granularity keeps the 32-bit monitors far from a full wrap */
+      _npu_cache_acc[i] += g_npu_exec_ctx.cur_epoch.cache_counters[i];
+    }
   }
 #endif
 
@@ -747,6 +943,382 @@ static void _npu_counters_POST_END(struct _npu_exec_context *ctx, const uint32_t
   }
 }
 
+#if defined(USE_WEIGHT_PREFETCH) && USE_WEIGHT_PREFETCH == 1
+
+#if !defined(LL_ATON_EB_DBG_INFO)
+#error "USE_WEIGHT_PREFETCH requires LL_ATON_EB_DBG_INFO (epoch numbers in the epoch-block descriptors)"
+#endif
+
+/* Next-epoch weight prefetch
+ *
+ * From the PRE_START hook of epoch N a spare GPDMA channel reads the
+ * parameter window of epoch N+1 (fixed-destination sink, software request)
+ * while the ATON units execute epoch N. The channel is programmed at
+ * register level, fire-and-forget: a still-busy channel simply skips the
+ * next kick, and the transfer is bounded by the BNDT field.
+ */
+
+#define _WP_DMA_CHANNEL_IDX     (15)    /* last GPDMA1 channel, unused by the app */
+#define _WP_DMA_CHANNEL         GPDMA1_Channel15
+#define _WP_MAX_TOUCH           (0xFFC0)  /* BNDT limit, burst aligned */
+
+static uint64_t _wp_sink;               /* fixed destination of the touch reads */
+static bool _wp_dma_ready;
+static const LL_Buffer_InfoTypeDef *_wp_params;
+
+static void _wp_dma_touch(uintptr_t addr, uint32_t size)
+{
+  DMA_Channel_TypeDef *ch = _WP_DMA_CHANNEL;
+
+  if (!_wp_dma_ready) {
+    __HAL_RCC_GPDMA1_CLK_ENABLE();
+    GPDMA1_S->SECCFGR |= (1UL << _WP_DMA_CHANNEL_IDX);
+    _wp_dma_ready = true;
+  }
+
+  if (ch->CCR & DMA_CCR_EN)
+    return;  /* previous touch still in flight, skip this one */
+
+  if (size > _WP_MAX_TOUCH)
+    size = _WP_MAX_TOUCH;
+
+  ch->CFCR = 0x00007F00UL;  /* clear the transfer flags */
+  /* 8-byte incrementing source bursts, fixed 8-byte destination */
+  ch->CTR1 = (3UL << DMA_CTR1_SDW_LOG2_Pos) | DMA_CTR1_SINC |
+             (7UL << DMA_CTR1_SBL_1_Pos) | (3UL << DMA_CTR1_DDW_LOG2_Pos);
+  ch->CTR2 = DMA_CTR2_SWREQ;  /* memory-to-memory */
+  ch->CSAR = (uint32_t)addr;
+  ch->CDAR = (uint32_t)&_wp_sink;
+  ch->CBR1 = size & DMA_CBR1_BNDT_Msk;
+  ch->CCR = DMA_CCR_EN;
+}
+
+static void _wp_setup(struct npu_instance *instance)
+{
+  _wp_params = npu_get_input_buffers_info(instance, -1);
+}
+
+static void _wp_prefetch_next(const LL_ATON_RT_EpochBlockItem_t *epoch_block)
+{
+  const LL_Buffer_InfoTypeDef *buf;
+
+  if ((_wp_params == NULL) || (epoch_block == NULL))
+    return;
+
+  /* first parameter window beyond the starting epoch block */
+  for (buf = _wp_params; buf->name != NULL; buf++) {
+    if ((buf->is_param == 1) && ((int16_t)buf->epoch > epoch_block->last_epoch_num)) {
+      _wp_dma_touch((uintptr_t)LL_Buffer_addr_start(buf), get_ll_buffer_size(buf));
+      return;
+    }
+  }
+}
+
+#endif /* USE_WEIGHT_PREFETCH */
+
+#if defined(USE_ENCRYPTED_PARAMS) && USE_ENCRYPTED_PARAMS == 1 && !(defined(USE_LAZY_PARAMS) && USE_LAZY_PARAMS == 1)
+#error "USE_ENCRYPTED_PARAMS requires USE_LAZY_PARAMS (decrypt-on-stage)"
+#endif
+
+#if defined(USE_WEIGHTS_4BIT) && USE_WEIGHTS_4BIT == 1
+#if !defined(USE_LAZY_PARAMS) || USE_LAZY_PARAMS != 1
+#error "USE_WEIGHTS_4BIT requires USE_LAZY_PARAMS (unpack-on-stage)"
+#endif
+#if defined(USE_ENCRYPTED_PARAMS) && USE_ENCRYPTED_PARAMS == 1
+#error "USE_WEIGHTS_4BIT is exclusive with USE_ENCRYPTED_PARAMS (keystream is tied to the plain layout)"
+#endif
+#endif
+
+#if defined(USE_LAZY_PARAMS) && USE_LAZY_PARAMS == 1
+
+#if !defined(USE_RELOC_MODE) || USE_RELOC_MODE != 1
+#error "USE_LAZY_PARAMS requires USE_RELOC_MODE (deferred params pool copy)"
+#endif
+#if !defined(LL_ATON_EB_DBG_INFO)
+#error "USE_LAZY_PARAMS requires LL_ATON_EB_DBG_INFO (epoch numbers in the epoch-block descriptors)"
+#endif
+
+/* Lazy per-epoch parameter staging
+ *
+ * The install is done with AI_RELOC_RT_LOAD_MODE_LAZY_PARAMS so the bulk
+ * memcpy of the params pool is skipped. From the PRE_START hook the
+ * parameter windows of the starting epoch block are staged from the flash
+ * image into the pool (blocking), and the next window is kicked one epoch
+ * ahead on a spare GPDMA channel so its copy overlaps the NPU execution.
+ * Once the whole pool is resident the hook turns into a no-op, so only the
+ * first inference pays for the staging.
+ *
+ * The destinations are the baked params-pool addresses (the epoch
+ * descriptors cannot be retargeted), so this removes the install-time bulk
+ * copy rather than shrinking the pool footprint.
+ */
+
+#define _LZ_DMA_CHANNEL_IDX     (13)    /* 14/15 used by the reloc copier/prefetch */
+#define _LZ_DMA_CHANNEL         GPDMA1_Channel13
+#define _LZ_MAX_XFER            (0xFFC0)  /* BNDT limit, burst aligned */
+
+static uintptr_t _lz_src_base;          /* params section in the flash image */
+static uintptr_t _lz_dst_base;          /* params pool in RAM */
+static uint32_t _lz_pool_size;
+static const LL_Buffer_InfoTypeDef *_lz_next;     /* first window not yet resident */
+static const LL_Buffer_InfoTypeDef *_lz_inflight; /* window kicked ahead, or NULL */
+static bool _lz_done;
+
+#if !defined(USE_ENCRYPTED_PARAMS) || USE_ENCRYPTED_PARAMS == 0
+static bool _lz_dma_ready;
+
+static void _lz_dma_wait(void)
+{
+  while (_LZ_DMA_CHANNEL->CCR & DMA_CCR_EN) {}
+}
+
+static void _lz_dma_kick(uintptr_t dst, uintptr_t src, uint32_t size)
+{
+  DMA_Channel_TypeDef *ch = _LZ_DMA_CHANNEL;
+
+  if (!_lz_dma_ready) {
+    __HAL_RCC_GPDMA1_CLK_ENABLE();
+    GPDMA1_S->SECCFGR |= (1UL << _LZ_DMA_CHANNEL_IDX);
+    _lz_dma_ready = true;
+  }
+
+  ch->CFCR = 0x00007F00UL;  /* clear the transfer flags */
+  /* 8-byte incrementing bursts on both sides */
+  ch->CTR1 = (3UL << DMA_CTR1_SDW_LOG2_Pos) | DMA_CTR1_SINC |
+             (7UL << DMA_CTR1_SBL_1_Pos) |
+             (3UL << DMA_CTR1_DDW_LOG2_Pos) | DMA_CTR1_DINC |
+             (7UL << DMA_CTR1_DBL_1_Pos);
+  ch->CTR2 = DMA_CTR2_SWREQ;  /* memory-to-memory */
+  ch->CSAR = (uint32_t)src;
+  ch->CDAR = (uint32_t)dst;
+  ch->CBR1 = size & DMA_CBR1_BNDT_Msk;
+  ch->CCR = DMA_CCR_EN;
+}
+#endif /* !USE_ENCRYPTED_PARAMS */
+
+#if defined(USE_WEIGHTS_4BIT) && USE_WEIGHTS_4BIT == 1
+
+/* 4-bit packed parameter image
+ *
+ * The flash image may hold the params pool repacked by
+ * scripts/N6_scripts/pack_weights4.py: a directory of ranges covering the
+ * pool, where windows whose int8 weights all fit in [-8, 7] are stored two
+ * per byte (low nibble first). Packed windows are expanded with an MVE
+ * nibble-unpack pass while being staged instead of DMA-copied; the other
+ * ranges keep the byte-per-byte copy, only with the source offset
+ * translated through the directory. Detected by magic in _lz_setup(), a
+ * plain image stages exactly as before.
+ */
+
+#define _W4_MAGIC  (0x4b503457UL)  /* "W4PK" */
+
+struct _w4_range {
+  uint32_t dst_off;   /* range start, offset in the plain params pool */
+  uint32_t dst_size;  /* unpacked size in bytes */
+  uint32_t src_off;   /* payload offset of the (possibly packed) data */
+  uint32_t packed;    /* 1: two int4 per byte, 0: byte per byte */
+};
+
+static const struct _w4_range *_w4_ranges;
+static uint32_t _w4_n_ranges;
+static uintptr_t _w4_payload;
+static bool _w4_active;
+
+#if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1)
+#include <arm_mve.h>
+#define _W4_HAS_MVE 1
+#else
+#define _W4_HAS_MVE 0
+#endif
+
+/* expand 'dst_size' int4 values (two per source byte, low nibble first,
+   sign extended) into int8 */
+static void _w4_unpack(uint8_t *dst, const uint8_t *src, uint32_t dst_size)
+{
+  uint32_t i = 0;
+
+#if _W4_HAS_MVE == 1
+  for (; (i + 32) <= dst_size; i += 32) {
+    int8x16_t b = vld1q_s8((const int8_t *)&src[i / 2]);
+    int8x16x2_t out;
+    out.val[0] = vshrq_n_s8(vshlq_n_s8(b, 4), 4);  /* low nibbles */
+    out.val[1] = vshrq_n_s8(b, 4);                 /* high nibbles */
+    vst2q_s8((int8_t *)&dst[i], out);
+  }
+#endif
+  for (; i < dst_size; i += 2) {
+    int8_t b = (int8_t)src[i / 2];
+    dst[i] = (uint8_t)((int8_t)(b << 4) >> 4);
+    if ((i + 1) < dst_size)
+      dst[i + 1] = (uint8_t)(b >> 4);
+  }
+}
+
+/* payload address of pool offset 'off', NULL when the directory does not
+   cover the window (stale packer output) */
+static uintptr_t _w4_translate(uint32_t off, uint32_t size, uint32_t *packed)
+{
+  for (uint32_t n = 0; n < _w4_n_ranges; n++) {
+    const struct _w4_range *r = &_w4_ranges[n];
+    if ((off >= r->dst_off) && ((off + size) <= (r->dst_off + r->dst_size))) {
+      uint32_t rel = off - r->dst_off;
+      *packed = r->packed;
+      return _w4_payload + r->src_off + (r->packed ? (rel / 2) : rel);
+    }
+  }
+  return 0;
+}
+
+static void _w4_setup(void)
+{
+  const uint32_t *hdr = (const uint32_t *)_lz_src_base;
+
+  _w4_active = false;
+  if (hdr[0] != _W4_MAGIC)
+    return;  /* plain params image */
+
+  /* header: magic, unpacked pool size, number of ranges, reserved */
+  _w4_n_ranges = hdr[2];
+  _w4_ranges = (const struct _w4_range *)(_lz_src_base + 16);
+  _w4_payload = (uintptr_t)(_w4_ranges + _w4_n_ranges);
+  _w4_active = true;
+}
+
+#endif /* USE_WEIGHTS_4BIT */
+
+/* stage one parameter window, when 'wait' is false the last chunk is left
+   in flight */
+static void _lz_stage(const LL_Buffer_InfoTypeDef *buf, bool wait)
+{
+  uintptr_t dst = (uintptr_t)LL_Buffer_addr_start(buf);
+  uint32_t size = get_ll_buffer_size(buf);
+
+  if ((dst < _lz_dst_base) || ((dst + size) > (_lz_dst_base + _lz_pool_size)))
+    return;  /* outside the deferred pool, already resident */
+
+  uintptr_t src = _lz_src_base + (dst - _lz_dst_base);
+
+#if defined(USE_WEIGHTS_4BIT) && USE_WEIGHTS_4BIT == 1
+  if (_w4_active) {
+    uint32_t packed = 0;
+
+    src = _w4_translate(dst - _lz_dst_base, size, &packed);
+    if (src == 0)
+      return;  /* window not covered, re-pack the image */
+
+    if (packed) {
+      /* CPU nibble expansion, always synchronous: the window is written
+         through the MCU cache and cleaned afterwards */
+      _lz_dma_wait();
+      _w4_unpack((uint8_t *)dst, (const uint8_t *)src, size);
+      LL_ATON_Cache_MCU_Clean_Range(dst, size);
+      (void)wait;
+      return;
+    }
+  }
+#endif /* USE_WEIGHTS_4BIT */
+
+  /* drop any stale lines over the DMA-written window */
+  LL_ATON_Cache_MCU_Clean_Invalidate_Range(dst, size);
+
+#if defined(USE_ENCRYPTED_PARAMS) && USE_ENCRYPTED_PARAMS == 1
+  /* the window is cipher-text: route it through the ATON cipher DMA. The
+   * keystream only depends on the keys and on the flash address each
+   * 8-byte group was encrypted at (per-segment container, see
+   * scripts/N6_encrypt --segment-size), so an aligned window decrypts
+   * independently of the rest of the image; a trailing partial group is
+   * decrypted in full, the spill-over bytes belong to the next window and
+   * decrypt to the correct plain-text. The stream engines are idle at the
+   * epoch boundary and every epoch block reprograms its units, so the
+   * helper's reconfiguration is safe here — but not while the NPU runs,
+   * hence no look-ahead in this mode (see _lz_pre_start). */
+  const LL_Cypher_InitTypeDef cypher_conf = {
+      .cypherCacheMask = CYPHER_CACHE_NONE,
+      .cypherEnableMask = CYPHER_SRC_MASK,
+      .busIfKeyLsb = BUSIF_LSB_KEY,
+      .busIfKeyMsb = BUSIF_MSB_KEY,
+  };
+  const LL_Cypher_RegionTypeDef region = {
+      .srcAdd = (uint32_t)src,
+      .dstAdd = (uint32_t)dst,
+      .len = (size + 7UL) & ~7UL,
+  };
+  (void)wait;  /* always synchronous */
+  LL_DmaCypherBatch(&cypher_conf, &region, 1);
+#else
+  while (size > 0) {
+    uint32_t n = (size > _LZ_MAX_XFER) ? _LZ_MAX_XFER : size;
+    _lz_dma_wait();
+    _lz_dma_kick(dst, src, n);
+    dst += n;
+    src += n;
+    size -= n;
+  }
+  if (wait)
+    _lz_dma_wait();
+#endif /* USE_ENCRYPTED_PARAMS */
+}
+
+static void _lz_setup(struct npu_instance *instance)
+{
+  _lz_done = true;
+  _lz_inflight = NULL;
+
+  if (ll_aton_reloc_get_lazy_params(&_lz_src_base, &_lz_dst_base, &_lz_pool_size) != 1)
+    return;  /* nothing was deferred (e.g. params kept in-place) */
+
+#if defined(USE_WEIGHTS_4BIT) && USE_WEIGHTS_4BIT == 1
+  _w4_setup();
+#endif
+
+  _lz_next = npu_get_input_buffers_info(instance, -1);
+  _lz_done = (_lz_next == NULL);
+}
+
+static void _lz_pre_start(const LL_ATON_RT_EpochBlockItem_t *epoch_block)
+{
+  if (_lz_done || (epoch_block == NULL))
+    return;
+
+  /* make every window the starting epoch block may read resident */
+  while ((_lz_next->name != NULL) &&
+         ((_lz_next->is_param != 1) ||
+          ((int16_t)_lz_next->epoch <= epoch_block->last_epoch_num))) {
+    if (_lz_next->is_param == 1) {
+#if !defined(USE_ENCRYPTED_PARAMS) || USE_ENCRYPTED_PARAMS == 0
+      if (_lz_next == _lz_inflight) {
+        _lz_dma_wait();
+        _lz_inflight = NULL;
+      } else
+#endif
+      {
+        _lz_stage(_lz_next, true);
+      }
+    }
+    _lz_next++;
+  }
+
+#if !defined(USE_ENCRYPTED_PARAMS) || USE_ENCRYPTED_PARAMS == 0
+  /* kick the next window one epoch ahead, overlapped with the NPU (plain
+     copies only: the cipher path needs the stream engines, busy while the
+     NPU runs) */
+  if ((_lz_next->name != NULL) && (_lz_inflight == NULL)) {
+    _lz_stage(_lz_next, false);
+    _lz_inflight = _lz_next;
+  }
+#endif
+
+  if (_lz_next->name == NULL) {
+#if !defined(USE_ENCRYPTED_PARAMS) || USE_ENCRYPTED_PARAMS == 0
+    _lz_dma_wait();
+    _lz_inflight = NULL;
+#endif
+    _lz_done = true;  /* whole pool resident, later inferences pay nothing */
+  }
+}
+
+#endif /* USE_LAZY_PARAMS */
+
 void _rt_callback(LL_ATON_RT_Callbacktype_t ctype)
 {
   if(ctype == LL_ATON_RT_Callbacktype_RT_Init){
@@ -761,6 +1333,71 @@ void _rt_callback(LL_ATON_RT_Callbacktype_t ctype)
 }
 
 
+/*
+* Deliver the pending batched POST_END notification (aggregation mode,
+* cb_batch > 1). Also called from npu_run() to flush a trailing partial
+* batch once the inference is done.
+*/
+static void _npu_cb_batch_flush(void)
+{
+  if (g_npu_exec_ctx.cb_pending == 0)
+    return;
+
+  if (g_npu_exec_ctx.user_cb != NULL) {
+    g_npu_exec_ctx.user_cb(LL_ATON_RT_Callbacktype_POST_END,
+                           g_npu_exec_ctx.exec_epoch_idx - 1,
+                           g_npu_exec_ctx.cb_last_eb,
+                           &g_npu_exec_ctx.batch_epoch);
+  }
+
+  memset(&g_npu_exec_ctx.batch_epoch, 0, sizeof(struct npu_epoch_counters));
+  g_npu_exec_ctx.cb_pending = 0;
+}
+
+/*
+* ATON utilization gauge (capacity planning)
+*
+* Busy is the wall time with an epoch block in flight (PRE_START to
+* POST_END hook of each block), idle the gaps in between - inside a run
+* and between npu_run invocations alike. The DWT counter is reset per
+* epoch block step by the run loops and cannot span those gaps, so the
+* gauge samples the free-running microsecond clock built from the HAL
+* tick and the SysTick countdown (same construction as the clock-sync
+* probe in aiValidation_ATON.c). Wraps every ~71 min, the 64-bit
+* accumulators are fed with wrap-safe unsigned deltas.
+*/
+static uint64_t _util_busy_us;
+static uint64_t _util_idle_us;
+static uint32_t _util_last_us;        /* clock at the last busy/idle edge */
+static uint32_t _util_runs;           /* completed inferences since reset */
+static uint32_t _util_queue_peak;     /* submit queue depth high-water mark */
+
+static uint32_t _util_now_us(void)
+{
+  const uint32_t load = SysTick->LOAD;
+  uint32_t tick, val;
+
+  do {  /* re-sample when the tick rolled over between the two reads */
+    tick = port_hal_get_tick();
+    val = SysTick->VAL;
+  } while (tick != port_hal_get_tick());
+
+  return tick * 1000U + (uint32_t)(((uint64_t)(load - val) * 1000ULL) / (load + 1U));
+}
+
+/* Epoch-boundary window service, see npu_set_epoch_service() */
+static npu_epoch_service_t _npu_epoch_service;
+
+void npu_set_epoch_service(npu_epoch_service_t service)
+{
+  _npu_epoch_service = service;
+}
+
+#if defined(USE_EC_BLOB_TIERS) && USE_EC_BLOB_TIERS == 1
+/* defined with the tiering machinery below, after the descriptor pinning */
+static void _ec_tier_pre_start(const LL_ATON_RT_EpochBlockItem_t *epoch_block);
+#endif
+
 /* Callbacks used for benchmarking purposes */
 static void _epoch_callback(LL_ATON_RT_Callbacktype_t ctype,
                             const NN_Instance_TypeDef *nn_instance,
@@ -771,16 +1408,40 @@ static void _epoch_callback(LL_ATON_RT_Callbacktype_t ctype,
 
   if (ctype == LL_ATON_RT_Callbacktype_PRE_START)
   {
+    /* the gap since the last POST_END (or gauge reset) was idle time */
+    const uint32_t now_us = _util_now_us();
+    _util_idle_us += now_us - _util_last_us;
+    _util_last_us = now_us;
+
     g_npu_exec_ctx.cur_epoch.npu_core = 0;
     g_npu_exec_ctx.cpu_cycles_all += ts;
 
-    if (g_npu_exec_ctx.user_cb != NULL) {
-      g_npu_exec_ctx.user_cb(ctype, g_npu_exec_ctx.exec_epoch_idx, epoch_block, NULL);
-    }
+    LL_Dbgtrc_Evt_Push(LL_DBGTRC_EVT_EPOCH_PRE, (uint16_t)g_npu_exec_ctx.exec_epoch_idx, 0);
+
+    /* in aggregation mode (cb_batch > 1) the user cb and the HW counter
+       (re)configuration are only performed on the first epoch block of a
+       batch, cb_pending is always 0 in per-epoch mode */
+    if (g_npu_exec_ctx.cb_pending == 0) {
+      if (g_npu_exec_ctx.user_cb != NULL) {
+        g_npu_exec_ctx.user_cb(ctype, g_npu_exec_ctx.exec_epoch_idx, epoch_block, NULL);
+      }
 
-    g_npu_exec_ctx.cur_epoch.counter_fmt = 0;
+      g_npu_exec_ctx.cur_epoch.counter_fmt = 0;
 #if defined(USE_NPU_COUNTERS) && USE_NPU_COUNTERS == 1
-    _npu_counters_PRE_START(&g_npu_exec_ctx, epoch_block);
+      _npu_counters_PRE_START(&g_npu_exec_ctx, epoch_block);
+#endif
+    }
+
+#if defined(USE_LAZY_PARAMS) && USE_LAZY_PARAMS == 1
+    _lz_pre_start(epoch_block);
+#endif
+
+#if defined(USE_WEIGHT_PREFETCH) && USE_WEIGHT_PREFETCH == 1
+    _wp_prefetch_next(epoch_block);
+#endif
+
+#if defined(USE_EC_BLOB_TIERS) && USE_EC_BLOB_TIERS == 1
+    _ec_tier_pre_start(epoch_block);
 #endif
 
     g_npu_exec_ctx.exec_epoch_idx += 1;
@@ -812,16 +1473,55 @@ static void _epoch_callback(LL_ATON_RT_Callbacktype_t ctype,
 
   else if (ctype == LL_ATON_RT_Callbacktype_POST_END)
   {
+    /* the epoch block just spent was busy time */
+    const uint32_t now_us = _util_now_us();
+    _util_busy_us += now_us - _util_last_us;
+    _util_last_us = now_us;
+
     g_npu_exec_ctx.cur_epoch.npu_end = ts_npu - g_npu_exec_ctx.cur_epoch.npu_end;
     g_npu_exec_ctx.cpu_cycles_end += ts;
     g_npu_exec_ctx.cur_epoch.cpu_end = ts;
 
-    if (g_npu_exec_ctx.mode)
-      _npu_counters_POST_END(&g_npu_exec_ctx, ts_npu, epoch_block);
+    LL_Dbgtrc_Evt_Push(LL_DBGTRC_EVT_EPOCH_POST, (uint16_t)(g_npu_exec_ctx.exec_epoch_idx - 1), 0);
+
+    if (g_npu_exec_ctx.cb_batch > 1) {
+      /* aggregation mode: accumulate and deliver every cb_batch epoch blocks */
+      struct npu_epoch_counters *acc = &g_npu_exec_ctx.batch_epoch;
+
+      acc->cpu_start += g_npu_exec_ctx.cur_epoch.cpu_start;
+      acc->cpu_core += g_npu_exec_ctx.cur_epoch.cpu_core;
+      acc->cpu_end += g_npu_exec_ctx.cur_epoch.cpu_end;
+      acc->npu_start += g_npu_exec_ctx.cur_epoch.npu_start;
+      acc->npu_core += g_npu_exec_ctx.cur_epoch.npu_core;
+      acc->npu_end += g_npu_exec_ctx.cur_epoch.npu_end;
+      acc->counter_fmt = g_npu_exec_ctx.cur_epoch.counter_fmt;
+
+      g_npu_exec_ctx.cb_last_eb = epoch_block;
+      g_npu_exec_ctx.cb_pending += 1;
+
+      if (g_npu_exec_ctx.cb_pending >= g_npu_exec_ctx.cb_batch) {
+        if (g_npu_exec_ctx.mode)
+          _npu_counters_POST_END(&g_npu_exec_ctx, ts_npu, epoch_block);
+        memcpy(&acc->counters[0], &g_npu_exec_ctx.cur_epoch.counters[0],
+               sizeof(g_npu_exec_ctx.cur_epoch.counters));
+        memcpy(&acc->cache_counters[0], &g_npu_exec_ctx.cur_epoch.cache_counters[0],
+               sizeof(g_npu_exec_ctx.cur_epoch.cache_counters));
+        _npu_cb_batch_flush();
+      }
+    }
+    else {
+      if (g_npu_exec_ctx.mode)
+        _npu_counters_POST_END(&g_npu_exec_ctx, ts_npu, epoch_block);
 
-    if (g_npu_exec_ctx.user_cb != NULL) {
-      g_npu_exec_ctx.user_cb(ctype, g_npu_exec_ctx.exec_epoch_idx - 1, epoch_block, &g_npu_exec_ctx.cur_epoch);
+      if (g_npu_exec_ctx.user_cb != NULL) {
+        g_npu_exec_ctx.user_cb(ctype, g_npu_exec_ctx.exec_epoch_idx - 1, epoch_block, &g_npu_exec_ctx.cur_epoch);
+      }
     }
+
+    /* boundary window: the finished block has drained, the next one is
+       not programmed yet */
+    if (_npu_epoch_service != NULL)
+      _npu_epoch_service();
   };
 
   port_dwt_reset();
@@ -836,28 +1536,90 @@ static void _npu_internal_reset(void)
   t = ATON_CLKCTRL_CTRL_GET(0);
   t = ATON_CLKCTRL_CTRL_SET_CLR(t, 1);
   ATON_CLKCTRL_CTRL_SET(0, t);
+
+  /* the reset may have cleared the bus-interface key registers: drop the
+     cached view so the next LL_Busif_SetKeys reprograms them */
+  LL_Busif_InvalidateKeyCache();
 }
 
 #define AI_RELOC_ROUND_UP_32B(_v)   (((_v) + 31) & ~31)   /* 32-Bytes aligned */
 #define AI_RELOC_ROUND_DOWN_32B(_v) ((_v) & ~31)          /* 32-Bytes aligned */
 
+#if defined(USE_WARM_RUN) && USE_WARM_RUN == 1
+/* cold on the first run, re-armed by the memory-write service */
+static bool _npu_mem_dirty = true;
+#endif
+
+/*
+* Flag the weights/activations as externally modified, the next run goes
+* through the full NPU cache scrub again (see _prepare_input_buffers).
+*/
+void npu_mark_memory_dirty(void)
+{
+#if defined(USE_WARM_RUN) && USE_WARM_RUN == 1
+  _npu_mem_dirty = true;
+#endif
+}
+
 static void _prepare_input_buffers(struct npu_instance *instance)
 {
   if (!instance)
     return;
 
+  struct mcu_cache_range ranges[NPU_MAX_IO_BUFFER];
+  int n = 0;
+
+#if !(defined(USE_MPU_WT_IO) && USE_MPU_WT_IO == 1)
+  /* batched maintenance: one barrier sequence for all the input windows,
+     one for all the output windows (see mcu_cache_op_ranges) */
   for (int i=0; i < instance->info.n_inputs; i++) {
     const LL_Buffer_InfoTypeDef *ll_buf = instance->info.in_bufs[i];
-    LL_ATON_Cache_MCU_Clean_Invalidate_Range((uintptr_t)LL_Buffer_addr_start(ll_buf), LL_Buffer_len(ll_buf));
+    ranges[n].start_addr = (uint32_t)(uintptr_t)LL_Buffer_addr_start(ll_buf);
+    ranges[n].end_addr = (uint32_t)(uintptr_t)LL_Buffer_addr_end(ll_buf);
+    n++;
   }
+  mcu_cache_op_ranges(MCU_CACHE_OP_CLEAN_INVALIDATE, ranges, n);
 
+  n = 0;
+#else
+  /* USE_MPU_WT_IO: the input windows are write-through mapped, the upload
+     stores are already in the backing memory - nothing to clean */
+#endif
   for (int i=0; i < instance->info.n_outputs; i++) {
     const LL_Buffer_InfoTypeDef *ll_buf = instance->info.out_bufs[i];
-    LL_ATON_Cache_MCU_Invalidate_Range((uintptr_t)LL_Buffer_addr_start(ll_buf), LL_Buffer_len(ll_buf));
+    ranges[n].start_addr = (uint32_t)(uintptr_t)LL_Buffer_addr_start(ll_buf);
+    ranges[n].end_addr = (uint32_t)(uintptr_t)LL_Buffer_addr_end(ll_buf);
+    n++;
   }
+  mcu_cache_op_ranges(MCU_CACHE_OP_INVALIDATE, ranges, n);
 
 #ifdef USE_NPU_CACHE
-  npu_cache_invalidate();
+#if defined(USE_WARM_RUN) && USE_WARM_RUN == 1
+  if (_npu_mem_dirty) {
+    npu_cache_invalidate();
+    _npu_mem_dirty = false;
+  } else {
+    /* warm run: weights/activations are unchanged, only the input windows
+       may hold stale NPU cache lines */
+    for (int i=0; i < instance->info.n_inputs; i++) {
+      const LL_Buffer_InfoTypeDef *ll_buf = instance->info.in_bufs[i];
+      npu_cache_clean_invalidate_range((uint32_t)(uintptr_t)LL_Buffer_addr_start(ll_buf),
+                                       (uint32_t)(uintptr_t)LL_Buffer_addr_end(ll_buf));
+    }
+  }
+#else
+  if (npu_cache_has_pins()) {
+    /* pinned (weight) windows registered: keep the resident lines alive,
+       only the input windows may hold stale NPU cache lines */
+    for (int i=0; i < instance->info.n_inputs; i++) {
+      const LL_Buffer_InfoTypeDef *ll_buf = instance->info.in_bufs[i];
+      npu_cache_clean_invalidate_range((uint32_t)(uintptr_t)LL_Buffer_addr_start(ll_buf),
+                                       (uint32_t)(uintptr_t)LL_Buffer_addr_end(ll_buf));
+    }
+  } else {
+    npu_cache_invalidate();
+  }
+#endif
 #endif
 }
 
@@ -866,19 +1628,866 @@ static void _prepare_output_buffers(struct npu_instance *instance)
   return;
 }
 
-static void _force_clean_cache_subsystem(struct npu_instance *instance)
+#if defined(LL_ATON_USE_DTCM) && !(defined(USE_RELOC_MODE) && USE_RELOC_MODE == 1)
+
+/* The generated epoch-block descriptor lists are const data in default RAM
+ * and are walked at every epoch transition. They are copied once into CM55
+ * DTCM and the execution state is re-pointed after each network reset, so
+ * the transitions read zero-wait-state memory (with hundreds of epochs per
+ * img inference the descriptor misses are measurable).
+ */
+#define _DTCM_EB_POOL_ENTRIES   (640)
+
+static LL_ATON_DTCM_SECTION LL_ATON_RT_EpochBlockItem_t _dtcm_eb_pool[_DTCM_EB_POOL_ENTRIES];
+static int _dtcm_eb_pool_used;
+
+struct _dtcm_eb_slot {
+  const LL_ATON_RT_EpochBlockItem_t *orig;  /* generated list */
+  const LL_ATON_RT_EpochBlockItem_t *copy;  /* DTCM copy (orig if pool full) */
+};
+
+static struct _dtcm_eb_slot _dtcm_eb_slots[NPU_NETWORK_NUMBER];
+
+static void _pin_epoch_blocks(struct npu_instance *instance)
 {
-#ifdef USE_NPU_CACHE
-  npu_cache_invalidate();
+  NN_Instance_TypeDef *nn_inst = instance->impl;
+  const LL_ATON_RT_EpochBlockItem_t *list = nn_inst->exec_state.first_epoch_block;
+  const LL_ATON_RT_EpochBlockItem_t *copy = NULL;
+
+  if (list == NULL)
+    return;
+
+  /* retrieve/install the DTCM copy of the generated list */
+  for (int i = 0; i < NPU_NETWORK_NUMBER; i++) {
+    if (_dtcm_eb_slots[i].orig == list) {
+      copy = _dtcm_eb_slots[i].copy;
+      break;
+    }
+    if (_dtcm_eb_slots[i].orig == NULL) {
+      int n_eb = 1;  /* terminating epoch block is included */
+      for (const LL_ATON_RT_EpochBlockItem_t *eb = list; !EpochBlock_IsLastEpochBlock(eb); eb++)
+        n_eb++;
+
+      if ((_dtcm_eb_pool_used + n_eb) <= _DTCM_EB_POOL_ENTRIES) {
+        memcpy(&_dtcm_eb_pool[_dtcm_eb_pool_used], list, n_eb * sizeof(*list));
+        copy = &_dtcm_eb_pool[_dtcm_eb_pool_used];
+        _dtcm_eb_pool_used += n_eb;
+      } else {
+        copy = list;  /* pool exhausted, keep the generated list */
+      }
+      _dtcm_eb_slots[i].orig = list;
+      _dtcm_eb_slots[i].copy = copy;
+      break;
+    }
+  }
+
+  if ((copy != NULL) && (copy != list)) {
+    nn_inst->exec_state.first_epoch_block = copy;
+    nn_inst->exec_state.current_epoch_block = copy;
+#ifndef NDEBUG
+    /* the copy may have been compacted by npu_fuse_epoch_blocks() */
+    uint32_t n_eb = 1;  /* terminating epoch block is included */
+    for (const LL_ATON_RT_EpochBlockItem_t *eb = copy; !EpochBlock_IsLastEpochBlock(eb); eb++)
+      n_eb++;
+    nn_inst->exec_state.nr_of_epoch_blocks = n_eb;
 #endif
-  mcu_cache_clean_invalidate();
+  }
 }
 
+#if (defined(USE_EPOCH_FUSION) && USE_EPOCH_FUSION == 1) || \
+    (defined(USE_EPOCH_MEMO) && USE_EPOCH_MEMO == 1) || \
+    (defined(USE_OVERLAP_ANALYZER) && USE_OVERLAP_ANALYZER == 1) || \
+    (defined(USE_EC_FLASH_PARTITION) && USE_EC_FLASH_PARTITION == 1) || \
+    (defined(USE_EC_BLOB_TIERS) && USE_EC_BLOB_TIERS == 1)
+/* only the DTCM copy may be rewritten, NULL when none is installed */
+static LL_ATON_RT_EpochBlockItem_t *_mutable_eb_list(struct npu_instance *instance)
+{
+  for (int i = 0; i < NPU_NETWORK_NUMBER; i++) {
+    if ((_dtcm_eb_slots[i].copy == instance->impl->exec_state.first_epoch_block) &&
+        (_dtcm_eb_slots[i].copy != _dtcm_eb_slots[i].orig))
+      return (LL_ATON_RT_EpochBlockItem_t *)_dtcm_eb_slots[i].copy;
+  }
+  return NULL;
+}
+#endif
 
-/* -------------------------------------------------------------------------
-* Wrapper entry points
-* -------------------------------------------------------------------------
-*/
+#if defined(USE_EPOCH_FUSION) && USE_EPOCH_FUSION == 1
+
+/* Epoch fusion
+ *
+ * Every epoch transition pays fixed runtime bookkeeping (and callback
+ * dispatch when tracing). Runs of adjacent pure-SW epoch blocks (no ATON
+ * lock, no wait mask, no events to wait for) are collapsed into a single
+ * scheduled unit: a trampoline descriptor whose start function executes the
+ * member start/end functions back to back. The rewrite happens in place on
+ * the mutable DTCM copy of the generated descriptor list. HW, hybrid,
+ * internal and blob epoch blocks are never touched.
+ */
+
+#define _FUSE_MAX_UNITS         (16)
+#define _FUSE_MAX_MEMBERS       (96)
+
+struct _fuse_unit {
+  const LL_ATON_RT_EpochBlockItem_t *members;
+  int n;
+};
+
+static LL_ATON_DTCM_SECTION LL_ATON_RT_EpochBlockItem_t _fuse_members[_FUSE_MAX_MEMBERS];
+static struct _fuse_unit _fuse_units[_FUSE_MAX_UNITS];
+static int _fuse_n_units;
+static int _fuse_n_members;
+
+static void _fuse_exec(const void *epoch_block)
+{
+  const LL_ATON_RT_EpochBlockItem_t *eb = (const LL_ATON_RT_EpochBlockItem_t *)epoch_block;
+  const struct _fuse_unit *unit = &_fuse_units[eb->blob_address];
+
+  for (int i = 0; i < unit->n; i++) {
+    const LL_ATON_RT_EpochBlockItem_t *m = &unit->members[i];
+    if (m->start_epoch_block != NULL)
+      m->start_epoch_block((const void *)m);
+    if (m->end_epoch_block != NULL)
+      m->end_epoch_block((const void *)m);
+  }
+}
+
+/* fusable: pure SW, nothing to wait for, no special handling flags */
+static bool _fuse_is_candidate(const LL_ATON_RT_EpochBlockItem_t *eb)
+{
+  const uint16_t excluded = EpochBlock_Flags_blob | EpochBlock_Flags_last_eb |
+                            EpochBlock_Flags_pure_hw | EpochBlock_Flags_hybrid |
+                            EpochBlock_Flags_internal | EpochBlock_Flags_blob_encrypted;
+
+  return ((eb->flags & EpochBlock_Flags_pure_sw) != 0) &&
+         ((eb->flags & excluded) == 0) && (eb->wait_mask == 0);
+}
+
+/*
+* Fuse adjacent pure-SW epoch blocks of the instance (to be called once,
+* after npu_init(.., 1)). Returns the number of epoch blocks removed from
+* the schedule, or -1 when no mutable descriptor copy is available.
+*/
+int npu_fuse_epoch_blocks(struct npu_instance *instance)
+{
+  if ((!instance) || (!instance->impl))
+    return -1;
+
+  _pin_epoch_blocks(instance);
+
+  LL_ATON_RT_EpochBlockItem_t *list = _mutable_eb_list(instance);
+  if (list == NULL)
+    return -1;
+
+  int r = 0;
+  int w = 0;
+  int removed = 0;
+
+  while (!EpochBlock_IsLastEpochBlock(&list[r])) {
+    /* length of the fusable run starting at r */
+    int n = 0;
+    while (_fuse_is_candidate(&list[r + n]))
+      n++;
+
+    if ((n >= 2) && (_fuse_n_units < _FUSE_MAX_UNITS) &&
+        ((_fuse_n_members + n) <= _FUSE_MAX_MEMBERS)) {
+      struct _fuse_unit *unit = &_fuse_units[_fuse_n_units];
+
+      memcpy(&_fuse_members[_fuse_n_members], &list[r], n * sizeof(*list));
+      unit->members = &_fuse_members[_fuse_n_members];
+      unit->n = n;
+      _fuse_n_members += n;
+
+      LL_ATON_RT_EpochBlockItem_t fused = {0};
+      fused.start_epoch_block = _fuse_exec;
+      fused.blob_address = (uintptr_t)_fuse_n_units;  /* unit index, see _fuse_exec() */
+      fused.flags = EpochBlock_Flags_pure_sw |
+                    (list[r].flags & EpochBlock_Flags_epoch_start) |
+                    (list[r + n - 1].flags & EpochBlock_Flags_epoch_end);
+#ifdef LL_ATON_EB_DBG_INFO
+      fused.epoch_num = list[r].epoch_num;
+      fused.last_epoch_num = list[r + n - 1].last_epoch_num;
+#endif
+      list[w++] = fused;
+      _fuse_n_units++;
+      r += n;
+      removed += n - 1;
+    } else {
+      list[w++] = list[r++];
+    }
+  }
+  list[w] = list[r];  /* terminating epoch block */
+
+  /* re-point the execution state at the compacted list */
+  instance->impl->exec_state.first_epoch_block = list;
+  instance->impl->exec_state.current_epoch_block = list;
+#ifndef NDEBUG
+  instance->impl->exec_state.nr_of_epoch_blocks -= removed;
+#endif
+
+  return removed;
+}
+
+#endif /* USE_EPOCH_FUSION */
+
+#if defined(USE_EPOCH_MEMO) && USE_EPOCH_MEMO == 1
+
+#if !defined(LL_ATON_EB_DBG_INFO)
+#error "USE_EPOCH_MEMO requires LL_ATON_EB_DBG_INFO (epoch numbers in the epoch-block descriptors)"
+#endif
+
+/* Software-epoch result memoization
+ *
+ * Some pure-SW epochs (positional-encoding generation, constant reshapes)
+ * produce byte-identical outputs every inference. Candidates are wrapped
+ * at bootstrap with a trampoline descriptor on the mutable DTCM copy; the
+ * metadata does not list the non-param inputs of an epoch, so constancy
+ * is established dynamically: the first run executes and captures the
+ * output bytes, the second run executes again and compares - only
+ * byte-identical outputs across two (different-input) inferences promote
+ * the epoch to constant. From then on the epoch is skipped and its
+ * captured outputs are copied back instead, guarded by a hash over the
+ * param (const) buffers the epoch consumes: a mismatch - a rewritten
+ * weight window, a reinstalled model - demotes the unit to plain
+ * execution for the rest of the session. Restored ranges are cache-
+ * cleaned for the downstream ATON consumers. To be called after
+ * npu_fuse_epoch_blocks(): fused multi-epoch units span several epoch
+ * numbers and are left alone.
+ */
+
+#define _MEMO_MAX_UNITS         (8)
+#ifndef NPU_MEMO_POOL_BYTES
+#define NPU_MEMO_POOL_BYTES     (32 * 1024)
+#endif
+
+enum _memo_state {
+  _MEMO_PRIME = 0,  /* first run: execute and capture */
+  _MEMO_VERIFY,     /* second run: execute and byte-compare */
+  _MEMO_CONST,      /* constant: restore instead of executing */
+  _MEMO_OFF,        /* not constant (or guard tripped): execute */
+};
+
+struct _memo_unit {
+  LL_ATON_RT_EpochBlockItem_t orig;   /* wrapped descriptor, still executable */
+  const LL_Buffer_InfoTypeDef *bufs;  /* internal buffers of the owning model */
+  uint8_t *save;                      /* captured output bytes (pool slice) */
+  uint32_t out_bytes;
+  uint32_t out_hash;                  /* capture-time output hash */
+  uint32_t in_hash;                   /* capture-time param-input hash */
+  uint8_t state;                      /* enum _memo_state */
+};
+
+static uint8_t _memo_pool[NPU_MEMO_POOL_BYTES];
+static uint32_t _memo_pool_used;
+static struct _memo_unit _memo_units[_MEMO_MAX_UNITS];
+static int _memo_n_units;
+
+/* FNV-1a, chained across buffers (seed with 0) */
+static uint32_t _memo_hash(uint32_t h, const uint8_t *p, uint32_t n)
+{
+  if (h == 0)
+    h = 2166136261u;
+  while (n--)
+    h = (h ^ *p++) * 16777619u;
+  return h;
+}
+
+/* outputs of the epoch: internal non-param buffers it produces */
+static bool _memo_is_output(const struct _memo_unit *unit, const LL_Buffer_InfoTypeDef *buf)
+{
+  return (buf->is_param == 0) && ((int16_t)buf->epoch == unit->orig.epoch_num);
+}
+
+/* const inputs of the epoch: param buffers consumed in it */
+static bool _memo_is_input(const struct _memo_unit *unit, const LL_Buffer_InfoTypeDef *buf)
+{
+  return (buf->is_param == 1) && ((int16_t)buf->epoch == unit->orig.epoch_num);
+}
+
+static uint32_t _memo_hash_bufs(const struct _memo_unit *unit,
+                                bool (*select)(const struct _memo_unit *, const LL_Buffer_InfoTypeDef *))
+{
+  uint32_t h = 0;
+  for (const LL_Buffer_InfoTypeDef *buf = unit->bufs; buf->name != NULL; buf++)
+    if (select(unit, buf))
+      h = _memo_hash(h, LL_Buffer_addr_start((LL_Buffer_InfoTypeDef *)buf),
+                     LL_Buffer_len(buf));
+  return h;
+}
+
+static void _memo_run_orig(const struct _memo_unit *unit)
+{
+  if (unit->orig.start_epoch_block != NULL)
+    unit->orig.start_epoch_block((const void *)&unit->orig);
+  if (unit->orig.end_epoch_block != NULL)
+    unit->orig.end_epoch_block((const void *)&unit->orig);
+}
+
+static void _memo_exec(const void *epoch_block)
+{
+  const LL_ATON_RT_EpochBlockItem_t *eb = (const LL_ATON_RT_EpochBlockItem_t *)epoch_block;
+  struct _memo_unit *unit = &_memo_units[eb->blob_address];
+  uint8_t *save;
+
+  switch (unit->state) {
+  case _MEMO_PRIME:
+    _memo_run_orig(unit);
+    save = unit->save;
+    for (const LL_Buffer_InfoTypeDef *buf = unit->bufs; buf->name != NULL; buf++) {
+      if (_memo_is_output(unit, buf)) {
+        memcpy(save, LL_Buffer_addr_start((LL_Buffer_InfoTypeDef *)buf), LL_Buffer_len(buf));
+        save += LL_Buffer_len(buf);
+      }
+    }
+    unit->out_hash = _memo_hash_bufs(unit, _memo_is_output);
+    unit->in_hash = _memo_hash_bufs(unit, _memo_is_input);
+    unit->state = _MEMO_VERIFY;
+    break;
+
+  case _MEMO_VERIFY:
+    _memo_run_orig(unit);
+    unit->state = ((_memo_hash_bufs(unit, _memo_is_output) == unit->out_hash) &&
+                   (_memo_hash_bufs(unit, _memo_is_input) == unit->in_hash))
+                  ? _MEMO_CONST : _MEMO_OFF;
+    break;
+
+  case _MEMO_CONST:
+    if (_memo_hash_bufs(unit, _memo_is_input) != unit->in_hash) {
+      /* guard tripped (rewritten params): back to plain execution */
+      unit->state = _MEMO_OFF;
+      _memo_run_orig(unit);
+      break;
+    }
+    save = unit->save;
+    for (const LL_Buffer_InfoTypeDef *buf = unit->bufs; buf->name != NULL; buf++) {
+      if (_memo_is_output(unit, buf)) {
+        uint8_t *dst = LL_Buffer_addr_start((LL_Buffer_InfoTypeDef *)buf);
+        memcpy(dst, save, LL_Buffer_len(buf));
+        save += LL_Buffer_len(buf);
+        mcu_cache_clean_range((uint32_t)(uintptr_t)dst,
+                              (uint32_t)(uintptr_t)(dst + LL_Buffer_len(buf)));
+      }
+    }
+    break;
+
+  default:
+    _memo_run_orig(unit);
+    break;
+  }
+}
+
+/* memoizable: a single-epoch pure-SW block with nothing to wait for, whose
+   outputs are described in the buffer metadata and fit the save pool */
+static bool _memo_is_candidate(const LL_ATON_RT_EpochBlockItem_t *eb)
+{
+  const uint16_t excluded = EpochBlock_Flags_blob | EpochBlock_Flags_last_eb |
+                            EpochBlock_Flags_pure_hw | EpochBlock_Flags_hybrid |
+                            EpochBlock_Flags_internal | EpochBlock_Flags_blob_encrypted;
+
+  return ((eb->flags & EpochBlock_Flags_pure_sw) != 0) &&
+         ((eb->flags & excluded) == 0) && (eb->wait_mask == 0) &&
+         (eb->epoch_num == eb->last_epoch_num) &&
+         (eb->start_epoch_block != NULL);
+}
+
+/*
+* Wrap the memoizable pure-SW epoch blocks of the instance (to be called
+* once, after npu_init(.., 1) and after npu_fuse_epoch_blocks()). Returns
+* the number of wrapped candidates, or -1 when no mutable descriptor copy
+* is available.
+*/
+int npu_memo_epoch_blocks(struct npu_instance *instance)
+{
+  if ((!instance) || (!instance->impl))
+    return -1;
+
+  _pin_epoch_blocks(instance);
+
+  LL_ATON_RT_EpochBlockItem_t *list = _mutable_eb_list(instance);
+  const LL_Buffer_InfoTypeDef *bufs = npu_get_internal_buffers_info(instance);
+  if ((list == NULL) || (bufs == NULL))
+    return -1;
+
+  int wrapped = 0;
+
+  for (LL_ATON_RT_EpochBlockItem_t *eb = list; !EpochBlock_IsLastEpochBlock(eb); eb++) {
+    if (!_memo_is_candidate(eb) || (_memo_n_units >= _MEMO_MAX_UNITS))
+      continue;
+    if (eb->start_epoch_block == _memo_exec)
+      continue;  /* already wrapped (re-entered bootstrap) */
+
+    /* the whole output set must be described and must fit the pool */
+    uint32_t out_bytes = 0;
+    for (const LL_Buffer_InfoTypeDef *buf = bufs; buf->name != NULL; buf++)
+      if ((buf->is_param == 0) && ((int16_t)buf->epoch == eb->epoch_num))
+        out_bytes += LL_Buffer_len(buf);
+    if ((out_bytes == 0) || ((_memo_pool_used + out_bytes) > NPU_MEMO_POOL_BYTES))
+      continue;
+
+    struct _memo_unit *unit = &_memo_units[_memo_n_units];
+    unit->orig = *eb;
+    unit->bufs = bufs;
+    unit->save = &_memo_pool[_memo_pool_used];
+    unit->out_bytes = out_bytes;
+    unit->state = _MEMO_PRIME;
+    _memo_pool_used += out_bytes;
+
+    eb->start_epoch_block = _memo_exec;
+    eb->end_epoch_block = NULL;
+    eb->blob_address = (uintptr_t)_memo_n_units;  /* unit index, see _memo_exec() */
+    _memo_n_units++;
+    wrapped++;
+  }
+
+  return wrapped;
+}
+
+#endif /* USE_EPOCH_MEMO */
+
+#if defined(USE_EC_FLASH_PARTITION) && USE_EC_FLASH_PARTITION == 1
+
+/* Epoch Controller blob flash partition
+ *
+ * The generated <network>_ecblobs.h headers compile the EC blobs into the
+ * firmware image, so a model change forces a full rebuild and reflash. With
+ * the partition flashed (see scripts/N6_scripts/ec_partition_pack.py and the
+ * flash_ecpart make target) the blob epoch-block descriptors are re-pointed
+ * at the matching binary of the mapped partition on the mutable DTCM copy.
+ * Entries are matched per blob block in schedule order with the identifier
+ * naming of the generated arrays ("_ec_blob_<name>_<n>"); absent or
+ * unusable entries keep the compiled-in blob. Encrypted blobs are never
+ * re-pointed, the cipher flow is tied to the compiled-in image.
+ */
+
+/*
+* Re-point the blob epoch blocks of the instance at the flash partition (to
+* be called once, after npu_init(.., 1) and before any fusion pass). Returns
+* the number of re-pointed blobs, or -1 when no mutable descriptor copy is
+* available.
+*/
+int npu_connect_ec_partition(struct npu_instance *instance)
+{
+  if ((!instance) || (!instance->impl))
+    return -1;
+
+  _pin_epoch_blocks(instance);
+
+  LL_ATON_RT_EpochBlockItem_t *list = _mutable_eb_list(instance);
+  if (list == NULL)
+    return -1;
+
+  const uint8_t *part = (const uint8_t *)EC_PARTITION_BASE;
+  if (ec_part_num_blobs(part) == 0)
+    return 0;  /* no (or invalid) partition flashed */
+
+  int connected = 0;
+  unsigned int ordinal = 0;
+
+  for (LL_ATON_RT_EpochBlockItem_t *eb = list; !EpochBlock_IsLastEpochBlock(eb); eb++) {
+    if (!EpochBlock_IsEpochBlob(eb))
+      continue;
+    ordinal++;
+    if (EpochBlock_IsBlobEncrypted(eb))
+      continue;
+
+    char id[ECPART_ID_LEN];
+    snprintf(id, sizeof(id), "_ec_blob_%s_%u", instance->info.name, ordinal);
+
+    const uint8_t *bin = ec_part_find(part, id, NULL);
+    if (bin == NULL)
+      continue;
+
+    const uint64_t *blob = ec_get_blob_ptr(bin);
+    if ((blob == NULL) || (((const ECInstr *)blob)[0] != ECASM_BLOB_MAGIC))
+      continue;  /* unusable in place (bad or compressed blob section) */
+
+    eb->blob_address = (uintptr_t)blob;
+    connected++;
+  }
+
+  return connected;
+}
+
+#endif /* USE_EC_FLASH_PARTITION */
+
+#if defined(USE_EC_BLOB_TIERS) && USE_EC_BLOB_TIERS == 1
+
+/* Epoch Controller blob residency tiers
+ *
+ * With the flash partition connected every blob executes in place from the
+ * memory-mapped NOR: zero RAM footprint, but the Epoch Controller fetches
+ * its whole instruction stream through the XIP window on every run.
+ * Tiering splits the difference with the per-epoch profile of the model:
+ * the hottest blobs (largest profiled epoch cost) are copied once into a
+ * resident fast pool, the cold rest stays in flash and is staged on demand
+ * into a small rotating buffer from the PRE_START hook of its owning epoch
+ * block. A big-model EC footprint shrinks to EC_TIER_FAST_POOL_BYTES plus
+ * two EC_TIER_STAGE_BYTES buffers while the hot loop keeps SRAM fetch
+ * speed. Like the lazy-params stager the on-demand copies ride the epoch
+ * hooks of the npu_run path; blobs too large for the staging buffer (and
+ * everything on the sched/plan paths) keep executing in place from flash.
+ * One tiering is active at a time: a new call replaces the previous layout.
+ */
+
+#define _EC_TIER_MAX_BLOBS      (32)
+
+struct _ec_tier_unit {
+  const LL_ATON_RT_EpochBlockItem_t *eb;  /* blob block on the mutable copy */
+  uintptr_t src;                          /* blob in the mapped partition */
+  uint32_t bytes;                         /* magic + length + instructions */
+};
+
+static struct _ec_tier_unit _ec_tier_units[_EC_TIER_MAX_BLOBS];  /* cold tier */
+static int _ec_tier_n_units;
+
+static uint64_t _ec_tier_pool[EC_TIER_FAST_POOL_BYTES / 8];      /* hot tier */
+static uint32_t _ec_tier_pool_used;
+
+static uint64_t _ec_tier_stage[2][EC_TIER_STAGE_BYTES / 8];
+static int _ec_tier_stage_next;
+static const struct _ec_tier_unit *_ec_tier_stage_owner[2];
+
+/* blob size in bytes, including the magic and length words */
+static uint32_t _ec_tier_blob_bytes(uintptr_t blob_addr)
+{
+  return (((const ECInstr *)blob_addr)[1] + 2) * sizeof(ECInstr);
+}
+
+/* PRE_START hook: stage the cold blob of the starting epoch block into the
+   next rotating buffer. With few cold blobs a buffer often still holds the
+   blob from the previous run and the copy is skipped. */
+static void _ec_tier_pre_start(const LL_ATON_RT_EpochBlockItem_t *epoch_block)
+{
+  for (int i = 0; i < _ec_tier_n_units; i++) {
+    struct _ec_tier_unit *unit = &_ec_tier_units[i];
+    if (unit->eb != epoch_block)
+      continue;
+
+    for (int b = 0; b < 2; b++)
+      if (_ec_tier_stage_owner[b] == unit)
+        return;  /* still staged from an earlier pass */
+
+    uint64_t *buf = &_ec_tier_stage[_ec_tier_stage_next][0];
+    _ec_tier_stage_owner[_ec_tier_stage_next] = unit;
+    _ec_tier_stage_next ^= 1;
+
+    memcpy(buf, (const void *)unit->src, unit->bytes);
+    /* the EC fetches through the NPU bus, push the copy out of the D-cache */
+    mcu_cache_clean_range((uint32_t)(uintptr_t)buf,
+                          (uint32_t)(uintptr_t)buf + unit->bytes);
+    ((LL_ATON_RT_EpochBlockItem_t *)epoch_block)->blob_address = (uintptr_t)buf;
+    return;
+  }
+}
+
+/*
+* Tier the partition-resident blobs of the instance by profiled epoch cost
+* (to be called after npu_connect_ec_partition and a profiled run).
+* 'epoch_cycles' maps an epoch number to its profiled cycle cost, unknown
+* epochs rank coldest. Returns the number of blobs pinned in the fast pool,
+* or -1 when no mutable descriptor copy is available.
+*/
+int npu_ec_tier_blobs(struct npu_instance *instance,
+                      const uint32_t *epoch_cycles, uint32_t n_epochs)
+{
+  struct _ec_tier_cand {
+    LL_ATON_RT_EpochBlockItem_t *eb;
+    uint32_t bytes;
+    uint32_t cycles;
+  } cand[_EC_TIER_MAX_BLOBS];
+  int n_cand = 0;
+
+  if ((!instance) || (!instance->impl) || (!epoch_cycles))
+    return -1;
+
+  _pin_epoch_blocks(instance);
+
+  LL_ATON_RT_EpochBlockItem_t *list = _mutable_eb_list(instance);
+  if (list == NULL)
+    return -1;
+
+  /* a re-tier starts over from the in-place layout */
+  for (int i = 0; i < _ec_tier_n_units; i++)
+    ((LL_ATON_RT_EpochBlockItem_t *)_ec_tier_units[i].eb)->blob_address =
+        _ec_tier_units[i].src;
+  _ec_tier_n_units = 0;
+  _ec_tier_pool_used = 0;
+  _ec_tier_stage_owner[0] = NULL;
+  _ec_tier_stage_owner[1] = NULL;
+  _ec_tier_stage_next = 0;
+
+  for (LL_ATON_RT_EpochBlockItem_t *eb = list; !EpochBlock_IsLastEpochBlock(eb); eb++) {
+    if (!EpochBlock_IsEpochBlob(eb) || EpochBlock_IsBlobEncrypted(eb))
+      continue;
+    if (eb->blob_address < EC_PARTITION_BASE)
+      continue;  /* compiled-in blob, already resident */
+    if (n_cand >= _EC_TIER_MAX_BLOBS)
+      break;
+
+    cand[n_cand].eb = eb;
+    cand[n_cand].bytes = _ec_tier_blob_bytes(eb->blob_address);
+    cand[n_cand].cycles = ((eb->epoch_num >= 0) &&
+                           ((uint32_t)eb->epoch_num < n_epochs))
+                              ? epoch_cycles[eb->epoch_num] : 0;
+    n_cand++;
+  }
+
+  /* hottest first (insertion sort, the list is short) */
+  for (int i = 1; i < n_cand; i++) {
+    int j = i;
+    while ((j > 0) && (cand[j - 1].cycles < cand[j].cycles)) {
+      const struct _ec_tier_cand tmp = cand[j - 1];
+      cand[j - 1] = cand[j];
+      cand[j] = tmp;
+      j--;
+    }
+  }
+
+  int pinned = 0;
+  for (int i = 0; i < n_cand; i++) {
+    /* keep the next blob 8-byte aligned in the pool */
+    const uint32_t bytes8 = (cand[i].bytes + 7) & ~7U;
+
+    if ((_ec_tier_pool_used + bytes8) <= sizeof(_ec_tier_pool)) {
+      uint64_t *dst = &_ec_tier_pool[_ec_tier_pool_used / 8];
+      memcpy(dst, (const void *)cand[i].eb->blob_address, cand[i].bytes);
+      mcu_cache_clean_range((uint32_t)(uintptr_t)dst,
+                            (uint32_t)(uintptr_t)dst + cand[i].bytes);
+      cand[i].eb->blob_address = (uintptr_t)dst;
+      _ec_tier_pool_used += bytes8;
+      pinned++;
+    } else if ((cand[i].bytes <= sizeof(_ec_tier_stage[0])) &&
+               (_ec_tier_n_units < _EC_TIER_MAX_BLOBS)) {
+      _ec_tier_units[_ec_tier_n_units].eb = cand[i].eb;
+      _ec_tier_units[_ec_tier_n_units].src = cand[i].eb->blob_address;
+      _ec_tier_units[_ec_tier_n_units].bytes = cand[i].bytes;
+      _ec_tier_n_units++;
+    }
+    /* else: too large for the rotating buffer, executes in place */
+  }
+
+  return pinned;
+}
+
+#endif /* USE_EC_BLOB_TIERS */
+
+#if defined(USE_OVERLAP_ANALYZER) && USE_OVERLAP_ANALYZER == 1
+
+/* Inter-epoch overlap analyzer
+ *
+ * A pure-HW epoch block ends with a wait on its output stream engines
+ * (wait_mask). When the next HW block drives a disjoint engine set, that
+ * wait serializes work the fabric could overlap: the earlier block's
+ * output drain and the next block's streaming. The per-epoch engine
+ * usage masks needed to flag those pairs are only emitted with
+ * LL_ATON_EB_DBG_INFO; without them the analyzer reports -1. The primary
+ * output is the pair table (model-compiler feedback); the rewrite defers
+ * the flagged wait bits into the next block's mask on the mutable DTCM
+ * copy. The masks cannot see sharing below the stream engines
+ * (fixed-function units, bus ports), and in async mode an engine event
+ * arriving between the two blocks may be missed, so the rewrite is
+ * opt-in per model (polling runtime mode recommended).
+ */
+
+static struct npu_overlap_pair _overlap_pairs[NPU_OVERLAP_MAX_PAIRS];
+static int _overlap_n_pairs;
+
+int npu_overlap_get_report(const struct npu_overlap_pair **pairs)
+{
+  if (pairs != NULL)
+    *pairs = _overlap_pairs;
+  return _overlap_n_pairs;
+}
+
+#ifdef LL_ATON_EB_DBG_INFO
+
+/* overlap-relevant: standard stream-engine HW block, no special handling */
+static bool _overlap_is_candidate(const LL_ATON_RT_EpochBlockItem_t *eb)
+{
+  const uint16_t excluded = EpochBlock_Flags_blob | EpochBlock_Flags_last_eb |
+                            EpochBlock_Flags_hybrid | EpochBlock_Flags_internal |
+                            EpochBlock_Flags_blob_encrypted;
+
+  return ((eb->flags & EpochBlock_Flags_pure_hw) != 0) &&
+         ((eb->flags & excluded) == 0);
+}
+
+/*
+* Scan the epoch block list of the instance for overlap-safe serializations
+* (to be called once, after npu_init(.., 1) and any fusion pass). Returns
+* the number of pairs found, or -1 when rewrite is requested without a
+* mutable descriptor copy.
+*/
+int npu_overlap_analyze(struct npu_instance *instance, int rewrite)
+{
+  if ((!instance) || (!instance->impl))
+    return -1;
+
+  _pin_epoch_blocks(instance);
+
+  const LL_ATON_RT_EpochBlockItem_t *list = instance->impl->exec_state.first_epoch_block;
+  LL_ATON_RT_EpochBlockItem_t *mlist = NULL;
+
+  if (rewrite) {
+    mlist = _mutable_eb_list(instance);
+    if (mlist == NULL)
+      return -1;
+    list = mlist;
+  }
+  if (list == NULL)
+    return -1;
+
+  _overlap_n_pairs = 0;
+  int found = 0;
+
+  for (int i = 0; !EpochBlock_IsLastEpochBlock(&list[i]); i++) {
+    if (!_overlap_is_candidate(&list[i]) || (list[i].wait_mask == 0))
+      continue;
+
+    /* next engine user in schedule order: intervening pure-SW epochs run
+       on the CPU and do not gate the deferral */
+    int j = i + 1;
+    while (!EpochBlock_IsLastEpochBlock(&list[j]) && EpochBlock_IsEpochPureSW(&list[j]))
+      j++;
+    if (EpochBlock_IsLastEpochBlock(&list[j]) || !_overlap_is_candidate(&list[j]))
+      continue;
+
+    const uint32_t next_engines = list[j].in_streng_mask | list[j].out_streng_mask;
+    const uint32_t deferrable = list[i].wait_mask & ~next_engines;
+    if (deferrable == 0)
+      continue;
+
+    if (_overlap_n_pairs < NPU_OVERLAP_MAX_PAIRS) {
+      _overlap_pairs[_overlap_n_pairs].epoch_num = list[i].epoch_num;
+      _overlap_pairs[_overlap_n_pairs].next_epoch_num = list[j].epoch_num;
+      _overlap_pairs[_overlap_n_pairs].deferrable_mask = deferrable;
+      _overlap_n_pairs++;
+    }
+    found++;
+
+    if (mlist != NULL) {
+      /* keep waiting on the engines the next block reuses, defer the rest */
+      mlist[i].wait_mask &= next_engines;
+      mlist[j].wait_mask |= deferrable;
+    }
+  }
+
+  return found;
+}
+
+#else /* !LL_ATON_EB_DBG_INFO */
+
+int npu_overlap_analyze(struct npu_instance *instance, int rewrite)
+{
+  LL_ATON_LIB_UNUSED(instance);
+  LL_ATON_LIB_UNUSED(rewrite);
+  return -1;  /* engine usage masks need a LL_ATON_EB_DBG_INFO build */
+}
+
+#endif /* LL_ATON_EB_DBG_INFO */
+
+#endif /* USE_OVERLAP_ANALYZER */
+
+#else
+
+static void _pin_epoch_blocks(struct npu_instance *instance)
+{
+  LL_ATON_LIB_UNUSED(instance);
+}
+
+#if defined(USE_EPOCH_FUSION) && USE_EPOCH_FUSION == 1
+int npu_fuse_epoch_blocks(struct npu_instance *instance)
+{
+  LL_ATON_LIB_UNUSED(instance);
+  return -1;  /* no mutable descriptor copy without the DTCM pinning */
+}
+#endif
+
+#if defined(USE_EPOCH_MEMO) && USE_EPOCH_MEMO == 1
+int npu_memo_epoch_blocks(struct npu_instance *instance)
+{
+  LL_ATON_LIB_UNUSED(instance);
+  return -1;  /* no mutable descriptor copy without the DTCM pinning */
+}
+#endif
+
+#if defined(USE_EC_FLASH_PARTITION) && USE_EC_FLASH_PARTITION == 1
+int npu_connect_ec_partition(struct npu_instance *instance)
+{
+  LL_ATON_LIB_UNUSED(instance);
+  return -1;  /* no mutable descriptor copy without the DTCM pinning */
+}
+#endif
+
+#if defined(USE_OVERLAP_ANALYZER) && USE_OVERLAP_ANALYZER == 1
+int npu_overlap_analyze(struct npu_instance *instance, int rewrite)
+{
+  LL_ATON_LIB_UNUSED(instance);
+  LL_ATON_LIB_UNUSED(rewrite);
+  return -1;  /* no mutable descriptor copy without the DTCM pinning */
+}
+
+int npu_overlap_get_report(const struct npu_overlap_pair **pairs)
+{
+  if (pairs != NULL)
+    *pairs = NULL;
+  return 0;
+}
+#endif
+
+#endif /* LL_ATON_USE_DTCM && !USE_RELOC_MODE */
+
+/* Above this total IO footprint the line-by-line ranged maintenance costs
+   more than scrubbing the whole cache in one pass */
+#define _CACHE_RANGE_THRESHOLD  (256 * 1024)
+
+static void _force_clean_cache_subsystem(struct npu_instance *instance)
+{
+  uint32_t total = 0;
+
+  if (instance) {
+    for (int i = 0; i < instance->info.n_inputs; i++)
+      total += LL_Buffer_len(instance->info.in_bufs[i]);
+    for (int i = 0; i < instance->info.n_outputs; i++)
+      total += LL_Buffer_len(instance->info.out_bufs[i]);
+  }
+
+  if ((total == 0) || (total > _CACHE_RANGE_THRESHOLD)) {
+#ifdef USE_NPU_CACHE
+    npu_cache_invalidate();
+#endif
+    mcu_cache_clean_invalidate();
+    return;
+  }
+
+  /* ranged maintenance on the exact IO extents only: a whole-cache
+     invalidate would also evict the runtime's own hot state, paid back
+     on the next epoch transitions */
+  for (int i = 0; i < instance->info.n_inputs; i++) {
+    const LL_Buffer_InfoTypeDef *ll_buf = instance->info.in_bufs[i];
+    mcu_cache_clean_range((uint32_t)(uintptr_t)LL_Buffer_addr_start(ll_buf),
+                          (uint32_t)(uintptr_t)LL_Buffer_addr_end(ll_buf));
+#ifdef USE_NPU_CACHE
+    npu_cache_clean_invalidate_range((uint32_t)(uintptr_t)LL_Buffer_addr_start(ll_buf),
+                                     (uint32_t)(uintptr_t)LL_Buffer_addr_end(ll_buf));
+#endif
+  }
+
+  for (int i = 0; i < instance->info.n_outputs; i++) {
+    const LL_Buffer_InfoTypeDef *ll_buf = instance->info.out_bufs[i];
+    mcu_cache_clean_invalidate_range((uint32_t)(uintptr_t)LL_Buffer_addr_start(ll_buf),
+                                     (uint32_t)(uintptr_t)LL_Buffer_addr_end(ll_buf));
+#ifdef USE_NPU_CACHE
+    npu_cache_clean_invalidate_range((uint32_t)(uintptr_t)LL_Buffer_addr_start(ll_buf),
+                                     (uint32_t)(uintptr_t)LL_Buffer_addr_end(ll_buf));
+#endif
+  }
+}
+
+
+/* -------------------------------------------------------------------------
+* Wrapper entry points
+* -------------------------------------------------------------------------
+*/
 
 /*
 * Retrieve and populate an instance of the model.
@@ -906,10 +2515,160 @@ int npu_get_instance_by_index(int idx, struct npu_instance *instance)
 
   instance->state = 0;
   instance->user_cb = NULL;
+  instance->complete_cb = NULL;
+  instance->complete_cookie = NULL;
+  instance->preproc_fn = NULL;
+  instance->preproc_desc = NULL;
+
+  return 0;
+}
+
+/*
+* A/B model switchover (USE_RELOC_AB_BANKS)
+*
+*  npu_reloc_prepare_next() installs the pending relocatable binary into the
+*  inactive bank and initializes it, while the active bank keeps serving
+*  npu_run(). npu_reloc_switchover() then publishes the prepared bank with a
+*  single pointer update and releases the previous one.
+*
+*  Both return 0 on success, -1 when not supported/nothing prepared and
+*  -2 when the install fails.
+*/
+#if defined(USE_RELOC_MODE) && USE_RELOC_MODE == 1 && defined(USE_RELOC_AB_BANKS) && USE_RELOC_AB_BANKS == 1
+
+int npu_reloc_prepare_next(void)
+{
+  int bank = _nn_active_bank ^ 1;
+
+  NN_Instance_TypeDef *next = _reloc_install_instance(_RELOC_BANK_EXEC_ADDR(bank), _RELOC_BANK_EXEC_RAM_SZ,
+                                                      _RELOC_BANK_EXT_ADDR(bank), _RELOC_BANK_EXT_RAM_SZ,
+                                                      &NN_Instance_Banks[bank]);
+
+  if (!next)
+    return -2;
+
+  /* initialize the network now, so the switchover is only a pointer update */
+  LL_ATON_RT_Init_Network(next);
+
+  _nn_prepared_bank = bank;
+
+  return 0;
+}
+
+int npu_reloc_switchover(struct npu_instance *instance)
+{
+  if (_nn_prepared_bank < 0)
+    return -1;
+
+  NN_Instance_TypeDef *prev = _nn_active_inst;
+  NN_Instance_TypeDef *next = &NN_Instance_Banks[_nn_prepared_bank];
+
+  _nn_active_bank = _nn_prepared_bank;
+  _nn_prepared_bank = -1;
+
+  /* single aligned store: atomic wrt the (synchronous) run path */
+  _nn_active_inst = next;
+
+  if (instance) {
+    instance->impl = next;
+    _populate_nn_info(instance);
+  }
+
+  if (prev && (prev != next))
+    LL_ATON_RT_DeInit_Network(prev);
 
   return 0;
 }
 
+#else /* !USE_RELOC_AB_BANKS */
+
+int npu_reloc_prepare_next(void)
+{
+  return -1;
+}
+
+int npu_reloc_switchover(struct npu_instance *instance)
+{
+  UNUSED(instance);
+  return -1;
+}
+
+#endif /* USE_RELOC_AB_BANKS */
+
+/*
+* Profile-driven activations placement (USE_ACTS_PLACEMENT)
+*
+*  npu_reloc_place_acts() moves the activations/external pool of the
+*  installed relocatable model to the fast on-chip window ('fast_bank'=1,
+*  AXIRAM2) or back to the external PSRAM default ('fast_bank'=0). The move
+*  is a re-install through the reloc mechanism: the pool base is the only
+*  placement degree of freedom, the buffer offsets inside the pool are baked
+*  into the mpool descriptors of the image. The IO buffer addresses change
+*  with the pool, the instance info is re-populated.
+*
+*  Returns 0 on success (or already placed), -1 when not supported or the
+*  pool does not fit the fast window, -2 when the re-install fails.
+*/
+#if defined(USE_RELOC_MODE) && USE_RELOC_MODE == 1 && defined(USE_ACTS_PLACEMENT) && USE_ACTS_PLACEMENT == 1
+
+int npu_reloc_place_acts(struct npu_instance *instance, int fast_bank)
+{
+  uintptr_t addr = fast_bank ? (uintptr_t)_RELOC_FAST_ACTS_ADDR : (uintptr_t)_RELOC_EXT_RAM_ADDR;
+  uint32_t size = fast_bank ? _RELOC_FAST_ACTS_SZ : _RELOC_MAX_EXT_RAM_SZ;
+
+  if (!instance || !instance->impl)
+    return -1;
+
+  if (addr == _acts_ram_addr)
+    return 0;
+
+  /* fit check before the resident install is torn down */
+  uint32_t *rom_addr = (uint32_t *)_RELOC_BASE_ADDR_1;
+  ll_aton_reloc_info rt;
+
+  if (AI_RELOC_MAGIC != *rom_addr)
+    rom_addr = (uint32_t *)_RELOC_BASE_ADDR_0;
+
+  if ((AI_RELOC_MAGIC != *rom_addr) ||
+      ll_aton_reloc_get_info((uintptr_t)rom_addr, &rt) || (rt.ext_ram_sz > size))
+    return -1;
+
+  NN_Instance_TypeDef *nn_inst = (NN_Instance_TypeDef *)instance->impl;
+
+  LL_ATON_RT_DeInit_Network(nn_inst);
+
+  _acts_ram_addr = addr;
+  _acts_ram_sz = size;
+
+  if (_reloc_install_instance((uintptr_t)_RELOC_EXEC_RAM_ADDR, _RELOC_MAX_EXEC_RAM_SZ,
+                              _acts_ram_addr, _acts_ram_sz, nn_inst) == NULL) {
+    /* fall back to the previous bank, the model must stay runnable */
+    _acts_ram_addr = fast_bank ? (uintptr_t)_RELOC_EXT_RAM_ADDR : (uintptr_t)_RELOC_FAST_ACTS_ADDR;
+    _acts_ram_sz = fast_bank ? _RELOC_MAX_EXT_RAM_SZ : _RELOC_FAST_ACTS_SZ;
+    _reloc_install_instance((uintptr_t)_RELOC_EXEC_RAM_ADDR, _RELOC_MAX_EXEC_RAM_SZ,
+                            _acts_ram_addr, _acts_ram_sz, nn_inst);
+    LL_ATON_RT_Init_Network(nn_inst);
+    return -2;
+  }
+
+  LL_ATON_RT_Init_Network(nn_inst);
+  _populate_nn_info(instance);
+  npu_mark_memory_dirty();
+
+  return 0;
+}
+
+#else /* !USE_ACTS_PLACEMENT */
+
+int npu_reloc_place_acts(struct npu_instance *instance, int fast_bank)
+{
+  UNUSED(instance);
+  UNUSED(fast_bank);
+  return -1;
+}
+
+#endif /* USE_ACTS_PLACEMENT */
+
 /*
 * Retrieve the description of the input LL buffer(s)
 *
@@ -990,56 +2749,513 @@ const LL_Buffer_InfoTypeDef* npu_get_output_buffers_info(const struct npu_instan
       if (idx == num) {
         return aton_buf;
       }
-      idx++;
-    } else {
-      return NULL;
+      idx++;
+    } else {
+      return NULL;
+    }
+  }
+  return NULL;
+}
+
+/*
+* Retrieve the description of the internal LL buffer(s)
+*
+*  'instance'   structure to handle the instance.
+*  'num'        index of the tensor (if =-1, all are returned)
+*
+*   if invalid NULL is returned
+*
+*/
+const LL_Buffer_InfoTypeDef* npu_get_internal_buffers_info(const struct npu_instance *instance)
+{
+  const LL_Buffer_InfoTypeDef *aton_buf;
+
+  if (!instance)
+    return NULL;
+
+  const NN_Instance_TypeDef *nn_inst = instance->impl;
+
+#if defined(USE_RELOC_MODE) && USE_RELOC_MODE == 1
+  if (nn_inst->exec_state.inst_reloc != 0)
+    aton_buf = &ll_aton_reloc_get_internal_buffers_info(nn_inst)[0];
+  else
+    aton_buf = nn_inst->network->internal_buffers_info();
+#else
+  aton_buf = nn_inst->network->internal_buffers_info();
+#endif
+
+  return aton_buf;
+}
+
+/*
+* Lazily connect the user-allocated IO buffers of an instance.
+*
+* Models generated with user-allocated IO report NULL buffer addresses until
+* the application provides the storage. Instead of per-model static arrays
+* (see ai_io_buffers_ATON.c for the "Default" build), the space is carved out
+* of a single shared arena the first time the instance is used; an instance
+* whose IO buffers are already allocated (pool mode) is left untouched.
+*
+* Opt-in with NPU_IO_ARENA_SIZE (> 0) from 'app_config.h'. Returns 0 on
+* success (or nothing to do), -1 if the arena is exhausted or a setter fails.
+*/
+#ifndef NPU_IO_ARENA_SIZE
+#define NPU_IO_ARENA_SIZE (0)
+#endif
+
+#if NPU_IO_ARENA_SIZE > 0
+static uint8_t _npu_io_arena[NPU_IO_ARENA_SIZE] __attribute__((aligned(32)));
+static uint32_t _npu_io_arena_used;
+static const NN_Instance_TypeDef *_npu_io_connected[NPU_NETWORK_NUMBER];
+
+#if defined(USE_PINGPONG_OUTPUTS) && USE_PINGPONG_OUTPUTS == 1
+/* double-buffered outputs: two arena banks per output, the flip re-points
+   the model at the idle bank and hands the just-written one to the drain
+   path (see npu_flip_output_buffers) */
+static struct {
+  const NN_Instance_TypeDef *nn_inst;               /* owner, NULL = inactive */
+  uint8_t *bank[2][NPU_MAX_IO_BUFFER];              /* per-output bank addresses */
+  LL_Buffer_InfoTypeDef prev[NPU_MAX_IO_BUFFER + 1];/* snapshot of the drained bank */
+  int n;                                            /* number of outputs */
+  int cur;                                          /* bank the model writes to */
+} _pp_out;
+#endif
+#endif
+
+int npu_connect_io_arena(struct npu_instance *instance)
+{
+#if NPU_IO_ARENA_SIZE > 0
+  const LL_Buffer_InfoTypeDef *aton_buf;
+
+  if (!instance || !instance->impl)
+    return -1;
+
+  const NN_Instance_TypeDef *nn_inst = instance->impl;
+
+#if defined(USE_MPU_WT_IO) && USE_MPU_WT_IO == 1
+  /* map the whole arena write-through once, the carving stays inside it
+     (region 0 covers the default-network arena, see connect_input_buffers) */
+  static bool _npu_io_mpu_mapped;
+  if (!_npu_io_mpu_mapped) {
+    MPU_WT_Region_Config(1, (uint32_t)(uintptr_t)_npu_io_arena, sizeof(_npu_io_arena));
+    _npu_io_mpu_mapped = true;
+  }
+#endif
+
+  for (int i = 0; i < NPU_NETWORK_NUMBER; i++) {
+    if (_npu_io_connected[i] == nn_inst)
+      return 0; /* already carved for this instance */
+  }
+
+  uint32_t used = _npu_io_arena_used;
+
+  for (int pass = 0; pass < 2; pass++) {
+    for (int32_t num = 0; ; num++) {
+      aton_buf = pass == 0 ? npu_get_input_buffers_info(instance, num)
+                           : npu_get_output_buffers_info(instance, num);
+      if (!aton_buf)
+        break;
+      if (LL_Buffer_addr_start((LL_Buffer_InfoTypeDef *)aton_buf))
+        continue; /* already allocated (pool mode) */
+
+      uint32_t size = LL_Buffer_len(aton_buf);
+      if (used + AI_RELOC_ROUND_UP_32B(size) > NPU_IO_ARENA_SIZE)
+        return -1;
+
+      LL_ATON_User_IO_Result_t res;
+      if (pass == 0)
+        res = nn_inst->network->input_setter((uint32_t)num, &_npu_io_arena[used], size);
+      else
+        res = nn_inst->network->output_setter((uint32_t)num, &_npu_io_arena[used], size);
+      if (res != LL_ATON_User_IO_NOERROR)
+        return -1;
+
+      used += AI_RELOC_ROUND_UP_32B(size);
+    }
+  }
+
+#if defined(USE_PINGPONG_OUTPUTS) && USE_PINGPONG_OUTPUTS == 1
+  /* carve the second output bank - only when every output is settable and
+     arena-resident, pool-allocated outputs cannot be flipped */
+  uint32_t pp_used = used;
+
+  _pp_out.nn_inst = NULL;
+  _pp_out.n = 0;
+  _pp_out.cur = 0;
+
+  for (int32_t num = 0; ; num++) {
+    aton_buf = npu_get_output_buffers_info(instance, num);
+    if (!aton_buf)
+      break;
+
+    uint8_t *cur_ptr = (uint8_t *)(uintptr_t)LL_Buffer_addr_start((LL_Buffer_InfoTypeDef *)aton_buf);
+    uint32_t size = LL_Buffer_len(aton_buf);
+
+    if ((num >= NPU_MAX_IO_BUFFER) ||
+        (cur_ptr < &_npu_io_arena[0]) || (cur_ptr >= &_npu_io_arena[NPU_IO_ARENA_SIZE]) ||
+        (pp_used + AI_RELOC_ROUND_UP_32B(size) > NPU_IO_ARENA_SIZE)) {
+      _pp_out.n = 0;
+      break;
+    }
+
+    _pp_out.bank[0][num] = cur_ptr;
+    _pp_out.bank[1][num] = &_npu_io_arena[pp_used];
+    pp_used += AI_RELOC_ROUND_UP_32B(size);
+    _pp_out.n = num + 1;
+  }
+
+  if (_pp_out.n) {
+    _pp_out.nn_inst = nn_inst;
+    used = pp_used;
+  }
+#endif
+
+  for (int i = 0; i < NPU_NETWORK_NUMBER; i++) {
+    if (_npu_io_connected[i] == NULL) {
+      _npu_io_connected[i] = nn_inst;
+      break;
+    }
+  }
+  _npu_io_arena_used = used;
+#else
+  UNUSED(instance);
+#endif
+  return 0;
+}
+
+/*
+* Register the parameter windows of an instance as pinned in the NPU cache
+* (USE_NPU_CACHE_PIN). Only small weight sets qualify (total size up to
+* NPU_CACHE_PIN_MAX_BYTES): pinning a large set would just turn the whole
+* cache scrub off without keeping anything resident.
+*
+* Returns the number of pinned windows, 0 when nothing qualifies.
+*/
+int npu_pin_weights(struct npu_instance *instance)
+{
+#if defined(USE_NPU_CACHE) && defined(USE_NPU_CACHE_PIN) && USE_NPU_CACHE_PIN == 1
+  const LL_Buffer_InfoTypeDef *aton_buf;
+  uint32_t total = 0;
+  int n = 0;
+
+  if (!instance)
+    return 0;
+
+  const LL_Buffer_InfoTypeDef *input_buffs = npu_get_input_buffers_info(instance, -1);
+
+  if (!input_buffs)
+    return 0;
+
+  for (aton_buf = input_buffs; aton_buf->name != NULL; aton_buf++) {
+    if (aton_buf->is_param == 1)
+      total += get_ll_buffer_size(aton_buf);
+  }
+
+  if ((total == 0) || (total > NPU_CACHE_PIN_MAX_BYTES))
+    return 0;
+
+  for (aton_buf = input_buffs; aton_buf->name != NULL; aton_buf++) {
+    if (aton_buf->is_param != 1)
+      continue;
+    if (npu_cache_pin_range((uint32_t)(uintptr_t)LL_Buffer_addr_start((LL_Buffer_InfoTypeDef *)aton_buf),
+                            (uint32_t)(uintptr_t)LL_Buffer_addr_end((LL_Buffer_InfoTypeDef *)aton_buf)) != 0)
+      break;
+    n++;
+  }
+
+  return n;
+#else
+  UNUSED(instance);
+  return 0;
+#endif
+}
+
+/*
+* Flip the double-buffered outputs of an instance (USE_PINGPONG_OUTPUTS).
+*
+* The model is re-pointed at the idle arena bank and a snapshot of the
+* just-written descriptors is returned (name-terminated list, stable until
+* the next flip): the caller drains run N from it while the NPU already
+* writes run N+1 into the other bank.
+*
+* Returns NULL when ping-pong is not active for this instance.
+*/
+const LL_Buffer_InfoTypeDef *npu_flip_output_buffers(struct npu_instance *instance)
+{
+#if (NPU_IO_ARENA_SIZE > 0) && defined(USE_PINGPONG_OUTPUTS) && USE_PINGPONG_OUTPUTS == 1
+  if (!instance || (_pp_out.n == 0) || (instance->impl != _pp_out.nn_inst))
+    return NULL;
+
+  const NN_Instance_TypeDef *nn_inst = instance->impl;
+  const int next = _pp_out.cur ^ 1;
+
+  for (int num = 0; num < _pp_out.n; num++) {
+    const LL_Buffer_InfoTypeDef *aton_buf = npu_get_output_buffers_info(instance, num);
+
+    if (!aton_buf)
+      return NULL;
+
+    /* snapshot of the just-written bank, handed to the drain path */
+    _pp_out.prev[num] = *aton_buf;
+
+    if (nn_inst->network->output_setter((uint32_t)num, _pp_out.bank[next][num],
+                                        LL_Buffer_len(aton_buf)) != LL_ATON_User_IO_NOERROR)
+      return NULL;
+  }
+
+  /* name-terminated, as the generated buffer info lists */
+  memset(&_pp_out.prev[_pp_out.n], 0, sizeof(_pp_out.prev[0]));
+  _pp_out.cur = next;
+
+  return &_pp_out.prev[0];
+#else
+  UNUSED(instance);
+  return NULL;
+#endif
+}
+
+/*
+* Register the user callback for a given instance.
+*/
+int npu_set_callback(struct npu_instance *instance, npu_user_cb user_cb)
+{
+  if (!instance)
+    return -1;
+
+  instance->user_cb = user_cb;
+  return 0;
+}
+
+/*
+* Register the completion callback and its per-request context.
+*
+* The callback fires once per inference on every execution path (npu_run,
+* npu_run_sched, submit/poll queue), including the error returns, with the
+* final counters snapshot - so event-driven callers do not have to poll the
+* runtime state or re-read the counters themselves.
+*/
+int npu_set_complete_callback(struct npu_instance *instance,
+                              npu_complete_cb complete_cb, void *cookie)
+{
+  if (!instance)
+    return -1;
+
+  instance->complete_cb = complete_cb;
+  instance->complete_cookie = cookie;
+  return 0;
+}
+
+/* deliver the completion notification, pass-through of 'ret' */
+static int _notify_complete(struct npu_instance *instance, int ret,
+                            const struct npu_counters *counters)
+{
+  if (ret >= 0)
+    _util_runs += 1;
+
+  if (instance->complete_cb)
+    instance->complete_cb(instance, ret, counters, instance->complete_cookie);
+  return ret;
+}
+
+/*
+* Register the input preprocessing stage of an instance.
+*
+* 'fn' runs at the top of npu_run with the first input buffer as
+* destination; NULL unregisters. The descriptor is caller-owned and only
+* referenced, so a sensor driver can retarget 'src' per frame.
+*/
+int npu_set_preproc(struct npu_instance *instance, npu_preproc_fn fn,
+                    const struct npu_preproc_desc *desc)
+{
+  if (!instance)
+    return -1;
+
+  instance->preproc_fn = fn;
+  instance->preproc_desc = desc;
+  return 0;
+}
+
+#if defined(USE_PREPROC) && USE_PREPROC == 1
+
+#include <math.h>  /* lrintf */
+
+#if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 2)
+#include <arm_mve.h>
+#define _PREPROC_HAS_MVE 1
+#else
+#define _PREPROC_HAS_MVE 0
+#endif
+
+static uint32_t _preproc_cycles;        /* stage cycles of the last npu_run */
+
+/* resolved crop window and channel count (0 means full frame / 1 channel) */
+static void _preproc_window(const struct npu_preproc_desc *desc,
+                            uint32_t *w, uint32_t *h, uint32_t *c)
+{
+  *w = desc->crop_w ? desc->crop_w : desc->src_w;
+  *h = desc->crop_h ? desc->crop_h : desc->src_h;
+  *c = desc->src_c ? desc->src_c : 1;
+}
+
+/*
+* u8 interleaved frame -> float32 model input: crop + normalize, optional
+* HWC -> CHW deinterleave. The interleaved path works on contiguous source
+* rows and is MVE-vectorized; the planar gather is strided and kept scalar.
+*/
+int npu_preproc_u8_to_f32(const struct npu_preproc_desc *desc,
+                          void *dst, uint32_t dst_size)
+{
+  uint32_t w, h, c;
+  _preproc_window(desc, &w, &h, &c);
+
+  if (!desc->src || ((w * h * c * sizeof(float)) > dst_size))
+    return -1;
+
+  const uint8_t *src = (const uint8_t *)desc->src;
+  const uint32_t row_stride = (uint32_t)desc->src_w * c;
+  const float scale = desc->scale;
+  const float offset = desc->offset;
+  float *out = (float *)dst;
+
+  if (!desc->to_chw) {
+    const uint32_t row_len = w * c;
+    for (uint32_t r = 0; r < h; r++) {
+      const uint8_t *s = src + ((uint32_t)desc->crop_y + r) * row_stride
+                             + (uint32_t)desc->crop_x * c;
+      uint32_t i = 0;
+#if _PREPROC_HAS_MVE == 1
+      const float32x4_t voff = vdupq_n_f32(offset);
+      for (; (i + 4) <= row_len; i += 4) {
+        const float32x4_t v = vcvtq_f32_u32(vldrbq_u32(&s[i]));
+        vst1q_f32(&out[i], vmulq_n_f32(vsubq_f32(v, voff), scale));
+      }
+#endif
+      for (; i < row_len; i++)
+        out[i] = ((float)s[i] - offset) * scale;
+      out += row_len;
+    }
+  } else {
+    for (uint32_t ch = 0; ch < c; ch++)
+      for (uint32_t r = 0; r < h; r++) {
+        const uint8_t *s = src + ((uint32_t)desc->crop_y + r) * row_stride
+                               + (uint32_t)desc->crop_x * c + ch;
+        for (uint32_t x = 0; x < w; x++)
+          *out++ = ((float)s[x * c] - offset) * scale;
+      }
+  }
+
+  return (int)(w * h * c * sizeof(float));
+}
+
+/*
+* u8 interleaved frame -> int8 model input: crop + normalize + round to
+* nearest with saturation (q = round((in - offset) * scale), [-128, 127]).
+*/
+int npu_preproc_u8_to_s8(const struct npu_preproc_desc *desc,
+                         void *dst, uint32_t dst_size)
+{
+  uint32_t w, h, c;
+  _preproc_window(desc, &w, &h, &c);
+
+  if (!desc->src || ((w * h * c) > dst_size))
+    return -1;
+
+  const uint8_t *src = (const uint8_t *)desc->src;
+  const uint32_t row_stride = (uint32_t)desc->src_w * c;
+  const float scale = desc->scale;
+  const float offset = desc->offset;
+  int8_t *out = (int8_t *)dst;
+
+  if (!desc->to_chw) {
+    const uint32_t row_len = w * c;
+    for (uint32_t r = 0; r < h; r++) {
+      const uint8_t *s = src + ((uint32_t)desc->crop_y + r) * row_stride
+                             + (uint32_t)desc->crop_x * c;
+      uint32_t i = 0;
+#if _PREPROC_HAS_MVE == 1
+      const float32x4_t voff = vdupq_n_f32(offset);
+      for (; (i + 4) <= row_len; i += 4) {
+        const float32x4_t v = vcvtq_f32_u32(vldrbq_u32(&s[i]));
+        int32x4_t q = vcvtnq_s32_f32(vmulq_n_f32(vsubq_f32(v, voff), scale));
+        q = vmaxq_s32(q, vdupq_n_s32(-128));
+        q = vminq_s32(q, vdupq_n_s32(127));
+        vstrbq_s32(&out[i], q);
+      }
+#endif
+      for (; i < row_len; i++) {
+        int32_t q = (int32_t)lrintf(((float)s[i] - offset) * scale);
+        q = (q < -128) ? -128 : ((q > 127) ? 127 : q);
+        out[i] = (int8_t)q;
+      }
+      out += row_len;
     }
+  } else {
+    for (uint32_t ch = 0; ch < c; ch++)
+      for (uint32_t r = 0; r < h; r++) {
+        const uint8_t *s = src + ((uint32_t)desc->crop_y + r) * row_stride
+                               + (uint32_t)desc->crop_x * c + ch;
+        for (uint32_t x = 0; x < w; x++) {
+          int32_t q = (int32_t)lrintf(((float)s[x * c] - offset) * scale);
+          q = (q < -128) ? -128 : ((q > 127) ? 127 : q);
+          *out++ = (int8_t)q;
+        }
+      }
   }
-  return NULL;
+
+  return (int)(w * h * c);
 }
 
-/*
-* Retrieve the description of the internal LL buffer(s)
-*
-*  'instance'   structure to handle the instance.
-*  'num'        index of the tensor (if =-1, all are returned)
-*
-*   if invalid NULL is returned
-*
-*/
-const LL_Buffer_InfoTypeDef* npu_get_internal_buffers_info(const struct npu_instance *instance)
+/* run the registered stage into the first input buffer, with the epoch
+   accounting: the measured window joins the PRE tier (cpu_start), and the
+   DWT is re-armed afterwards so the cycles are not counted a second time
+   in the first PRE_START gap (same idiom as _epoch_callback) */
+static void _preproc_run(struct npu_instance *instance)
 {
-  const LL_Buffer_InfoTypeDef *aton_buf;
+  _preproc_cycles = 0;
 
-  if (!instance)
-    return NULL;
+  if (!instance->preproc_fn || !instance->preproc_desc ||
+      (instance->info.n_inputs < 1))
+    return;
 
-  const NN_Instance_TypeDef *nn_inst = instance->impl;
+  const LL_Buffer_InfoTypeDef *ll_buf = instance->info.in_bufs[0];
 
-#if defined(USE_RELOC_MODE) && USE_RELOC_MODE == 1
-  if (nn_inst->exec_state.inst_reloc != 0)
-    aton_buf = &ll_aton_reloc_get_internal_buffers_info(nn_inst)[0];
-  else
-    aton_buf = nn_inst->network->internal_buffers_info();
-#else
-  aton_buf = nn_inst->network->internal_buffers_info();
-#endif
+  instance->preproc_fn(instance->preproc_desc,
+                       LL_Buffer_addr_start(ll_buf),
+                       get_ll_buffer_size(ll_buf));
 
-  return aton_buf;
+  _preproc_cycles = port_dwt_get_cycles();
+  g_npu_exec_ctx.cpu_cycles_start += _preproc_cycles;
+  port_dwt_reset();
 }
 
-/*
-* Register the user callback for a given instance.
-*/
-int npu_set_callback(struct npu_instance *instance, npu_user_cb user_cb)
+uint32_t npu_preproc_cycles(void)
 {
-  if (!instance)
-    return -1;
+  return _preproc_cycles;
+}
 
-  instance->user_cb = user_cb;
+#else /* !USE_PREPROC */
+
+uint32_t npu_preproc_cycles(void)
+{
   return 0;
 }
 
+int npu_preproc_u8_to_f32(const struct npu_preproc_desc *desc,
+                          void *dst, uint32_t dst_size)
+{
+  (void)desc; (void)dst; (void)dst_size;
+  return -1;
+}
+
+int npu_preproc_u8_to_s8(const struct npu_preproc_desc *desc,
+                         void *dst, uint32_t dst_size)
+{
+  (void)desc; (void)dst; (void)dst_size;
+  return -1;
+}
+
+#endif /* USE_PREPROC */
+
 /*
 * Initialize/reset the instance
 *
@@ -1048,12 +3264,18 @@ int npu_set_callback(struct npu_instance *instance, npu_user_cb user_cb)
 *             if state==1, instance is re-initialized
 *  mode = 2 - reset the instance if state==1
 *
+*  b15..b8 of 'mode' optionally carry the epoch callback aggregation
+*  factor (see NPU_INIT_SET_CB_BATCH), 0 keeps the current setting.
 */
 int npu_init(struct npu_instance *instance, uint32_t mode)
 {
   if (!instance)
     return -1;
 
+  if (NPU_INIT_CB_BATCH(mode) != 0)
+    instance->cb_batch = NPU_INIT_CB_BATCH(mode);
+  mode = NPU_INIT_MODE(mode);
+
   port_dwt_reset();
   if (mode == 0) {
     /* Disable TOP NPU/CACHE clocks */
@@ -1069,11 +3291,24 @@ int npu_init(struct npu_instance *instance, uint32_t mode)
     _force_clean_cache_subsystem(instance);
     port_dwt_init();
     _npu_internal_reset();
+#if USE_COUNTER_NPU_CACHE
+    npu_cache_counters_acc_reset();
+#endif
 
     LL_ATON_RT_SetRuntimeCallback(_rt_callback);
     LL_ATON_RT_RuntimeInit();                       // Initialize runtime
     LL_ATON_RT_Init_Network(instance->impl);  // Initialize passed network instance object
 
+    /* carve the user-allocated IO buffers out of the shared arena
+       (no-op for pool-allocated models, see NPU_IO_ARENA_SIZE) */
+    npu_connect_io_arena(instance);
+
+#if defined(USE_NPU_CACHE_PIN) && USE_NPU_CACHE_PIN == 1
+    /* register small weight sets as pinned, the run path then preserves
+       the resident NPU cache lines (see _prepare_input_buffers) */
+    npu_pin_weights(instance);
+#endif
+
     instance->state = 1;
   } else if (mode == 2) {
     if (instance->state == 1) {
@@ -1086,13 +3321,62 @@ int npu_init(struct npu_instance *instance, uint32_t mode)
   return 0;
 }
 
+/* Stall-cause accumulation: the WFE wait of the run loop is the time the
+   CPU spends with the NPU not done, attributed to the wait source of the
+   epoch block being waited on (see npu_get_stall_cycles). */
+#if NPU_STALL_SLOTS < (ATON_STRENG_NUM + 1)
+#error "NPU_STALL_SLOTS does not cover the stream engines of this platform"
+#endif
+static uint64_t _stall_cycles[NPU_STALL_SLOTS];
+
+const uint64_t *npu_get_stall_cycles(void)
+{
+  return _stall_cycles;
+}
+
+/*
+* Read the ATON utilization gauge, optionally resetting it.
+*
+* The open gap since the last epoch block edge is folded into the idle
+* side at read time, so a read on a quiescent board reports the elapsed
+* idle instead of the state frozen at the last inference. 'reset' != 0
+* restarts the accounting window.
+*/
+int npu_util_get(struct npu_util_gauge *gauge, int reset)
+{
+  const uint32_t now_us = _util_now_us();
+
+  _util_idle_us += now_us - _util_last_us;
+  _util_last_us = now_us;
+
+  if (gauge) {
+    gauge->busy_us = _util_busy_us;
+    gauge->idle_us = _util_idle_us;
+    gauge->runs = _util_runs;
+    gauge->queue_peak = _util_queue_peak;
+  }
+
+  if (reset) {
+    _util_busy_us = 0;
+    _util_idle_us = 0;
+    _util_runs = 0;
+    _util_queue_peak = 0;
+  }
+
+  return 0;
+}
+
 /*
 * Run a simple inference
+*
+*  Returns the inference time in ms, -1 on error. With USE_EPOCH_WATCHDOG=1
+*  a hung epoch aborts the run and -(epoch block index + 2) is returned.
 */
 int npu_run(struct npu_instance *instance, struct npu_counters *counters)
 {
   bool should_be_deinit = false;
   LL_ATON_RT_RetValues_t ll_aton_rt_ret = LL_ATON_RT_DONE;
+  struct npu_counters cb_snapshot;
 
   if (counters)
     memset(counters, 0, sizeof(struct npu_counters));
@@ -1100,8 +3384,20 @@ int npu_run(struct npu_instance *instance, struct npu_counters *counters)
   if (!instance)
     return -1;
 
+  /* completion callback wants the final counters even when the caller
+     passed none: fill a call-scoped snapshot instead */
+  if (instance->complete_cb && !counters) {
+    memset(&cb_snapshot, 0, sizeof(cb_snapshot));
+    counters = &cb_snapshot;
+  }
+
   memset(&g_npu_exec_ctx, 0, sizeof(struct _npu_exec_context));
 
+  /* the event ring holds the trace of the last inference */
+  LL_Dbgtrc_Evt_Reset();
+
+  memset(_stall_cycles, 0, sizeof(_stall_cycles));
+
   if (instance->state == 0) {
     npu_init(instance, 1);
     should_be_deinit = true;
@@ -1109,21 +3405,45 @@ int npu_run(struct npu_instance *instance, struct npu_counters *counters)
 
   if (instance->user_cb) {
     g_npu_exec_ctx.user_cb = instance->user_cb;
-    g_npu_exec_ctx.mode = instance->option;
+    g_npu_exec_ctx.mode = npu_counter_preset_expand(instance->option);
+    g_npu_exec_ctx.cb_batch = (instance->cb_batch > 1) ? instance->cb_batch : 1;
     LL_ATON_RT_SetEpochCallback(_epoch_callback, instance->impl);
   } else {
     g_npu_exec_ctx.mode = 0;
+#if (defined(USE_WEIGHT_PREFETCH) && USE_WEIGHT_PREFETCH == 1) || (defined(USE_LAZY_PARAMS) && USE_LAZY_PARAMS == 1) || \
+    (defined(USE_EC_BLOB_TIERS) && USE_EC_BLOB_TIERS == 1)
+    /* epoch hooks are also needed for the prefetch/staging kicks */
+    LL_ATON_RT_SetEpochCallback(_epoch_callback, instance->impl);
+#endif
   }
 
+#if defined(USE_WEIGHT_PREFETCH) && USE_WEIGHT_PREFETCH == 1
+  _wp_setup(instance);
+#endif
+#if defined(USE_LAZY_PARAMS) && USE_LAZY_PARAMS == 1
+  _lz_setup(instance);
+#endif
+
   /* --   LL_ATON_RT_Main(); -- */
 
+  /* duty-cycled clock boost: applied (and settled) before the timing
+     starts, restored as soon as the epoch loop completes */
+  clk_profile_run_enter();
+
   uint32_t tick = port_hal_get_tick();
   g_npu_exec_ctx.cpu_cycles_all = 0;
   port_dwt_reset();
 
+#if defined(USE_PREPROC) && USE_PREPROC == 1
+  /* sensor-side input conditioning, inside the timed window so the
+     end-to-end numbers include it (see npu_set_preproc) */
+  _preproc_run(instance);
+#endif
+
   _prepare_input_buffers(instance);
 
   LL_ATON_RT_Reset_Network(instance->impl);
+  _pin_epoch_blocks(instance);
 
   // Set bus interface keys -- used for encrypted inference only
   LL_Busif_SetKeys ( 0 , 0 , BUSIF_LSB_KEY , BUSIF_MSB_KEY );
@@ -1131,16 +3451,71 @@ int npu_run(struct npu_instance *instance, struct npu_counters *counters)
   LL_Busif_SetKeys ( 1 , 0 , BUSIF_LSB_KEY , BUSIF_MSB_KEY );
   LL_Busif_SetKeys ( 1 , 1 , BUSIF_LSB_KEY , BUSIF_MSB_KEY );
 
+#if defined(USE_EPOCH_WATCHDOG) && USE_EPOCH_WATCHDOG == 1
+  uint32_t wd_tick = port_hal_get_tick();
+  int32_t wd_idx = -1;
+#endif
+
   do {
     /* Execute first/next step of Cube.AI/ATON runtime */
     ll_aton_rt_ret = LL_ATON_RT_RunEpochBlock(instance->impl);
 
+#if defined(USE_EPOCH_WATCHDOG) && USE_EPOCH_WATCHDOG == 1
+    const int32_t cur_idx = (int32_t)__LL_ATON_RT_GetCurrEpochBlockIndex(instance->impl);
+    if (cur_idx != wd_idx) {
+      /* progressed to a new epoch block, re-arm the timeout */
+      wd_idx = cur_idx;
+      wd_tick = port_hal_get_tick();
+    }
+    else if ((ll_aton_rt_ret == LL_ATON_RT_WFE) &&
+             ((port_hal_get_tick() - wd_tick) > EPOCH_WATCHDOG_TIMEOUT_MS)) {
+      /* hung epoch: release the runtime/IP and report the epoch index
+         (the SysTick IRQ wakes the WFE wait at every tick) */
+      LL_ATON_RT_SetEpochCallback((TraceEpochBlock_FuncPtr_t)NULL, instance->impl);
+      g_npu_exec_ctx.user_cb = NULL;
+      LL_ATON_RT_DeInit_Network(instance->impl);
+      _npu_internal_reset();
+      instance->state = 0;  /* force a full re-init before the next run */
+      clk_profile_run_exit();
+      return _notify_complete(instance, -(int)(cur_idx + 2), counters);
+    }
+#endif
+
     /* Wait for next event */
     if (ll_aton_rt_ret == LL_ATON_RT_WFE) {
+      /* attribute the wait to the source(s) the runtime armed for this
+         epoch block: epoch-controller blobs on one side, the stream
+         engines of the wait mask on the other (equal split when the
+         block waits on several engines) */
+      const LL_ATON_RT_EpochBlockItem_t *eb = instance->impl->exec_state.current_epoch_block;
+      const uint32_t stall_t0 = port_dwt_get_cycles();
       LL_ATON_OSAL_WFE();
+      const uint32_t stall = port_dwt_get_cycles() - stall_t0;
+      if (EpochBlock_IsEpochBlob(eb)) {
+        _stall_cycles[NPU_STALL_EPOCHCTRL] += stall;
+      } else {
+        const uint32_t mask = eb->wait_mask & ((1UL << ATON_STRENG_NUM) - 1);
+        int n_set = 0;
+        for (int b = 0; b < ATON_STRENG_NUM; b++)
+          if (mask & (1UL << b))
+            n_set++;
+        for (int b = 0; n_set && (b < ATON_STRENG_NUM); b++)
+          if (mask & (1UL << b))
+            _stall_cycles[b] += stall / (uint32_t)n_set;
+      }
     }
   } while (ll_aton_rt_ret != LL_ATON_RT_DONE);
 
+  clk_profile_run_exit();
+
+  /* pending async NPU-cache cleans (USE_NPU_CACHE_ASYNC) must have landed
+     before the outputs are read from outside the NPU; no-op otherwise */
+  npu_cache_sync();
+
+  /* aggregation mode: deliver a trailing partial batch (without the HW
+     counter block, the dbgtrc counters are torn down with the runtime) */
+  _npu_cb_batch_flush();
+
   _prepare_output_buffers(instance);
 
   g_npu_exec_ctx.cpu_cycles_all += port_dwt_get_cycles();
@@ -1156,7 +3531,7 @@ int npu_run(struct npu_instance *instance, struct npu_counters *counters)
   }
 
   if (ll_aton_rt_ret != LL_ATON_RT_DONE)
-    return -1;
+    return _notify_complete(instance, -1, counters);
 
   if (counters) {
     g_npu_exec_ctx.cpu_cycles_all += g_npu_exec_ctx.cpu_cycles_start;
@@ -1173,7 +3548,423 @@ int npu_run(struct npu_instance *instance, struct npu_counters *counters)
     counters->cpu_core = g_npu_exec_ctx.cpu_cycles_npu;
     counters->cpu_end = g_npu_exec_ctx.cpu_cycles_end;
     counters->extra = g_npu_exec_ctx.npu_cycles_all;
+
+#if USE_COUNTER_NPU_CACHE
+    /* wrap-safe 64-bit totals, cumulated over all the runs since npu_init */
+    uint64_t cache_acc[8];
+    if (npu_cache_counters_acc_get(&cache_acc[0]) == 0) {
+      counters->cache_r_miss = cache_acc[1];
+      counters->cache_w_miss = cache_acc[5];
+    }
+#endif
+  }
+
+  return _notify_complete(instance, (int)tick, counters);
+}
+
+/*
+* Run several inferences concurrently on the single ATON IP, interleaved
+* at epoch-block granularity.
+*
+* At each epoch block boundary the pending instance with the highest
+* priority is resumed, so a short low-latency network (kws) progresses
+* between the epoch blocks of a long-running one (img). The ATON IP lock
+* (__ll_current_aton_ip_owner) is taken/released by the runtime per epoch
+* block, an epoch block in flight (LL_ATON_RT_WFE) cannot be handed over:
+* the scheduler drives it to completion before re-arbitrating. Worst case
+* added latency for the high priority network is therefore one epoch block
+* of the low priority one.
+*
+* All instances must be initialized (npu_init(.., 1)) beforehand. The
+* per-epoch user callback relies on the single execution context
+* (g_npu_exec_ctx) and is not supported in co-scheduled mode.
+*/
+int npu_run_sched(struct npu_sched_task *tasks, int n_tasks)
+{
+  LL_ATON_RT_RetValues_t rt_state[NPU_NETWORK_NUMBER];
+  uint64_t cycles[NPU_NETWORK_NUMBER];
+  uint32_t tick[NPU_NETWORK_NUMBER];
+  int remaining = n_tasks;
+
+  if ((!tasks) || (n_tasks < 1) || (n_tasks > NPU_NETWORK_NUMBER))
+    return -1;
+
+  for (int i = 0; i < n_tasks; i++) {
+    if ((!tasks[i].instance) || (tasks[i].instance->state == 0))
+      return -1;
+    if (tasks[i].counters)
+      memset(tasks[i].counters, 0, sizeof(struct npu_counters));
+    tasks[i].ret = -1;
+  }
+
+  /* prepare and reset every network before the first arbitration */
+  for (int i = 0; i < n_tasks; i++) {
+    _prepare_input_buffers(tasks[i].instance);
+    LL_ATON_RT_Reset_Network(tasks[i].instance->impl);
+    _pin_epoch_blocks(tasks[i].instance);
+    rt_state[i] = LL_ATON_RT_NO_WFE;
+    cycles[i] = 0;
+    tick[i] = port_hal_get_tick();
+  }
+
+  // Set bus interface keys -- used for encrypted inference only
+  LL_Busif_SetKeys ( 0 , 0 , BUSIF_LSB_KEY , BUSIF_MSB_KEY );
+  LL_Busif_SetKeys ( 0 , 1 , BUSIF_LSB_KEY , BUSIF_MSB_KEY );
+  LL_Busif_SetKeys ( 1 , 0 , BUSIF_LSB_KEY , BUSIF_MSB_KEY );
+  LL_Busif_SetKeys ( 1 , 1 , BUSIF_LSB_KEY , BUSIF_MSB_KEY );
+
+  while (remaining) {
+    /* pick the highest priority instance not yet completed */
+    int cur = -1;
+    for (int i = 0; i < n_tasks; i++) {
+      if (rt_state[i] == LL_ATON_RT_DONE)
+        continue;
+      if ((cur < 0) || (tasks[i].priority > tasks[cur].priority))
+        cur = i;
+    }
+
+    /* drive it up to the next epoch block boundary, an in-flight epoch
+       block may not be preempted (see LL_ATON_RT_RunEpochBlock) */
+    do {
+      port_dwt_reset();
+      rt_state[cur] = LL_ATON_RT_RunEpochBlock(tasks[cur].instance->impl);
+      cycles[cur] += port_dwt_get_cycles();
+
+      if (rt_state[cur] == LL_ATON_RT_WFE)
+        LL_ATON_OSAL_WFE();
+    } while (rt_state[cur] == LL_ATON_RT_WFE);
+
+    if (rt_state[cur] == LL_ATON_RT_DONE) {
+      _prepare_output_buffers(tasks[cur].instance);
+      tick[cur] = port_hal_get_tick() - tick[cur];
+
+      if (tasks[cur].counters)
+        tasks[cur].counters->cpu_all = cycles[cur];
+
+      tasks[cur].ret = (int)tick[cur];
+      _notify_complete(tasks[cur].instance, tasks[cur].ret, tasks[cur].counters);
+      remaining--;
+    }
+  }
+
+  return 0;
+}
+
+/*
+* Run several inferences following a statically scheduled interleave plan
+* computed offline (scripts/epoch_controller/prepare_interleave_plan.py).
+*
+* 'plan' holds one task index per epoch-block slot; each slot advances the
+* named task by one epoch block. Since the slot order is fixed at build
+* time from profile data, the co-execution latency is deterministic, which
+* the runtime priority arbitration of npu_run_sched() cannot guarantee.
+* The plan degrades instead of failing when it does not match the deployed
+* networks: slots naming an out-of-range or already completed task are
+* skipped, and once the plan is exhausted the remaining epoch blocks are
+* drained in task declaration order. A NULL/empty plan therefore runs the
+* tasks sequentially.
+*
+* Same restrictions as npu_run_sched(): all instances initialized, no
+* per-epoch user callback in co-scheduled mode.
+*/
+int npu_run_plan(struct npu_sched_task *tasks, int n_tasks,
+                 const uint8_t *plan, uint32_t plan_len)
+{
+  LL_ATON_RT_RetValues_t rt_state[NPU_NETWORK_NUMBER];
+  uint64_t cycles[NPU_NETWORK_NUMBER];
+  uint32_t tick[NPU_NETWORK_NUMBER];
+  uint32_t slot = 0;
+  int remaining = n_tasks;
+
+  if ((!tasks) || (n_tasks < 1) || (n_tasks > NPU_NETWORK_NUMBER))
+    return -1;
+  if ((!plan) && (plan_len != 0))
+    return -1;
+
+  for (int i = 0; i < n_tasks; i++) {
+    if ((!tasks[i].instance) || (tasks[i].instance->state == 0))
+      return -1;
+    if (tasks[i].counters)
+      memset(tasks[i].counters, 0, sizeof(struct npu_counters));
+    tasks[i].ret = -1;
+  }
+
+  /* prepare and reset every network before the first slot */
+  for (int i = 0; i < n_tasks; i++) {
+    _prepare_input_buffers(tasks[i].instance);
+    LL_ATON_RT_Reset_Network(tasks[i].instance->impl);
+    _pin_epoch_blocks(tasks[i].instance);
+    rt_state[i] = LL_ATON_RT_NO_WFE;
+    cycles[i] = 0;
+    tick[i] = port_hal_get_tick();
+  }
+
+  // Set bus interface keys -- used for encrypted inference only
+  LL_Busif_SetKeys ( 0 , 0 , BUSIF_LSB_KEY , BUSIF_MSB_KEY );
+  LL_Busif_SetKeys ( 0 , 1 , BUSIF_LSB_KEY , BUSIF_MSB_KEY );
+  LL_Busif_SetKeys ( 1 , 0 , BUSIF_LSB_KEY , BUSIF_MSB_KEY );
+  LL_Busif_SetKeys ( 1 , 1 , BUSIF_LSB_KEY , BUSIF_MSB_KEY );
+
+  while (remaining) {
+    /* take the next usable slot of the plan */
+    int cur = -1;
+    while ((slot < plan_len) && (cur < 0)) {
+      uint8_t idx = plan[slot++];
+      if ((idx < n_tasks) && (rt_state[idx] != LL_ATON_RT_DONE))
+        cur = (int)idx;
+    }
+
+    /* plan exhausted: drain what is left in task declaration order */
+    if (cur < 0) {
+      for (int i = 0; i < n_tasks; i++) {
+        if (rt_state[i] != LL_ATON_RT_DONE) {
+          cur = i;
+          break;
+        }
+      }
+    }
+
+    /* drive it up to the next epoch block boundary, an in-flight epoch
+       block may not be preempted (see LL_ATON_RT_RunEpochBlock) */
+    do {
+      port_dwt_reset();
+      rt_state[cur] = LL_ATON_RT_RunEpochBlock(tasks[cur].instance->impl);
+      cycles[cur] += port_dwt_get_cycles();
+
+      if (rt_state[cur] == LL_ATON_RT_WFE)
+        LL_ATON_OSAL_WFE();
+    } while (rt_state[cur] == LL_ATON_RT_WFE);
+
+    if (rt_state[cur] == LL_ATON_RT_DONE) {
+      _prepare_output_buffers(tasks[cur].instance);
+      tick[cur] = port_hal_get_tick() - tick[cur];
+
+      if (tasks[cur].counters)
+        tasks[cur].counters->cpu_all = cycles[cur];
+
+      tasks[cur].ret = (int)tick[cur];
+      _notify_complete(tasks[cur].instance, tasks[cur].ret, tasks[cur].counters);
+      remaining--;
+    }
+  }
+
+  return 0;
+}
+
+/*
+* Asynchronous inference queue
+*
+* npu_submit() enqueues an inference request, npu_poll() makes it progress
+* by one epoch block step and must be called from the application main loop
+* (bare metal, no RTOS: the "background" execution is the HW epoch running
+* while the CPU is back in the caller, typically draining the COM link).
+* On completion npu_poll() invokes the registered completion callback.
+*/
+
+struct _npu_queue_entry {
+  struct npu_instance *instance;
+  struct npu_counters *counters;
+  npu_done_cb done_cb;
+  void *cookie;
+};
+
+static struct _npu_queue_entry _npu_queue[NPU_QUEUE_DEPTH];
+static int _npu_queue_head;
+static int _npu_queue_count;
+static bool _npu_active;              /* head entry is started */
+static uint64_t _npu_active_cycles;
+static uint32_t _npu_active_tick;
+
+/*
+* Queue an inference request.
+*
+*  'counters'   optional (may be NULL), filled on completion.
+*  'done_cb'    optional (may be NULL), called from npu_poll() context.
+*
+*  Returns 0 or -1 (invalid instance or queue full).
+*/
+bool npu_is_active(void)
+{
+  return (_npu_queue_count != 0);
+}
+
+int npu_submit(struct npu_instance *instance, struct npu_counters *counters,
+               npu_done_cb done_cb, void *cookie)
+{
+  if ((!instance) || (instance->state == 0))
+    return -1;
+
+  if (_npu_queue_count >= NPU_QUEUE_DEPTH)
+    return -1;
+
+  struct _npu_queue_entry *entry =
+      &_npu_queue[(_npu_queue_head + _npu_queue_count) % NPU_QUEUE_DEPTH];
+
+  entry->instance = instance;
+  entry->counters = counters;
+  entry->done_cb = done_cb;
+  entry->cookie = cookie;
+  _npu_queue_count++;
+  if ((uint32_t)_npu_queue_count > _util_queue_peak)
+    _util_queue_peak = (uint32_t)_npu_queue_count;
+
+  return 0;
+}
+
+/*
+* Make the queued inferences progress (non-blocking).
+*
+* Executes at most one epoch block step of the request at the head of the
+* queue; a step returning LL_ATON_RT_WFE leaves the HW epoch in flight and
+* returns immediately, the caller regains the CPU.
+*
+*  Returns the number of requests still queued/in-flight (0 = idle).
+*/
+int npu_poll(void)
+{
+  LL_ATON_RT_RetValues_t ll_aton_rt_ret;
+
+  if (_npu_queue_count == 0)
+    return 0;
+
+  struct _npu_queue_entry *entry = &_npu_queue[_npu_queue_head];
+
+  if (!_npu_active) {
+    /* start the head request */
+    if (entry->counters)
+      memset(entry->counters, 0, sizeof(struct npu_counters));
+
+    _prepare_input_buffers(entry->instance);
+    LL_ATON_RT_Reset_Network(entry->instance->impl);
+    _pin_epoch_blocks(entry->instance);
+
+    // Set bus interface keys -- used for encrypted inference only
+    LL_Busif_SetKeys ( 0 , 0 , BUSIF_LSB_KEY , BUSIF_MSB_KEY );
+    LL_Busif_SetKeys ( 0 , 1 , BUSIF_LSB_KEY , BUSIF_MSB_KEY );
+    LL_Busif_SetKeys ( 1 , 0 , BUSIF_LSB_KEY , BUSIF_MSB_KEY );
+    LL_Busif_SetKeys ( 1 , 1 , BUSIF_LSB_KEY , BUSIF_MSB_KEY );
+
+    _npu_active_cycles = 0;
+    _npu_active_tick = port_hal_get_tick();
+    _npu_active = true;
   }
 
-  return tick;
+  port_dwt_reset();
+  ll_aton_rt_ret = LL_ATON_RT_RunEpochBlock(entry->instance->impl);
+  _npu_active_cycles += port_dwt_get_cycles();
+
+  /* any step that does not leave a HW epoch in flight (LL_ATON_RT_WFE)
+     ended at an epoch block boundary: serve the window there too, the
+     epoch callback is not installed on the queued path */
+  if ((ll_aton_rt_ret != LL_ATON_RT_WFE) && (_npu_epoch_service != NULL))
+    _npu_epoch_service();
+
+  if (ll_aton_rt_ret == LL_ATON_RT_DONE) {
+    _prepare_output_buffers(entry->instance);
+
+    const int ret = (int)(port_hal_get_tick() - _npu_active_tick);
+
+    if (entry->counters)
+      entry->counters->cpu_all = _npu_active_cycles;
+
+    _npu_active = false;
+    _npu_queue_head = (_npu_queue_head + 1) % NPU_QUEUE_DEPTH;
+    _npu_queue_count--;
+
+    _notify_complete(entry->instance, ret, entry->counters);
+
+    if (entry->done_cb)
+      entry->done_cb(entry->instance, ret, entry->cookie);
+  }
+
+  return _npu_queue_count;
+}
+
+/*
+* Epoch-boundary suspend/resume of the in-flight inference.
+*
+* npu_poll() only ever leaves the runtime at an epoch block boundary, where
+* the ATON IP ownership (__ll_current_aton_ip_owner) has been released by
+* the runtime and the whole execution position lives in the exec_state of
+* the network's own NN instance. Suspending is therefore just parking the
+* active queue entry: the instance is NOT reset, the next npu_poll() steps
+* whatever request is then at the head of the queue.
+*
+* Typical use - a latency-critical kws request arriving while img runs:
+*
+*   npu_suspend();                     (park img at the next boundary)
+*   npu_submit(&kws, ...);
+*   npu_wait_all();                    (kws runs on the now-free IP)
+*   npu_resume();                      (img continues where it stopped)
+*
+* Worst case added latency for the preempting network is one epoch block
+* of the suspended one, as an epoch block in flight (LL_ATON_RT_WFE) is
+* driven to its boundary before npu_poll() returns.
+*
+* One park slot: a second npu_suspend() before npu_resume() fails. The
+* preempting run must not touch the suspended network instance (no
+* npu_init(.., 0)/re-init of it) while it is parked.
+*/
+static struct _npu_queue_entry _npu_parked;
+static bool _npu_parked_valid;
+static uint64_t _npu_parked_cycles;
+static uint32_t _npu_parked_elapsed;  /* ms spent before the suspend */
+
+/*
+* Park the active (started) head request at the current epoch boundary.
+*
+*  Returns 0 or -1 (nothing active, or the park slot is busy).
+*/
+int npu_suspend(void)
+{
+  if ((!_npu_active) || (_npu_parked_valid))
+    return -1;
+
+  _npu_parked = _npu_queue[_npu_queue_head];
+  _npu_parked_cycles = _npu_active_cycles;
+  _npu_parked_elapsed = port_hal_get_tick() - _npu_active_tick;
+  _npu_parked_valid = true;
+
+  _npu_active = false;
+  _npu_queue_head = (_npu_queue_head + 1) % NPU_QUEUE_DEPTH;
+  _npu_queue_count--;
+
+  return 0;
+}
+
+/*
+* Put the parked request back at the head of the queue and re-arm it, the
+* next npu_poll() continues from the parked exec_state (no network reset).
+*
+*  Returns 0 or -1 (nothing parked, or the queue is full).
+*/
+int npu_resume(void)
+{
+  if ((!_npu_parked_valid) || (_npu_queue_count >= NPU_QUEUE_DEPTH))
+    return -1;
+
+  _npu_queue_head = (_npu_queue_head + NPU_QUEUE_DEPTH - 1) % NPU_QUEUE_DEPTH;
+  _npu_queue[_npu_queue_head] = _npu_parked;
+  _npu_queue_count++;
+
+  _npu_active_cycles = _npu_parked_cycles;
+  _npu_active_tick = port_hal_get_tick() - _npu_parked_elapsed;
+  _npu_active = true;
+  _npu_parked_valid = false;
+
+  return 0;
+}
+
+/*
+* Drain the queue (blocking helper).
+*/
+int npu_wait_all(void)
+{
+  int pending;
+
+  do {
+    pending = npu_poll();
+  } while (pending > 0);
+
+  return pending;
 }
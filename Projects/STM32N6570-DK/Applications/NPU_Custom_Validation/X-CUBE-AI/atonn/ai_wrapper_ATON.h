@@ -41,8 +41,10 @@
 #define USE_NPU_CACHE
 #define USE_NPU_COUNTERS                1
 
-// [수정] AI 모델 개수 정의
+// [수정] AI 모델 개수 정의 (NPU_NETWORK_LIST와 함께 app_config.h에서 재정의 가능)
+#ifndef NPU_NETWORK_NUMBER
 #define NPU_NETWORK_NUMBER      (2)   /* number of embedded model */
+#endif
 
 
 #define NPU_MAX_IO_BUFFER       (32)
@@ -57,6 +59,24 @@
 #define COUNTER_OPT_STRG_I_ACTIVE       (1 << 5)
 #define COUNTER_OPT_STRG_O_ACTIVE       (1 << 6)
 
+/* COUNTER preset profiles: a preset id in this field of the run option
+ * expands to a ready-made combination of the counter options above
+ * (see npu_counter_preset_expand), so the host selects an event set by
+ * name per run instead of assembling the mux bits - and without a
+ * rebuild between event sets.
+ *   BANDWIDTH : bus-interface R/W data volume and burst lengths per port
+ *   STALL     : per-stream-engine HENV wait cycles + epoch length
+ *   ACTIVITY  : per-stream-engine active cycles (epoch masks) + epoch length
+ *   CACHE     : NPU cache monitors + epoch length
+ */
+#define COUNTER_PRESET_POS              (8)
+#define COUNTER_PRESET_MSK              (0x7)
+#define COUNTER_PRESET_NONE             (0)   /* raw counter option bits */
+#define COUNTER_PRESET_BANDWIDTH        (1)
+#define COUNTER_PRESET_STALL            (2)
+#define COUNTER_PRESET_ACTIVITY         (3)
+#define COUNTER_PRESET_CACHE            (4)
+
 /* COUNTER format/status */
 #define COUNTER_FMT_OPT_SHIFT           (8)
 #define COUNTER_FMT_NUMBER(_fmt_)       ((_fmt_) & 0xFF)
@@ -83,6 +103,8 @@ struct npu_counters {
   uint64_t cpu_end;                     /* Cumulated MCU cycles to finalize the epoch blocks */
   uint64_t cpu_all;                     /* Cumulated MCU cycles (out-of-the box) */
   uint64_t extra;                       /* extra */
+  uint64_t cache_r_miss;                /* NPU cache read misses since npu_init (64-bit SW accumulation) */
+  uint64_t cache_w_miss;                /* NPU cache write misses since npu_init (64-bit SW accumulation) */
 };
 
 #define NPU_MODEL_INFO_FLAGS_RELOC         (1 << 0)    /* RELOCATABLE model */
@@ -115,13 +137,67 @@ typedef void (*npu_user_cb)(const LL_ATON_RT_Callbacktype_t ctype,
                             const LL_ATON_RT_EpochBlockItem_t *epoch_block,
                             struct npu_epoch_counters *counters);
 
+struct npu_instance;
+
+/* completion cb - called once per inference when the run finishes, with the
+   per-request context pointer and the final counters snapshot. 'ret' is the
+   inference time in ms (<0 on error); 'counters' is valid for the duration
+   of the call only when the caller passed no counters of its own. */
+typedef void (*npu_complete_cb)(struct npu_instance *instance, int ret,
+                                const struct npu_counters *counters,
+                                void *cookie);
+
+/* Input preprocessing stage (USE_PREPROC): production feeds come from a
+   sensor, not from the protobuf link, and the mandatory input conditioning
+   (crop, normalize, layout conversion) belongs in the end-to-end numbers.
+   The stage registered on an instance runs at the top of npu_run, inside
+   the timed window, and its cycles are accounted with the epoch
+   instrumentation: they join the PRE tier (cpu_start) and therefore
+   cpu_all. 'dst' is the first input buffer of the instance. A 0-size crop
+   window means the full frame; out = (in - offset) * scale. */
+struct npu_preproc_desc {
+  const void *src;                      /* sensor-format source frame */
+  uint16_t src_w;                       /* source geometry, pixels */
+  uint16_t src_h;
+  uint16_t src_c;                       /* interleaved channels (0: 1) */
+  uint16_t crop_x;                      /* crop window origin */
+  uint16_t crop_y;
+  uint16_t crop_w;                      /* crop window size (0: full frame) */
+  uint16_t crop_h;
+  float scale;                          /* normalization */
+  float offset;
+  uint8_t to_chw;                       /* deinterleave HWC -> CHW planes */
+};
+
+/* stage kernel - returns the number of bytes produced, <0 on error */
+typedef int (*npu_preproc_fn)(const struct npu_preproc_desc *desc,
+                              void *dst, uint32_t dst_size);
+
+int npu_set_preproc(struct npu_instance *instance, npu_preproc_fn fn,
+                    const struct npu_preproc_desc *desc);
+
+/* CPU cycles spent in the stage during the last npu_run (0: no stage) */
+uint32_t npu_preproc_cycles(void);
+
+/* built-in kernels, MVE-accelerated on the interleaved path: u8 camera
+   frame to float32 / int8 model input */
+int npu_preproc_u8_to_f32(const struct npu_preproc_desc *desc,
+                          void *dst, uint32_t dst_size);
+int npu_preproc_u8_to_s8(const struct npu_preproc_desc *desc,
+                         void *dst, uint32_t dst_size);
+
 /* model instance */
 struct npu_instance {
   uint32_t state;
   struct npu_model_info info;
   NN_Instance_TypeDef *impl;
   npu_user_cb user_cb;
+  npu_complete_cb complete_cb;          /* optional completion notification */
+  void *complete_cookie;                /* per-request context for complete_cb */
+  npu_preproc_fn preproc_fn;            /* optional input preprocessing stage */
+  const struct npu_preproc_desc *preproc_desc;
   uint32_t option;
+  uint32_t cb_batch;                    /* epoch cb aggregation factor, <=1: per-epoch */
   uint32_t install_cycles;
   uint32_t init_cycles;
 };
@@ -147,16 +223,183 @@ struct _shape_desc {
  * Wrapper entry points
  */
 
+/* npu_init 'mode' argument: b7..b0 command (0: reset, 1: init, 2: cache reset),
+   b15..b8 epoch callback aggregation factor (0: keep current setting,
+   1: per-epoch callbacks, N>1: one batched notification every N epoch blocks
+   with accumulated counters) */
+#define NPU_INIT_MODE(_m_)              ((_m_) & 0xFF)
+#define NPU_INIT_CB_BATCH(_m_)          (((_m_) >> 8) & 0xFF)
+#define NPU_INIT_SET_CB_BATCH(_n_)      (((uint32_t)(_n_) & 0xFF) << 8)
+
 int npu_get_instance_by_index(int idx, struct npu_instance *instance);
 int npu_init(struct npu_instance *instance, uint32_t mode);
 int npu_set_callback(struct npu_instance *instance, npu_user_cb user_cb);
+int npu_set_complete_callback(struct npu_instance *instance,
+                              npu_complete_cb complete_cb, void *cookie);
+void npu_mark_memory_dirty(void);
+
+/* Expand the COUNTER_PRESET field of a run option into the matching
+   COUNTER_OPT bits (identity when the field is COUNTER_PRESET_NONE) */
+uint32_t npu_counter_preset_expand(uint32_t option);
 
 int npu_run(struct npu_instance *instance, struct npu_counters *counters);
+int npu_fuse_epoch_blocks(struct npu_instance *instance);
+
+/* Wraps the memoizable pure-SW epoch blocks with a capture/verify/restore
+   trampoline (opt-in, see USE_EPOCH_MEMO). Returns the number of wrapped
+   candidates, or -1 when no mutable descriptor copy is available. */
+int npu_memo_epoch_blocks(struct npu_instance *instance);
+
+/* Re-points the blob epoch blocks of an instance at the matching entries of
+   the Epoch Controller blob partition in the mapped external flash (opt-in,
+   see USE_EC_FLASH_PARTITION / EC_PARTITION_BASE). Returns the number of
+   re-pointed blobs (0 when no partition is flashed), or -1 when no mutable
+   descriptor copy is available. */
+int npu_connect_ec_partition(struct npu_instance *instance);
+
+/* Tiers the partition-resident EC blobs of an instance by profiled epoch
+   cost (opt-in, see USE_EC_BLOB_TIERS): the hottest blobs are copied into
+   a resident fast pool, cold ones stay in the mapped flash and are staged
+   on demand through a small rotating buffer at their PRE_START hook.
+   'epoch_cycles' maps an epoch number to its profiled cycle cost
+   (n_epochs entries, unknown epochs rank coldest). Returns the number of
+   blobs pinned resident, or -1 when no mutable descriptor copy is
+   available. To be called after npu_connect_ec_partition and a profiled
+   run; a new call replaces the previous layout. */
+int npu_ec_tier_blobs(struct npu_instance *instance,
+                      const uint32_t *epoch_cycles, uint32_t n_epochs);
+
+/* Inter-epoch overlap analyzer (USE_OVERLAP_ANALYZER): scans the epoch
+   block list for consecutive pure-HW blocks where the earlier block's
+   terminal wait covers stream engines the next block does not reuse -
+   i.e. a serialization the fabric could overlap. Each finding is one
+   pair (epoch numbers plus the deferrable wait bits); the table is the
+   compiler-feedback report. npu_overlap_analyze() returns the number of
+   pairs found (may exceed the recorded NPU_OVERLAP_MAX_PAIRS), or -1
+   when the engine usage masks are unavailable (LL_ATON_EB_DBG_INFO) or,
+   with rewrite != 0, when there is no mutable descriptor copy. The
+   rewrite defers the flagged wait bits into the next block's mask on the
+   DTCM copy; the masks cannot see sharing below the stream engines
+   (fixed-function units, bus ports), so it is opt-in per model after
+   counter review. */
+#define NPU_OVERLAP_MAX_PAIRS  (32)
+
+struct npu_overlap_pair {
+  int16_t epoch_num;                    /* earlier (waiting) epoch */
+  int16_t next_epoch_num;               /* next engine user in the schedule */
+  uint32_t deferrable_mask;             /* wait bits not reused by the next epoch */
+};
+
+int npu_overlap_analyze(struct npu_instance *instance, int rewrite);
+int npu_overlap_get_report(const struct npu_overlap_pair **pairs);
+
+/* NPU stall-cause breakdown of the last npu_run(): CPU cycles spent in the
+   WFE wait per wait source. Slots 0..5 are the stream engines (equal split
+   when an epoch waits on several), the last slot the epoch-controller
+   blobs. The completion of the fixed-function units (conv accel, ...) is
+   signalled through their output stream engine, so that is the finest
+   cause granularity observable at runtime. */
+#define NPU_STALL_SLOTS      (7)
+#define NPU_STALL_EPOCHCTRL  (NPU_STALL_SLOTS - 1)
+
+const uint64_t *npu_get_stall_cycles(void);
+
+/* ATON utilization gauge for capacity planning: wall time with an epoch
+   block in flight vs. the idle gaps, in us, plus the completed inference
+   count and the submit queue depth high-water mark since the last reset.
+   utilization = busy_us / (busy_us + idle_us). */
+struct npu_util_gauge {
+  uint64_t busy_us;                     /* epoch block in flight */
+  uint64_t idle_us;                     /* gaps inside and between runs */
+  uint32_t runs;                        /* completed inferences */
+  uint32_t queue_peak;                  /* submit queue high-water mark */
+};
+
+int npu_util_get(struct npu_util_gauge *gauge, int reset);
+
+/* A/B model banks (USE_RELOC_AB_BANKS): install the pending relocatable
+   binary in the inactive bank while the active one keeps running, then
+   publish it with an atomic pointer switch. -1 when not supported. */
+int npu_reloc_prepare_next(void);
+int npu_reloc_switchover(struct npu_instance *instance);
+
+/* Activations pool placement (USE_ACTS_PLACEMENT): re-install the model
+   with the acts/ext pool in the fast on-chip window ('fast_bank'=1) or
+   back in the external PSRAM default ('fast_bank'=0). -1 when not
+   supported or the pool does not fit, -2 when the re-install fails. */
+int npu_reloc_place_acts(struct npu_instance *instance, int fast_bank);
+
+/* co-scheduler task - one entry per network instance to interleave */
+struct npu_sched_task {
+  struct npu_instance *instance;        /* initialized instance (state==1) */
+  uint32_t priority;                    /* higher value is resumed first */
+  struct npu_counters *counters;        /* optional, may be NULL */
+  int ret;                              /* out: inference time in ms, <0 on error */
+};
+
+int npu_run_sched(struct npu_sched_task *tasks, int n_tasks);
+
+/* Statically scheduled variant of npu_run_sched(): follows an offline
+   computed interleave plan (one task index per epoch-block slot, see
+   scripts/epoch_controller/prepare_interleave_plan.py) for deterministic
+   co-execution latency. Unusable slots are skipped and the tasks are
+   drained in declaration order once the plan is exhausted. */
+int npu_run_plan(struct npu_sched_task *tasks, int n_tasks,
+                 const uint8_t *plan, uint32_t plan_len);
+
+/* asynchronous inference queue - submit/poll API on top of the epoch
+   block machinery, see npu_submit()/npu_poll() */
+#define NPU_QUEUE_DEPTH         (4)
+
+/* completion callback - called from npu_poll() context when a submitted
+   inference completes, 'ret' is the inference time in ms (<0 on error) */
+typedef void (*npu_done_cb)(struct npu_instance *instance, int ret, void *cookie);
+
+int npu_submit(struct npu_instance *instance, struct npu_counters *counters,
+               npu_done_cb done_cb, void *cookie);
+int npu_poll(void);
+int npu_wait_all(void);
+
+/* Epoch-boundary suspend/resume of the in-flight queued inference: the
+   suspended network parks its exec_state in its own NN instance and the
+   ATON IP is free between epoch blocks, so a latency-critical request can
+   be submitted and drained before npu_resume() continues the parked run.
+   Worst case preemption latency is one epoch block. */
+int npu_suspend(void);
+int npu_resume(void);
+
+/* Epoch-boundary window service: the registered hook is invoked at epoch
+   block boundaries - from the epoch callback (POST_END) and from the
+   npu_poll() steps that do not leave a HW epoch in flight - i.e. at
+   moments where the stream engines are quiescent. Host-side services use
+   it to touch activation memory without racing the NPU (see the batched
+   read window in aiPbMemRWServices.c). NULL disables. */
+typedef void (*npu_epoch_service_t)(void);
+void npu_set_epoch_service(npu_epoch_service_t service);
+
+/* true while queued inferences are pending/in flight (npu_submit path) -
+   the only situation where the command loop runs concurrently with the
+   NPU, the blocking npu_run variants never return the CPU mid-run */
+bool npu_is_active(void);
 
 const LL_Buffer_InfoTypeDef* npu_get_input_buffers_info(const struct npu_instance *instance, int32_t num);
 const LL_Buffer_InfoTypeDef* npu_get_output_buffers_info(const struct npu_instance *instance, int32_t num);
 const LL_Buffer_InfoTypeDef* npu_get_internal_buffers_info(const struct npu_instance *instance);
 
+/* Connects the user-allocated IO buffers of an instance to the shared IO
+   arena (opt-in, see NPU_IO_ARENA_SIZE). No-op for pool-allocated models. */
+int npu_connect_io_arena(struct npu_instance *instance);
+
+/* Registers the parameter windows of an instance as pinned in the NPU
+   cache (opt-in, see USE_NPU_CACHE_PIN). Returns the number of pinned
+   windows, 0 when the weight set does not qualify. */
+int npu_pin_weights(struct npu_instance *instance);
+
+/* Flips the double-buffered outputs (opt-in, see USE_PINGPONG_OUTPUTS) and
+   returns a stable snapshot of the just-written descriptors to drain from,
+   NULL when ping-pong is not active for this instance. */
+const LL_Buffer_InfoTypeDef *npu_flip_output_buffers(struct npu_instance *instance);
+
 
 
 #endif /* __AI_NPU_WRAPPER_H__ */
@@ -0,0 +1,39 @@
+#
+# Makefile additions for N6-DK, benchmark reference configuration
+#
+# Minimal-perturbation build whose numbers can be quoted as the reference
+# for this silicon: UART-only transport (no USBX tasks, CDC threads or
+# their tick interrupts), asserts and the dump/debug API compiled out, the
+# per-epoch-block debug info stripped from the descriptors, the MVE SW
+# kernels (with their per-node dispatch memo) compiled in and the epoch
+# watchdog re-arm removed from the run loop. The IRQ/WFE epoch wait
+# (LL_ATON_RT_USE_IRQ_OR_MASK) is already set in the main Makefile.
+#
+C_DEFS += -DUSE_STM32N6570_DK
+
+# N6-DK build conf handles CR5 boards
+C_DEFS += -DSTM32N6570_DK_REV=STM32N6570_DK_C01
+
+# Board-specific includes/sources (BSP + memories management)
+C_INCLUDES += -I$(BSP_PATH)/Components/mx66uw1g45g
+C_INCLUDES += -I$(BSP_PATH)/Components/aps256xx
+C_INCLUDES += -I$(BSP_PATH)/STM32N6xx_DK
+C_INCLUDES += -I$(DK_DRIVER_PATH)
+
+DRIVER_SOURCES += $(DK_DRIVER_PATH)/stm32n6570_discovery.c
+DRIVER_SOURCES += $(DK_DRIVER_PATH)/stm32n6570_discovery_xspi.c
+DRIVER_SOURCES += $(DK_DRIVER_PATH)/stm32n6570_discovery_bus.c
+DRIVER_SOURCES += $(BSP_PATH)/Components/aps256xx/aps256xx.c
+DRIVER_SOURCES += $(BSP_PATH)/Components/mx66uw1g45g/mx66uw1g45g.c
+
+### Bench-specific
+# speed over size, asserts and debug hooks compiled out
+OPT = -O2 -g3
+C_DEFS := $(filter-out -DUSE_FULL_ASSERT -DLL_ATON_DUMP_DEBUG_API -DLL_ATON_EB_DBG_INFO,$(C_DEFS))
+C_DEFS += -DNDEBUG
+# Helium SW fallback kernels + per-node dispatch memo
+C_DEFS += -DLL_ATON_SW_USE_MVE=1
+# no tick-based re-arm in the epoch loop, no sampling/trace interrupts
+C_DEFS += -DUSE_EPOCH_WATCHDOG=0
+C_DEFS += -DUSE_PC_SAMPLING=0
+C_DEFS += -DUSE_ITM_TRACE=0
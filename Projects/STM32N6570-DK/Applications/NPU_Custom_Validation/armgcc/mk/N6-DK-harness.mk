@@ -0,0 +1,43 @@
+#
+# Makefile additions for N6-DK, CI benchmark harness configuration
+#
+# The N6-DK-bench reference build with main() rerouted into the scripted
+# benchmark harness (aiBenchHarness_ATON.c): the steps generated into
+# bench_plan.h (make variable BENCH_PLAN, see gen_bench_plan.py) run at
+# boot on synthesized inputs and a single machine-readable b:-line report
+# goes out over the UART. Flash it, power it, read a serial port - the
+# push-button CI entry point, no host tooling in the measured path.
+#
+C_DEFS += -DUSE_STM32N6570_DK
+
+# N6-DK build conf handles CR5 boards
+C_DEFS += -DSTM32N6570_DK_REV=STM32N6570_DK_C01
+
+# Board-specific includes/sources (BSP + memories management)
+C_INCLUDES += -I$(BSP_PATH)/Components/mx66uw1g45g
+C_INCLUDES += -I$(BSP_PATH)/Components/aps256xx
+C_INCLUDES += -I$(BSP_PATH)/STM32N6xx_DK
+C_INCLUDES += -I$(DK_DRIVER_PATH)
+
+DRIVER_SOURCES += $(DK_DRIVER_PATH)/stm32n6570_discovery.c
+DRIVER_SOURCES += $(DK_DRIVER_PATH)/stm32n6570_discovery_xspi.c
+DRIVER_SOURCES += $(DK_DRIVER_PATH)/stm32n6570_discovery_bus.c
+DRIVER_SOURCES += $(BSP_PATH)/Components/aps256xx/aps256xx.c
+DRIVER_SOURCES += $(BSP_PATH)/Components/mx66uw1g45g/mx66uw1g45g.c
+
+### Bench-reference settings (keep in sync with mk/N6-DK-bench.mk so the
+### harness numbers stay comparable with the hosted reference build)
+# speed over size, asserts and debug hooks compiled out
+OPT = -O2 -g3
+C_DEFS := $(filter-out -DUSE_FULL_ASSERT -DLL_ATON_DUMP_DEBUG_API -DLL_ATON_EB_DBG_INFO,$(C_DEFS))
+C_DEFS += -DNDEBUG
+# Helium SW fallback kernels + per-node dispatch memo
+C_DEFS += -DLL_ATON_SW_USE_MVE=1
+# no tick-based re-arm in the epoch loop, no sampling/trace interrupts
+C_DEFS += -DUSE_EPOCH_WATCHDOG=0
+C_DEFS += -DUSE_PC_SAMPLING=0
+C_DEFS += -DUSE_ITM_TRACE=0
+
+### Harness-specific
+C_DEFS += -DUSE_BENCH_HARNESS=1
+ATONN_SOURCES += $(ATONN_PATH)/aiBenchHarness_ATON.c
@@ -60,6 +60,22 @@ Reset_Handler:
   msr   MSPLIM, r0
   ldr   r0, =_estack
   mov   sp, r0          /* set stack pointer */
+
+/* Paint the reserved MSP stack for the high-watermark scan (the stack is
+   still empty here, see aiPbCmdStackStat) */
+  ldr r0, =_sstack
+  ldr r1, =_estack
+  ldr r2, =0xDEDEDEDE
+  b LoopFillStack
+
+FillStack:
+  str r2, [r0]
+  adds r0, r0, #4
+
+LoopFillStack:
+  cmp r0, r1
+  bcc FillStack
+
 /* Call the clock system initialization function.*/
   bl  SystemInit
 
@@ -80,6 +96,23 @@ LoopCopyDataInit:
   cmp r4, r1
   bcc CopyDataInit
 
+/* Copy the dtcm data segment initializers to DTCM */
+  ldr r0, =_sdtcm
+  ldr r1, =_edtcm
+  ldr r2, =_sidtcm
+  movs r3, #0
+  b LoopCopyDtcmInit
+
+CopyDtcmInit:
+  ldr r4, [r2, r3]
+  str r4, [r0, r3]
+  adds r3, r3, #4
+
+LoopCopyDtcmInit:
+  adds r4, r0, r3
+  cmp r4, r1
+  bcc CopyDtcmInit
+
 /* Zero fill the bss segment. */
   ldr r2, =_sbss
   ldr r4, =_ebss
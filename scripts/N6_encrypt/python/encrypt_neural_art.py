@@ -1,5 +1,6 @@
 import argparse
 from pb_outputs import message_pb2 as pbproto
+import hashlib
 import json
 import logging
 import time
@@ -87,6 +88,31 @@ class CInfoReader:
         self.output_file.write_bytes(c)
         logger.info(f"Encrypted data injected into {self.output_file.name}")
 
+    def write_segment_manifest(self, segment_size: int):
+        """Describe the encrypted region as independently decryptable units.
+
+        The cipher keystream only depends on the keys and on the final (flash)
+        address of each 8-byte group, so any aligned sub-range of the image can
+        be decrypted on its own: the manifest fixes the granularity the loaders
+        (e.g. the lazy per-epoch staging of the validation firmware) are allowed
+        to rely on, instead of treating the container as one monolithic unit.
+        """
+        if segment_size % 8 != 0:
+            raise ValueError(f"Segment size must be a multiple of 8 bytes (got {segment_size})")
+        total = self.mem_initializer_encryption_len
+        segments = [
+            {"offset": off, "size": min(segment_size, total - off)}
+            for off in range(0, total, segment_size)
+        ]
+        manifest = {
+            "base_address": self.mem_initializer_base + self.mem_initializer_encryption_offset,
+            "segment_size": segment_size,
+            "segments": segments,
+        }
+        out = self.output_file.with_name(self.output_file.stem + "_segments.json")
+        out.write_text(json.dumps(manifest, indent=2))
+        logger.info(f"Segment manifest ({len(segments)} units of {segment_size} bytes) written to {out.name}")
+
 
 class EncryptionProgressBar(tqdm):
     # print only if the logger is in error mode
@@ -109,6 +135,19 @@ class EncryptionProgressBar(tqdm):
             super(EncryptionProgressBar, self).update(round(n / 1024, ndigits=3))
 
 
+def encryption_fingerprint(b: bytes, keys: list[int], nb_rounds: int, base_address: int) -> str:
+    """Identity of an encryption job: plaintext, key material and parameters.
+
+    The keys are folded into the digest rather than stored, so the cache file
+    written in incremental mode does not leak key material.
+    """
+    h = hashlib.sha256()
+    h.update(b)
+    h.update(struct.pack("<QQ", keys[0] & 0xFFFF_FFFF_FFFF_FFFF, keys[1] & 0xFFFF_FFFF_FFFF_FFFF))
+    h.update(struct.pack("<iQ", nb_rounds, base_address))
+    return h.hexdigest()
+
+
 def raw_data_worker_tx(s, data: bytes, final_address:int):
     msg = pbproto.MyMessage()
     command = pbproto.RawData()
@@ -340,6 +379,23 @@ def main(args):
     nb_rounds = args.nbrounds
     logger.info("Parsing c_info file")
     cinfo = CInfoReader(c_info=c_info, mem_init=raw_file)
+    b, final_addr = cinfo.get_bytes_to_encrypt()
+
+    # Incremental mode: the board round-trip is skipped entirely when the
+    # plaintext, the key material and the parameters are unchanged since the
+    # last run and the previous encrypted output is still intact.
+    cache_file = cinfo.output_file.with_name(cinfo.output_file.stem + "_cache.json")
+    fingerprint = encryption_fingerprint(b, keys, nb_rounds, final_addr)
+    if args.incremental and cache_file.is_file() and cinfo.output_file.is_file():
+        cache = json.loads(cache_file.read_text())
+        if (cache.get("fingerprint") == fingerprint and
+                cache.get("output_sha256") == hashlib.sha256(cinfo.output_file.read_bytes()).hexdigest()):
+            logger.info(f"Plaintext, keys and parameters unchanged: reusing {cinfo.output_file.name}")
+            if args.segment_size:
+                cinfo.write_segment_manifest(args.segment_size)
+            logger.info("Done")
+            return raw_file, cinfo.output_file, cinfo.mem_initializer_base
+
     if comport == "auto":
         s = su.autoconnect_STLink(BAUDRATE)
     else:
@@ -353,9 +409,16 @@ def main(args):
     send_encryption_params(s, key_LSB=keys[1], key_MSB=keys[0], nb_rounds=nb_rounds)
     wait_for_ack(s)
     # Send data
-    b, final_addr = cinfo.get_bytes_to_encrypt()
     rcv = send_binary_data(s, b, final_address=final_addr)
     cinfo.inject_encrypted_bytes(rcv)
+    if args.segment_size:
+        cinfo.write_segment_manifest(args.segment_size)
+    if args.incremental:
+        cache_file.write_text(json.dumps({
+            "fingerprint": fingerprint,
+            "output_sha256": hashlib.sha256(cinfo.output_file.read_bytes()).hexdigest(),
+        }, indent=2))
+        logger.debug(f"Encryption cache written to {cache_file.name}")
 
     logger.info("Done")
     return raw_file, cinfo.output_file, cinfo.mem_initializer_base
@@ -389,6 +452,8 @@ def create_parser() -> argparse.ArgumentParser:
     parser_.add_argument( "-k", "--keys", default=[0xAABBCCDDAABBCCDD, 0xAABBCCDDAABBCCDD], action=ConvertToHexListAction, nargs=2, help="Keys to use (MSB LSB)", )
     parser_.add_argument( "-r", "--nbrounds", default=12, action=DeprecatedAction, help="Number of rounds (ignored for now)", )
     parser_.add_argument( "-p", "--comport", default="auto", help='COM-port name to be used for transmitting data to STLink. auto tries to connect to the first "STLink" found.', )
+    parser_.add_argument( "-s", "--segment-size", type=int, default=0, help="Describe the encrypted image as independently decryptable units of this size (bytes, multiple of 8) in a sidecar manifest. 0 keeps the monolithic container.", )
+    parser_.add_argument( "-i", "--incremental", action="store_true", default=False, help="Skip the board round-trip when the plaintext, keys and parameters are unchanged since the last run (per-output cache file).", )
     parser_.add_argument("c_info", type=lambda x: Path(x), help="json file output of the compilation")
     parser_.add_argument( "raw_file", type=lambda x: Path(x), help="memory-initializer file output of the compilation (.raw)", )
     return parser_
@@ -9,6 +9,7 @@
 Utility functions to manipulate the binay objects
 """
 
+import json
 import logging
 import os
 import sys
@@ -42,10 +43,11 @@ from prepare_network import _FAKE_SIZE
 #   v1.1 - add rt ctx dump
 #          complete/fix debug info in gen c/h files
 #   v1.2 - add ecblob in params support
+#   v1.3 - add per-region hash table generation
 #
 
 __title__ = 'NPU Utility - Elf/Binary parser'
-__version__ = '1.2'
+__version__ = '1.3'
 __author__ = 'STMicroelectronics'
 
 
@@ -124,6 +126,83 @@ def _get_vseg(addr: int) -> MSegmentID:
         return MSegmentID.UNUSED
 
 
+_HASH_REGION_SIZE = 0x10000  # 64KiB - default granularity of the region hash table
+
+
+def crc32_mpeg2(data: bytes) -> int:
+    """Compute the CRC-32/MPEG-2 of the provided buffer
+
+    Same algorithm as the STM32 CRC unit in its reset configuration
+    (poly 0x04C11DB7, init 0xFFFFFFFF, no reflection, no final xor):
+    the value matches the CMD_MEMORY_CHECKSUM answer when the firmware
+    is built with USE_HW_CRC_CHECKSUM=1.
+    """
+    crc = 0xFFFFFFFF
+    for byte_ in data:
+        crc ^= byte_ << 24
+        for _ in range(8):
+            if crc & 0x80000000:
+                crc = ((crc << 1) & 0xFFFFFFFF) ^ 0x04C11DB7
+            else:
+                crc = (crc << 1) & 0xFFFFFFFF
+    return crc
+
+
+def build_region_hash_table(data: bytes, region_size: int = _HASH_REGION_SIZE) -> Dict[str, Any]:
+    """Build the per-region hash table of a binary image
+
+    The image is split into fixed-size regions (last one possibly shorter)
+    and a CRC-32/MPEG-2 is computed for each of them. Region offsets are
+    implicit: region i covers [i * region_size, min((i + 1) * region_size, image_size)).
+    """
+    regions_ = []
+    for off_ in range(0, len(data), region_size):
+        regions_.append(crc32_mpeg2(data[off_:off_ + region_size]))
+    return {
+        'version': 1,
+        'region_size': region_size,
+        'image_size': len(data),
+        'regions': regions_,
+    }
+
+
+def write_region_hash_table(binary_path: Union[str, Path], region_size: int = _HASH_REGION_SIZE) -> Path:
+    """Compute and save the per-region hash table of a binary image
+
+    The table is written next to the image as '<image>.rht.json'. A loader
+    (or a previous run of this script) holding the previous table can then
+    re-verify only the regions whose CRC changed - see changed_regions() -
+    instead of checksumming the whole image on target.
+    """
+    binary_path = Path(binary_path)
+    table_ = build_region_hash_table(binary_path.read_bytes(), region_size)
+    table_path = binary_path.parent.joinpath(binary_path.name + '.rht.json')
+    with open(table_path, 'w') as _f:
+        json.dump(table_, _f, indent=1)
+    return table_path
+
+
+def changed_regions(new_table: Dict[str, Any], old_table: Optional[Dict[str, Any]]) -> List[tuple]:
+    """Return the (offset, size) list of the regions to re-verify
+
+    All regions are returned when no previous table is available or when
+    the tables are not comparable (different granularity or image size).
+    """
+    region_size = new_table['region_size']
+    image_size = new_table['image_size']
+    comparable_ = old_table is not None and \
+        old_table.get('version') == new_table['version'] and \
+        old_table.get('region_size') == region_size and \
+        old_table.get('image_size') == image_size
+    changed_ = []
+    for idx_, crc_ in enumerate(new_table['regions']):
+        if comparable_ and old_table['regions'][idx_] == crc_:
+            continue
+        off_ = idx_ * region_size
+        changed_.append((off_, min(region_size, image_size - off_)))
+    return changed_
+
+
 _REQUESTED_ELF_SECTIONS = [
     '.flash', '.rel.flash', '.data', '.rel.data', '.relocs', '.bss'
 ]
@@ -910,9 +989,15 @@ class ElfPostProcess():
                 binary_params_path.write_bytes(full_params)
             else:
                 binary_params_path.write_bytes(Path(self._paramspath).read_bytes())
-            return [Path(binary_path), Path(binary_params_path)]
+            saved_ = [Path(binary_path), Path(binary_params_path)]
+        else:
+            saved_ = [Path(binary_path)]
+
+        for path_ in saved_:
+            table_path = write_region_hash_table(path_)
+            self._logger.debug('-> Creating \'%s\'', table_path)
 
-        return [Path(binary_path)]
+        return saved_
 
     def to_c(self, dst_path: Optional[Union[str, Path]] = None) -> List[Path]:
         """Create the c-files"""
@@ -1504,6 +1504,17 @@ class CNpuNetworkDesc():
         logger.debug('<- CNpuNetworkDesc done')
         self._logger = logger
 
+    def __getstate__(self):
+        """Drop the logger reference (parsed-network cache support)"""
+        state = self.__dict__.copy()
+        state['_logger'] = None
+        return state
+
+    def __setstate__(self, state):
+        """Re-attach the default logger after unpickling"""
+        self.__dict__.update(state)
+        self._logger = logging.getLogger()
+
     @property
     def filepath(self) -> Path:
         """Return used file-path"""
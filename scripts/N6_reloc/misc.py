@@ -48,6 +48,7 @@ class Params:
     board: str = 'stm32n6570-dk'
     mode: str = ''
     parse_only: bool = False
+    use_cache: bool = False
     cont: bool = False
     llvm: bool = False
     st_clang: bool = False
@@ -149,6 +150,9 @@ class Params:
         if hasattr(args, 'parse_only'):
             self.parse_only = args.parse_only
 
+        if hasattr(args, 'use_cache'):
+            self.use_cache = args.use_cache
+
         if hasattr(args, 'gen_c_file'):
             self.gen_c_file = args.gen_c_file
 
@@ -11,7 +11,9 @@ NPU Utility functions - prepare the network.c for relocatable mode
 
 import logging
 import argparse
+import hashlib
 import os
+import pickle
 import sys
 import glob
 import zlib
@@ -19,9 +21,10 @@ from textwrap import dedent, indent
 from datetime import datetime
 from string import Template
 from pathlib import Path
-from typing import List, Optional, Tuple
+from typing import List, Optional, Tuple, Union
 
 from c_network_parser import CNpuNetworkDesc
+from c_network_parser import __version__ as _PARSER_VERSION
 from reloc_misc import MPoolCDesc, MPoolCType, align_up
 from exceptions import ExceptionErr, RelocPrepareError
 from misc import size_int_to_str
@@ -36,10 +39,11 @@ from target import DevicePropertyDesc
 #   v0.2 - fix case where 0-initializer is not provided
 #   v1.0 - add support for clang tool-chain
 #   v1.1 - add support to place the ecblob with param
+#   v1.2 - add parsed-network cache
 #
 
 __title__ = 'NPU Utility - Preparing/checking the generated C-files for relocatable mode'
-__version__ = '1.1'
+__version__ = '1.2'
 __author__ = 'STMicroelectronics'
 
 
@@ -228,6 +232,69 @@ def _patch_epoch_mgr(lines: List[str], c_labels: List[str]) -> int:
     return len(patches_)
 
 
+def _resolve_network_file(filepath: Union[Path, str], f_name: str) -> Path:
+    """Return the path of the network C-file (mirror of the parser resolution)"""
+    filepath = Path(filepath)
+    if filepath.is_dir():
+        name_ = 'network' if f_name == 'no-name' else f_name
+        filepath = filepath / f'{name_}.c'
+    return filepath
+
+
+def _network_cache_key(c_file: Path, f_name: str, target: str, mem_only: bool) -> str:
+    """Build the content-based key of the parsed-network cache"""
+    hash_ = hashlib.sha256()
+    hash_.update(c_file.read_bytes())
+    stem_ = c_file.stem
+    for json_name in (f'{stem_}_c_info.json', f'{stem_}.json', 'c_info.json'):
+        json_file = c_file.parent / json_name
+        if json_file.is_file():
+            hash_.update(json_file.read_bytes())
+            break
+    hash_.update(f'{_PARSER_VERSION}:{f_name}:{target}:{mem_only}'.encode('utf-8'))
+    return hash_.hexdigest()
+
+
+def _load_parsed_network(args: Params, logger: logging.Logger) -> CNpuNetworkDesc:
+    """Return the parsed network desc, through the cache when enabled"""
+
+    use_cache_ = bool(getattr(args, 'use_cache', False))
+    mem_only_ = not args.parse_only
+    cache_file: Optional[Path] = None
+    key_ = ''
+
+    if use_cache_:
+        c_file = _resolve_network_file(args.input, args.name)
+        if c_file.is_file():
+            cache_file = c_file.parent / f'{c_file.stem}_parsed.cache'
+            key_ = _network_cache_key(c_file, args.name, args.target, mem_only_)
+            if cache_file.is_file():
+                try:
+                    with open(cache_file, 'rb') as c_fd:
+                        cached_ = pickle.load(c_fd)
+                    if cached_.get('key') == key_:
+                        logger.info('Using the parsed-network cache \'%s\'', cache_file)
+                        return cached_['desc']
+                except (pickle.UnpicklingError, EOFError, AttributeError, KeyError,
+                        ImportError, OSError) as exc_:
+                    logger.warning('Invalid parsed-network cache, re-parsing.. (%s)', exc_)
+
+    c_npu_network = CNpuNetworkDesc(args.input, logger,
+                                    f_name=args.name,
+                                    target=args.target,
+                                    mem_only=mem_only_)
+
+    if cache_file is not None:
+        try:
+            with open(cache_file, 'wb') as c_fd:
+                pickle.dump({'key': key_, 'desc': c_npu_network}, c_fd)
+            logger.info('Parsed-network cache updated \'%s\'', cache_file)
+        except (pickle.PicklingError, OSError) as exc_:
+            logger.warning('Unable to update the parsed-network cache (%s)', exc_)
+
+    return c_npu_network
+
+
 def prepare_c_network_file(args: Params, no_banner: bool = False):
     """Entry point to prepare the c-files"""
 
@@ -244,10 +311,7 @@ def prepare_c_network_file(args: Params, no_banner: bool = False):
     logger.info('clang mode  : %s', clang_mode)
 
     # check info from generated file
-    c_npu_network = CNpuNetworkDesc(args.input, logger,
-                                    f_name=args.name,
-                                    target=args.target,
-                                    mem_only=not args.parse_only)
+    c_npu_network = _load_parsed_network(args, logger)
     args.input = c_npu_network.filepath
     f_name_ = c_npu_network.f_name
     c_name_ = c_npu_network.c_name
@@ -609,6 +673,9 @@ def main():
     parser.add_argument('--parse-only', action='store_true',
                         help='Parsing only the generated c-files')
 
+    parser.add_argument('--cache', action='store_true', dest='use_cache',
+                        help='Use the parsed-network cache (skip parsing when unchanged)')
+
     parser.add_argument('--cont', action='store_true',
                         help='Continue on error')
 
@@ -10,12 +10,15 @@ Utility function to deploy a relocatable model
 """
 
 import argparse
+import json
 import os
+import socket
 import sys
 import logging
 from pathlib import Path
 from datetime import datetime
 import time
+from typing import Any, Dict, Optional
 
 from misc import Params, create_logger
 from tools import STM32CubeIDEResources, CExecutable
@@ -30,16 +33,19 @@ from exceptions import ExcToolsErr
 #   v1.0 - initial version
 #   v1.1 - add llvm/(st-)clang support
 #   v1.2 - add support for usbc test firmware
+#   v1.3 - add daemon mode (warm board session across invocations)
 #
 
 
 __title__ = 'NPU Utility - ST Load and run (dev environment)'
-__version__ = '1.2'
+__version__ = '1.3'
 __author__ = 'STMicroelectronics'
 
 
 _DEFAULT_INPUT = 'build/network_rel.bin'
 _GDB_SERVER_PORTNO = 36789
+_DAEMON_HOST = '127.0.0.1'
+_DAEMON_PORTNO = 36790
 _DEFAULT_BOARD = 'stm32n6570-dk'
 _DEFAULT_DEST_ADDR = '0x71000000,0x71800000'
 
@@ -56,7 +62,39 @@ def _get_params_file(net_file) -> str:
     return ''
 
 
-def st_load_and_run(params: Params, no_banner: bool = False):
+def _invoke_runner(runner, params: Params, logger, keep: bool = False):
+    """Run the deployed model through an already connected AiRunner"""
+
+    runner.summary(print_fn=logger.info)
+
+    inputs = runner.generate_rnd_inputs(batch_size=2)
+    mode = runner.Mode.PER_LAYER
+    if params.debug:
+        mode |= runner.Mode.DEBUG
+    outputs, profiler = runner.invoke(inputs,  # disable_pb=True,
+                                      mode=mode)
+    runner.print_profiling(inputs, profiler, outputs,
+                           print_fn=logger.info,
+                           tensor_info=False)
+
+    if not keep:
+        runner.disconnect()
+
+    return 0
+
+
+def _session_key(params: Params, binary_file: Path):
+    """Identity of a deployment: same key -> the board state can be reused"""
+    try:
+        mtime_ = os.path.getmtime(binary_file)
+    except OSError:
+        mtime_ = 0
+    return [str(Path(binary_file).resolve()), mtime_,
+            params.mode, params.board, str(params.address)]
+
+
+def st_load_and_run(params: Params, no_banner: bool = False,
+                    session: Optional[Dict[str, Any]] = None):
     """Post-Process the elf file"""
 
     logger = logging.getLogger()
@@ -80,6 +118,19 @@ def st_load_and_run(params: Params, no_banner: bool = False):
         logger.info('Creating date : %s', datetime.now().ctime())
         logger.info('')
 
+    key_ = None
+    if session is not None:
+        key_ = _session_key(params, binary_file)
+        runner_ = session.get('runner')
+        if session.get('key') == key_ and runner_ is not None and runner_.is_connected:
+            logger.info('Reusing the warm board session (deployed model is unchanged).')
+            logger.info('')
+            return _invoke_runner(runner_, params, logger, keep=True)
+        if runner_ is not None:
+            runner_.disconnect()
+            session['runner'] = None
+            session['key'] = None
+
     logger.info('Entry point    : \'%s\'', binary_file)
     logger.info('Board          : \'%s\'', params.board)
     logger.info('mode           : %s', mode_params)
@@ -220,20 +271,103 @@ def st_load_and_run(params: Params, no_banner: bool = False):
         logger.error(runner.get_error())
         return -1
 
-    runner.summary(print_fn=logger.info)
+    if session is not None:
+        session['runner'] = runner
+        session['key'] = key_
 
-    inputs = runner.generate_rnd_inputs(batch_size=2)
-    mode = AiRunner.Mode.PER_LAYER
-    if params.debug:
-        mode |= AiRunner.Mode.DEBUG
-    outputs, profiler = runner.invoke(inputs,  # disable_pb=True,
-                                      mode=mode)
-    runner.print_profiling(inputs, profiler, outputs,
-                           print_fn=logger.info,
-                           tensor_info=False)
+    return _invoke_runner(runner, params, logger, keep=session is not None)
+
+
+class _LogCapture(logging.Handler):
+    """Collects the log records emitted while serving a daemon request"""
 
-    runner.disconnect()
+    def __init__(self):
+        super().__init__()
+        self.lines = []
+
+    def emit(self, record):
+        self.lines.append(self.format(record))
+
+
+def _daemon_request(request: Dict[str, Any], timeout: float = 2.0) -> Optional[Dict[str, Any]]:
+    """Send a request to a running daemon, None when no daemon is listening"""
+    try:
+        sock = socket.create_connection((_DAEMON_HOST, _DAEMON_PORTNO), timeout=timeout)
+    except OSError:
+        return None
+    with sock:
+        sock.settimeout(None)  # a 'run' request includes the full deployment
+        sock.sendall(json.dumps(request).encode('utf-8') + b'\n')
+        data = b''
+        while True:
+            chunk = sock.recv(4096)
+            if not chunk:
+                break
+            data += chunk
+    return json.loads(data.decode('utf-8'))
+
+
+def daemon_serve(params: Params):
+    """Serve load-and-run requests, keeping the board session warm in between
+
+    The deployed model, the started validation firmware and the AiRunner
+    serial link are kept alive across requests: a request whose input
+    file (path/mtime), mode, board and addresses are unchanged skips the
+    flash/reset/load sequence entirely and goes straight to the inference.
+    """
+
+    logger = logging.getLogger()
+    session: Dict[str, Any] = {}
 
+    try:
+        srv = socket.create_server((_DAEMON_HOST, _DAEMON_PORTNO))
+    except OSError as exc:
+        logger.error('Unable to listen on %s:%d (%s) - daemon already running?',
+                     _DAEMON_HOST, _DAEMON_PORTNO, exc)
+        return -1
+
+    logger.info('%s (version %s)', __title__, __version__)
+    logger.info('Daemon listening on %s:%d (--daemon stop to terminate)',
+                _DAEMON_HOST, _DAEMON_PORTNO)
+
+    with srv:
+        while True:
+            conn, _ = srv.accept()
+            with conn:
+                try:
+                    req = json.loads(conn.makefile('r').readline())
+                except (ValueError, OSError):
+                    continue
+                cmd = req.get('cmd')
+                if cmd == 'stop':
+                    conn.sendall(json.dumps({'returncode': 0, 'log': []}).encode('utf-8'))
+                    break
+                if cmd != 'run':
+                    reply = {'returncode': -1, 'log': [f'unknown command: {cmd}']}
+                    conn.sendall(json.dumps(reply).encode('utf-8'))
+                    continue
+
+                capture = _LogCapture()
+                logger.addHandler(capture)
+                try:
+                    req_params = Params(argparse.Namespace(**req['params']))
+                    res = st_load_and_run(req_params, no_banner=True, session=session)
+                except Exception as exc:  # pylint: disable=broad-except
+                    logger.exception(exc, stack_info=False, exc_info=params.debug)
+                    # next request redeploys from scratch
+                    runner_ = session.pop('runner', None)
+                    session.pop('key', None)
+                    if runner_ is not None and runner_.is_connected:
+                        runner_.disconnect()
+                    res = -1
+                finally:
+                    logger.removeHandler(capture)
+                conn.sendall(json.dumps({'returncode': res, 'log': capture.lines}).encode('utf-8'))
+
+    runner_ = session.get('runner')
+    if runner_ is not None and runner_.is_connected:
+        runner_.disconnect()
+    logger.info('Daemon terminated.')
     return 0
 
 
@@ -276,10 +410,42 @@ def main():
     parser.add_argument('--no-color', action='store_const', const=1,
                         help='disable log color support')
 
-    params: Params = Params(parser.parse_args())
+    parser.add_argument('--daemon', metavar='STR', type=str,
+                        choices=['serve', 'run', 'stop'],
+                        help='daemon mode: serve (hold a warm board session), '
+                             'run (hand the job to a running daemon, falls back to '
+                             'a direct execution when none is running), stop')
+
+    args = parser.parse_args()
+    params: Params = Params(args)
 
     logger = create_logger(params, Path(__file__).stem)
 
+    if args.daemon == 'stop':
+        if _daemon_request({'cmd': 'stop'}) is None:
+            logger.warning('No daemon is running.')
+        else:
+            logger.info('Daemon stopped.')
+        return 0
+
+    if args.daemon == 'serve':
+        try:
+            return daemon_serve(params)
+        except Exception as e:  # pylint: disable=broad-except
+            logger.exception(e, stack_info=False, exc_info=params.debug)
+            return -1
+
+    if args.daemon == 'run':
+        req_params = {k: v for k, v in vars(args).items() if k != 'daemon'}
+        # the daemon may run from another working directory
+        req_params['input'] = str(Path(args.input).resolve())
+        reply = _daemon_request({'cmd': 'run', 'params': req_params})
+        if reply is not None:
+            for line in reply.get('log', []):
+                print(line)
+            return reply.get('returncode', -1)
+        logger.warning('No daemon is running, executing the job directly.')
+
     try:
         res = st_load_and_run(params)
     except Exception as e:  # pylint: disable=broad-except
@@ -64,6 +64,51 @@ def safe_copy(src: Path, dst: Path):
         raise FileNotFoundError(f"{str(src)} does not exists")
 
 
+def verify_weights_crc(weights_file: Path, weights_location: int) -> int:
+    """Verifies the flashed weights with the device-side CRC checksum service.
+
+    Replaces CubeProgrammer's --verify (a full SWD read-back of the image):
+    the running validation firmware checksums the region with the CRC
+    peripheral at bus speed (CMD_MEMORY_CHECKSUM, USE_HW_CRC_CHECKSUM=1)
+    and only the 32-bit result crosses the link.
+    """
+    try:
+        from stm_ai_runner import AiRunner
+        from stm_ai_runner.stm32_utility import crc32_mpeg2
+    except ImportError:
+        sys.path.append(str(Path(__file__).resolve().parent.parent / "ai_runner"))
+        try:
+            from stm_ai_runner import AiRunner
+            from stm_ai_runner.stm32_utility import crc32_mpeg2
+        except ImportError:
+            log(logging.ERROR, "stm_ai_runner module not found, cannot CRC-verify (update PYTHONPATH or drop --fast-verify)")
+            return 1
+
+    data = weights_file.read_bytes()
+    expected = crc32_mpeg2(data)
+
+    runner = AiRunner()
+    runner.connect(desc='serial')
+    if not runner.is_connected:
+        log(logging.ERROR, f"CRC verification failed: no serial connection ({runner.get_error()})")
+        return 1
+    try:
+        resp = runner.extension(cmd='checksum-in-memory',
+                                target_addr=weights_location,
+                                size=len(data))
+    finally:
+        runner.disconnect()
+
+    if not resp or resp.get('error'):
+        log(logging.ERROR, f"CRC verification failed: checksum service error ({resp})")
+        return 1
+    if resp['crc'] != expected:
+        log(logging.ERROR, f"CRC verification failed: device={resp['crc']:#010x} expected={expected:#010x}")
+        return 1
+    log(logging.INFO, f"CRC verification OK ({len(data):,} bytes, crc={expected:#010x})".replace(',', ' '))
+    return 0
+
+
 def copy_files_to_project(src_network_c: Path, tgt_directory:Path):
     file_names_to_copy = ["network.c", "network.h", "network_c_info.json",
                           "network_config.h", "network_generate_report.txt",
@@ -193,7 +238,10 @@ def main_cm55_loader(path_to_network_c:List[Path] = None,
     #   -extloader: External loader for the flash
     #   --download: file to download to flash (.hex file or .bin file with offset)
     #   --verify: Verify the file has been correctly written to flash for success
-    cmd = [str(path_to_cube), '-q', '-c', 'port='+port, 'mode=hotplug', 'ap=1', '--extload', str(path_to_stldr), '--download', str(weights_file), f"{weights_location:#10x}", "--verify"]
+    fast_verify = bool(getattr(args, "flash_fast_verify", False))
+    cmd = [str(path_to_cube), '-q', '-c', 'port='+port, 'mode=hotplug', 'ap=1', '--extload', str(path_to_stldr), '--download', str(weights_file), f"{weights_location:#10x}"]
+    if not fast_verify:
+        cmd.append("--verify")
     if stlink_sn:
         cmd.insert(cmd.index("port=SWD")+1, f"sn={stlink_sn}")
     
@@ -224,8 +272,15 @@ def main_cm55_loader(path_to_network_c:List[Path] = None,
     log(logging.INFO, f"Running the program")
     rv = compiler.load_and_run()
     show_returncode("Running", rv)
-    return rv
+    if rv:
+        return rv
 
+    # Deferred verification: the SWD read-back is skipped at flash time and
+    # the region is checksummed by the board itself once the firmware runs
+    if fast_verify and not skip_extflash_prog:
+        log(logging.INFO, f"Verifying flashed weights with the device-side CRC service")
+        rv = verify_weights_crc(weights_file, weights_location)
+        show_returncode("CRC verification", rv)
     return rv
 
 
@@ -249,6 +304,8 @@ if __name__ == "__main__":
     parser.add_argument("--port", dest="st_link_port", default='SWD', help="Force the use of CubeProgrammer port (default: SWD)")
     parser.add_argument("--clean", action="store_true", dest="project_clean",
                     default=False, help="Clean the project before building it (default: False)")
+    parser.add_argument("--fast-verify", action="store_true", dest="flash_fast_verify",
+                    default=False, help="Skip the SWD read-back verify at flash time, checksum the weights with the on-board CRC service once the firmware runs (default: False)")
     CM55LoaderConfig.add_args(parser=parser)
     args = parser.parse_args()
     rv = main_cm55_loader(path_to_network_c=None,     # First and second arguments are forced to None (will be handled by n6loader config after)
@@ -0,0 +1,134 @@
+from __future__ import annotations
+import argparse
+import logging
+import re
+import sys
+from pathlib import Path
+from typing import Dict, List, Tuple
+
+# Build-time const-data dedup across co-flashed models. The generated
+# model sources (img.c, kws.c, ...) carry one single-line `static const`
+# table per quantization scale/offset vector and shape descriptor; when
+# models are co-flashed - in particular A/B revisions of the same network -
+# many of those tables are byte-identical. This pass rewrites the sources
+# into the build directory with every table whose (type, initializer)
+# appears more than once replaced by a reference to a single shared
+# definition (model_shared_const.c/.h, emitted alongside), so the flash
+# image carries each distinct table exactly once. The references are
+# patched with file-top #defines, which keeps the shared symbols valid
+# address constants in the generated buffer descriptors. The checked-in
+# generated sources are never modified (see DEDUP_CONST in the armgcc
+# Makefile). Epoch Controller blobs are not covered here, they are shared
+# through the EC flash partition instead (ec_partition_pack.py).
+
+_ARRAY_RE = re.compile(
+    r"^(\s*)(?:static\s+)?const\s+([A-Za-z_]\w*(?:\s+[A-Za-z_]\w*)*)\s+"
+    r"([A-Za-z_]\w*)\[\]\s*=\s*\{(.*)\};\s*$")
+
+# element sizes for the saved-bytes report (unknown types count elements)
+_TYPE_SIZE = {"uint8_t": 1, "int8_t": 1, "uint16_t": 2, "int16_t": 2,
+              "uint32_t": 4, "int32_t": 4, "float": 4, "uint64_t": 8,
+              "int64_t": 8, "double": 8}
+
+logger = logging.getLogger(__name__)
+
+
+def set_logger():
+    logger.setLevel(logging.DEBUG)
+    ch = logging.StreamHandler()
+    ch.setLevel(logging.INFO)
+    formatter = logging.Formatter('%(asctime)s  %(name)s -- %(message)s', datefmt='%m/%d/%Y %I:%M:%S %p')
+    ch.setFormatter(formatter)
+    logger.addHandler(ch)
+
+
+def scan_tables(lines: List[str]) -> Dict[int, Tuple[str, str, str]]:
+    """Returns the {line index: (type, name, normalized init)} const tables"""
+    tables = {}
+    for n, line in enumerate(lines):
+        m = _ARRAY_RE.match(line)
+        if m:
+            tables[n] = (m.group(2), m.group(3), " ".join(m.group(4).split()))
+    return tables
+
+
+def table_size(ctype: str, init: str) -> int:
+    """Returns the approximate flash size of a table in bytes"""
+    return (init.count(",") + 1) * _TYPE_SIZE.get(ctype, 1)
+
+
+def dedup(paths: List[Path], out_dir: Path) -> int:
+    """Rewrites the sources into out_dir with shared tables merged, returns the bytes saved"""
+    sources = {p: p.read_text().splitlines(keepends=True) for p in paths}
+    scans = {p: scan_tables(lines) for p, lines in sources.items()}
+
+    # count every (type, init) across all files; names that reappear with a
+    # different initializer in the same file cannot be #define-patched
+    counts: Dict[Tuple[str, str], int] = {}
+    for p, tables in scans.items():
+        names = [t[1] for t in tables.values()]
+        ambiguous = {n for n in names if names.count(n) > 1}
+        scans[p] = {ln: t for ln, t in tables.items() if t[1] not in ambiguous}
+        for _, (ctype, _, init) in scans[p].items():
+            counts[(ctype, init)] = counts.get((ctype, init), 0) + 1
+
+    shared = {key: f"g_mdl_const_{n}"
+              for n, key in enumerate(k for k, c in sorted(counts.items()) if c > 1)}
+    saved = sum((counts[k] - 1) * table_size(*k) for k in shared)
+
+    out_dir.mkdir(parents=True, exist_ok=True)
+    decls = []
+    for (ctype, init), sym in shared.items():
+        decls.append((ctype, sym, init))
+
+    banner = ("/* Generated by dedup_model_const.py - DO NOT EDIT.\n"
+              "   One definition for every const table that appears in more than\n"
+              "   one place across the co-flashed model sources. */\n")
+    header = banner + "#ifndef MODEL_SHARED_CONST_H\n#define MODEL_SHARED_CONST_H\n\n#include <stdint.h>\n\n"
+    body = banner + "\n#include \"model_shared_const.h\"\n\n"
+    for ctype, sym, init in decls:
+        header += f"extern const {ctype} {sym}[];\n"
+        body += f"const {ctype} {sym}[] = {{{init}}};\n"
+    header += "\n#endif\n"
+    (out_dir / "model_shared_const.h").write_text(header)
+    (out_dir / "model_shared_const.c").write_text(body)
+
+    for p, lines in sources.items():
+        defines = []
+        for ln, (ctype, name, init) in scans[p].items():
+            sym = shared.get((ctype, init))
+            if sym is None:
+                continue
+            defines.append(f"#define {name} {sym}\n")
+            lines[ln] = f"/* dedup: {name} -> {sym} (model_shared_const.c) */\n"
+        if defines:
+            last_inc = max(n for n, l in enumerate(lines) if l.lstrip().startswith("#include"))
+            lines[last_inc + 1:last_inc + 1] = (
+                ["\n/* dedup_model_const.py: shared const tables */\n",
+                 "#include \"model_shared_const.h\"\n"] + defines)
+        (out_dir / p.name).write_text("".join(lines))
+        logger.info(f"  {p.name}: {len(defines)} table(s) shared")
+
+    logger.info(f"{len(shared)} shared table(s), ~{saved:,d} bytes of flash saved")
+    return saved
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Merge identical const tables across generated model sources")
+    parser.add_argument("sources", nargs="+", type=Path, help="generated model sources (img.c, kws.c, ...)")
+    parser.add_argument("-o", "--output", type=Path, required=True,
+                        help="output directory for the rewritten sources and the shared TU")
+    args = parser.parse_args()
+
+    set_logger()
+
+    try:
+        dedup(args.sources, args.output)
+    except (ValueError, OSError) as exc:
+        logger.error(f"{exc}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,96 @@
+from __future__ import annotations
+import argparse
+import logging
+import struct
+import sys
+from pathlib import Path
+from typing import List, Tuple
+
+# Packs Epoch Controller binaries into a flashable blob partition image
+# consumed in place by the firmware (USE_EC_FLASH_PARTITION, see
+# ecloader.c). Layout, all little endian:
+#
+#   header  : magic "ECPT" (u32), entry count (u32)
+#   directory: per entry a 32-byte NUL-terminated identifier, the binary
+#             offset from the partition base (u32) and its size (u32)
+#   payload : the binaries, 8-byte aligned (the blob section of a cooked
+#             binary must stay 8-byte aligned to be usable without a copy)
+#
+# The directory identifier defaults to the file stem and must match the
+# name of the generated blob array it replaces ("_ec_blob_<network>_<n>"),
+# use '<id>=<file>' arguments to override. Flash the image at
+# EC_PARTITION_BASE (make flash_ecpart).
+
+ECPART_MAGIC = 0x54504345  # "ECPT"
+ECPART_ID_LEN = 32
+_ALIGN = 8
+
+logger = logging.getLogger(__name__)
+
+
+def set_logger():
+    logger.setLevel(logging.DEBUG)
+    ch = logging.StreamHandler()
+    ch.setLevel(logging.INFO)
+    formatter = logging.Formatter('%(asctime)s  %(name)s -- %(message)s', datefmt='%m/%d/%Y %I:%M:%S %p')
+    ch.setFormatter(formatter)
+    logger.addHandler(ch)
+
+
+def parse_blob_arg(arg: str) -> Tuple[str, Path]:
+    """Returns the (identifier, path) of a '<id>=<file>' or plain '<file>' argument"""
+    if "=" in arg:
+        blob_id, _, path = arg.partition("=")
+    else:
+        path = arg
+        blob_id = Path(arg).stem
+    if len(blob_id.encode()) >= ECPART_ID_LEN:
+        raise ValueError(f"identifier '{blob_id}' exceeds {ECPART_ID_LEN - 1} characters")
+    return blob_id, Path(path)
+
+
+def pack_partition(blobs: List[Tuple[str, Path]]) -> bytes:
+    """Returns the packed partition image"""
+    header_size = 8 + len(blobs) * (ECPART_ID_LEN + 8)
+    directory = struct.pack("<II", ECPART_MAGIC, len(blobs))
+    payload = b""
+    offset = (header_size + _ALIGN - 1) & ~(_ALIGN - 1)
+    payload += b"\0" * (offset - header_size)
+
+    for blob_id, path in blobs:
+        data = path.read_bytes()
+        directory += struct.pack(f"<{ECPART_ID_LEN}sII", blob_id.encode(), offset, len(data))
+        payload += data
+        offset += len(data)
+        pad = (-offset) % _ALIGN
+        payload += b"\0" * pad
+        offset += pad
+        logger.info(f"  {blob_id:<32s} {len(data):>8,d} bytes ({path})")
+
+    return directory + payload
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Pack Epoch Controller binaries into a blob partition image")
+    parser.add_argument("blobs", nargs="+", metavar="[ID=]FILE",
+                        help="Epoch Controller binary, optionally prefixed with its directory identifier "
+                             "(default: the file stem)")
+    parser.add_argument("-o", "--output", type=Path, required=True, help="output partition image")
+    args = parser.parse_args()
+
+    set_logger()
+
+    try:
+        blobs = [parse_blob_arg(arg) for arg in args.blobs]
+        image = pack_partition(blobs)
+    except (ValueError, OSError) as exc:
+        logger.error(f"{exc}")
+        return 1
+
+    args.output.write_bytes(image)
+    logger.info(f"{args.output}: {len(blobs)} blob(s), {len(image):,d} bytes")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
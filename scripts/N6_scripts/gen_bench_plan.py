@@ -0,0 +1,88 @@
+from __future__ import annotations
+import argparse
+import json
+import logging
+import sys
+from pathlib import Path
+
+# Generates bench_plan.h, the benchmark plan baked into the N6-DK-harness
+# firmware (see aiBenchHarness_ATON.c), from a JSON plan description:
+#
+#   {
+#     "name": "nightly",
+#     "steps": [
+#       { "model": 0, "iters": 100, "warmup": 2, "preset": "none" },
+#       { "model": 0, "iters": 50,  "preset": "cache" },
+#       { "model": 1, "iters": 100, "preset": "stall" }
+#     ]
+#   }
+#
+# "model" is the npu_get_instance_by_index() index, "preset" one of the
+# COUNTER_PRESET_* names (default "none", the clean timing reference).
+# The counter preset is emitted symbolically so the header stays readable
+# and tracks the firmware's COUNTER_PRESET_POS encoding. Regenerated into
+# the build directory by the armgcc Makefile, never checked in.
+
+_PRESETS = ("none", "bandwidth", "stall", "activity", "cache")
+
+_DEF_WARMUP = 1
+
+logger = logging.getLogger(__name__)
+
+
+def set_logger():
+    logger.setLevel(logging.DEBUG)
+    ch = logging.StreamHandler()
+    ch.setLevel(logging.INFO)
+    formatter = logging.Formatter('%(asctime)s  %(name)s -- %(message)s', datefmt='%m/%d/%Y %I:%M:%S %p')
+    ch.setFormatter(formatter)
+    logger.addHandler(ch)
+
+
+def step_line(step: dict) -> str:
+    """Returns one BENCH_PLAN_STEPS initializer (struct _bench_step order)"""
+    model = int(step["model"])
+    iters = int(step["iters"])
+    warmup = int(step.get("warmup", _DEF_WARMUP))
+    preset = str(step.get("preset", "none")).lower()
+    if preset not in _PRESETS:
+        raise ValueError(f"unknown counter preset '{preset}' (one of {_PRESETS})")
+    if iters <= 0:
+        raise ValueError("iters must be >= 1")
+    option = f"(COUNTER_PRESET_{preset.upper()} << COUNTER_PRESET_POS)"
+    return f'  {{ {model}, {warmup}, {iters}, {option}, "{preset}" }}'
+
+
+def gen_header(plan: dict) -> str:
+    steps = plan["steps"]
+    if not steps:
+        raise ValueError("the plan has no steps")
+    lines = [
+        "/* Generated by gen_bench_plan.py - DO NOT EDIT */",
+        f'#define BENCH_PLAN_NAME "{plan.get("name", "default")}"',
+        f"#define BENCH_PLAN_N_STEPS ({len(steps)})",
+        "#define BENCH_PLAN_STEPS \\",
+    ]
+    lines.append(", \\\n".join(step_line(s) for s in steps))
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="bench_plan.h generator")
+    parser.add_argument("plan", type=Path, help="JSON benchmark plan")
+    parser.add_argument("-o", "--output", type=Path, required=True,
+                        help="generated header path")
+    args = parser.parse_args()
+
+    set_logger()
+
+    plan = json.loads(args.plan.read_text())
+    header = gen_header(plan)
+    args.output.write_text(header)
+    logger.info("%s: %d step(s) -> %s",
+                plan.get("name", "default"), len(plan["steps"]), args.output)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
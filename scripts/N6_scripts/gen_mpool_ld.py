@@ -0,0 +1,112 @@
+from __future__ import annotations
+import argparse
+import json
+import logging
+import re
+import sys
+from pathlib import Path
+from typing import List, Tuple
+
+# Generates a linker placement fragment from a NeuralArt memory pool
+# descriptor (my_mpools/*.mpool, the file user_neuralart.json hands to the
+# NPU compiler). The fragment defines one __mpool_<name>/__mpool_<name>_end
+# symbol pair per pool and ASSERTs that the firmware MEMORY regions do not
+# overlap any writable on-chip pool, so a hand-edit of STM32N657xx.ld that
+# drifts from the compiler's pool assumptions fails the link instead of
+# silently moving buffers to a slower bank. Included from the linker
+# script (INCLUDE mpools.ld), regenerated by the armgcc Makefile.
+
+_MAGNITUDE = {"BYTES": 1, "KBYTES": 1024, "MBYTES": 1024 * 1024}
+
+# firmware MEMORY regions checked against the writable pools
+_REGIONS = ("AXISRAM1_S", "DTCM_S")
+
+logger = logging.getLogger(__name__)
+
+
+def set_logger():
+    logger.setLevel(logging.DEBUG)
+    ch = logging.StreamHandler()
+    ch.setLevel(logging.INFO)
+    formatter = logging.Formatter('%(asctime)s  %(name)s -- %(message)s', datefmt='%m/%d/%Y %I:%M:%S %p')
+    ch.setFormatter(formatter)
+    logger.addHandler(ch)
+
+
+def load_mpool(path: Path) -> dict:
+    """Parses an .mpool file, repairing the stray missing-quote typos some
+    of the checked-in descriptors carry"""
+    text = path.read_text()
+    try:
+        return json.loads(text)
+    except json.JSONDecodeError:
+        repaired = re.sub(r'(?<=[,{\s])(\w+)":', r'"\1":', text)
+        return json.loads(repaired)
+
+
+def scaled(field: dict) -> int:
+    """Returns a {value, magnitude} descriptor field in bytes"""
+    return int(str(field["value"]), 0) * _MAGNITUDE[field.get("magnitude", "BYTES")]
+
+
+def read_pools(path: Path) -> List[Tuple[str, int, int, bool]]:
+    """Returns the (name, base, size, writable) pools of the descriptor"""
+    mpool = load_mpool(path)
+    pools = []
+    for pool in mpool["memory"]["mempools"]:
+        size = scaled(pool["size"])
+        if size == 0:
+            continue  # pool disabled in this configuration
+        writable = pool.get("prop", {}).get("rights", "") == "ACC_WRITE"
+        pools.append((pool["name"], scaled(pool["offset"]), size, writable))
+    return pools
+
+
+def emit_fragment(pools: List[Tuple[str, int, int, bool]], source: str) -> str:
+    lines = [
+        f"/* Generated by gen_mpool_ld.py from {source} - do not edit.",
+        "   NPU memory pool windows as the NeuralArt compiler assumed them;",
+        "   the ASSERTs fail the link when a firmware region drifts into a",
+        "   writable pool. */",
+        "",
+    ]
+    for name, base, size, _ in pools:
+        lines.append(f"__mpool_{name} = 0x{base:08x};")
+        lines.append(f"__mpool_{name}_end = 0x{base + size:08x};")
+    lines.append("")
+    for name, base, size, writable in pools:
+        if not writable:
+            continue  # read-only pools (weights flash) cannot be clobbered by the firmware
+        for region in _REGIONS:
+            lines.append(
+                f"ASSERT(ORIGIN({region}) + LENGTH({region}) <= __mpool_{name} ||\n"
+                f"       ORIGIN({region}) >= __mpool_{name}_end,\n"
+                f'       "{region} overlaps NPU memory pool {name}")')
+    lines.append("")
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate a linker placement fragment from an .mpool descriptor")
+    parser.add_argument("mpool", type=Path, help="NeuralArt memory pool descriptor (my_mpools/*.mpool)")
+    parser.add_argument("-o", "--output", type=Path, required=True, help="output linker fragment")
+    args = parser.parse_args()
+
+    set_logger()
+
+    try:
+        pools = read_pools(args.mpool)
+        fragment = emit_fragment(pools, args.mpool.name)
+    except (ValueError, KeyError, json.JSONDecodeError, OSError) as exc:
+        logger.error(f"{args.mpool}: {exc}")
+        return 1
+
+    args.output.write_text(fragment)
+    for name, base, size, writable in pools:
+        logger.info(f"  {name:<12s} 0x{base:08x} +{size:#x}{'' if writable else ' (ro)'}")
+    logger.info(f"{args.output}: {len(pools)} pool(s)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
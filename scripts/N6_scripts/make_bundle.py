@@ -0,0 +1,126 @@
+from __future__ import annotations
+import argparse
+import logging
+import struct
+import sys
+import zlib
+from pathlib import Path
+from typing import List, Tuple
+
+# Packs deploy artifacts (reloc binary, EC blobs, weights image) into the
+# model bundle container installed in one pass by the firmware
+# (_CMD_BUNDLE_INSTALL, see aiValidation_ATON.c). Layout, uint32 little
+# endian:
+#
+#   directory: magic "NBDL", section count, then per section the
+#              destination address, stored (wire) size, installed size,
+#              flags (bit 0 = LZ4) and CRC32 of the stored bytes
+#   payload  : the section payloads back-to-back, in directory order
+#
+# With --lz4 each section is block-compressed (lz4.block, same stream the
+# Epoch Controller binaries use) and kept compressed only when the saving
+# clears the in-place inflation margin - the device receives a compressed
+# payload at the tail of its destination window and inflates forward, so
+# the stored stream must stay ahead of the write pointer.
+
+BUNDLE_MAGIC = 0x4C44424E  # "NBDL"
+BUNDLE_FLAG_LZ4 = 1 << 0
+
+
+def inplace_margin(installed: int) -> int:
+    """Returns the LZ4 in-place decompression margin for a section"""
+    return (installed >> 8) + 32
+
+
+logger = logging.getLogger(__name__)
+
+
+def set_logger():
+    logger.setLevel(logging.DEBUG)
+    ch = logging.StreamHandler()
+    ch.setLevel(logging.INFO)
+    formatter = logging.Formatter('%(asctime)s  %(name)s -- %(message)s', datefmt='%m/%d/%Y %I:%M:%S %p')
+    ch.setFormatter(formatter)
+    logger.addHandler(ch)
+
+
+def parse_section_arg(arg: str) -> Tuple[int, Path]:
+    """Returns the (destination address, path) of an 'ADDR=FILE' argument"""
+    addr, sep, path = arg.partition("=")
+    if not sep or not path:
+        raise ValueError(f"'{arg}': expected ADDR=FILE")
+    return int(addr, 0), Path(path)
+
+
+def lz4_block_compress(raw: bytes) -> bytes:
+    """Returns the raw LZ4 block stream of the data"""
+    try:
+        import lz4.block
+    except ImportError:
+        raise RuntimeError(
+            "The 'lz4' package is required to compress bundle sections "
+            "(pip install lz4)")
+    return lz4.block.compress(raw, store_size=False, mode="high_compression")
+
+
+def build_sections(specs: List[Tuple[int, Path]], use_lz4: bool) -> List[Tuple[int, int, int, bytes]]:
+    """Returns the (address, installed size, flags, stored payload) sections"""
+    sections = []
+    for addr, path in specs:
+        raw = path.read_bytes()
+        if not raw:
+            raise ValueError(f"{path}: empty section")
+        flags = 0
+        stored = raw
+        if use_lz4:
+            packed = lz4_block_compress(raw)
+            if len(packed) + inplace_margin(len(raw)) <= len(raw):
+                stored = packed
+                flags = BUNDLE_FLAG_LZ4
+        sections.append((addr, len(raw), flags, stored))
+        note = f"lz4 {len(stored):,d}" if flags else "raw"
+        logger.info(f"  0x{addr:08x} {len(raw):>10,d} bytes ({note}, {path})")
+    return sections
+
+
+def pack_bundle(sections: List[Tuple[int, int, int, bytes]]) -> bytes:
+    """Returns the packed bundle image"""
+    directory = struct.pack("<II", BUNDLE_MAGIC, len(sections))
+    payload = b""
+    for addr, installed, flags, stored in sections:
+        crc = zlib.crc32(stored) & 0xFFFFFFFF
+        directory += struct.pack("<IIIII", addr, len(stored), installed, flags, crc)
+        payload += stored
+    return directory + payload
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Pack deploy artifacts into a single-pass install bundle")
+    parser.add_argument("sections", nargs="+", metavar="ADDR=FILE",
+                        help="section payload and its destination address on the device")
+    parser.add_argument("--lz4", action="store_true",
+                        help="LZ4-compress sections (kept raw when the saving does not "
+                             "clear the in-place inflation margin)")
+    parser.add_argument("-o", "--output", type=Path, required=True, help="output bundle image")
+    args = parser.parse_args()
+
+    set_logger()
+
+    try:
+        specs = [parse_section_arg(arg) for arg in args.sections]
+        sections = build_sections(specs, args.lz4)
+        bundle = pack_bundle(sections)
+    except (ValueError, RuntimeError, OSError) as exc:
+        logger.error(f"{exc}")
+        return 1
+
+    args.output.write_bytes(bundle)
+    wire = sum(len(s[3]) for s in sections)
+    installed = sum(s[1] for s in sections)
+    logger.info(f"{args.output}: {len(sections)} section(s), "
+                f"{wire:,d} bytes on the wire for {installed:,d} installed")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,6 +1,8 @@
 from __future__ import annotations
 import logging
 import argparse
+import hashlib
+import json
 from pathlib import Path
 from typing import List
 import subprocess
@@ -124,6 +126,29 @@ def safe_copy(src: Path, dst: Path):
         raise FileNotFoundError(f"{str(src)} does not exists")
 
 
+## Incremental flashing: digests of what was last flashed, per board/memory
+FLASH_STATE_PATH = Path(__file__).with_name("n6_loader_flash_state.json")
+
+def flash_state_load() -> dict:
+    """Loads the digests of the last successfully flashed memory files"""
+    try:
+        return json.loads(FLASH_STATE_PATH.read_text())
+    except (OSError, ValueError):
+        return {}
+
+def flash_state_save(state: dict):
+    """Persists the digests of the flashed memory files"""
+    try:
+        FLASH_STATE_PATH.write_text(json.dumps(state, indent=1))
+    except OSError as e:
+        log(logging.ERROR, f"Could not save the flash state file ({e})")
+
+def hexfile_digest(mf: Path) -> str:
+    """Digest of a hex dump (objcopy output is deterministic: same raw
+    content and offset -> same hex file)"""
+    return hashlib.sha256(Path(mf).read_bytes()).hexdigest()
+
+
 def main_n6_loader(path_to_network_c:List[Path] = None,
                    path_to_memorydumps:Path = None,
                    clean_before_build:bool = False,
@@ -270,6 +295,16 @@ def main_n6_loader(path_to_network_c:List[Path] = None,
     log(logging.DEBUG, f"Launching command: {' '.join(cmd)}")
     log(logging.DEBUG, result.stdout.decode('utf-8').replace("\r\n","\n"))
     
+    # Incremental flashing: skip the external memories whose content did not
+    # change since the last successful flash on this board. The loader runs
+    # right after a powerdown reset (no firmware up yet), so the resident
+    # state is tracked host-side; any actually flashed file is still passed
+    # with --verify.
+    incremental = bool(getattr(args, "flash_incremental", False))
+    flash_state = flash_state_load() if incremental else {}
+    flash_state_dirty = False
+    board_key = f"{stlink_sn or 'default'}:{port}"
+
     # Add memories
     for mf in mem_hex_dumps:
         mem_file_type = mf.suffixes[0][1:]
@@ -280,9 +315,14 @@ def main_n6_loader(path_to_network_c:List[Path] = None,
             cmd = [str(path_to_cube), '-q', '-c', 'port='+port, 'mode=hotplug', 'ap=1', '--extload', flshl, '--download', str(mf), "--verify"]
             if stlink_sn:
                 cmd.insert(cmd.index("port=SWD")+1, f"sn={stlink_sn}")
-            
+
+            state_key = f"{board_key}:{mem_file_type}"
+            digest = hexfile_digest(mf) if incremental else None
+
             if skip_extflash_prog:
                 log(logging.INFO, f"Skipping flashing memory {mem_file_type} -- {size_kb:,.3f} kB")
+            elif incremental and flash_state.get(state_key) == digest:
+                log(logging.INFO, f"Memory {mem_file_type} unchanged since last flash, skipping -- {size_kb:,.3f}".replace(',', ' ') + " kB")
             else:
                 log(logging.INFO, f"Flashing memory {mem_file_type} -- {size_kb:,.3f}".replace(',', ' ') + " kB")
                 result = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
@@ -291,7 +331,14 @@ def main_n6_loader(path_to_network_c:List[Path] = None,
 
                 if result.returncode:
                     log(logging.INFO, f"Flashing memory {mem_file_type} -- return code ERROR")
+                    if incremental:
+                        # resident content is unknown, force a reflash next time
+                        flash_state.pop(state_key, None)
+                        flash_state_save(flash_state)
                     return result.returncode
+                if incremental:
+                    flash_state[state_key] = digest
+                    flash_state_dirty = True
         else:
             if skip_ramdata_prog:
                 log(logging.INFO, f"""Not planning to load ram data {mem_file_type} -- {size_kb:,.3f}kB""")
@@ -299,8 +346,11 @@ def main_n6_loader(path_to_network_c:List[Path] = None,
                 log(logging.INFO, f"""Loading {mem_file_type} after program start -- {size_kb:,.3f}kB""")
                 compiler.add_memory_file_to_load(mem_file_type, Path(mf).resolve())
 
+    if flash_state_dirty:
+        flash_state_save(flash_state)
+
     compiler.dump_macro_file()
-    
+
     if not skip_build:
         step_s = f"Building project (conf= {build_conf})"
         if clean_before_build is True:
@@ -332,6 +382,8 @@ if __name__ == "__main__":
     parser.add_argument("--port", dest="st_link_port", default='SWD', help="Force the use of CubeProgrammer port (default: SWD)")
     parser.add_argument("--clean", action="store_true", dest="project_clean",
                     default=False, help="Clean the project before building it (default: False)")
+    parser.add_argument("--incremental", action="store_true", dest="flash_incremental",
+                    default=False, help="Only flash the external memories whose content changed since the last flash (default: False)")
     N6LoaderConfig.add_args(parser=parser)
     args = parser.parse_args()
 
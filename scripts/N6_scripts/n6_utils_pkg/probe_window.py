@@ -0,0 +1,157 @@
+"""
+Host side of the probe-visible bulk-readback window (USE_PROBE_WINDOW builds)
+
+The firmware publishes a region descriptor in a fixed 64-byte SRAM slot at
+the top of AXISRAM1 (see .probe_window in STM32N657xx.ld and
+aiPbCmdProbeWindow() in aiPbMemRWServices.c). This module reads the
+descriptor and dumps the published region through the debug probe
+(STM32CubeProgrammer CLI, hotplug connection - the firmware keeps running)
+while the CDC/UART link carries only the control traffic, so both paths
+move data at once.
+
+Consistency protocol: the descriptor sequence count is odd while the
+firmware updates it; the host samples the descriptor before and after the
+region dump and retries when the counts differ. The token field echoes the
+reqid of the publishing request, so a caller driving the CDC link can match
+the window against its own publish command.
+"""
+
+from dataclasses import dataclass
+from pathlib import Path
+import logging
+import re
+import struct
+import subprocess
+import tempfile
+
+log = logging.getLogger(__name__)
+
+# Keep in sync with the firmware side (aiPbMemRWServices.c / STM32N657xx.ld)
+PROBE_WINDOW_ADDR = 0x340FFFC0
+PROBE_WINDOW_MAGIC = 0x30574250  # 'PBW0'
+_DESC_SIZE = 32                  # magic, seq, addr, size, token, reserved[3]
+
+
+@dataclass
+class ProbeWindowDesc:
+    """Decoded descriptor slot"""
+    magic: int
+    seq: int
+    addr: int
+    size: int
+    token: int
+
+    @property
+    def stable(self) -> bool:
+        """True when the descriptor is valid and no update is in flight"""
+        return self.magic == PROBE_WINDOW_MAGIC and (self.seq % 2) == 0
+
+    @property
+    def published(self) -> bool:
+        """True when a region is currently published"""
+        return self.stable and self.addr != 0 and self.size != 0
+
+
+class ProbeWindowReader:
+    """
+    Bulk memory readback through the debug probe
+
+    Wraps STM32CubeProgrammer CLI calls with the connection arguments used
+    by the loaders (hotplug, access port 1): the target is not halted nor
+    reset, the reads run concurrently with the firmware.
+    """
+
+    def __init__(self, path_to_cube_programmer: Path, port: str = 'SWD',
+                 st_link_sn: str = None):
+        """
+        :param path_to_cube_programmer: Path to the STM32_Programmer_CLI binary
+        :param port: Port to use when calling CubeProgrammer (default: SWD)
+        :param st_link_sn: ST-Link serial number (optional)
+        """
+        self._cube = Path(path_to_cube_programmer)
+        self._connect = ['-q', '-c', f'port={port}', 'mode=hotplug',
+                         'freq=2000', 'ap=1']
+        if st_link_sn:
+            self._connect.insert(self._connect.index(f'port={port}') + 1,
+                                 f'sn={st_link_sn}')
+
+    def _cli(self, *args) -> str:
+        cmd = [str(self._cube), *self._connect, *args]
+        log.debug("Launching command: %s", ' '.join(cmd))
+        result = subprocess.run(cmd, stdout=subprocess.PIPE,
+                                stderr=subprocess.STDOUT)
+        out = result.stdout.decode('utf-8', errors='replace').replace("\r\n", "\n")
+        if result.returncode:
+            log.debug(out)
+            raise RuntimeError(
+                f"STM32_Programmer_CLI failed (rc={result.returncode}): "
+                f"{' '.join(args)}")
+        return out
+
+    def read_descriptor(self) -> ProbeWindowDesc:
+        """
+        Read and decode the descriptor slot
+
+        :return: the decoded descriptor
+        """
+        out = self._cli('-r32', f'{PROBE_WINDOW_ADDR:#010x}', str(_DESC_SIZE))
+        # output lines: "0x340FFFC0 : 30574250 00000002 ..."
+        words = []
+        for line in out.splitlines():
+            m = re.match(r"\s*0x[0-9A-Fa-f]{8}\s*:\s*((?:[0-9A-Fa-f]{8}\s*)+)",
+                         line)
+            if m:
+                words += [int(w, 16) for w in m.group(1).split()]
+        if len(words) < _DESC_SIZE // 4:
+            raise RuntimeError("Could not parse the descriptor readback:\n" + out)
+        return ProbeWindowDesc(*words[:5])
+
+    def read_region(self, addr: int, size: int) -> bytes:
+        """
+        Dump an arbitrary region through the probe (no descriptor handshake)
+
+        :param addr: region base address
+        :param size: region size in bytes
+        :return: the region contents
+        """
+        with tempfile.TemporaryDirectory() as tmp:
+            dump = Path(tmp) / "probe_window.bin"
+            self._cli('-u', f'{addr:#010x}', f'{size:#x}', str(dump))
+            data = dump.read_bytes()
+        if len(data) < size:
+            raise RuntimeError(
+                f"Short probe read: {len(data)} of {size} bytes @ {addr:#x}")
+        return data[:size]
+
+    def read_window(self, token: int = None, retries: int = 4) -> bytes:
+        """
+        Read the currently published region
+
+        :param token: when given, the descriptor token (reqid of the publish
+                      command) must match - guards against reading a stale
+                      window
+        :param retries: re-read attempts when the firmware republishes the
+                        window mid-dump
+        :return: the region contents
+        :raises RuntimeError: no stable published window, token mismatch or
+                              the window kept moving
+        """
+        for _ in range(retries):
+            desc = self.read_descriptor()
+            if not desc.published:
+                raise RuntimeError(
+                    f"No published probe window (magic={desc.magic:#010x}, "
+                    f"seq={desc.seq})")
+            if token is not None and desc.token != token:
+                raise RuntimeError(
+                    f"Probe window token mismatch (got {desc.token}, "
+                    f"expected {token})")
+            data = self.read_region(desc.addr, desc.size)
+            check = self.read_descriptor()
+            if check.stable and check.seq == desc.seq:
+                log.debug("Probe window read: %d bytes @ %#x (seq=%d)",
+                          desc.size, desc.addr, desc.seq)
+                return data
+            log.debug("Probe window moved during the dump (seq %d -> %d), "
+                      "retrying", desc.seq, check.seq)
+        raise RuntimeError("Probe window kept moving, giving up")
@@ -0,0 +1,131 @@
+from __future__ import annotations
+import argparse
+import logging
+import struct
+import sys
+from pathlib import Path
+from typing import List, Tuple
+
+# Repacks a params pool image into the 4-bit packed container staged by the
+# firmware when it is built with USE_WEIGHTS_4BIT=1 (see the lazy-params
+# staging in ai_wrapper_ATON.c). Parameter windows whose int8 weights all
+# fit in [-8, 7] are stored two per byte (low nibble first, sign extended
+# on unpack); everything else - ineligible windows and the gaps between
+# windows - stays byte per byte. Layout, all little endian:
+#
+#   header : magic "W4PK" (u32), unpacked pool size (u32), range count
+#            (u32), reserved (u32)
+#   ranges : per range the pool offset (u32), the unpacked size (u32), the
+#            payload offset (u32) and the packed flag (u32)
+#   payload: the range data; byte-per-byte ranges keep their pool offset
+#            congruence modulo 8 so the staging DMA source alignment is
+#            preserved, packed ranges are unpacked by the CPU
+#
+# The window list is one "offset,size" pair per line (hex or decimal, '#'
+# comments), i.e. the parameter windows of the model in pool order.
+
+W4_MAGIC = 0x4B503457  # "W4PK"
+_ALIGN = 8
+
+logger = logging.getLogger(__name__)
+
+
+def set_logger():
+    logger.setLevel(logging.DEBUG)
+    ch = logging.StreamHandler()
+    ch.setLevel(logging.INFO)
+    formatter = logging.Formatter('%(asctime)s  %(name)s -- %(message)s', datefmt='%m/%d/%Y %I:%M:%S %p')
+    ch.setFormatter(formatter)
+    logger.addHandler(ch)
+
+
+def read_windows(path: Path, pool_size: int) -> List[Tuple[int, int]]:
+    """Returns the sorted, validated (offset, size) parameter windows"""
+    windows = []
+    for raw in path.read_text().splitlines():
+        line = raw.split("#", 1)[0].strip()
+        if not line:
+            continue
+        offset, size = (int(f.strip(), 0) for f in line.split(","))
+        if size <= 0 or offset < 0 or (offset + size) > pool_size:
+            raise ValueError(f"window {offset:#x},{size:#x} outside the {pool_size:#x} byte pool")
+        windows.append((offset, size))
+    windows.sort()
+    for (o1, s1), (o2, _) in zip(windows, windows[1:]):
+        if (o1 + s1) > o2:
+            raise ValueError(f"overlapping windows at {o1:#x} and {o2:#x}")
+    return windows
+
+
+def is_packable(data: bytes) -> bool:
+    """True when every byte, read as int8, fits in [-8, 7]"""
+    return all(b <= 0x07 or b >= 0xF8 for b in data)
+
+
+def pack_nibbles(data: bytes) -> bytes:
+    """Packs int8 values into two-per-byte nibbles, low nibble first"""
+    if len(data) % 2:
+        data += b"\0"
+    return bytes(((data[i] & 0x0F) | ((data[i + 1] & 0x0F) << 4)) for i in range(0, len(data), 2))
+
+
+def build_ranges(pool: bytes, windows: List[Tuple[int, int]]) -> List[Tuple[int, int, bool, bytes]]:
+    """Returns the (dst_off, dst_size, packed, data) ranges covering the pool"""
+    ranges = []
+    plain_start = 0  # start of the pending byte-per-byte run
+    for offset, size in windows:
+        data = pool[offset:offset + size]
+        if not is_packable(data):
+            continue  # absorbed by the surrounding plain run
+        if offset > plain_start:
+            ranges.append((plain_start, offset - plain_start, False, pool[plain_start:offset]))
+        ranges.append((offset, size, True, pack_nibbles(data)))
+        plain_start = offset + size
+    if plain_start < len(pool):
+        ranges.append((plain_start, len(pool) - plain_start, False, pool[plain_start:]))
+    return ranges
+
+
+def pack_container(pool: bytes, ranges: List[Tuple[int, int, bool, bytes]]) -> bytes:
+    """Returns the packed container image"""
+    directory = struct.pack("<IIII", W4_MAGIC, len(pool), len(ranges), 0)
+    payload = b""
+    for dst_off, dst_size, packed, data in ranges:
+        # byte-per-byte ranges keep the pool offset congruence modulo the
+        # DMA alignment, packed ranges only need the nibble stream
+        want = 0 if packed else dst_off % _ALIGN
+        payload += b"\0" * ((want - len(payload)) % _ALIGN)
+        directory += struct.pack("<IIII", dst_off, dst_size, len(payload), int(packed))
+        payload += data
+    return directory + payload
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Repack a params pool image with 4-bit packed weight windows")
+    parser.add_argument("image", type=Path, help="plain params pool image")
+    parser.add_argument("windows", type=Path, help="parameter window list, one 'offset,size' per line")
+    parser.add_argument("-o", "--output", type=Path, required=True, help="output packed container")
+    args = parser.parse_args()
+
+    set_logger()
+
+    try:
+        pool = args.image.read_bytes()
+        windows = read_windows(args.windows, len(pool))
+        ranges = build_ranges(pool, windows)
+        container = pack_container(pool, ranges)
+    except (ValueError, OSError) as exc:
+        logger.error(f"{exc}")
+        return 1
+
+    n_packed = sum(1 for r in ranges if r[2])
+    saved = sum(r[1] - len(r[3]) for r in ranges if r[2])
+    logger.info(f"{len(windows)} window(s), {n_packed} packed, {len(ranges)} range(s)")
+    logger.info(f"{args.output}: {len(container):,d} bytes "
+                f"({len(pool):,d} plain, {saved:,d} saved in packed windows)")
+    args.output.write_bytes(container)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
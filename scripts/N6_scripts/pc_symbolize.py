@@ -0,0 +1,101 @@
+from __future__ import annotations
+import logging
+import argparse
+import bisect
+import re
+import shutil
+import subprocess
+import sys
+from pathlib import Path
+from typing import Dict, List, Tuple
+
+# Symbolizes the SysTick PC samples emitted by the firmware when it is
+# built with USE_PC_SAMPLING=1 and the RUN command is issued with the
+# debug option. Input is either the captured console log (the "s:pcs:s:"
+# lines, colon-separated hex PCs) or a plain list of hex addresses, one
+# or more per line. Output is a per-function sample histogram sorted by
+# sample count, i.e. where the software epochs spend their time.
+
+logger = logging.getLogger(__name__)
+
+
+def set_logger():
+    logger.setLevel(logging.DEBUG)
+    ch = logging.StreamHandler()
+    ch.setLevel(logging.INFO)
+    formatter = logging.Formatter('%(asctime)s  %(name)s -- %(message)s', datefmt='%m/%d/%Y %I:%M:%S %p')
+    ch.setFormatter(formatter)
+    logger.addHandler(ch)
+
+
+def read_symbols(elf: Path, nm: str) -> List[Tuple[int, int, str]]:
+    """Returns the sorted (start, size, name) list of the ELF function symbols"""
+    cmd = [nm, "--print-size", "--size-sort", "--radix=x", str(elf)]
+    out = subprocess.run(cmd, capture_output=True, text=True, check=True).stdout
+    symbols = []
+    for line in out.splitlines():
+        # <addr> <size> <type> <name>
+        m = re.match(r"([0-9a-fA-F]+)\s+([0-9a-fA-F]+)\s+[tTwW]\s+(\S+)", line)
+        if m:
+            symbols.append((int(m.group(1), 16), int(m.group(2), 16), m.group(3)))
+    symbols.sort()
+    return symbols
+
+
+def read_samples(log_file: Path) -> List[int]:
+    samples = []
+    for line in log_file.read_text(errors="replace").splitlines():
+        m = re.search(r"s:pcs:s:(.*)", line)
+        fields = m.group(1).split(":") if m else line.replace(":", " ").split()
+        for field in fields:
+            try:
+                samples.append(int(field.strip(), 16))
+            except ValueError:
+                pass  # not a hex PC (prompt noise, other s-msgs, ...)
+    return samples
+
+
+def symbolize(samples: List[int], symbols: List[Tuple[int, int, str]]) -> Dict[str, int]:
+    starts = [s[0] for s in symbols]
+    histogram: Dict[str, int] = {}
+    for pc in samples:
+        # Thumb: bit 0 of the stacked PC is part of the xPSR restore, clear it
+        pc &= ~1
+        i = bisect.bisect_right(starts, pc) - 1
+        name = "<unknown>"
+        if i >= 0:
+            start, size, sym = symbols[i]
+            if size == 0 or pc < start + size:
+                name = sym
+        histogram[name] = histogram.get(name, 0) + 1
+    return histogram
+
+
+def main() -> int:
+    set_logger()
+    parser = argparse.ArgumentParser(description="Symbolize firmware PC samples against the ELF")
+    parser.add_argument("elf", type=Path, help="firmware ELF file (network_validate.elf)")
+    parser.add_argument("log", type=Path, help="console log with s:pcs lines, or raw hex PC list")
+    parser.add_argument("--nm", default="arm-none-eabi-nm", help="nm binary to use")
+    args = parser.parse_args()
+
+    if shutil.which(args.nm) is None:
+        logger.error(f"{args.nm} not found in PATH")
+        return 1
+
+    symbols = read_symbols(args.elf, args.nm)
+    samples = read_samples(args.log)
+    if not samples:
+        logger.error(f"no PC samples found in {args.log}")
+        return 1
+    logger.info(f"{len(samples)} samples, {len(symbols)} function symbols")
+
+    histogram = symbolize(samples, symbols)
+    total = len(samples)
+    for name, count in sorted(histogram.items(), key=lambda kv: kv[1], reverse=True):
+        print(f"{count:8d}  {100.0 * count / total:5.1f}%  {name}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
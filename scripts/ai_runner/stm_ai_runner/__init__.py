@@ -13,6 +13,8 @@ from .ai_runner import AiRunner  # noqa:F401
 from .ai_runner import AiRunnerCallback  # noqa:F401
 from .ai_runner import AiRunnerSession  # noqa:F401
 from .ai_interpreter import AiRunnerInterpreter  # noqa:F401
+from .ai_runner_pool import AiRunnerPool  # noqa:F401
+from .ai_runner_pool import pool_device_discovery  # noqa:F401
 
 from .ai_resolver import is_valid_exec_domain  # noqa:F401
 from .stm32_utility import dump_ihex_file  # noqa:F401
@@ -157,6 +157,13 @@ class AiHwDriver(ABC):
     def _read(self, size, timeout=0):
         return 0
 
+    def _readinto(self, buffer, timeout=0):
+        """Default: emulated with _read() and one copy"""  # noqa: DAR101,DAR201,DAR401
+        data = self._read(len(buffer), timeout)
+        n_read = len(data)
+        buffer[:n_read] = data
+        return n_read
+
     @abstractmethod
     def _write(self, data, timeout=0):
         return 0
@@ -181,6 +188,12 @@ class AiHwDriver(ABC):
             return self._read(size, timeout)
         raise NotConnectedError()
 
+    def readinto(self, buffer, timeout=0):
+        """Read the data directly into a preallocated buffer"""  # noqa: DAR101,DAR201,DAR401
+        if self.is_connected:
+            return self._readinto(buffer, timeout)
+        raise NotConnectedError()
+
     def write(self, data, timeout=0):
         """Write the data"""  # noqa: DAR101,DAR201,DAR401
         if self.is_connected:
@@ -804,6 +817,19 @@ class AiRunner:
 
         start_time = t.perf_counter()
         outputs = []
+
+        if (batch_size > 1 and callback is None and m_outputs is None
+                and not io_extra_bytes and mode == AiRunner.Mode.IO_ONLY):
+            # protocol-level batching: one exchange carries the whole sample
+            # train, the driver returns None when the target can not do it
+            invoke_batch_ = getattr(self._drv, 'invoke_batch', None)
+            b_outputs = invoke_batch_(inputs, name=name_, profiler=profiler,
+                                      option=option) if invoke_batch_ else None
+            if b_outputs is not None:
+                profiler['debug']['host_duration'] = (t.perf_counter() - start_time) * 1000.0
+                profiler['info'] = self.get_info(name_)
+                return self._check_outputs(b_outputs, out_desc, io_mode), profiler
+
         prog_bar = None
         cont = True
         for batch in range(batch_size):
@@ -815,6 +841,11 @@ class AiRunner:
             elif prog_bar:
                 prog_bar.update(1)
             s_inputs = [np.expand_dims(in_[batch], axis=0) for in_ in inputs]
+            if batch + 1 < batch_size:
+                # allow the driver to prefetch the next sample (pipelined RUN)
+                next_inputs = [np.expand_dims(in_[batch + 1], axis=0) for in_ in inputs]
+            else:
+                next_inputs = None
             if m_outputs:
                 ms_outputs = [np.expand_dims(out_[batch], axis=0) for out_ in m_outputs]
             else:
@@ -826,6 +857,7 @@ class AiRunner:
                                                        io_extra_bytes=io_extra_bytes,
                                                        sample_idx=batch,
                                                        option=option,
+                                                       next_inputs=next_inputs,
                                                        callback=callback, ms_outputs=ms_outputs)
             if batch == 0:
                 outputs = s_outputs
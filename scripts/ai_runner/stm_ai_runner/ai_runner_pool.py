@@ -0,0 +1,291 @@
+###################################################################################
+#   Copyright (c) 2021, 2024 STMicroelectronics.
+#   All rights reserved.
+#   This software is licensed under terms that can be found in the LICENSE file in
+#   the root directory of this software component.
+#   If no LICENSE file comes with this software, it is provided AS-IS.
+###################################################################################
+"""
+STM AI runner - multi-device pool
+
+Drives several boards exposing the same model(s) as one logical runner:
+the sample batch is sharded across the pool, each shard runs on its own
+board in parallel and the merged outputs come back in sample order with
+per-board provenance in the profiler.
+
+!!! example
+    ```python
+       from stm_ai_runner import AiRunnerPool
+       pool = AiRunnerPool()
+       pool.connect()              # every STLink VCP found, or pass a list
+       outputs, profiler = pool.invoke(input_data)
+       print(profiler['pool']['boards'])
+       pool.disconnect()
+    ```
+"""
+
+import logging
+from concurrent.futures import ThreadPoolExecutor
+from typing import Dict, List, Optional, Tuple, Union
+
+import numpy as np
+
+from .ai_runner import AiRunner
+from .serial_hw_drv import serial_device_discovery
+from .utils import get_logger
+
+
+__version__ = '1.0'
+
+
+def pool_device_discovery(filter_desc: str = 'STLink') -> List[str]:
+    """
+    Scan the serial ports for pool candidates.
+
+    Parameters
+    ----------
+    filter_desc
+        substring the port description must contain ('' keeps everything,
+        the default keeps the STLink Virtual COM ports)
+
+    Returns
+    -------
+    List[str]
+        connection descriptors ('serial:<device>'), one per board
+    """
+    devs = serial_device_discovery()
+    return ['serial:' + dev['device'] for dev in devs
+            if not filter_desc or filter_desc in dev['desc']]
+
+
+class AiRunnerPool:
+    """Pool of AiRunner instances presented as one logical runner.
+
+    Each board keeps its own AiRunner (and its own serial link, protocol
+    state and log file context); the pool only coordinates sharding and
+    aggregation, so everything a single runner accepts is valid here.
+    Per-layer profiling and callbacks are inherently per-board: when they
+    are requested, the whole batch is routed to the first board and the
+    pool degrades to a single-device runner for that call.
+    """
+
+    def __init__(self, logger=None, debug=False, verbosity=0):
+        """
+        Constructor
+
+        Parameters
+        ----------
+        logger
+            Logger object which must be used
+        debug
+            Logger is created with DEBUG level if True
+        verbosity
+            Logger is created with INFO level if > 0
+        """
+        if logger is None:
+            lvl = logging.DEBUG if debug else logging.INFO
+            logger = get_logger(self.__class__.__name__, lvl)
+        self._logger = logger
+        self._debug = debug
+        self._verbosity = verbosity
+        self._runners: List[AiRunner] = []
+        self._descs: List[str] = []
+        self._names: List[str] = []
+
+    @property
+    def is_connected(self) -> bool:
+        """Indicate if at least one board is connected"""
+        # noqa: DAR101,DAR201,DAR401
+        return any(r.is_connected for r in self._runners)
+
+    @property
+    def size(self) -> int:
+        """Return the number of connected boards"""
+        # noqa: DAR101,DAR201,DAR401
+        return sum(1 for r in self._runners if r.is_connected)
+
+    @property
+    def names(self) -> List[str]:
+        """Return the models available on every board of the pool"""
+        # noqa: DAR101,DAR201,DAR401
+        return self._names
+
+    @property
+    def boards(self) -> List[str]:
+        """Return the connection descriptors of the connected boards"""
+        # noqa: DAR101,DAR201,DAR401
+        return [d for d, r in zip(self._descs, self._runners) if r.is_connected]
+
+    def connect(self, descs: Optional[List[str]] = None, **kwargs) -> bool:
+        """
+        Connect the pool.
+
+        Parameters
+        ----------
+        descs
+            list of connection descriptors, one per board; None discovers
+            every STLink Virtual COM port
+        kwargs
+            forwarded to each AiRunner.connect()
+
+        Returns
+        -------
+        bool
+            True if at least one board is connected
+        """
+        self.disconnect()
+        if descs is None:
+            descs = pool_device_discovery()
+        for desc in descs:
+            runner = AiRunner(debug=self._debug, verbosity=self._verbosity)
+            if runner.connect(desc, **kwargs):
+                self._runners.append(runner)
+                self._descs.append(desc)
+                self._logger.debug('pool: "%s" connected (%s)', desc, runner.names)
+            else:
+                self._logger.warning('pool: "%s" not connected: %s', desc, runner.get_error())
+        # only the models present on every board can be sharded
+        if self._runners:
+            names = set(self._runners[0].names)
+            for runner in self._runners[1:]:
+                names &= set(runner.names)
+            self._names = [n for n in self._runners[0].names if n in names]
+            for desc, runner in zip(self._descs, self._runners):
+                extra = [n for n in runner.names if n not in names]
+                if extra:
+                    self._logger.warning('pool: "%s" models %s not on every board, ignored',
+                                         desc, extra)
+        return self.is_connected
+
+    def disconnect(self) -> bool:
+        """Close the connection with every board"""
+        # noqa: DAR101,DAR201,DAR401
+        for runner in self._runners:
+            runner.disconnect()
+        self._runners = []
+        self._descs = []
+        self._names = []
+        return True
+
+    def get_info(self, name: Optional[str] = None) -> Dict:
+        """Get model details from the first board of the pool"""
+        # noqa: DAR101,DAR201,DAR401
+        return self._runners[0].get_info(name) if self._runners else dict()
+
+    def get_inputs(self, name: Optional[str] = None):
+        """Get description of the input tensors (first board)"""
+        # noqa: DAR101,DAR201,DAR401
+        return self._runners[0].get_inputs(name) if self._runners else []
+
+    def get_outputs(self, name: Optional[str] = None):
+        """Get description of the output tensors (first board)"""
+        # noqa: DAR101,DAR201,DAR401
+        return self._runners[0].get_outputs(name) if self._runners else []
+
+    def generate_rnd_inputs(self, name=None, batch_size=4, rng=np.random.RandomState(42), val=None):
+        """Generate input data with random values (first board)"""
+        # noqa: DAR101,DAR201,DAR401
+        if not self._runners:
+            return []
+        return self._runners[0].generate_rnd_inputs(name=name, batch_size=batch_size,
+                                                    rng=rng, val=val)
+
+    def _shards(self, batch_size: int) -> List[Tuple[int, int]]:
+        """Contiguous (start, stop) shard per board, in board order"""
+        # noqa: DAR101,DAR201,DAR401
+        n_boards = self.size
+        base, rem = divmod(batch_size, n_boards)
+        shards = []
+        start = 0
+        for idx in range(n_boards):
+            stop = start + base + (1 if idx < rem else 0)
+            shards.append((start, stop))
+            start = stop
+        return shards
+
+    def invoke(self, inputs: Union[np.ndarray, List[np.ndarray]], **kwargs) -> Tuple[List[np.ndarray], Dict]:
+        """
+        Invoke the c-network, batch sharded across the pool.
+
+        Parameters
+        ----------
+        inputs
+            Input samples. A Numpy array, or a list of arrays in case where
+            the model has multiple inputs.
+        kwargs
+            specific parameters, forwarded to each AiRunner.invoke()
+
+        Returns
+        -------
+        tuple
+            (outputs in sample order, profiler of the first shard extended
+            with a 'pool' section carrying the per-board provenance)
+
+        Raises
+        ------
+        RuntimeError
+            when every shard failed
+        """
+        runners = [r for r in self._runners if r.is_connected]
+        descs = [d for d, r in zip(self._descs, self._runners) if r.is_connected]
+        if not isinstance(inputs, list):
+            inputs = [inputs]
+        batch_size = inputs[0].shape[0]
+
+        # per-board state (callbacks, per-layer dumps) can not be merged:
+        # keep the documented single-runner behavior on one board
+        if not runners:
+            return [], {}
+        if (len(runners) == 1 or batch_size == 1
+                or kwargs.get('callback') is not None
+                or kwargs.get('mode', AiRunner.Mode.IO_ONLY) != AiRunner.Mode.IO_ONLY):
+            return runners[0].invoke(inputs, **kwargs)
+
+        shards = self._shards(batch_size)
+
+        def _one(idx):
+            start, stop = shards[idx]
+            s_inputs = [in_[start:stop] for in_ in inputs]
+            return runners[idx].invoke(s_inputs, disable_pb=True, **dict(kwargs))
+
+        results: List = [None] * len(shards)
+        with ThreadPoolExecutor(max_workers=len(shards)) as executor:
+            futures = {executor.submit(_one, idx): idx for idx in range(len(shards))}
+            for fut, idx in futures.items():
+                try:
+                    results[idx] = fut.result()
+                except Exception as exc:  # noqa: B902
+                    self._logger.error('pool: "%s" shard failed: %s', descs[idx], exc)
+
+        # failed shards are replayed on the first healthy board, the suite
+        # completes (slower) instead of losing the samples
+        retry_on = next((i for i, r in enumerate(results) if r is not None), None)
+        if retry_on is None:
+            raise RuntimeError('pool: every shard failed')
+        for idx, res in enumerate(results):
+            if res is None:
+                start, stop = shards[idx]
+                s_inputs = [in_[start:stop] for in_ in inputs]
+                results[idx] = runners[retry_on].invoke(s_inputs, disable_pb=True,
+                                                        **dict(kwargs))
+                descs[idx] = descs[retry_on] + ' (retry)'
+
+        # merge: shards are contiguous and in board order, concatenation
+        # restores the sample order of the caller
+        outputs = [np.concatenate([res[0][o] for res in results], axis=0)
+                   for o in range(len(results[0][0]))]
+        profiler = results[0][1]
+        profiler['c_durations'] = [dur for res in results for dur in res[1]['c_durations']]
+        profiler['pool'] = {
+            'boards': [
+                {
+                    'desc': descs[idx],
+                    'samples': shards[idx][1] - shards[idx][0],
+                    'first_sample': shards[idx][0],
+                    'host_duration': res[1]['debug']['host_duration'],
+                    'c_durations': res[1]['c_durations'],
+                }
+                for idx, res in enumerate(results)
+            ],
+        }
+        return outputs, profiler
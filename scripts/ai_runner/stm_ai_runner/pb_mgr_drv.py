@@ -11,6 +11,8 @@ ST AI runner - Driver for proto buff messages
 
 import logging
 import os
+import pickle
+import struct
 import time as t
 from typing import List, Tuple, Dict
 
@@ -504,6 +506,98 @@ def _tensor_to_io_tensor(msg, name=None, tag=None):
     return io_tensor
 
 
+# spare TENSOR_FLAG/CAP bits - LZ4-compressed tensor payloads (see aiPbLz4.c)
+_TENSOR_FLAG_LZ4 = 1 << 12
+_CAP_LZ4 = 64
+
+# spare CAP/RUN_PARAM bits - batched raw upload of the input tensors
+_CAP_BULK_IO = 4
+_RUN_CONF_BULK_WRITE = 1 << 12
+
+# spare RUN_PARAM bit - pipelined RUN, the inputs of the next sample are
+# streamed while the device executes the current one (bulk mode only). The
+# device reports an armed background reception with the MSB of the ack param.
+_RUN_CONF_PIPELINE = 1 << 13
+_ACK_FLAG_PIPE_ARMED = 1 << 31
+
+# spare EnumCmd value - host/device clock-sync probe, the ack echoes the
+# free-running device timestamp in us (see aiPbCmdClockSync)
+_CMD_CLOCK_SYNC = 17
+_CLOCK_SYNC_WRAP_US = 1 << 32
+
+# spare CAP/RUN_PARAM bits - batched multi-sample RUN, a single request
+# carries the whole sample train (count in the param high byte, bulk mode)
+_CAP_BATCH_RUN = 128
+_RUN_CONF_BATCH = 1 << 17
+_RUN_BATCH_POS = 24
+_RUN_BATCH_MAX = 255
+
+# spare EnumCmd value - session capability digest, the ack carries a hash of
+# the static session facts so the cached discovery answers can be replayed
+# instead of re-queried (see aiPbCmdSessionDigest)
+_CMD_SESSION_DIGEST = 18
+_SESSION_CACHE_PATH = os.path.join(os.path.expanduser('~'), '.stm_ai_runner',
+                                   'session_cache.pkl')
+_SESSION_CACHE_MAX_ENTRIES = 16
+
+# spare EnumCmd value - memory-subscription (watch) service, the device
+# samples the registered ranges itself and pushes compact change records
+# instead of being polled with MEMORY_READ requests (see aiPbCmdMemWatch)
+_CMD_MEM_WATCH = 19
+_MEM_WATCH_MAX_RANGES = 4
+_MEM_WATCH_MAX_SIZE = 64
+
+# spare EnumCmd value - partial tensor fetch, pulls an offset/stride
+# selection of a last-run output buffer instead of the whole tensor
+# (see aiPbCmdTensorFetch)
+_CMD_TENSOR_FETCH = 20
+_TENSOR_FETCH_MAX_LOOPS = 4
+
+
+def _lz4_block_decompress(raw, dst_size):
+    """Decompress a LZ4 block (fallback when the lz4 package is not installed)"""  # noqa: DAR101,DAR201,DAR401
+    try:
+        import lz4.block  # noqa: pylint: disable=import-outside-toplevel
+        return lz4.block.decompress(raw, uncompressed_size=dst_size)
+    except ImportError:
+        pass
+    dst = bytearray(dst_size)  # preallocated, filled in place
+    pos = 0
+    idx = 0
+    while idx < len(raw):
+        token = raw[idx]
+        idx += 1
+        lit_len = token >> 4
+        if lit_len == 15:
+            while raw[idx] == 255:
+                lit_len += 255
+                idx += 1
+            lit_len += raw[idx]
+            idx += 1
+        dst[pos:pos + lit_len] = raw[idx:idx + lit_len]
+        pos += lit_len
+        idx += lit_len
+        if idx >= len(raw):
+            break  # last sequence has no match part
+        offset = raw[idx] | (raw[idx + 1] << 8)
+        idx += 2
+        match_len = (token & 0x0F) + 4
+        if (token & 0x0F) == 15:
+            while raw[idx] == 255:
+                match_len += 255
+                idx += 1
+            match_len += raw[idx]
+            idx += 1
+        if offset >= match_len:  # non-overlapping match, bulk copy
+            dst[pos:pos + match_len] = dst[pos - offset:pos - offset + match_len]
+            pos += match_len
+        else:
+            for _ in range(match_len):  # byte-wise, overlapping copies are legal
+                dst[pos] = dst[pos - offset]
+                pos += 1
+    return dst if pos == dst_size else dst[:pos]
+
+
 def _decode_tensor_msg(msg, name, tag):
     """Decode aiTensorMsg to ndarray/IOTensor object"""  # noqa: DAR101,DAR201,DAR401
     tensor_msg = msg.tensor if isinstance(msg, stm32msg.respMsg) else msg
@@ -518,10 +612,15 @@ def _decode_tensor_msg(msg, name, tag):
 
     if not data.datas or (tensor_msg.desc.flags & stm32msg.TENSOR_FLAG_NO_DATA):
         return np.array([], dtype=dt_), io_tensor, is_last
-    # mutable_arr = np.frombuffer(bytearray(data.datas), dtype=dt_)
-    mutable_arr = np.fromstring(data.datas, dtype=dt_)
+    datas = data.datas
+    if tensor_msg.desc.flags & _TENSOR_FLAG_LZ4:
+        datas = _lz4_block_decompress(datas, io_tensor.get_c_size_in_bytes())
+    # preallocated final (mutable) array, one vectorized copy from the
+    # message buffer - no intermediate string/array object
+    arr = np.empty(c_shape, dtype=dt_)
+    arr.view(np.uint8).reshape(-1)[:] = np.frombuffer(datas, dtype=np.uint8)
 
-    return np.reshape(mutable_arr, c_shape), io_tensor, is_last
+    return arr, io_tensor, is_last
 
 
 def _get_model_io_desc(io_tensors):
@@ -564,6 +663,7 @@ class AiPbMsg(AiRunnerDriver):
         msg_ = f'creating {self._io_drv}'
         self._logger.debug(msg_)
         self._target_msg: List[str] = []  # used to store the 's:' from target
+        self._pipe_streamed = False  # next-sample inputs already streamed (pipelined RUN)
 
     @property
     def is_connected(self):
@@ -679,16 +779,19 @@ class AiPbMsg(AiRunnerDriver):
         buf = bytearray()
 
         packet_s = int(self._packet_in_size + 2)
+        # single packet buffer filled in place, no per-read allocations
+        p_buf = bytearray(packet_s)
+        p_view = memoryview(p_buf)
         if timeout == 0:
             t.sleep(0.2)
 
         start_time = t.monotonic()
         while True:
-            p_buf = bytearray()
-            while len(p_buf) < packet_s:
-                io_buf = self._io_drv.read(packet_s - len(p_buf))
-                if io_buf:
-                    p_buf += io_buf
+            filled = 0
+            while filled < packet_s:
+                n_read = self._io_drv.readinto(p_view[filled:])
+                if n_read:
+                    filled += n_read
                 else:
                     cum_time = t.monotonic() - start_time
                     if timeout and (cum_time > timeout / 1000):
@@ -702,10 +805,10 @@ class AiPbMsg(AiRunnerDriver):
             size = (p_buf[0] & 0x7F) << 8 | p_buf[1] & 0xFF
             if last:
                 # buf += p_buf[1:1 + p_buf[0]]
-                buf += p_buf[2:2 + size]
+                buf += p_view[2:2 + size]
                 break
             # buf += p_buf[1:packet_s]
-            buf += p_buf[2:packet_s]
+            buf += p_view[2:packet_s]
         resp = self._parse_and_check(buf, msg_type)
         return resp
 
@@ -814,6 +917,26 @@ class AiPbMsg(AiRunnerDriver):
                                     state=stm32msg.S_WAITING)
         return resp
 
+    def _cmd_clock_sync(self, timeout):
+        """CLOCK_SYNC probe"""  # noqa: DAR101,DAR201,DAR401
+        self._send_request(_CMD_CLOCK_SYNC)
+        resp = self._waiting_answer(timeout=timeout, msg_type='ack',
+                                    state=stm32msg.S_DONE)
+        return resp
+
+    def _cmd_session_digest(self, timeout=500):
+        """SESSION_DIGEST probe, None when the firmware does not support it"""  # noqa: DAR101,DAR201,DAR401
+        try:
+            self._send_request(_CMD_SESSION_DIGEST)
+            resp = self._waiting_answer(timeout=timeout, msg_type='ack',
+                                        state=None)
+        except (HwIOError, InvalidMsgError):
+            # old firmware answers S_ERROR/E_INVALID_PARAM for an unknown cmd
+            return None
+        if resp.state != stm32msg.S_DONE or resp.ack.error != stm32msg.E_NONE:
+            return None
+        return resp.ack.param
+
     def _cmd_memory_checksum(self, timeout, addr, size):
         """MEMORY_CHECKSUM command"""  # noqa: DAR101,DAR201,DAR401
         self._send_request(stm32msg.CMD_MEMORY_CHECKSUM, param=addr, opt=size)
@@ -884,6 +1007,27 @@ class AiPbMsg(AiRunnerDriver):
         self._send_ack()
         return resp
 
+    def _send_input_buffers_bulk(self, s_inputs, next_datas=None):
+        """Send all the input payloads back-to-back as raw length-prefixed
+        blobs (device built with the BULK_IO capability), single ack for
+        the whole batch. When the device reports an armed background
+        reception (pipelined RUN), next_datas is streamed immediately,
+        without framing nor host ack - the device DMA consumes it during
+        the NPU execution"""  # noqa: DAR101,DAR201,DAR401
+
+        for input_ in s_inputs:
+            dt_ = np.dtype(input_.dtype.type)
+            dt_ = dt_.newbyteorder('<')
+            datas = bytes(input_.astype(dt_).flatten().tobytes())
+            self._io_drv.write(len(datas).to_bytes(4, 'little') + datas)
+        resp = self._waiting_answer(msg_type='ack', state=stm32msg.S_PROCESSING)
+        if next_datas is not None and (resp.ack.param & _ACK_FLAG_PIPE_ARMED):
+            self._io_drv.write(next_datas)
+            self._pipe_streamed = True
+        else:
+            self._send_ack()
+        return resp
+
     def _receive_data(self):
         """Receive a data from the device and sent an ack"""  # noqa: DAR101,DAR201,DAR401
         resp = self._waiting_answer(msg_type='data')
@@ -997,6 +1141,46 @@ class AiPbMsg(AiRunnerDriver):
         }
         return model_info_msg.name
 
+    def _load_session_cache(self, digest):
+        """Replay the cached NETWORK_INFO answers matching the device digest"""  # noqa: DAR101,DAR201,DAR401
+        try:
+            with open(_SESSION_CACHE_PATH, 'rb') as cache_fd:
+                entry = pickle.load(cache_fd).get(digest)
+        except (OSError, pickle.UnpicklingError, EOFError, AttributeError):
+            return False
+        if not entry:
+            return False
+        try:
+            for minfo_raw, target_msg in entry['models']:
+                minfo = stm32msg.aiModelInfoMsg()
+                minfo.ParseFromString(minfo_raw)
+                self._target_msg = list(target_msg)
+                self._register_model(minfo)
+        except Exception as exc_:  # pylint: disable=broad-except
+            # a stale/corrupted entry should never break the discovery
+            self._logger.debug(f'session cache entry discarded ({exc_})')
+            self._models.clear()
+            return False
+        return True
+
+    def _save_session_cache(self, digest, entry):
+        """Store the NETWORK_INFO answers for replay in the next sessions"""  # noqa: DAR101,DAR201,DAR401
+        try:
+            try:
+                with open(_SESSION_CACHE_PATH, 'rb') as cache_fd:
+                    cache = pickle.load(cache_fd)
+            except (OSError, pickle.UnpicklingError, EOFError, AttributeError):
+                cache = {}
+            cache.pop(digest, None)
+            cache[digest] = entry
+            while len(cache) > _SESSION_CACHE_MAX_ENTRIES:
+                cache.pop(next(iter(cache)))  # drop the oldest entry
+            os.makedirs(os.path.dirname(_SESSION_CACHE_PATH), exist_ok=True)
+            with open(_SESSION_CACHE_PATH, 'wb') as cache_fd:
+                pickle.dump(cache, cache_fd)
+        except OSError as exc_:
+            self._logger.debug(f'session cache not saved ({exc_})')
+
     def discover(self, flush=False):
         """Build the list of the available model"""  # noqa: DAR101,DAR201,DAR401
         if flush:
@@ -1009,18 +1193,31 @@ class AiPbMsg(AiRunnerDriver):
             self._sys_info = self._cmd_sys_info(timeout=500)
         self._log_msg(self._sys_info, 'sys_info')
 
+        # the digest covers the static session facts (clocks, caps, transport
+        # limits, installed model descriptors): when it matches a previous
+        # session, the NETWORK_INFO round trips are replayed from the cache
+        digest_ = self._cmd_session_digest()
+        if digest_ is not None and self._load_session_cache(digest_):
+            msg = f'discover() replayed from the session cache (digest=0x{digest_:08x})'
+            self._logger.debug(msg)
+            return list(self._models.keys())
+
+        cached_models = []
         while cont:
             self._target_msg = []  # reset buffer to store the 's:' message from target
             n_info = self._cmd_model_info(timeout=5000, param=param)
             if n_info is not None:
                 self._log_msg(n_info, 'model_info')
             if n_info is not None:
+                cached_models.append((n_info.SerializeToString(), list(self._target_msg)))
                 name = self._register_model(n_info)
                 msg = f'discover() found="{name}"'
                 self._logger.debug(msg)
                 param += 1
             else:
                 cont = False
+        if digest_ is not None and self._models:
+            self._save_session_cache(digest_, {'models': cached_models})
         return list(self._models.keys())
 
     def _receive_features(self, profiler, callback, rt_decoder):
@@ -1153,6 +1350,7 @@ class AiPbMsg(AiRunnerDriver):
         callback = kwargs.pop('callback', None)
         sample_idx = kwargs.pop('sample_idx', -1)
         option = kwargs.pop('option', 0)
+        next_inputs = kwargs.pop('next_inputs', None)
 
         param = stm32msg.P_RUN_MODE_IO_ONLY
         if mode & AiRunner.Mode.PER_LAYER:
@@ -1176,6 +1374,15 @@ class AiPbMsg(AiRunnerDriver):
             param |= stm32msg.P_RUN_CONF_DIRECT_WRITE
             direct_write_ = True
 
+        bulk_write_ = bool(self._sync.capability & _CAP_BULK_IO) and not direct_write_\
+            and not (param & stm32msg.P_RUN_CONF_CONST_VALUE)
+        if bulk_write_:
+            param |= _RUN_CONF_BULK_WRITE
+            if next_inputs is not None:
+                # request the prefetch of the next-sample inputs, effective
+                # only when the device is built with USE_PIPELINED_RUN=1
+                param |= _RUN_CONF_PIPELINE
+
         self._logger.debug(f'-> Requested RUN mode: {mode} (param={bin(param)}, option={hex(option)})')
 
         s_outputs = []
@@ -1185,6 +1392,21 @@ class AiPbMsg(AiRunnerDriver):
         self._cmd_run(timeout=1000, c_name=name, param=param, opt=option)
 
         # send the inputs
+        if bulk_write_:
+            next_datas = None
+            if next_inputs is not None and (param & _RUN_CONF_PIPELINE):
+                next_datas = b''.join(
+                    bytes(in_.astype(np.dtype(in_.dtype.type).newbyteorder('<')).flatten().tobytes())
+                    for in_ in next_inputs)
+            if self._pipe_streamed:
+                # the inputs were already streamed during the previous NPU run
+                self._logger.debug('INPUT TENSOR(S) already on target (pipelined)..')
+                self._pipe_streamed = False
+                s_inputs = []
+            else:
+                self._logger.debug(f'SEND {len(s_inputs)} INPUT TENSOR(S) (bulk mode)..')
+            self._send_input_buffers_bulk(s_inputs, next_datas=next_datas)
+            s_inputs = []
         for idx, input_ in enumerate(s_inputs):
             is_last = (idx + 1) == model['info'].n_inputs
             target_addr = model['tens_inputs'][idx].c_addr
@@ -1252,6 +1474,75 @@ class AiPbMsg(AiRunnerDriver):
 
         return s_outputs, dur
 
+    def invoke_batch(self, inputs, **kwargs):
+        """Run a whole sample train with a single protocol exchange (batched RUN).
+        Returns None when the device does not support it, the caller falls back
+        to the per-sample path."""  # noqa: DAR101,DAR201,DAR401
+
+        name = kwargs.pop('name', None)
+        profiler = kwargs.pop('profiler', None)
+        option = kwargs.pop('option', 0)
+
+        if name is None or name not in self._models:
+            raise InvalidParamError('Invalid requested model name: ' + str(name))
+        if not (self._sync.capability & _CAP_BATCH_RUN)\
+                or not (self._sync.capability & _CAP_BULK_IO)\
+                or self._io_drv.write_memory(0, None) == 1:
+            return None
+
+        model = self._models[name]
+        rt_decoder = model['rt_decoder']
+        n_outputs = model['info'].n_outputs
+        batch_size = inputs[0].shape[0]
+
+        def _sample_blob(idx):
+            """Length-prefixed raw payloads of one sample, all inputs"""  # noqa: DAR101,DAR201,DAR401
+            blob = b''
+            for in_ in inputs:
+                datas = bytes(in_[idx].astype(
+                    np.dtype(in_.dtype.type).newbyteorder('<')).flatten().tobytes())
+                blob += len(datas).to_bytes(4, 'little') + datas
+            return blob
+
+        outputs = [[] for _ in range(n_outputs)]
+        done = 0
+        while done < batch_size:
+            chunk = min(batch_size - done, _RUN_BATCH_MAX)
+            param = stm32msg.P_RUN_MODE_IO_ONLY | _RUN_CONF_BULK_WRITE\
+                | _RUN_CONF_BATCH | (chunk << _RUN_BATCH_POS)
+            opt_ = rt_decoder.build_option_parameter(option, done)
+            self._logger.debug(f'-> Batched RUN: {chunk} sample(s) (param={bin(param)})')
+            self._cmd_run(timeout=1000, c_name=name, param=param, opt=opt_)
+
+            # the inputs of sample s+1 go out only once the outputs of sample s
+            # are drained, so a single link direction carries bulk data at a
+            # time and the exchange cannot deadlock on transport flow control
+            self._io_drv.write(_sample_blob(done))
+            for s_ in range(chunk):
+                resp = self._waiting_answer(msg_type='op', timeout=50000,
+                                            state=stm32msg.S_PROCESSING)
+                if profiler:
+                    profiler['c_durations'].append(resp.op.duration)
+                    profiler['debug']['exec_times'].append(resp.op.duration)
+                    profiler['debug']['counters']['type'] =\
+                        rt_decoder.counter_desc(resp.op.counter_type)
+                    profiler['debug']['counters']['values'].append(
+                        rt_decoder.counter_decode(resp.op.counter_type, resp.op.counters))
+                for idx in range(n_outputs):
+                    is_last_ = (s_ + 1) == chunk and (idx + 1) == n_outputs
+                    state = stm32msg.S_DONE if is_last_ else stm32msg.S_PROCESSING
+                    resp = self._waiting_answer(msg_type='tensor', timeout=50000,
+                                                state=state)
+                    output, _, _ = _decode_tensor_msg(resp, '', 'O_{}'.format(idx))
+                    outputs[idx].append(output)
+                if done + s_ + 1 < batch_size and s_ + 1 < chunk:
+                    self._io_drv.write(_sample_blob(done + s_ + 1))
+            done += chunk
+
+        self._logger.debug(f'<- done ({batch_size} samples, batched)')
+
+        return [np.concatenate(out_, axis=0) for out_ in outputs]
+
     def extension(self, name=None, **kwargs):
         """Specific command"""  # noqa: DAR101,DAR201,DAR401
 
@@ -1270,6 +1561,18 @@ class AiPbMsg(AiRunnerDriver):
         if cmd == 'self-test':
             return self._self_tests(name=name, **kwargs)
 
+        # -- host/device clock synchronization
+        if cmd == 'clock-sync':
+            return self._clock_sync_services(**kwargs)
+
+        # -- memory-subscription (watch) service
+        if cmd == 'memory-watch':
+            return self._memory_watch_services(**kwargs)
+
+        # -- partial tensor fetch
+        if cmd == 'fetch-tensor':
+            return self._tensor_fetch_services(name=name, **kwargs)
+
         # -- read/write cmd
         if AiRunner.Caps.MEMORY_RW not in self.capabilities:
             self._logger.error('RW memory capatibility not available')
@@ -1306,6 +1609,139 @@ class AiPbMsg(AiRunnerDriver):
 
         return resp_
 
+    def _clock_sync_services(self, **kwargs):
+        """Estimate the device/host clock offset and drift with a probe train"""  # noqa: DAR101,DAR201,DAR401
+
+        probes = int(kwargs.pop('probes', 31))
+        timeout = kwargs.pop('timeout', 500)
+
+        samples = []  # (host_mid_us, device_us, rtt_us)
+        wrap = 0
+        prev_dev = None
+        for _ in range(max(probes, 2)):
+            t0_ = t.perf_counter()
+            resp = self._cmd_clock_sync(timeout)
+            t1_ = t.perf_counter()
+            if resp.ack.error != stm32msg.E_NONE:
+                return {'error': resp.ack.error, 'offset_us': 0.0, 'drift_ppm': 0.0,
+                        'rtt_us': 0.0, 'samples': samples}
+            dev_ = resp.ack.param
+            if prev_dev is not None and dev_ < prev_dev:
+                wrap += _CLOCK_SYNC_WRAP_US
+            prev_dev = dev_
+            samples.append(((t0_ + t1_) * 0.5e6, float(dev_ + wrap), (t1_ - t0_) * 1e6))
+
+        # offset from the lowest-RTT probe, least queuing/scheduling noise;
+        # the device timestamp maps to the middle of the round trip
+        best = min(samples, key=lambda s: s[2])
+        offset_us = best[1] - best[0]
+
+        # drift as the least-squares slope of (device - host) over host time
+        xs_ = np.array([s[0] - samples[0][0] for s in samples])
+        ys_ = np.array([s[1] - s[0] - offset_us for s in samples])
+        drift_ppm = float(np.polyfit(xs_, ys_, 1)[0]) * 1e6 if xs_[-1] > 0 else 0.0
+
+        self._logger.debug('clock-sync offset=%.1fus drift=%.2fppm rtt=%.1fus (%d probes)',
+                           offset_us, drift_ppm, best[2], len(samples))
+
+        return {'error': stm32msg.E_NONE, 'offset_us': offset_us, 'drift_ppm': drift_ppm,
+                'rtt_us': best[2], 'samples': samples}
+
+    def _tensor_fetch_services(self, name=None, **kwargs):
+        """Fetch an offset/stride selection of a last-run output buffer"""  # noqa: DAR101,DAR201,DAR401
+
+        index = int(kwargs.pop('output', 0))
+        offset = int(kwargs.pop('offset', 0))  # base byte offset
+        run_len = int(kwargs.pop('run_len', 0))  # contiguous bytes per run
+        loops = kwargs.pop('loops', [])  # (count, byte_stride), outermost first
+        timeout = kwargs.pop('timeout', 500)
+
+        if run_len <= 0 or len(loops) > _TENSOR_FETCH_MAX_LOOPS:
+            return {'error': stm32msg.E_INVALID_PARAM, 'data': None}
+
+        # gather program, the host-side flattening of the axis selection
+        prog = struct.pack('<III', offset, run_len, len(loops))
+        prog += b''.join(struct.pack('<II', int(c_), int(s_)) for c_, s_ in loops)
+
+        self._send_request(_CMD_TENSOR_FETCH, param=index, opt=len(prog), name=name)
+        resp = self._waiting_answer(timeout=timeout, msg_type='ack', state=None)
+        if resp.state != stm32msg.S_WAITING:
+            return {'error': resp.ack.error, 'data': None}
+
+        data_msg = stm32msg.aiDataMsg()
+        data_msg.addr = 0  # pylint: disable=no-member
+        data_msg.type = 0  # pylint: disable=no-member
+        data_msg.datas = prog  # pylint: disable=no-member
+        data_msg.size = len(prog)  # pylint: disable=no-member
+        self._write_delimited(data_msg)
+
+        resp = self._waiting_answer(timeout=timeout, msg_type='ack', state=None)
+        if resp.state != stm32msg.S_PROCESSING:
+            return {'error': resp.ack.error, 'data': None}
+        total = resp.ack.param
+
+        r_data = bytes()
+        while len(r_data) < total:
+            seg_data, _, _, is_last = self._receive_data()
+            r_data += seg_data
+            if is_last:
+                break
+        return {'error': stm32msg.E_NONE, 'data': r_data}
+
+    def _memory_watch_services(self, **kwargs):
+        """Watch address ranges, collecting the pushed change records"""  # noqa: DAR101,DAR201,DAR401
+
+        ranges = kwargs.pop('ranges', [])  # list of (addr, size) tuples
+        period = int(kwargs.pop('period', 100))  # sampling period in ms
+        duration = float(kwargs.pop('duration', 1.0))  # watch window in s
+        timeout = kwargs.pop('timeout', 500)
+
+        if not ranges or len(ranges) > _MEM_WATCH_MAX_RANGES or\
+                any(size_ == 0 or size_ > _MEM_WATCH_MAX_SIZE for _, size_ in ranges):
+            return {'error': stm32msg.E_INVALID_PARAM, 'count': 0, 'records': []}
+
+        self._send_request(_CMD_MEM_WATCH, param=len(ranges), opt=period)
+        resp = self._waiting_answer(timeout=timeout, msg_type='ack', state=None)
+        if resp.state != stm32msg.S_WAITING:
+            return {'error': resp.ack.error, 'count': 0, 'records': []}
+
+        # packed {uint32 addr, uint32 size} descriptors of the watched ranges
+        descs = b''.join(struct.pack('<II', addr_, size_) for addr_, size_ in ranges)
+        data_msg = stm32msg.aiDataMsg()
+        data_msg.addr = 0  # pylint: disable=no-member
+        data_msg.type = 0  # pylint: disable=no-member
+        data_msg.datas = descs  # pylint: disable=no-member
+        data_msg.size = len(descs)  # pylint: disable=no-member
+        self._write_delimited(data_msg)
+
+        # the device first pushes the baseline records, then one record per
+        # change until the closing ack is sent; each record carries the range
+        # address, the device timestamp (us) and the new contents
+        records = []
+        deadline = t.monotonic() + duration
+        stop_sent = False
+        while True:
+            if not stop_sent and t.monotonic() >= deadline:
+                self._send_ack()  # close the session
+                stop_sent = True
+            remaining_ms = int(max(deadline - t.monotonic(), 0.0) * 1000.0)
+            try:
+                resp = self._waiting_answer(timeout=remaining_ms + timeout, state=None)
+            except TimeoutError:
+                if stop_sent:
+                    raise
+                self._send_ack()  # quiet window, close the session
+                stop_sent = True
+                continue
+            if resp.WhichOneof('payload') == 'ack':
+                # final ack, param is the device-side record count
+                return {'error': resp.ack.error, 'count': resp.ack.param,
+                        'records': records}
+            records.append({'addr': resp.data.addr, 'time_us': resp.data.type,
+                            'data': bytes(resp.data.datas)})
+            if resp.state == stm32msg.S_PROCESSING:
+                self._send_ack()
+
     def _rw_memory_services(self, cmd, **kwargs):
         """Memory RW services"""  # noqa: DAR101,DAR201,DAR401
 
@@ -212,6 +212,10 @@ class SerialHwDriver(AiHwDriver):
         """Read data from the connected device"""  # noqa: DAR101,DAR201,DAR401
         return self._hdl.read(size)
 
+    def _readinto(self, buffer, timeout=0):
+        """Read data directly into a preallocated buffer"""  # noqa: DAR101,DAR201,DAR401
+        return self._hdl.readinto(buffer)
+
     def _write(self, data, timeout=0):
         """Write data to the connected device"""  # noqa: DAR101,DAR201,DAR401
         return self._hdl.write(data)
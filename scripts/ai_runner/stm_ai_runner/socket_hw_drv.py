@@ -188,6 +188,10 @@ class SocketHwDriver(AiHwDriver):
         """Read data from the connected device"""  # noqa: DAR101,DAR201,DAR401
         return self._hdl.recv(size)
 
+    def _readinto(self, buffer, timeout=0):
+        """Read data directly into a preallocated buffer"""  # noqa: DAR101,DAR201,DAR401
+        return self._hdl.recv_into(buffer)
+
     def _write(self, data, timeout=0):
         """Send data to the socket"""  # noqa: DAR101,DAR201,DAR401
         res = self._hdl.sendall(data)
@@ -208,6 +208,22 @@ def stm32_attr_config(cache):
     return desc
 
 
+def crc32_mpeg2(data):
+    """Computing CRC-32/MPEG-2, as returned by the STM32 CRC unit
+    (poly 0x04C11DB7, init 0xFFFFFFFF, no reflection, no final xor).
+    Value of the CMD_MEMORY_CHECKSUM answer when the firmware is built
+    with USE_HW_CRC_CHECKSUM=1."""  # noqa: DAR101,DAR201,DAR401
+    if not isinstance(data, (bytes, bytearray)):
+        msg = 'crc32_mpeg2() - Invalid data type: {} instead \'bytes,bytearray\''.format(type(data))
+        raise TypeError(msg)
+    crc = 0xFFFFFFFF
+    for char in data:
+        crc ^= char << 24
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x04C11DB7 if crc & 0x80000000 else crc << 1) & 0xFFFFFFFF
+    return crc
+
+
 def bsdchecksum(data):
     """Computing BSD 16b checksum"""  # noqa: DAR101,DAR201,DAR401
     # see https://en.wikipedia.org/wiki/BSD_checksum
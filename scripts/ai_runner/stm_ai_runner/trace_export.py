@@ -0,0 +1,136 @@
+###################################################################################
+#   Copyright (c) 2024 STMicroelectronics.
+#   All rights reserved.
+#   This software is licensed under terms that can be found in the LICENSE file in
+#   the root directory of this software component.
+#   If no LICENSE file comes with this software, it is provided AS-IS.
+###################################################################################
+"""
+ST AI runner - Chrome-trace (Perfetto) exporter for the NPU epoch timelines
+
+Consumes the per-epoch stat lines emitted by the validation firmware during
+an observed/profiled RUN ('s:node:...' records: evt_pre_start/evt_post_end,
+mcu_cycles, npu_cycles, streng_active, npu_cache) plus the binary event ring
+drain ('s:evtrc:evt:...') and renders them as Chrome trace-event JSON, one
+slice per epoch on the CPU and NPU tracks, one track per stream engine, and
+the cache-miss counters as counter tracks. Open the result with
+chrome://tracing or https://ui.perfetto.dev.
+
+The device timestamps are per-epoch cycle counts (the DWT is reset at every
+epoch boundary), so the timeline is reconstructed by laying the epochs
+end-to-end: slice durations are exact, inter-epoch gaps are not represented.
+"""
+
+import argparse
+import json
+import logging
+import re
+import sys
+
+logger = logging.getLogger('STAI-RUNNER')
+
+_STAT_RE = re.compile(r's:(\w+):(\w+):(\S*)')
+
+
+def _cycles_to_us(cycles, freq_mhz):
+    return float(cycles) / float(freq_mhz)
+
+
+def parse_stat_lines(lines):
+    """Yields (category, sub_category, fields) for every stat record"""
+    for line in lines:
+        match = _STAT_RE.search(line)
+        if match:
+            yield match.group(1), match.group(2), match.group(3).split(':')
+
+
+def build_trace(lines, fcpu_mhz=800, fnpu_mhz=1000):
+    """Builds the Chrome trace-event list from the captured log lines"""
+    events = []
+    t_cpu = 0.0          # running CPU-track clock (us)
+    epoch = None         # epoch index of the slice being assembled
+    cache_miss = [0, 0]  # cumulative [read, write] misses for the counter track
+
+    def meta(pid, name):
+        events.append({'ph': 'M', 'pid': pid, 'tid': 0, 'name': 'process_name',
+                       'args': {'name': name}})
+
+    meta(0, 'CPU (epoch prep/post)')
+    meta(1, 'NPU')
+    meta(2, 'Stream engines')
+    meta(3, 'Counters')
+
+    for cat, sub, fields in parse_stat_lines(lines):
+        if cat == 'node' and sub == 'evt_pre_start':
+            epoch = int(fields[1])
+        elif cat == 'node' and sub == 'mcu_cycles' and epoch is not None:
+            cpu_start, cpu_core, cpu_end = (int(f) for f in fields[:3])
+            dur_start = _cycles_to_us(cpu_start, fcpu_mhz)
+            dur_core = _cycles_to_us(cpu_core, fcpu_mhz)
+            dur_end = _cycles_to_us(cpu_end, fcpu_mhz)
+            events.append({'ph': 'X', 'pid': 0, 'tid': 0, 'ts': t_cpu,
+                           'dur': dur_start, 'name': f'epoch {epoch} prep'})
+            events.append({'ph': 'X', 'pid': 1, 'tid': 0, 'ts': t_cpu + dur_start,
+                           'dur': dur_core, 'name': f'epoch {epoch}'})
+            events.append({'ph': 'X', 'pid': 0, 'tid': 0,
+                           'ts': t_cpu + dur_start + dur_core,
+                           'dur': dur_end, 'name': f'epoch {epoch} post'})
+            t_cpu += dur_start + dur_core + dur_end
+        elif cat == 'node' and sub == 'streng_active' and epoch is not None:
+            # i|o:<engine>:<active cycles>:<idle vs npu_core>, 'max' summary skipped
+            if fields[0] in ('i', 'o'):
+                eng = int(fields[1])
+                active = _cycles_to_us(int(fields[2]), fnpu_mhz)
+                events.append({'ph': 'X', 'pid': 2, 'tid': eng,
+                               'ts': max(t_cpu - active, 0.0), 'dur': active,
+                               'name': f'streng {eng} {fields[0]} (epoch {epoch})'})
+        elif cat == 'node' and sub == 'npu_cache' and epoch is not None:
+            # r|w:<hits>:<misses>:...
+            idx = 0 if fields[0] == 'r' else 1
+            cache_miss[idx] += int(fields[2])
+            events.append({'ph': 'C', 'pid': 3, 'tid': 0, 'ts': t_cpu,
+                           'name': 'npu_cache_miss',
+                           'args': {'read': cache_miss[0], 'write': cache_miss[1]}})
+        elif cat == 'evtrc' and sub == 'evt':
+            # type:epoch:ts:arg - instant markers on the CPU track
+            evt_type, evt_epoch, evt_ts, _ = (int(f) for f in fields[:4])
+            name = {1: 'epoch_pre', 2: 'epoch_post', 3: 'user'}.get(evt_type, 'evt')
+            events.append({'ph': 'i', 'pid': 0, 'tid': 0,
+                           'ts': t_cpu + _cycles_to_us(evt_ts, fcpu_mhz),
+                           'name': f'{name} {evt_epoch}', 's': 'g'})
+
+    return events
+
+
+def export_trace(log_file, out_file, fcpu_mhz=800, fnpu_mhz=1000):
+    """Converts a captured validation log into a Chrome trace JSON file"""
+    with open(log_file, 'r', errors='replace') as file:
+        events = build_trace(file.readlines(), fcpu_mhz, fnpu_mhz)
+    if not events:
+        logger.error('no per-epoch stat records found in %s '
+                     '(run with the observer/profile option enabled)', log_file)
+        return 1
+    with open(out_file, 'w') as file:
+        json.dump({'traceEvents': events, 'displayTimeUnit': 'ms'}, file)
+    logger.info('%d trace events written to %s', len(events), out_file)
+    return 0
+
+
+def main():
+    """CLI entry point"""
+    logging.basicConfig(level=logging.INFO, format='%(levelname)s %(message)s')
+    parser = argparse.ArgumentParser(
+        description='Export NPU epoch timelines as Chrome trace-event JSON')
+    parser.add_argument('log', help='captured validation log with s:node lines')
+    parser.add_argument('-o', '--output', default='npu_trace.json',
+                        help='output trace file (default: npu_trace.json)')
+    parser.add_argument('--fcpu', type=float, default=800.0,
+                        help='CPU frequency in MHz for cycle conversion')
+    parser.add_argument('--fnpu', type=float, default=1000.0,
+                        help='NPU frequency in MHz for cycle conversion')
+    args = parser.parse_args()
+    return export_trace(args.log, args.output, args.fcpu, args.fnpu)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,87 @@
+#!/usr/bin/env python
+
+import argparse
+import struct
+from pathlib import Path
+
+# magic numbers, see Middlewares/ST/AI/Npu/ll_aton/ec.h
+ECASM_BINARY_MAGIC = 0xECBF0030
+ECASM_BLOB_MAGIC = 0xCA057A7A
+ECASM_BLOB_MAGIC_LZ4 = 0xCA057A4C
+
+
+def lz4_block_compress(raw: bytes) -> bytes:
+    """
+    Compress a buffer as a raw LZ4 block (no frame header, size not stored).
+    """
+    try:
+        import lz4.block
+    except ImportError as exc:
+        raise SystemError(
+            "The 'lz4' package is required to compress Epoch Controller binaries "
+            "(pip install lz4)"
+        ) from exc
+    return lz4.block.compress(raw, store_size=False, mode="high_compression")
+
+
+def compress_ec_binary(data: bytes, verbose: bool) -> bytes:
+    """
+    Replace the blob section of an Epoch Controller binary with its LZ4-compressed
+    variant (decompressed on target by ec_copy_blob).
+    """
+    magic, reloc_off, patch_off, debug_off, blob_off = struct.unpack_from("<5I", data, 0)
+
+    if magic != ECASM_BINARY_MAGIC:
+        raise SystemError("Input is not an Epoch Controller binary")
+    if blob_off == 0:
+        raise SystemError("Epoch Controller binary has no blob section")
+
+    blob_magic, blob_size = struct.unpack_from("<2I", data, blob_off)
+
+    if blob_magic == ECASM_BLOB_MAGIC_LZ4:
+        raise SystemError("Epoch Controller blob is already compressed")
+    if blob_magic != ECASM_BLOB_MAGIC:
+        raise SystemError("Invalid magic number of Epoch Controller blob")
+
+    raw = data[blob_off + 8 : blob_off + 8 + blob_size * 4]
+    payload = lz4_block_compress(raw)
+
+    if verbose:
+        print(f"blob section: {len(raw)} -> {len(payload)} bytes "
+              f"({100.0 * len(payload) / len(raw):.1f}%)")
+
+    # compressed section: magic, uncompressed size in 32-bit words, compressed size in
+    # bytes, payload (padded to keep the file 8-byte aligned)
+    section = struct.pack("<3I", ECASM_BLOB_MAGIC_LZ4, blob_size, len(payload)) + payload
+    section += b"\x00" * (-len(section) % 8)
+
+    # the blob is the last section of the binary: the header offsets are unchanged
+    return data[:blob_off] + section
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="compress the blob section of an Epoch Controller binary"
+    )
+    parser.add_argument("--inputfile", required=True, help="Epoch Controller binary to compress")
+    parser.add_argument(
+        "--outputfile",
+        required=False,
+        help="output file (defaults to compressing in place)",
+    )
+    parser.add_argument(
+        "--verbose", required=False, action="store_true", help="verbose"
+    )
+
+    args = parser.parse_args()
+
+    inputfile = Path(args.inputfile).absolute()
+    outputfile = Path(args.outputfile).absolute() if args.outputfile else inputfile
+
+    assert inputfile.exists(), "Epoch Controller binary not found"
+
+    outputfile.write_bytes(compress_ec_binary(inputfile.read_bytes(), args.verbose))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,99 @@
+#!/usr/bin/env python
+
+import argparse
+import struct
+from pathlib import Path
+
+# magic numbers, see Middlewares/ST/AI/Npu/ll_aton/ec.h
+ECASM_BINARY_MAGIC = 0xECBF0030
+ECASM_BINARY_MAGIC_COOKED = 0xECBF0031
+ECASM_BLOB_MAGIC = 0xCA057A7A
+ECASM_BLOB_MAGIC_LZ4 = 0xCA057A4C
+
+# cooked header: magic, reloc/patch/debug/blob offsets, reloc/patch/blob sizes in words
+COOKED_HEADER_SIZE = 8 * 4
+
+
+def _align8(data: bytes) -> bytes:
+    return data + b"\x00" * (-len(data) % 8)
+
+
+def cook_ec_binary(data: bytes, verbose: bool) -> bytes:
+    """
+    Convert an Epoch Controller binary into its "cooked" variant: the header is
+    extended with the precomputed word sizes of the relocation table, the patch
+    table and the blob section, and every section is realigned to 8 bytes so the
+    blob can be used in place (see ec_get_cooked_blob in ecloader.c).
+    """
+    magic, reloc_off, patch_off, debug_off, blob_off = struct.unpack_from("<5I", data, 0)
+
+    if magic == ECASM_BINARY_MAGIC_COOKED:
+        raise SystemError("Epoch Controller binary is already cooked")
+    if magic != ECASM_BINARY_MAGIC:
+        raise SystemError("Input is not an Epoch Controller binary")
+    if blob_off == 0:
+        raise SystemError("Epoch Controller binary has no blob section")
+
+    # section boundaries, in file order (same derivation as the on-target loader)
+    reloc_end = patch_off or debug_off or blob_off
+    patch_end = debug_off or blob_off
+
+    reloc = data[reloc_off:reloc_end] if reloc_off else b""
+    patch = data[patch_off:patch_end] if patch_off else b""
+    debug = data[debug_off:blob_off] if debug_off else b""
+    blob = data[blob_off:]
+
+    blob_magic, blob_size = struct.unpack_from("<2I", blob, 0)
+
+    if blob_magic not in (ECASM_BLOB_MAGIC, ECASM_BLOB_MAGIC_LZ4):
+        raise SystemError("Invalid magic number of Epoch Controller blob")
+
+    # rebuild the container with 8-byte aligned sections
+    out = bytearray(COOKED_HEADER_SIZE)
+    offsets = []
+
+    for section in (reloc, patch, debug, blob):
+        offsets.append(len(out) if section else 0)
+        out += _align8(section)
+
+    struct.pack_into(
+        "<8I", out, 0,
+        ECASM_BINARY_MAGIC_COOKED, *offsets,
+        len(reloc) // 4, len(patch) // 4, blob_size + 2,
+    )
+
+    if verbose:
+        print(f"reloc table: {len(reloc) // 4} words @ {offsets[0]:#x}")
+        print(f"patch table: {len(patch) // 4} words @ {offsets[1]:#x}")
+        print(f"blob section: {blob_size + 2} words @ {offsets[3]:#x}"
+              f"{' (compressed, no in-place use)' if blob_magic == ECASM_BLOB_MAGIC_LZ4 else ''}")
+
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="cook an Epoch Controller binary for parse-free loading"
+    )
+    parser.add_argument("--inputfile", required=True, help="Epoch Controller binary to cook")
+    parser.add_argument(
+        "--outputfile",
+        required=False,
+        help="output file (defaults to cooking in place)",
+    )
+    parser.add_argument(
+        "--verbose", required=False, action="store_true", help="verbose"
+    )
+
+    args = parser.parse_args()
+
+    inputfile = Path(args.inputfile).absolute()
+    outputfile = Path(args.outputfile).absolute() if args.outputfile else inputfile
+
+    assert inputfile.exists(), "Epoch Controller binary not found"
+
+    outputfile.write_bytes(cook_ec_binary(inputfile.read_bytes(), args.verbose))
+
+
+if __name__ == "__main__":
+    main()
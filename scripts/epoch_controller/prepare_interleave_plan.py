@@ -0,0 +1,129 @@
+#!/usr/bin/env python
+
+import argparse
+import json
+from pathlib import Path
+
+
+def load_profile(fname: Path):
+    """
+    Load a per-epoch profile and normalize it to a list of
+    (duration_us, dma_bound) tuples.
+
+    Accepted formats:
+      - plain JSON list of durations in us: [120.5, 80.0, ...]
+      - list of objects: [{"dur_us": 120.5, "dma_bound": true}, ...]
+      - object wrapper: {"epochs": [...]} with either of the above
+    When no "dma_bound" flag is present an epoch is considered DMA bound
+    if its "npu_busy_us" is below half of its duration.
+    """
+    with open(fname, encoding="utf-8") as ifile:
+        data = json.load(ifile)
+    if isinstance(data, dict):
+        data = data["epochs"]
+    epochs = []
+    for item in data:
+        if isinstance(item, dict):
+            dur = float(item.get("dur_us", item.get("duration", 0.0)))
+            if "dma_bound" in item:
+                bound = bool(item["dma_bound"])
+            else:
+                bound = float(item.get("npu_busy_us", dur)) < (dur / 2)
+            epochs.append((dur, bound))
+        else:
+            epochs.append((float(item), False))
+    if not epochs:
+        raise ValueError(f"{fname}: empty profile")
+    return epochs
+
+
+def compute_plan(primary, secondary, gap_scale):
+    """
+    Compute a deterministic interleave plan for two networks.
+
+    Walk the primary epochs in order and accumulate the time spent in
+    DMA-bound epochs as 'gap credit'. Whenever the credit covers the next
+    secondary epoch (scaled by 'gap_scale'), slot that secondary epoch in
+    right after the current primary one. Secondary epochs left over when
+    the primary network is exhausted are appended at the end.
+
+    Returns the plan as a list of task indices (0 primary, 1 secondary).
+    """
+    plan = []
+    credit = 0.0
+    sec_idx = 0
+    for dur, bound in primary:
+        plan.append(0)
+        if bound:
+            credit += dur
+        while (sec_idx < len(secondary)) and (credit * gap_scale >= secondary[sec_idx][0]):
+            credit -= secondary[sec_idx][0] / gap_scale
+            plan.append(1)
+            sec_idx += 1
+    while sec_idx < len(secondary):
+        plan.append(1)
+        sec_idx += 1
+    return plan
+
+
+def emit_header(ofname: Path, name: str, plan, primary, secondary):
+    """
+    Emit the plan as a C header consumed by npu_run_plan().
+    """
+    guard = f"NPU_PLAN_{name.upper()}_H"
+    n_interleaved = sum(1 for i, t in enumerate(plan[:-1]) if t == 1 and plan[i + 1] == 0)
+    with open(ofname.as_posix(), "w", encoding="utf-8") as ofile:
+        ofile.write(f"/* Generated by prepare_interleave_plan.py -- do not edit.\n")
+        ofile.write(f" * primary: {len(primary)} epoch blocks, "
+                    f"secondary: {len(secondary)} epoch blocks,\n")
+        ofile.write(f" * {n_interleaved} secondary blocks slotted into primary DMA-bound gaps.\n")
+        ofile.write(f" * Task index 0 is the primary network, 1 the secondary one.\n */\n")
+        ofile.write(f"#ifndef {guard}\n")
+        ofile.write(f"#define {guard}\n\n")
+        ofile.write("#include <stdint.h>\n\n")
+        ofile.write(f"#define NPU_PLAN_{name.upper()}_LEN ({len(plan)})\n\n")
+        ofile.write(f"static const uint8_t npu_plan_{name}[NPU_PLAN_{name.upper()}_LEN] = {{\n")
+        for i in range(0, len(plan), 16):
+            ofile.write("  " + ", ".join(str(t) for t in plan[i:i + 16]) + ",\n")
+        ofile.write("};\n\n")
+        ofile.write(f"#endif /* {guard} */\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="compute a static epoch interleave plan for a pair of "
+                    "networks from per-epoch profile data, emitted as a C "
+                    "header for npu_run_plan()"
+    )
+    parser.add_argument(
+        "--primary", required=True, help="per-epoch profile of the long-running network (json)"
+    )
+    parser.add_argument(
+        "--secondary", required=True, help="per-epoch profile of the network to slot into the gaps (json)"
+    )
+    parser.add_argument(
+        "--out", required=True, help="path of the C header to generate"
+    )
+    parser.add_argument(
+        "--name", required=False, type=str, default="default",
+        help="symbol suffix used in the generated header",
+    )
+    parser.add_argument(
+        "--gap-scale", required=False, type=float, default=1.0,
+        help="fraction of the accumulated DMA-bound gap time considered "
+             "usable for secondary epochs (< 1.0 is conservative)",
+    )
+    args = parser.parse_args()
+
+    primary = load_profile(Path(args.primary))
+    secondary = load_profile(Path(args.secondary))
+
+    plan = compute_plan(primary, secondary, args.gap_scale)
+    emit_header(Path(args.out), args.name, plan, primary, secondary)
+
+    print(f"{args.out}: {len(plan)} slots "
+          f"({len(primary)} primary / {len(secondary)} secondary epoch blocks)")
+
+
+if __name__ == "__main__":
+    main()